@@ -0,0 +1,101 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+// Helpers shared by the benchmark programs: a wall clock timer and the
+// structured grid meshes that several benchmarks run on.
+
+#pragma once
+#include <MeshLib/FEMesh.h>
+#include <chrono>
+
+//-----------------------------------------------------------------------------
+// Measures wall clock time in seconds. The timer starts when it is created.
+class BenchmarkTimer
+{
+	typedef std::chrono::steady_clock clock;
+
+public:
+	BenchmarkTimer() { start(); }
+
+	// restart the timer
+	void start() { m_t0 = clock::now(); }
+
+	// time since the timer was started
+	double elapsed() const { return std::chrono::duration<double>(clock::now() - m_t0).count(); }
+
+	// time since the timer was started, after which the timer is restarted
+	double lap()
+	{
+		clock::time_point t1 = clock::now();
+		double t = std::chrono::duration<double>(t1 - m_t0).count();
+		m_t0 = t1;
+		return t;
+	}
+
+private:
+	clock::time_point	m_t0;
+};
+
+//-----------------------------------------------------------------------------
+// Creates an n x n x n grid of hexes, or of tets when each hex is split in six.
+// Only the nodes and elements are created; the caller builds the mesh topology.
+inline void createGridMesh(FEMesh& m, int n, bool tets)
+{
+	int n1 = n + 1;
+	int NE = n*n*n*(tets ? 6 : 1);
+
+	m.Create(n1*n1*n1, NE);
+	for (int k = 0; k <= n; ++k)
+		for (int j = 0; j <= n; ++j)
+			for (int i = 0; i <= n; ++i) m.Node((k*n1 + j)*n1 + i).r = vec3d(i, j, k);
+
+	const int tet[6][4] = { { 0,1,2,6 },{ 0,2,3,6 },{ 0,3,7,6 },{ 0,7,4,6 },{ 0,4,5,6 },{ 0,5,1,6 } };
+	int ne = 0;
+	for (int k = 0; k < n; ++k)
+		for (int j = 0; j < n; ++j)
+			for (int i = 0; i < n; ++i)
+			{
+				int m0 = (k*n1 + j)*n1 + i;
+				int nn[8] = { m0, m0 + 1, m0 + n1 + 1, m0 + n1, m0 + n1*n1, m0 + n1*n1 + 1, m0 + n1*n1 + n1 + 1, m0 + n1*n1 + n1 };
+				if (tets)
+				{
+					for (int l = 0; l < 6; ++l)
+					{
+						FEElement& el = m.Element(ne++);
+						el.SetType(FE_TET4);
+						el.m_gid = 0;
+						for (int a = 0; a < 4; ++a) el.m_node[a] = nn[tet[l][a]];
+					}
+				}
+				else
+				{
+					FEElement& el = m.Element(ne++);
+					el.SetType(FE_HEX8);
+					el.m_gid = 0;
+					for (int a = 0; a < 8; ++a) el.m_node[a] = nn[a];
+				}
+			}
+}
@@ -0,0 +1,74 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+// Memory benchmark for the element storage of FEMesh. Creates large tet and hex 
+// meshes and reports how many bytes the element, face and node tables use per 
+// element, and how much of the element table is connectivity.
+//
+// usage: ElementMemoryBenchmark [max grid size]
+
+#include "BenchmarkHelpers.h"
+#include <MeshLib/FEElementLibrary.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	int maxGrid = (argc > 1 ? atoi(argv[1]) : 128);
+
+	FEElementLibrary::InitLibrary();
+
+	printf("sizeof(FEElement) = %d, sizeof(FEFace) = %d, sizeof(FENode) = %d\n\n", (int)sizeof(FEElement), (int)sizeof(FEFace), (int)sizeof(FENode));
+	printf("%6s %10s %12s %12s %12s %12s %12s %10s\n", "type", "elements", "elems (MB)", "faces (MB)", "nodes (MB)", "conn (MB)", "bytes/elem", "time (s)");
+	for (int l = 0; l < 2; ++l)
+	{
+		bool tets = (l == 1);
+		for (int n = 16; n <= maxGrid; n *= 2)
+		{
+			BenchmarkTimer timer;
+			FEMesh* pm = new FEMesh;
+			createGridMesh(*pm, n, tets);
+			pm->RebuildMesh();
+			double t = timer.elapsed();
+
+			int NE = pm->Elements();
+			double elemBytes = (double)NE*sizeof(FEElement);
+			double faceBytes = (double)pm->Faces()*sizeof(FEFace);
+			double nodeBytes = (double)pm->Nodes()*sizeof(FENode);
+
+			// bytes needed for the connectivity alone
+			double connBytes = (double)NE*(tets ? 4 : 8)*sizeof(int);
+
+			const double MB = 1024.0*1024.0;
+			printf("%6s %10d %12.1f %12.1f %12.1f %12.1f %12.1f %10.3f\n", (tets ? "tet4" : "hex8"), NE, elemBytes / MB, faceBytes / MB, nodeBytes / MB, connBytes / MB, (elemBytes + faceBytes + nodeBytes) / NE, t);
+
+			delete pm;
+		}
+	}
+
+	return 0;
+}
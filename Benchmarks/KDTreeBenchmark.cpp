@@ -0,0 +1,137 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+// Benchmark for the k-d tree that is used for the closest point queries in the
+// ICP registration. The tree is compared with a brute-force scan, both for the
+// timings and for the closest points that are found. 
+//
+// usage: KDTreeBenchmark [max nr of points] [max nr of brute-force queries]
+
+#include "BenchmarkHelpers.h"
+#include <MeshTools/FEKDTree.h>
+#include <MeshTools/ICPRegistration.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+using std::vector;
+
+//-----------------------------------------------------------------------------
+// random points on a wavy surface, similar to a surface scan
+static void createScan(int n, unsigned int seed, vector<vec3d>& pts)
+{
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<double> u(0.0, 1.0);
+	pts.resize(n);
+	for (int i = 0; i < n; ++i)
+	{
+		double x = u(rng), y = u(rng);
+		pts[i] = vec3d(x, y, 0.1*sin(6.0*x)*cos(4.0*y));
+	}
+}
+
+//-----------------------------------------------------------------------------
+static int bruteForceClosest(const vector<vec3d>& pts, const vec3d& x, double& dmin)
+{
+	int imin = -1;
+	dmin = 0.0;
+	for (int i = 0; i < (int)pts.size(); ++i)
+	{
+		double d = (pts[i] - x).SqrLength();
+		if ((imin == -1) || (d < dmin)) { imin = i; dmin = d; }
+	}
+	return imin;
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	int maxPoints = (argc > 1 ? atoi(argv[1]) : 200000);
+	int maxBrute = (argc > 2 ? atoi(argv[2]) : 2000);
+
+	printf("closest point queries (all points are queried)\n");
+	printf("%10s %12s %12s %14s %17s %10s\n", "points", "build (s)", "kd (s)", "kd/query (us)", "brute/query (us)", "mismatch");
+	for (int n = 25000; n <= maxPoints; n *= 2)
+	{
+		vector<vec3d> trg, qry;
+		createScan(n, 1, trg);
+		createScan(n, 2, qry);
+
+		BenchmarkTimer timer;
+		FEKDTree tree;
+		tree.Build(trg);
+		double tbuild = timer.elapsed();
+
+		// query all points in parallel
+		vector<int> ind(n);
+		vector<double> dist(n);
+		timer.start();
+#pragma omp parallel for
+		for (int i = 0; i < n; ++i) ind[i] = tree.FindClosest(qry[i], dist[i]);
+		double tkd = timer.elapsed();
+
+		// compare a subset with the brute-force scan
+		int nb = (n < maxBrute ? n : maxBrute);
+		int mismatch = 0;
+		timer.start();
+		for (int i = 0; i < nb; ++i)
+		{
+			double d;
+			int j = bruteForceClosest(trg, qry[i], d);
+			if ((j != ind[i]) || (d != dist[i])) mismatch++;
+		}
+		double tbrute = timer.elapsed();
+
+		printf("%10d %12.4f %12.4f %14.3f %17.3f %10d\n", n, tbuild, tkd, 1e6*tkd / n, (nb > 0 ? 1e6*tbrute / nb : 0.0), mismatch);
+	}
+
+	// register a scan to a rotated and shifted copy of itself
+	printf("\nICP registration\n");
+	printf("%10s %12s %10s %14s\n", "points", "time (s)", "iters", "rel. error");
+	for (int n = 25000; n <= maxPoints; n *= 2)
+	{
+		vector<vec3d> trg, src;
+		createScan(n, 1, trg);
+
+		quatd q(0.05, vec3d(0, 0, 1));
+		src.resize(n);
+		for (int i = 0; i < n; ++i)
+		{
+			vec3d r = trg[i];
+			q.RotateVector(r);
+			src[i] = r + vec3d(0.02, -0.01, 0.005);
+		}
+
+		GICPRegistration icp;
+		icp.SetMaxIterations(50);
+		BenchmarkTimer timer;
+		icp.Register(trg, src);
+		double t = timer.elapsed();
+
+		printf("%10d %12.4f %10d %14.3e\n", n, t, icp.Iterations(), icp.RelativeError());
+	}
+
+	return 0;
+}
@@ -0,0 +1,155 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+// Benchmark for LaplaceSolver. Solves a Laplace problem on hex meshes that are 
+// graded in one direction (the largest element is 100 times the smallest) with 
+// nodal relaxation and with the preconditioned CG method. Reports the iteration 
+// counts, times and the max difference with a tightly converged CG solution.
+//
+// The results are written to stderr, since the relaxation method prints its 
+// convergence history to stdout.
+//
+// usage: LaplaceBenchmark [max grid size] [tolerance] 2> results.txt
+
+#include "BenchmarkHelpers.h"
+#include <MeshLib/FEMesh.h>
+#include <MeshLib/FEElementLibrary.h>
+#include <MeshTools/LaplaceSolver.h>
+#include <MathLib/PCGSolver.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//-----------------------------------------------------------------------------
+// creates an n x n x n grid of hexes on the unit cube, graded in the x-direction
+static void createGradedMesh(FEMesh& m, int n, double ratio)
+{
+	int n1 = n + 1;
+	m.Create(n1*n1*n1, n*n*n);
+
+	double g = pow(ratio, 1.0 / (n - 1));
+	for (int k = 0; k <= n; ++k)
+		for (int j = 0; j <= n; ++j)
+			for (int i = 0; i <= n; ++i)
+			{
+				double x = (pow(g, i) - 1.0) / (pow(g, n) - 1.0);
+				m.Node((k*n1 + j)*n1 + i).r = vec3d(x, (double)j / n, (double)k / n);
+			}
+
+	int ne = 0;
+	for (int k = 0; k < n; ++k)
+		for (int j = 0; j < n; ++j)
+			for (int i = 0; i < n; ++i)
+			{
+				int m0 = (k*n1 + j)*n1 + i;
+				int nn[8] = { m0, m0 + 1, m0 + n1 + 1, m0 + n1, m0 + n1*n1, m0 + n1*n1 + 1, m0 + n1*n1 + n1 + 1, m0 + n1*n1 + n1 };
+				FEElement& el = m.Element(ne++);
+				el.SetType(FE_HEX8);
+				el.m_gid = 0;
+				for (int a = 0; a < 8; ++a) el.m_node[a] = nn[a];
+			}
+	m.TagAllElements(1);
+}
+
+//-----------------------------------------------------------------------------
+// u = 0 on x = 0, and u = 1 on the lower half of x = 1
+static void setBoundaryConditions(int n, vector<double>& val, vector<int>& bn)
+{
+	int n1 = n + 1;
+	val.assign(n1*n1*n1, 0.0);
+	bn.assign(n1*n1*n1, 0);
+	for (int k = 0; k <= n; ++k)
+		for (int j = 0; j <= n; ++j)
+		{
+			bn[(k*n1 + j)*n1] = 1;
+			if (2 * j < n)
+			{
+				bn[(k*n1 + j)*n1 + n] = 1;
+				val[(k*n1 + j)*n1 + n] = 1.0;
+			}
+		}
+}
+
+//-----------------------------------------------------------------------------
+enum Method { SOR, CG_JACOBI, CG_IC0 };
+
+static bool solve(FEMesh& m, int n, Method method, double tol, vector<double>& val, int& iters, double& time)
+{
+	vector<int> bn;
+	setBoundaryConditions(n, val, bn);
+
+	LaplaceSolver L;
+	L.SetMaxIterations(100000);
+	L.SetTolerance(tol);
+	if (method == SOR) L.SetMethod(LaplaceSolver::RELAXATION);
+	else
+	{
+		L.SetMethod(LaplaceSolver::CONJUGATE_GRADIENT);
+		L.SetPreconditioner(method == CG_JACOBI ? PCGSolver::JACOBI : PCGSolver::IC0);
+	}
+
+	BenchmarkTimer timer;
+	bool b = L.Solve(&m, val, bn, 1);
+	time = timer.elapsed();
+	iters = L.GetIterationCount();
+	return b;
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	int maxGrid = (argc > 1 ? atoi(argv[1]) : 64);
+	double tol = (argc > 2 ? atof(argv[2]) : 1e-6);
+
+	FEElementLibrary::InitLibrary();
+
+	const char* names[] = { "SOR", "CG+Jacobi", "CG+IC0" };
+
+	fprintf(stderr, "%8s %10s %10s %10s %10s %12s\n", "nodes", "method", "converged", "iters", "time (s)", "max error");
+	for (int n = 16; n <= maxGrid; n *= 2)
+	{
+		FEMesh m;
+		createGradedMesh(m, n, 100.0);
+
+		// reference solution
+		vector<double> ref;
+		int iters; double time;
+		solve(m, n, CG_IC0, 1e-12, ref, iters, time);
+
+		for (int i = 0; i < 3; ++i)
+		{
+			vector<double> val;
+			bool b = solve(m, n, (Method)i, tol, val, iters, time);
+
+			double err = 0.0;
+			for (size_t j = 0; j < val.size(); ++j) err = fmax(err, fabs(val[j] - ref[j]));
+
+			fprintf(stderr, "%8d %10s %10s %10d %10.3f %12.3e\n", m.Nodes(), names[i], (b ? "yes" : "no"), iters, time, err);
+		}
+	}
+
+	return 0;
+}
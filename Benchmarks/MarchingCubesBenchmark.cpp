@@ -0,0 +1,122 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+// Benchmark for the marching cubes iso-surface extraction. Synthetic volumes 
+// (a dense, wavy field and a single sphere in an empty volume) are written to a 
+// raw file and loaded in an image model. The surface is extracted with and without
+// skipping empty voxel blocks; both must give the same mesh.
+//
+// usage: MarchingCubesBenchmark [max volume size] [file name]
+
+#include "BenchmarkHelpers.h"
+#include <PostLib/MarchingCubes.h>
+#include <PostLib/ImageModel.h>
+#include <vector>
+#include <string>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+using namespace Post;
+
+//-----------------------------------------------------------------------------
+// writes an n^3 volume of 8-bit values
+static bool writeVolume(const char* szfile, int n, bool dense)
+{
+	std::vector<unsigned char> v((size_t)n*n*n);
+	for (int k = 0; k < n; ++k)
+		for (int j = 0; j < n; ++j)
+			for (int i = 0; i < n; ++i)
+			{
+				float x = (float)i / n - 0.5f, y = (float)j / n - 0.5f, z = (float)k / n - 0.5f;
+				float f;
+				if (dense)
+				{
+					float r = sqrtf(x*x + y*y + z*z);
+					f = 0.5f + 0.25f*sinf(20.f*x)*cosf(20.f*y) + 0.25f*sinf(20.f*z)*(r < 0.4f ? 1.f : 0.2f);
+				}
+				else f = (x*x + y*y + z*z < 0.1f ? 1.f : 0.f);
+
+				if (f < 0.f) f = 0.f;
+				if (f > 1.f) f = 1.f;
+				v[((size_t)k*n + j)*n + i] = (unsigned char)(255.f*f);
+			}
+
+	FILE* fp = fopen(szfile, "wb");
+	if (fp == nullptr) return false;
+	bool ret = (fwrite(v.data(), 1, v.size(), fp) == v.size());
+	fclose(fp);
+	return ret;
+}
+
+//-----------------------------------------------------------------------------
+static double extract(CMarchingCubes& mc, bool skipBlocks)
+{
+	mc.SetBlockSkipping(skipBlocks);
+	BenchmarkTimer timer;
+	mc.UpdateData(true);
+	return timer.elapsed();
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	int maxSize = (argc > 1 ? atoi(argv[1]) : 512);
+	std::string file = (argc > 2 ? argv[2] : "marching_cubes_benchmark.raw");
+
+	printf("%8s %6s %12s %12s %10s %12s %12s %8s\n", "volume", "size", "nodes", "faces", "mesh (MB)", "no skip (s)", "skip (s)", "match");
+	for (int l = 0; l < 2; ++l)
+	{
+		bool dense = (l == 0);
+		for (int n = 64; n <= maxSize; n *= 2)
+		{
+			if (writeVolume(file.c_str(), n, dense) == false) { fprintf(stderr, "Failed writing %s\n", file.c_str()); return 1; }
+
+			CImageModel img(nullptr);
+			if (img.LoadImageData(file, n, n, n, BOX(0, 0, 0, 1, 1, 1)) == false) { fprintf(stderr, "Failed reading %s\n", file.c_str()); return 1; }
+
+			CMarchingCubes mc(&img);
+			mc.SetIsoValue(0.5f);
+			mc.SetSmooth(true);
+			mc.SetCloseSurface(true);
+			mc.SetInvertSpace(false);
+			mc.UpdateData(false);
+
+			double t0 = extract(mc, false);
+			int nodes = mc.GetMesh().Nodes();
+			int faces = mc.GetMesh().Faces();
+
+			double t1 = extract(mc, true);
+			bool match = (mc.GetMesh().Nodes() == nodes) && (mc.GetMesh().Faces() == faces);
+
+			double MB = ((double)nodes*2.0*sizeof(vec3f) + (double)faces*sizeof(TriMesh::TRI)) / (1024.0*1024.0);
+			printf("%8s %6d %12d %12d %10.1f %12.4f %12.4f %8s\n", (dense ? "dense" : "sphere"), n, nodes, faces, MB, t0, t1, (match ? "yes" : "NO"));
+		}
+	}
+
+	remove(file.c_str());
+
+	return 0;
+}
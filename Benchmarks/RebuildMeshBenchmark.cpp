@@ -0,0 +1,82 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+// Benchmark for the mesh topology rebuild. Creates large hex and tet meshes and 
+// times FEMesh::RebuildMesh, followed by each of the Rebuild*Data stages that 
+// FEMesh::BuildMesh runs.
+//
+// usage: RebuildMeshBenchmark [max grid size]
+
+#include "BenchmarkHelpers.h"
+#include <MeshLib/FEElementLibrary.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//-----------------------------------------------------------------------------
+// gives access to the separate stages of FEMesh::BuildMesh
+class FEMeshBenchmark : public FEMesh
+{
+public:
+	void ElementData() { RebuildElementData(); }
+	void FaceData() { RebuildFaceData(); }
+	void EdgeData() { RebuildEdgeData(); }
+	void NodeData() { RebuildNodeData(); }
+};
+
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	int maxGrid = (argc > 1 ? atoi(argv[1]) : 128);
+
+	FEElementLibrary::InitLibrary();
+
+	printf("%6s %10s %10s %10s %12s %10s %10s %10s %10s %10s\n", "type", "elements", "faces", "edges", "rebuild (s)", "elem (s)", "face (s)", "edge (s)", "node (s)", "update (s)");
+	for (int l = 0; l < 2; ++l)
+	{
+		bool tets = (l == 1);
+		for (int n = 16; n <= maxGrid; n *= 2)
+		{
+			FEMeshBenchmark m;
+			createGridMesh(m, n, tets);
+
+			// the full rebuild, which creates the faces and edges
+			BenchmarkTimer timer;
+			m.RebuildMesh();
+			double trebuild = timer.lap();
+
+			// the stages of BuildMesh
+			m.ElementData(); double telem = timer.lap();
+			m.FaceData();    double tface = timer.lap();
+			m.EdgeData();    double tedge = timer.lap();
+			m.NodeData();    double tnode = timer.lap();
+			m.UpdateMesh();  double tupdate = timer.lap();
+
+			printf("%6s %10d %10d %10d %12.3f %10.3f %10.3f %10.3f %10.3f %10.3f\n", (tets ? "tet4" : "hex8"), m.Elements(), m.Faces(), m.Edges(), trebuild, telem, tface, tedge, tnode, tupdate);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,169 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+// Benchmark for the node weld modifier. A grid of quads with unshared nodes 
+// (as in an STL-derived surface) is welded with FEWeldNodes and with the 
+// pair loop that it replaced. Both should find the same number of nodes.
+//
+// usage: WeldBenchmark [max grid size] [max nodes for the pair loop]
+
+#include "BenchmarkHelpers.h"
+#include <MeshTools/FEWeldModifier.h>
+#include <MeshLib/FEMesh.h>
+#include <MeshLib/FEElementLibrary.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+
+//-----------------------------------------------------------------------------
+// gives access to the node weld step
+class FEWeldNodesBenchmark : public FEWeldNodes
+{
+public:
+	void Weld(FEMesh* pm) { UpdateNodes(pm); }
+};
+
+//-----------------------------------------------------------------------------
+// creates an nx x nx grid of quads, where each quad has its own nodes. The nodes
+// are perturbed by at most eps.
+static FEMesh* createQuadSoup(int nx, double eps)
+{
+	std::mt19937 rng(1);
+	std::uniform_real_distribution<double> d(-eps, eps);
+
+	FEMesh* pm = new FEMesh;
+	pm->Create(4 * nx * nx, nx * nx);
+	for (int j = 0; j < nx; ++j)
+		for (int i = 0; i < nx; ++i)
+		{
+			int ne = j * nx + i;
+			FEElement& el = pm->Element(ne);
+			el.SetType(FE_QUAD4);
+			el.m_gid = 0;
+
+			const int di[4] = { 0, 1, 1, 0 };
+			const int dj[4] = { 0, 0, 1, 1 };
+			for (int k = 0; k < 4; ++k)
+			{
+				FENode& node = pm->Node(4 * ne + k);
+				node.r = vec3d(i + di[k] + d(rng), j + dj[k] + d(rng), d(rng));
+				node.Select();
+				el.m_node[k] = 4 * ne + k;
+			}
+		}
+	return pm;
+}
+
+//-----------------------------------------------------------------------------
+// The pair loop that was used by FEWeldNodes before. Returns the nr of nodes
+// that are left after welding.
+static int pairLoopWeld(FEMesh& m, double threshold)
+{
+	int nodes = m.Nodes();
+	vector<int> sel; sel.reserve(nodes);
+	for (int i = 0; i < nodes; ++i) if (m.Node(i).IsSelected()) sel.push_back(i);
+
+	vector<int> order(nodes);
+	for (int i = 0; i < nodes; ++i) order[i] = i;
+
+	double eps = threshold * threshold;
+	int n = (int)sel.size();
+	for (int i = 0; i < n - 1; ++i)
+		for (int j = i + 1; j < n; ++j)
+		{
+			int ni = order[sel[i]];
+			int nj = order[sel[j]];
+			if (ni != nj)
+			{
+				vec3d& ri = m.Node(ni).r;
+				vec3d& rj = m.Node(nj).r;
+				double d = (ri.x - rj.x)*(ri.x - rj.x) + (ri.y - rj.y)*(ri.y - rj.y) + (ri.z - rj.z)*(ri.z - rj.z);
+				if (d <= eps)
+				{
+					order[sel[j]] = ni;
+					ri = (ri + rj)*0.5;
+				}
+			}
+		}
+
+	int count = 0;
+	for (int i = 0; i < nodes; ++i) if (order[i] == i) count++;
+	return count;
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	int maxGrid = (argc > 1 ? atoi(argv[1]) : 400);
+	int maxPairNodes = (argc > 2 ? atoi(argv[2]) : 40000);
+
+	FEElementLibrary::InitLibrary();
+
+	const double eps = 1e-4;
+	const double threshold = 1e-3;
+
+	printf("%10s %10s %12s %12s %12s %8s\n", "nodes", "welded", "grid (s)", "pairs (s)", "apply (s)", "match");
+	for (int nx = 25; nx <= maxGrid; nx *= 2)
+	{
+		FEMesh* pm = createQuadSoup(nx, eps);
+
+		// the weld step only
+		FEMesh m1(*pm);
+		FEWeldNodesBenchmark weld;
+		weld.SetThreshold(threshold);
+		BenchmarkTimer timer;
+		weld.Weld(&m1);
+		double tgrid = timer.elapsed();
+
+		// the full modifier (includes rebuilding the mesh)
+		timer.start();
+		FEMesh* pnew = weld.Apply(pm);
+		double tapply = timer.elapsed();
+		int welded = pnew->Nodes();
+
+		// the old pair loop
+		double tpair = -1.0;
+		const char* match = "-";
+		if (pm->Nodes() <= maxPairNodes)
+		{
+			FEMesh m2(*pm);
+			timer.start();
+			int n2 = pairLoopWeld(m2, threshold);
+			tpair = timer.elapsed();
+			match = (n2 == welded ? "yes" : "NO");
+		}
+
+		if (tpair >= 0.0)
+			printf("%10d %10d %12.4f %12.4f %12.4f %8s\n", pm->Nodes(), welded, tgrid, tpair, tapply, match);
+		else
+			printf("%10d %10d %12.4f %12s %12.4f %8s\n", pm->Nodes(), welded, tgrid, "-", tapply, match);
+
+		delete pnew;
+		delete pm;
+	}
+
+	return 0;
+}
@@ -0,0 +1,206 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+// Parse throughput benchmark for XMLReader. Generates a FEBio-style input file 
+// with node, element and element data sections and reads it back tag by tag, 
+// either converting the values with XMLTag::value or with the sscanf/atof/atoi 
+// conversions that were used before. Both must give the same values.
+//
+// usage: XMLReadBenchmark [max nr of nodes] [file name]
+
+#include "BenchmarkHelpers.h"
+#include <XML/XMLReader.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+using std::vector;
+
+//-----------------------------------------------------------------------------
+// writes an n x n x n grid of hex8 elements
+static bool writeTestFile(const char* szfile, int n)
+{
+	FILE* fp = fopen(szfile, "wt");
+	if (fp == nullptr) return false;
+
+	std::mt19937 rng(1);
+	std::uniform_real_distribution<double> u(-0.1, 0.1);
+
+	int n1 = n + 1;
+	fprintf(fp, "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?>\n");
+	fprintf(fp, "<febio_spec version=\"3.0\">\n");
+	fprintf(fp, "\t<Mesh>\n");
+	fprintf(fp, "\t\t<Nodes name=\"Object1\">\n");
+	for (int k = 0; k <= n; ++k)
+		for (int j = 0; j <= n; ++j)
+			for (int i = 0; i <= n; ++i)
+			{
+				int nid = (k*n1 + j)*n1 + i + 1;
+				fprintf(fp, "\t\t\t<node id=\"%d\">%.9lg,%.9lg,%.9lg</node>\n", nid, i + u(rng), j + u(rng), k + u(rng));
+			}
+	fprintf(fp, "\t\t</Nodes>\n");
+	fprintf(fp, "\t\t<Elements type=\"hex8\" name=\"Part1\">\n");
+	int eid = 1;
+	for (int k = 0; k < n; ++k)
+		for (int j = 0; j < n; ++j)
+			for (int i = 0; i < n; ++i)
+			{
+				int m = (k*n1 + j)*n1 + i + 1;
+				fprintf(fp, "\t\t\t<elem id=\"%d\">%d,%d,%d,%d,%d,%d,%d,%d</elem>\n", eid++, m, m + 1, m + n1 + 1, m + n1, m + n1*n1, m + n1*n1 + 1, m + n1*n1 + n1 + 1, m + n1*n1 + n1);
+			}
+	fprintf(fp, "\t\t</Elements>\n");
+	fprintf(fp, "\t</Mesh>\n");
+	fprintf(fp, "\t<MeshData>\n");
+	fprintf(fp, "\t\t<ElementData var=\"shell thickness\" elem_set=\"Part1\">\n");
+	for (int i = 1; i < eid; ++i) fprintf(fp, "\t\t\t<e lid=\"%d\">%.9lg</e>\n", i, 1.0 + u(rng));
+	fprintf(fp, "\t\t</ElementData>\n");
+	fprintf(fp, "\t</MeshData>\n");
+	fprintf(fp, "</febio_spec>\n");
+	fclose(fp);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+enum ParseMode {
+	SCAN_ONLY,		// read the tags, but don't convert values
+	XMLTAG_VALUE,	// convert with XMLTag::value
+	SSCANF			// convert with sscanf/atof/atoi
+};
+
+struct MeshValues
+{
+	vector<double>	r;
+	vector<int>		elem;
+	vector<double>	data;
+};
+
+//-----------------------------------------------------------------------------
+static bool parseTestFile(const char* szfile, ParseMode mode, MeshValues& mv)
+{
+	XMLReader xml;
+	if (xml.Open(szfile) == false) return false;
+
+	XMLTag tag;
+	if (xml.FindTag("febio_spec", tag) == false) return false;
+
+	try {
+		++tag;
+		do
+		{
+			if ((tag == "Mesh") || (tag == "MeshData"))
+			{
+				++tag;
+				do
+				{
+					bool bnodes = (tag == "Nodes");
+					bool belems = (tag == "Elements");
+					++tag;
+					do
+					{
+						if (bnodes)
+						{
+							double r[3] = { 0 };
+							if (mode == XMLTAG_VALUE) { vec3d v; tag.value(v); r[0] = v.x; r[1] = v.y; r[2] = v.z; }
+							else if (mode == SSCANF) sscanf(tag.szvalue(), "%lg,%lg,%lg", r, r + 1, r + 2);
+							mv.r.insert(mv.r.end(), r, r + 3);
+						}
+						else if (belems)
+						{
+							int n[8] = { 0 };
+							if (mode == XMLTAG_VALUE) tag.value(n, 8);
+							else if (mode == SSCANF) sscanf(tag.szvalue(), "%d,%d,%d,%d,%d,%d,%d,%d", n, n + 1, n + 2, n + 3, n + 4, n + 5, n + 6, n + 7);
+							mv.elem.insert(mv.elem.end(), n, n + 8);
+						}
+						else
+						{
+							double v = 0.0;
+							if (mode == XMLTAG_VALUE) tag.value(v);
+							else if (mode == SSCANF) v = atof(tag.szvalue());
+							mv.data.push_back(v);
+						}
+						++tag;
+					} while (!tag.isend());
+					++tag;
+				} while (!tag.isend());
+			}
+			else tag.skip();
+			++tag;
+		} while (!tag.isend());
+	}
+	catch (XMLReader::EndOfFile&)
+	{
+		// this is fine (the end tag of the root is not returned)
+	}
+	catch (...)
+	{
+		return false;
+	}
+
+	xml.Close();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	int maxNodes = (argc > 1 ? atoi(argv[1]) : 1000000);
+	const char* szfile = (argc > 2 ? argv[2] : "xml_read_benchmark.feb");
+
+	printf("%10s %10s %10s %12s %12s %12s %10s %8s\n", "nodes", "elements", "size (MB)", "scan (MB/s)", "value (MB/s)", "sscanf (MB/s)", "speedup", "match");
+	for (int n = 24; (n + 1)*(n + 1)*(n + 1) <= maxNodes; n *= 2)
+	{
+		if (writeTestFile(szfile, n) == false) { fprintf(stderr, "Failed writing %s\n", szfile); return 1; }
+
+		FILE* fp = fopen(szfile, "rb");
+		fseek(fp, 0, SEEK_END);
+		double MB = (double)ftell(fp) / (1024.0*1024.0);
+		fclose(fp);
+
+		MeshValues m0, m1, m2;
+		BenchmarkTimer timer;
+		bool b0 = parseTestFile(szfile, SCAN_ONLY, m0);
+		double tscan = timer.elapsed();
+
+		timer.start();
+		bool b1 = parseTestFile(szfile, XMLTAG_VALUE, m1);
+		double tvalue = timer.elapsed();
+
+		timer.start();
+		bool b2 = parseTestFile(szfile, SSCANF, m2);
+		double tsscanf = timer.elapsed();
+
+		if (!b0 || !b1 || !b2) { fprintf(stderr, "Failed reading %s\n", szfile); return 1; }
+
+		bool match = (m1.r == m2.r) && (m1.elem == m2.elem) && (m1.data == m2.data);
+		int nodes = (int)m1.r.size() / 3;
+		int elems = (int)m1.elem.size() / 8;
+		printf("%10d %10d %10.1f %12.1f %12.1f %12.1f %10.2f %8s\n", nodes, elems, MB, MB / tscan, MB / tvalue, MB / tsscanf, tsscanf / tvalue, (match ? "yes" : "NO"));
+	}
+
+	remove(szfile);
+
+	return 0;
+}
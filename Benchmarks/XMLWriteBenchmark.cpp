@@ -0,0 +1,254 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+// Write throughput benchmark for XMLWriter. Writes node, element and element data 
+// sections with the bulk add_leaves API, with one XMLElement per leaf, and with 
+// plain sprintf/fprintf calls in the format that XMLWriter used before. All 
+// three files must be identical.
+//
+// usage: XMLWriteBenchmark [max nr of nodes] [file name]
+
+#include "BenchmarkHelpers.h"
+#include <XML/XMLWriter.h>
+#include <random>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+using std::vector;
+using std::string;
+
+//-----------------------------------------------------------------------------
+struct MeshValues
+{
+	vector<int>		nid;	// node IDs
+	vector<double>	r;		// node coordinates
+	vector<int>		eid;	// element IDs
+	vector<int>		elem;	// hex8 connectivity
+	vector<double>	data;	// element values
+};
+
+// random mesh data (the connectivity does not have to make sense)
+static void createMesh(int nodes, MeshValues& m)
+{
+	std::mt19937 rng(1);
+	std::uniform_real_distribution<double> u(-1.0, 1.0);
+	std::uniform_int_distribution<int> e(-6, 6);
+
+	m.nid.resize(nodes);
+	m.r.resize(3 * nodes);
+	for (int i = 0; i < nodes; ++i)
+	{
+		m.nid[i] = i + 1;
+		for (int j = 0; j < 3; ++j) m.r[3 * i + j] = u(rng)*pow(10.0, e(rng));
+	}
+
+	int elems = nodes;
+	m.eid.resize(elems);
+	m.elem.resize(8 * elems);
+	m.data.resize(elems);
+	std::uniform_int_distribution<int> n(1, nodes);
+	for (int i = 0; i < elems; ++i)
+	{
+		m.eid[i] = i + 1;
+		for (int j = 0; j < 8; ++j) m.elem[8 * i + j] = n(rng);
+		m.data[i] = u(rng);
+	}
+}
+
+//-----------------------------------------------------------------------------
+static bool writeBulk(const char* szfile, const MeshValues& m)
+{
+	XMLWriter xml;
+	if (xml.open(szfile) == false) return false;
+	int NN = (int)m.nid.size();
+	int NE = (int)m.eid.size();
+
+	xml.add_branch("febio_spec");
+	xml.add_branch("Nodes");
+	xml.add_leaves("node", "id", m.nid.data(), m.r.data(), NN, 3);
+	xml.close_branch();
+	xml.add_branch("Elements");
+	xml.add_leaves("elem", "id", m.eid.data(), m.elem.data(), NE, 8);
+	xml.close_branch();
+	xml.add_branch("ElementData");
+	xml.add_leaves("e", "lid", m.eid.data(), m.data.data(), NE, 1);
+	xml.close_branch();
+	xml.close_branch();
+	xml.close();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+static bool writeLeaves(const char* szfile, const MeshValues& m)
+{
+	XMLWriter xml;
+	if (xml.open(szfile) == false) return false;
+	int NN = (int)m.nid.size();
+	int NE = (int)m.eid.size();
+
+	xml.add_branch("febio_spec");
+	xml.add_branch("Nodes");
+	{
+		XMLElement el("node");
+		int n = el.add_attribute("id", 0);
+		for (int i = 0; i < NN; ++i)
+		{
+			el.set_attribute(n, m.nid[i]);
+			el.value(vec3d(m.r[3 * i], m.r[3 * i + 1], m.r[3 * i + 2]));
+			xml.add_leaf(el, false);
+		}
+	}
+	xml.close_branch();
+	xml.add_branch("Elements");
+	{
+		XMLElement el("elem");
+		int n = el.add_attribute("id", 0);
+		for (int i = 0; i < NE; ++i)
+		{
+			el.set_attribute(n, m.eid[i]);
+			el.value((int*)&m.elem[8 * i], 8);
+			xml.add_leaf(el, false);
+		}
+	}
+	xml.close_branch();
+	xml.add_branch("ElementData");
+	{
+		XMLElement el("e");
+		int n = el.add_attribute("lid", 0);
+		for (int i = 0; i < NE; ++i)
+		{
+			el.set_attribute(n, m.eid[i]);
+			el.value(m.data[i]);
+			xml.add_leaf(el, false);
+		}
+	}
+	xml.close_branch();
+	xml.close_branch();
+	xml.close();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// the output format of XMLWriter before the bulk API was added
+static bool writeSprintf(const char* szfile, const MeshValues& m)
+{
+	FILE* fp = fopen(szfile, "wt");
+	if (fp == nullptr) return false;
+	int NN = (int)m.nid.size();
+	int NE = (int)m.eid.size();
+
+	char szval[512];
+	fprintf(fp, "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?>\n");
+	fprintf(fp, "<febio_spec>\n");
+	fprintf(fp, "\t<Nodes>\n");
+	for (int i = 0; i < NN; ++i)
+	{
+		sprintf(szval, "%.9lg,%.9lg,%.9lg", m.r[3 * i], m.r[3 * i + 1], m.r[3 * i + 2]);
+		fprintf(fp, "\t\t<node id=\"%d\">%s</node>\n", m.nid[i], szval);
+	}
+	fprintf(fp, "\t</Nodes>\n");
+	fprintf(fp, "\t<Elements>\n");
+	for (int i = 0; i < NE; ++i)
+	{
+		const int* n = &m.elem[8 * i];
+		sprintf(szval, "%6d,%6d,%6d,%6d,%6d,%6d,%6d,%6d", n[0], n[1], n[2], n[3], n[4], n[5], n[6], n[7]);
+		fprintf(fp, "\t\t<elem id=\"%d\">%s</elem>\n", m.eid[i], szval);
+	}
+	fprintf(fp, "\t</Elements>\n");
+	fprintf(fp, "\t<ElementData>\n");
+	for (int i = 0; i < NE; ++i)
+	{
+		sprintf(szval, "%.9lg", m.data[i]);
+		fprintf(fp, "\t\t<e lid=\"%d\">%s</e>\n", m.eid[i], szval);
+	}
+	fprintf(fp, "\t</ElementData>\n");
+	fprintf(fp, "</febio_spec>\n");
+	fclose(fp);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+static bool readFile(const string& file, string& s)
+{
+	FILE* fp = fopen(file.c_str(), "rb");
+	if (fp == nullptr) return false;
+	fseek(fp, 0, SEEK_END);
+	long size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	s.resize(size);
+	bool ret = (fread(&s[0], 1, size, fp) == (size_t)size);
+	fclose(fp);
+	return ret;
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	int maxNodes = (argc > 1 ? atoi(argv[1]) : 1000000);
+	string file = (argc > 2 ? argv[2] : "xml_write_benchmark.feb");
+	string file1 = file + ".1";
+	string file2 = file + ".2";
+
+	XMLWriter::SetFloatFormat(XMLWriter::FixedFormat);
+
+	printf("%10s %10s %12s %12s %14s %10s %8s\n", "nodes", "size (MB)", "bulk (MB/s)", "leaf (MB/s)", "sprintf (MB/s)", "speedup", "match");
+	for (int nodes = 15625; nodes <= maxNodes; nodes *= 4)
+	{
+		MeshValues m;
+		createMesh(nodes, m);
+
+		BenchmarkTimer timer;
+		bool b0 = writeBulk(file.c_str(), m);
+		double tbulk = timer.elapsed();
+
+		timer.start();
+		bool b1 = writeLeaves(file1.c_str(), m);
+		double tleaf = timer.elapsed();
+
+		timer.start();
+		bool b2 = writeSprintf(file2.c_str(), m);
+		double tsprintf = timer.elapsed();
+
+		string s0, s1, s2;
+		if (!b0 || !b1 || !b2 || !readFile(file, s0) || !readFile(file1, s1) || !readFile(file2, s2))
+		{
+			fprintf(stderr, "Failed writing %s\n", file.c_str());
+			return 1;
+		}
+
+		bool match = (s0 == s1) && (s0 == s2);
+		double MB = (double)s0.size() / (1024.0*1024.0);
+		printf("%10d %10.1f %12.1f %12.1f %14.1f %10.2f %8s\n", nodes, MB, MB / tbulk, MB / tleaf, MB / tsprintf, tsprintf / tbulk, (match ? "yes" : "NO"));
+	}
+
+	remove(file.c_str());
+	remove(file1.c_str());
+	remove(file2.c_str());
+
+	return 0;
+}
@@ -2131,16 +2131,16 @@ void FEBioExport25::WriteGeometryObject(FEBioExport25::Part* part)
 	// Write the nodes
 	m_xml.add_branch("Nodes");
 	{
-		XMLElement el("node");
-		int nid = el.add_attribute("id", 0);
-		for (int j = 0; j<pm->Nodes(); ++j)
+		int NN = pm->Nodes();
+		vector<int> nid(NN);
+		vector<double> r(3 * NN);
+		for (int j = 0; j<NN; ++j)
 		{
 			FENode& node = pm->Node(j);
-			el.set_attribute(nid, ++m_ntotnodes);
-			vec3d r = node.r;
-			el.value(r);
-			m_xml.add_leaf(el, false);
+			nid[j] = ++m_ntotnodes;
+			r[3 * j] = node.r.x; r[3 * j + 1] = node.r.y; r[3 * j + 2] = node.r.z;
 		}
+		m_xml.add_leaves("node", "id", nid.data(), r.data(), NN, 3);
 	}
 	m_xml.close_branch();
 
@@ -2525,17 +2525,19 @@ void FEBioExport25::WriteGeometryNodes()
 
 		m_xml.add_branch(tagNodes);
 		{
-			XMLElement el("node");
-			int nid = el.add_attribute("id", 0);
-			for (int j=0; j<pm->Nodes(); ++j, ++n)
+			int NN = pm->Nodes();
+			vector<int> nid(NN);
+			vector<double> r(3 * NN);
+			const Transform& T = po->GetTransform();
+			for (int j=0; j<NN; ++j, ++n)
 			{
 				FENode& node = pm->Node(j);
 				node.m_nid = n;
-				el.set_attribute(nid, n);
-				vec3d r = po->GetTransform().LocalToGlobal(node.r);
-				el.value(r);
-				m_xml.add_leaf(el, false);
+				nid[j] = n;
+				vec3d rj = T.LocalToGlobal(node.r);
+				r[3 * j] = rj.x; r[3 * j + 1] = rj.y; r[3 * j + 2] = rj.z;
 			}
+			m_xml.add_leaves("node", "id", nid.data(), r.data(), NN, 3);
 		}
 		m_xml.close_branch();
 	}
@@ -2672,7 +2674,6 @@ void FEBioExport25::WriteGeometryPart(GPart* pg, bool useMatNames)
 	// loop over unprocessed elements
 	int nset = 0;
 	int ncount = 0;
-	int nn[FEElement::MAX_NODES];
 	char szname[128] = {0};
 	for (int i=0;ncount<NEP;++i)
 	{
@@ -2704,28 +2705,26 @@ void FEBioExport25::WriteGeometryPart(GPart* pg, bool useMatNames)
 			xe.add_attribute("name", szname);
 			m_xml.add_branch(xe);
 			{
-				XMLElement xej("elem");
-				int n1 = xej.add_attribute("id",(int)0);
-
+				// collect the element IDs and connectivity so we can write them in one go
+				int ne = el.Nodes();
+				vector<int> eid, enode;
 				for (int j=i; j<NE; ++j)
 				{
 					FEElement_& ej = pm->ElementRef(j);
 					if ((ej.m_ntag == 1) && (ej.Type() == ntype))
 					{
-						int eid = m_ntotelem + ncount + 1;
-						xej.set_attribute(n1, eid);
-						int ne = ej.Nodes();
-						assert(ne == el.Nodes());
-						for (int k=0; k<ne; ++k) nn[k] = pm->Node(ej.m_node[k]).m_nid;
-						xej.value(nn, ne);
-						m_xml.add_leaf(xej, false);
+						int id = m_ntotelem + ncount + 1;
+						eid.push_back(id);
+						assert(ej.Nodes() == ne);
+						for (int k=0; k<ne; ++k) enode.push_back(pm->Node(ej.m_node[k]).m_nid);
 						ej.m_ntag = -1;	// mark as processed
-						ej.m_nid = eid;
+						ej.m_nid = id;
 						ncount++;
 
 						es.elem.push_back(j);
 					}
 				}
+				m_xml.add_leaves("elem", "id", eid.data(), enode.data(), (int)eid.size(), ne);
 			}
 			m_xml.close_branch();
 
@@ -3047,16 +3046,16 @@ void FEBioExport25::WriteMeshDataMaterialFibers()
 			tag.add_attribute("elem_set", elSet.name.c_str());
 			m_xml.add_branch(tag);
 			{
-				XMLElement el("elem");
-				int nid = el.add_attribute("lid", 0);
+				vector<int> lid(NE);
+				vector<double> v(3 * NE);
 				for (int j=0; j<NE; ++j)
 				{
 					FEElement_& e = pm->ElementRef(elSet.elem[j]);
 					vec3d a = T.LocalToGlobalNormal(e.m_fiber);
-					el.set_attribute(nid, j+1);
-					el.value(a);
-					m_xml.add_leaf(el, false);
+					lid[j] = j + 1;
+					v[3 * j] = a.x; v[3 * j + 1] = a.y; v[3 * j + 2] = a.z;
 				}
+				m_xml.add_leaves("elem", "lid", lid.data(), v.data(), NE, 3);
 			}
 			m_xml.close_branch(); // elem_data
 		}
@@ -3152,17 +3151,15 @@ void FEBioExport25::WriteMeshDataFields()
 				if (scale != 1.0) tag.add_attribute("scale", scale);
 				m_xml.add_branch(tag);
 				{
-					XMLElement el("elem");
-					int nid = el.add_attribute("lid", 0);
-					FEItemListBuilder::ConstIterator it = pg->begin();
-					for (int j = 0; j < pg->size(); ++j, ++it)
+					int NI = pg->size();
+					vector<int> lid(NI);
+					vector<double> v(NI);
+					for (int j = 0; j < NI; ++j)
 					{
-						int eid = *it;
-						FEElement_& e = pm->ElementRef(eid);
-						el.set_attribute(nid, j + 1);
-						el.value(data[j]);
-						m_xml.add_leaf(el, false);
+						lid[j] = j + 1;
+						v[j] = data[j];
 					}
+					m_xml.add_leaves("elem", "lid", lid.data(), v.data(), NI, 1);
 				}
 				m_xml.close_branch();
 			}
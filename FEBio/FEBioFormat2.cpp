@@ -603,7 +603,7 @@ void FEBioFormat2::ParseBCFixed(FEStep* pstep, XMLTag &tag)
 	}
 
 	// read the node list
-	std::list<int> nodeList;
+	std::vector<int> nodeList;
 	if (tag.isleaf() == false)
 	{
 		++tag;
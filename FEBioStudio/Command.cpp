@@ -98,3 +98,15 @@ void CCmdGroup::SetViewState(VIEW_STATE state)
 	CCommand::SetViewState(state);
 	for (int i = 0; i < m_Cmd.size(); i++) m_Cmd[i]->SetViewState(state);
 }
+
+size_t CCmdGroup::MemoryUsage() const
+{
+	size_t n = 0;
+	for (int i = 0; i < m_Cmd.size(); i++) n += m_Cmd[i]->MemoryUsage();
+	return n;
+}
+
+void CCmdGroup::Compact()
+{
+	for (int i = 0; i < m_Cmd.size(); i++) m_Cmd[i]->Compact();
+}
@@ -69,6 +69,12 @@ public:
 	virtual void SetViewState(VIEW_STATE state);
 	VIEW_STATE GetViewState();
 
+	// memory used to store the undo/redo data of this command (in bytes)
+	virtual size_t MemoryUsage() const { return 0; }
+
+	// reduce the memory used by this command (e.g. by moving data to a file)
+	virtual void Compact() {}
+
 protected:
 	// doc/view state variables
 	VIEW_STATE	m_state;
@@ -101,6 +107,10 @@ public:
 
 	void SetViewState(VIEW_STATE state) override;
 
+	size_t MemoryUsage() const override;
+
+	void Compact() override;
+
 protected:
 	CCmdPtrArray	m_Cmd;	// array of pointer to commands
 };
@@ -31,6 +31,10 @@ SOFTWARE.*/
 #include <GeomLib/GObject.h>
 
 std::string CBasicCmdManager::m_err;
+int CBasicCmdManager::m_memoryBudgetMB = 0;
+
+void CBasicCmdManager::SetMemoryBudget(int nsizeMB) { m_memoryBudgetMB = (nsizeMB < 0 ? 0 : nsizeMB); }
+int CBasicCmdManager::GetMemoryBudget() { return m_memoryBudgetMB; }
 
 CBasicCmdManager::CBasicCmdManager()
 {
@@ -44,11 +48,13 @@ CBasicCmdManager::~CBasicCmdManager()
 void CBasicCmdManager::AddCommand(CCommand* pcmd)
 {
 	// push the command
-	m_Undo.push(pcmd);
+	m_Undo.push_back(pcmd);
 
 	// clear the redo stack
 	int N = (int)m_Redo.size();
-	for (int i = 0; i<N; i++) { delete m_Redo.top(); m_Redo.pop(); }
+	for (int i = 0; i<N; i++) { delete m_Redo.back(); m_Redo.pop_back(); }
+
+	TrimUndoStack();
 }
 
 bool CBasicCmdManager::DoCommand(CCommand* pcmd)
@@ -78,58 +84,132 @@ bool CBasicCmdManager::DoCommand(CCommand* pcmd)
 	}
 
 	// add it to the undo stack
-	m_Undo.push(pcmd);
+	m_Undo.push_back(pcmd);
 
 	// clear the redo stack
 	int N = (int)m_Redo.size();
-	for (int i = 0; i<N; i++) { delete m_Redo.top(); m_Redo.pop(); }
+	for (int i = 0; i<N; i++) { delete m_Redo.back(); m_Redo.pop_back(); }
+
+	TrimUndoStack();
 
 	return true;
 }
 
-void CBasicCmdManager::UndoCommand()
+bool CBasicCmdManager::UndoCommand()
 {
-	if (m_Undo.empty() == false)
-	{
-		// pop the command from the undo stack
-		CCommand* pcmd = m_Undo.top(); m_Undo.pop();
+	m_err.clear();
 
-		// unexecute it
+	if (m_Undo.empty()) return false;
+
+	// pop the command from the undo stack
+	CCommand* pcmd = m_Undo.back(); m_Undo.pop_back();
+
+	// unexecute it
+	// (if this fails, the command stays on the undo stack)
+	try
+	{
 		pcmd->UnExecute();
+	}
+	catch (CCmdFailed e)
+	{
+		std::string err = e.GetErrorString();
+		if (err.empty()) err = "(unknown)";
 
-		// push it on the redo stack
-		m_Redo.push(pcmd);
+		SetErrorString(err);
+		m_Undo.push_back(pcmd);
+		return false;
 	}
+	catch (...)
+	{
+		SetErrorString("An unknown error has occurred.");
+		m_Undo.push_back(pcmd);
+		return false;
+	}
+
+	// push it on the redo stack
+	m_Redo.push_back(pcmd);
+
+	return true;
 }
 
-void CBasicCmdManager::RedoCommand()
+bool CBasicCmdManager::RedoCommand()
 {
-	if (m_Redo.empty() == false)
-	{
-		// pop the command from the redo stack
-		CCommand* pcmd = m_Redo.top(); m_Redo.pop();
+	m_err.clear();
+
+	if (m_Redo.empty()) return false;
 
-		// execute it
+	// pop the command from the redo stack
+	CCommand* pcmd = m_Redo.back(); m_Redo.pop_back();
+
+	// execute it
+	// (if this fails, the command stays on the redo stack)
+	try
+	{
 		pcmd->Execute();
+	}
+	catch (CCmdFailed e)
+	{
+		std::string err = e.GetErrorString();
+		if (err.empty()) err = "(unknown)";
 
-		// push it on the undo stack
-		m_Undo.push(pcmd);
+		SetErrorString(err);
+		m_Redo.push_back(pcmd);
+		return false;
 	}
+	catch (...)
+	{
+		SetErrorString("An unknown error has occurred.");
+		m_Redo.push_back(pcmd);
+		return false;
+	}
+
+	// push it on the undo stack
+	m_Undo.push_back(pcmd);
+
+	return true;
 }
 
 void CBasicCmdManager::Clear()
 {
 	// clear undo stack
 	int N = (int)m_Undo.size();
-	for (int i = 0; i<N; i++) { delete m_Undo.top(); m_Undo.pop(); }
+	for (int i = 0; i<N; i++) { delete m_Undo.back(); m_Undo.pop_back(); }
 
 	// clear redo stack
 	N = (int)m_Redo.size();
-	for (int i = 0; i<N; i++) { delete m_Redo.top(); m_Redo.pop(); }
+	for (int i = 0; i<N; i++) { delete m_Redo.back(); m_Redo.pop_back(); }
 }
 
-const char* CBasicCmdManager::GetUndoCmdName() { return (m_Undo.size() ? m_Undo.top()->GetName() : 0); }
-const char* CBasicCmdManager::GetRedoCmdName() { return (m_Redo.size() ? m_Redo.top()->GetName() : 0); }
+// If the undo history uses more memory than the budget allows, the oldest commands
+// are first asked to compact their data. If that is not enough, they are removed.
+// The last command is always kept.
+void CBasicCmdManager::TrimUndoStack()
+{
+	if (m_memoryBudgetMB == 0) return;
+	size_t budget = (size_t)m_memoryBudgetMB * 1024 * 1024;
+
+	size_t total = 0;
+	for (CCommand* pcmd : m_Undo) total += pcmd->MemoryUsage();
+
+	for (size_t i = 0; (total > budget) && (i + 1 < m_Undo.size()); ++i)
+	{
+		CCommand* pcmd = m_Undo[i];
+		size_t n0 = pcmd->MemoryUsage();
+		pcmd->Compact();
+		size_t n1 = pcmd->MemoryUsage();
+		if (n1 < n0) total -= n0 - n1;
+	}
+
+	while ((total > budget) && (m_Undo.size() > 1))
+	{
+		CCommand* pcmd = m_Undo.front(); m_Undo.pop_front();
+		total -= pcmd->MemoryUsage();
+		delete pcmd;
+	}
+}
+
+const char* CBasicCmdManager::GetUndoCmdName() { return (m_Undo.size() ? m_Undo.back()->GetName() : 0); }
+const char* CBasicCmdManager::GetRedoCmdName() { return (m_Redo.size() ? m_Redo.back()->GetName() : 0); }
 
 //////////////////////////////////////////////////////////////////////
 // CCommandManager
@@ -192,41 +272,35 @@ bool CCommandManager::DoCommand(CCommand* pcmd)
 	}
 		
 	// add it to the undo stack
-	m_Undo.push(pcmd);
+	m_Undo.push_back(pcmd);
 
 	// clear the redo stack
 	int N = (int)m_Redo.size();
-	for (int i=0; i<N; i++) { delete m_Redo.top(); m_Redo.pop(); }
+	for (int i=0; i<N; i++) { delete m_Redo.back(); m_Redo.pop_back(); }
+
+	TrimUndoStack();
 
 	return true;
 }
 
-void CCommandManager::UndoCommand()
+bool CCommandManager::UndoCommand()
 {
-	// pop the command from the undo stack
-	CCommand* pcmd = m_Undo.top(); m_Undo.pop();
+	if (m_Undo.empty()) return false;
 
 	// reset the view state
-	m_pDoc->SetViewState(pcmd->GetViewState());
+	m_pDoc->SetViewState(m_Undo.back()->GetViewState());
 
 	// unexecute it
-	pcmd->UnExecute();
-
-	// push it on the redo stack
-	m_Redo.push(pcmd);
+	return CBasicCmdManager::UndoCommand();
 }
 
-void CCommandManager::RedoCommand()
+bool CCommandManager::RedoCommand()
 {
-	// pop the command from the redo stack
-	CCommand* pcmd = m_Redo.top(); m_Redo.pop();
+	if (m_Redo.empty()) return false;
 
 	// reset the view state
-	m_pDoc->SetViewState(pcmd->GetViewState());
+	m_pDoc->SetViewState(m_Redo.back()->GetViewState());
 
 	// execute it
-	pcmd->Execute();
-
-	// push it on the undo stack
-	m_Undo.push(pcmd);
+	return CBasicCmdManager::RedoCommand();
 }
@@ -25,13 +25,15 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.*/
 
 #pragma once
-#include <stack>
+#include <deque>
 #include <string>
 
 class CCommand;
 class CGLDocument;
 
-typedef std::stack<CCommand*> CCmdStack;
+// The undo and redo stacks. The top of the stack is at the back. A deque is used
+// so that the oldest commands can be removed when the undo history gets too large.
+typedef std::deque<CCommand*> CCmdStack;
 
 class CBasicCmdManager
 {
@@ -46,19 +48,29 @@ public:
 
 	virtual bool DoCommand(CCommand* pcmd);
 
-	virtual void UndoCommand();
+	virtual bool UndoCommand();
 
-	virtual void RedoCommand();
+	virtual bool RedoCommand();
 
 	void Clear();
 
 	const char* GetUndoCmdName();
 	const char* GetRedoCmdName();
 
+	// Set the max memory (in MB) used by the undo history. Zero means no limit.
+	static void SetMemoryBudget(int nsizeMB);
+	static int GetMemoryBudget();
+
+protected:
+	// make sure the undo history stays within the memory budget
+	void TrimUndoStack();
+
 protected:
 	CCmdStack	m_Undo;	// the undo stack
 	CCmdStack	m_Redo;	// the redo stack
 
+	static int	m_memoryBudgetMB;	// memory budget of the undo history (in MB)
+
 public:
 	static const std::string& GetErrorString() { return m_err; }
 	void SetErrorString(const std::string& err) { m_err = err; }
@@ -75,9 +87,9 @@ public:
 
 	bool DoCommand(CCommand* pcmd) override;
 
-	void UndoCommand() override;
+	bool UndoCommand() override;
 
-	void RedoCommand() override;
+	bool RedoCommand() override;
 
 protected:
 	CGLDocument* m_pDoc; // pointer to the current document
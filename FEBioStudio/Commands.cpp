@@ -2735,6 +2735,17 @@ void CCmdUnhideAll::UnExecute()
 	m_bunhide = true;
 }
 
+//-----------------------------------------------------------------------------
+// estimate of the memory used by a mesh (in bytes)
+static size_t meshMemoryUsage(const FEMeshBase* pm)
+{
+	if (pm == nullptr) return 0;
+	size_t n = (size_t)pm->Nodes() * sizeof(FENode) + (size_t)pm->Faces() * sizeof(FEFace) + (size_t)pm->Edges() * sizeof(FEEdge);
+	const FECoreMesh* pc = dynamic_cast<const FECoreMesh*>(pm);
+	if (pc) n += (size_t)pc->Elements() * sizeof(FEElement);
+	return n;
+}
+
 //=============================================================================
 // CCmdApplyFEModifier
 //-----------------------------------------------------------------------------
@@ -2742,6 +2753,7 @@ void CCmdUnhideAll::UnExecute()
 CCmdApplyFEModifier::CCmdApplyFEModifier(FEModifier* pmod, GObject* po, FEGroup* selection) : CCommand(pmod->GetName())
 {
 	m_pnew = 0;
+	m_useDelta = false;
 
 	m_pobj = po;
 	m_psel = selection;
@@ -2755,6 +2767,15 @@ CCmdApplyFEModifier::CCmdApplyFEModifier(FEModifier* pmod, GObject* po, FEGroup*
 
 void CCmdApplyFEModifier::Execute()
 {
+	if (m_useDelta)
+	{
+		FEMesh* pm = m_pobj->GetFEMesh();
+		if (m_delta.Swap(*pm) == false) throw CCmdFailed(this, "Failed to restore the mesh.");
+		pm->UpdateMesh();
+		m_pobj->ReplaceFEMesh(pm);
+		return;
+	}
+
 	if (m_pnew == 0)
 	{
 		// create a new mesh
@@ -2768,6 +2789,23 @@ void CCmdApplyFEModifier::Execute()
 
 		// make sure the new mesh is selected
 		if (m_pobj) m_pobj->Select();
+
+		// If the modifier only moved nodes, we copy the new positions to the old mesh
+		// and only keep the old positions. This way the object keeps its mesh, which
+		// older commands may still refer to.
+		if ((m_pnew != m_pold) && FEMeshPositionDelta::PositionsOnly(*m_pnew, *m_pold))
+		{
+			m_delta.Build(*m_pnew, *m_pold);
+			if (m_delta.Swap(*m_pold) == false) throw CCmdFailed(this, "Failed to apply the modifier.");
+			delete m_pnew;
+			m_pnew = nullptr;
+			m_useDelta = true;
+
+			m_pold->UpdateMesh();
+			m_pobj->ReplaceFEMesh(m_pold);
+			m_pold = nullptr;
+			return;
+		}
 	}
 
 	if (m_pnew)
@@ -2795,6 +2833,13 @@ void CCmdApplyFEModifier::Execute()
 
 void CCmdApplyFEModifier::UnExecute()
 {
+	// the positions are swapped, so undo and redo are the same
+	if (m_useDelta)
+	{
+		Execute();
+		return;
+	}
+
 	// get the FEModel
 	if (m_pnew)
 	{
@@ -2807,6 +2852,16 @@ void CCmdApplyFEModifier::UnExecute()
 	}
 }
 
+size_t CCmdApplyFEModifier::MemoryUsage() const
+{
+	return (m_useDelta ? m_delta.MemoryUsage() : meshMemoryUsage(m_pnew));
+}
+
+void CCmdApplyFEModifier::Compact()
+{
+	if (m_useDelta) m_delta.Spill();
+}
+
 
 //=============================================================================
 // CCmdApplySurfaceModifier
@@ -2897,13 +2952,37 @@ CCmdChangeFEMesh::CCmdChangeFEMesh(GObject* po, FEMesh* pm, bool bup) : CCommand
 	m_update = bup;
 	m_po = po;
 	m_pnew = pm;
+	m_useDelta = false;
 }
 
 void CCmdChangeFEMesh::Execute()
 {
 	FEMesh* pm = m_po->GetFEMesh();
-	m_po->ReplaceFEMesh(m_pnew, m_update);
+	if (m_useDelta)
+	{
+		if (m_delta.Swap(*pm) == false) throw CCmdFailed(this, "Failed to restore the mesh.");
+		pm->UpdateMesh();
+		m_po->ReplaceFEMesh(pm, m_update);
+		return;
+	}
+
+	// If only the nodes moved, we copy the new positions to the current mesh
+	// and only keep the old positions. This way the object keeps its mesh, which
+	// older commands may still refer to.
+	if (pm && (pm != m_pnew) && FEMeshPositionDelta::PositionsOnly(*m_pnew, *pm))
+	{
+		m_delta.Build(*m_pnew, *pm);
+		if (m_delta.Swap(*pm) == false) throw CCmdFailed(this, "Failed to change the mesh.");
+		delete m_pnew;
+		m_pnew = nullptr;
+		m_useDelta = true;
+
+		pm->UpdateMesh();
+		m_po->ReplaceFEMesh(pm, m_update);
+		return;
+	}
 
+	m_po->ReplaceFEMesh(m_pnew, m_update);
 	m_pnew = pm;
 }
 
@@ -2912,6 +2991,16 @@ void CCmdChangeFEMesh::UnExecute()
 	Execute();
 }
 
+size_t CCmdChangeFEMesh::MemoryUsage() const
+{
+	return (m_useDelta ? m_delta.MemoryUsage() : meshMemoryUsage(m_pnew));
+}
+
+void CCmdChangeFEMesh::Compact()
+{
+	if (m_useDelta) m_delta.Spill();
+}
+
 //=============================================================================
 // CCmdChangeFESurfaceMesh
 //-----------------------------------------------------------------------------
@@ -2924,6 +3013,7 @@ CCmdChangeFESurfaceMesh::CCmdChangeFESurfaceMesh(GSurfaceMeshObject* po, FESurfa
 	m_update = up;
 	m_po = po;
 	m_pnew = pm;
+	m_useDelta = false;
 }
 
 CCmdChangeFESurfaceMesh::~CCmdChangeFESurfaceMesh()
@@ -2934,6 +3024,30 @@ CCmdChangeFESurfaceMesh::~CCmdChangeFESurfaceMesh()
 void CCmdChangeFESurfaceMesh::Execute()
 {
 	FESurfaceMesh* pm = m_po->GetSurfaceMesh();
+	if (m_useDelta)
+	{
+		if (m_delta.Swap(*pm) == false) throw CCmdFailed(this, "Failed to restore the mesh.");
+		pm->UpdateMesh();
+		m_po->ReplaceSurfaceMesh(pm);
+		return;
+	}
+
+	// If only the nodes moved, we copy the new positions to the current mesh
+	// and only keep the old positions. This way the object keeps its mesh, which
+	// older commands may still refer to.
+	if (pm && (pm != m_pnew) && FEMeshPositionDelta::PositionsOnly(*m_pnew, *pm))
+	{
+		m_delta.Build(*m_pnew, *pm);
+		if (m_delta.Swap(*pm) == false) throw CCmdFailed(this, "Failed to change the mesh.");
+		delete m_pnew;
+		m_pnew = nullptr;
+		m_useDelta = true;
+
+		pm->UpdateMesh();
+		m_po->ReplaceSurfaceMesh(pm);
+		return;
+	}
+
 	m_po->ReplaceSurfaceMesh(m_pnew);
 	m_pnew = pm;
 }
@@ -2943,6 +3057,16 @@ void CCmdChangeFESurfaceMesh::UnExecute()
 	Execute();
 }
 
+size_t CCmdChangeFESurfaceMesh::MemoryUsage() const
+{
+	return (m_useDelta ? m_delta.MemoryUsage() : meshMemoryUsage(m_pnew));
+}
+
+void CCmdChangeFESurfaceMesh::Compact()
+{
+	if (m_useDelta) m_delta.Spill();
+}
+
 
 ///////////////////////////////////////////////////////////////////////////////
 // CCmdChangeView
@@ -3317,17 +3441,11 @@ void CCmdUnassignBC::UnExecute()
 // CCmdAddToItemListBuilder
 //-----------------------------------------------------------------------------
 
-CCmdAddToItemListBuilder::CCmdAddToItemListBuilder(FEItemListBuilder* pold, list<int>& lnew) : CCommand("Add to selection")
+CCmdAddToItemListBuilder::CCmdAddToItemListBuilder(FEItemListBuilder* pold, const vector<int>& lnew) : CCommand("Add to selection")
 {
 	m_pold = pold;
 	m_lnew = lnew;
-	int n = m_pold->size();
-	if (n > 0)
-	{
-		m_tmp.resize(n);
-		FEItemListBuilder::Iterator it = m_pold->begin();
-		for (int i = 0; i<n; ++i, ++it) m_tmp[i] = *it;
-	}
+	m_tmp = m_pold->CopyItems();
 }
 
 void CCmdAddToItemListBuilder::Execute()
@@ -3338,25 +3456,18 @@ void CCmdAddToItemListBuilder::Execute()
 void CCmdAddToItemListBuilder::UnExecute()
 {
 	m_pold->clear();
-	int n = (int)m_tmp.size();
-	for (int i = 0; i<n; ++i) m_pold->add(m_tmp[i]);
+	m_pold->add(m_tmp);
 }
 
 //-----------------------------------------------------------------------------
 // CCmdRemoveFromItemListBuilder
 //-----------------------------------------------------------------------------
 
-CCmdRemoveFromItemListBuilder::CCmdRemoveFromItemListBuilder(FEItemListBuilder* pold, list<int>& lnew) : CCommand("Remove from selection")
+CCmdRemoveFromItemListBuilder::CCmdRemoveFromItemListBuilder(FEItemListBuilder* pold, const vector<int>& lnew) : CCommand("Remove from selection")
 {
 	m_pold = pold;
 	m_lnew = lnew;
-	int n = m_pold->size();
-	if (n > 0)
-	{
-		m_tmp.resize(n);
-		FEItemListBuilder::Iterator it = m_pold->begin();
-		for (int i = 0; i<n; ++i, ++it) m_tmp[i] = *it;
-	}
+	m_tmp = m_pold->CopyItems();
 }
 
 void CCmdRemoveFromItemListBuilder::Execute()
@@ -3367,8 +3478,7 @@ void CCmdRemoveFromItemListBuilder::Execute()
 void CCmdRemoveFromItemListBuilder::UnExecute()
 {
 	m_pold->clear();
-	int n = (int)m_tmp.size();
-	for (int i = 0; i<n; ++i) m_pold->add(m_tmp[i]);
+	m_pold->add(m_tmp);
 }
 
 //-----------------------------------------------------------------------------
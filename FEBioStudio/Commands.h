@@ -42,6 +42,7 @@ SOFTWARE.*/
 #include <MeshTools/FESurfaceModifier.h>
 #include <GeomLib/GSurfaceMeshObject.h>
 #include <GLLib/GLCamera.h>
+#include <MeshLib/FEMeshPositionDelta.h>
 
 class ObjectMeshList;
 class MeshLayer;
@@ -1137,12 +1138,18 @@ public:
 	void Execute();
 	void UnExecute();
 
+	size_t MemoryUsage() const override;
+	void Compact() override;
+
 protected:
 	GObject*		m_pobj;
 	FEMesh*			m_pold;	// old, unmodified mesh
 	FEMesh*			m_pnew;	// new, modified mesh
 	FEModifier*		m_pmod;
 	FEGroup*		m_psel;
+
+	FEMeshPositionDelta	m_delta;	// used instead of m_pnew when the modifier only moved nodes
+	bool				m_useDelta;
 };
 
 //-----------------------------------------------------------------------------
@@ -1175,10 +1182,16 @@ public:
 	void Execute();
 	void UnExecute();
 
+	size_t MemoryUsage() const override;
+	void Compact() override;
+
 protected:
 	bool		m_update;
 	GObject*	m_po;
 	FEMesh*		m_pnew;
+
+	FEMeshPositionDelta	m_delta;	// used instead of m_pnew when only the nodes moved
+	bool				m_useDelta;
 };
 
 //-----------------------------------------------------------------------------
@@ -1191,10 +1204,16 @@ public:
 	void Execute();
 	void UnExecute();
 
+	size_t MemoryUsage() const override;
+	void Compact() override;
+
 protected:
 	bool				m_update;
 	GSurfaceMeshObject*	m_po;
 	FESurfaceMesh*		m_pnew;
+
+	FEMeshPositionDelta	m_delta;	// used instead of m_pnew when only the nodes moved
+	bool				m_useDelta;
 };
 
 //-----------------------------------------------------------------------------
@@ -1386,14 +1405,14 @@ protected:
 class CCmdAddToItemListBuilder : public CCommand
 {
 public:
-	CCmdAddToItemListBuilder(FEItemListBuilder* pold, list<int>& lnew);
+	CCmdAddToItemListBuilder(FEItemListBuilder* pold, const vector<int>& lnew);
 
 	void Execute();
 	void UnExecute();
 
 protected:
 	FEItemListBuilder* m_pold;
-	list<int>	m_lnew;
+	vector<int>	m_lnew;
 	vector<int>	m_tmp;
 };
 
@@ -1401,14 +1420,14 @@ protected:
 class CCmdRemoveFromItemListBuilder : public CCommand
 {
 public:
-	CCmdRemoveFromItemListBuilder(FEItemListBuilder* pold, list<int>& lnew);
+	CCmdRemoveFromItemListBuilder(FEItemListBuilder* pold, const vector<int>& lnew);
 
 	void Execute();
 	void UnExecute();
 
 protected:
 	FEItemListBuilder* m_pold;
-	list<int>	m_lnew;
+	vector<int>	m_lnew;
 	vector<int>	m_tmp;
 };
 
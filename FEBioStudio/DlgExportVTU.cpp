@@ -0,0 +1,103 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#include "stdafx.h"
+#include "DlgExportVTU.h"
+#include <QBoxLayout>
+#include <QDialogButtonBox>
+#include <QCheckBox>
+#include <QRadioButton>
+#include <QListWidget>
+#include <QLabel>
+#include <PostLib/FEPostModel.h>
+
+class CDlgExportVTU_UI
+{
+public:
+	QRadioButton*	allStates;
+	QRadioButton*	currState;
+	QCheckBox*		compress;
+	QListWidget*	fields;
+
+public:
+	void setup(QDialog* dlg, Post::FEPostModel& fem)
+	{
+		allStates = new QRadioButton("Export all states (writes a .pvd collection)");
+		currState = new QRadioButton("Export current state only");
+		compress = new QCheckBox("Compress data (zlib)");
+
+		fields = new QListWidget;
+		Post::FEDataManager& DM = *fem.GetDataManager();
+		Post::FEDataFieldPtr pd = DM.FirstDataField();
+		for (int i = 0; i < DM.DataFields(); ++i, ++pd)
+		{
+			QListWidgetItem* item = new QListWidgetItem(QString::fromStdString((*pd)->GetName()), fields);
+			item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+			item->setCheckState(Qt::Checked);
+		}
+
+		QVBoxLayout* l = new QVBoxLayout;
+		l->addWidget(allStates);
+		l->addWidget(currState);
+		l->addWidget(compress);
+		l->addWidget(new QLabel("Data fields:"));
+		l->addWidget(fields);
+
+		allStates->setChecked(true);
+
+		QDialogButtonBox* bb = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+		l->addWidget(bb);
+
+		dlg->setLayout(l);
+
+		QObject::connect(bb, SIGNAL(accepted()), dlg, SLOT(accept()));
+		QObject::connect(bb, SIGNAL(rejected()), dlg, SLOT(reject()));
+	}
+};
+
+CDlgExportVTU::CDlgExportVTU(Post::FEPostModel& fem, QWidget* parent) : QDialog(parent), ui(new CDlgExportVTU_UI)
+{
+	m_allStates = true;
+	m_compress = false;
+
+	setWindowTitle("Export VTU");
+	ui->setup(this, fem);
+}
+
+void CDlgExportVTU::accept()
+{
+	m_allStates = ui->allStates->isChecked();
+	m_compress = ui->compress->isChecked();
+
+	m_fields.clear();
+	for (int i = 0; i < ui->fields->count(); ++i)
+	{
+		QListWidgetItem* item = ui->fields->item(i);
+		if (item->checkState() == Qt::Checked) m_fields.push_back(item->text().toStdString());
+	}
+
+	QDialog::accept();
+}
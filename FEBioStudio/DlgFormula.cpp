@@ -34,7 +34,8 @@ SOFTWARE.*/
 #include <QValidator>
 #include <QMessageBox>
 #include <QCheckBox>
-#include <MathLib/MathParser.h>
+#include <MathLib/MathExpression.h>
+#include <cmath>
 
 CDlgFormula::CDlgFormula(QWidget* parent) : QDialog(parent)
 {
@@ -138,23 +139,29 @@ std::vector<LOADPOINT> CDlgFormula::GetPoints()
 	int samples = GetSamples();
 
 	std::vector<LOADPOINT> pts;
-	CMathParser m;
-	int ierr;
-	LOADPOINT pt;
-	for (int i = 0; i<samples; ++i)
+	CMathExpression m;
+	m.AddVariable("t");
+	if ((samples <= 0) || (m.Compile(smath) == false)) return pts;
+
+	// evaluate all samples at once
+	std::vector<double> t(samples), v(samples);
+	for (int i = 0; i<samples; ++i) t[i] = fmin + i*(fmax - fmin) / (samples - 1);
+	const double* vars[] = { t.data() };
+	const int stride[] = { 1 };
+	m.Eval(samples, vars, stride, v.data());
+
+	// CMathParser reported an error for a division by zero. Here these give
+	// inf or nan, which we reject in the same way.
+	for (int i = 0; i < samples; ++i)
 	{
-		pt.time = fmin + i*(fmax - fmin) / (samples - 1);
-		m.set_variable("t", pt.time);
-
-		pt.load = m.eval(smath.c_str(), ierr);
-
-		pts.push_back(pt);
+		if (std::isfinite(v[i]) == false) return pts;
+	}
 
-		if (ierr != 0)
-		{
-			pts.clear();
-			break;
-		}
+	pts.resize(samples);
+	for (int i = 0; i < samples; ++i)
+	{
+		pts[i].time = t[i];
+		pts[i].load = v[i];
 	}
 
 	return pts;
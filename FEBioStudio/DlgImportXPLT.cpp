@@ -31,6 +31,8 @@ SOFTWARE.*/
 #include <QDialogButtonBox>
 #include <QBoxLayout>
 #include <QLabel>
+#include <QSpinBox>
+#include <XPLTLib/xpltFileReader.h>
 
 
 // converts a string to a list of numbers. 
@@ -101,7 +103,9 @@ public:
 	QRadioButton* pb1;
 	QRadioButton* pb2;
 	QRadioButton* pb3;
+	QRadioButton* pb4;
 	QLineEdit* pitems;
+	QSpinBox* pmaxStates;
 
 public:
 	void setupUi(QDialog* parent)
@@ -119,6 +123,14 @@ public:
 		pv->addWidget(pitems = new QLineEdit);
 		pv->addWidget(new QLabel("(e.g.:1,2,3:6,10:100:5)"));
 
+		pv->addWidget(pb4 = new QRadioButton("Read states on demand"));
+		QHBoxLayout* ph = new QHBoxLayout;
+		ph->addWidget(new QLabel("Max states in memory:"));
+		ph->addWidget(pmaxStates = new QSpinBox);
+		pmaxStates->setRange(3, 10000);
+		pmaxStates->setValue(10);
+		pv->addLayout(ph);
+
 		QDialogButtonBox* bb = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
 
 		pv->addWidget(bb);
@@ -127,6 +139,7 @@ public:
 		QObject::connect(bb, SIGNAL(accepted()), parent, SLOT(accept()));
 		QObject::connect(bb, SIGNAL(rejected()), parent, SLOT(reject()));
 		QObject::connect(pitems, SIGNAL(textEdited(const QString&)), pb3, SLOT(click()));
+		QObject::connect(pmaxStates, SIGNAL(valueChanged(int)), pb4, SLOT(click()));
 	}
 };
 
@@ -134,6 +147,9 @@ CDlgImportXPLT::CDlgImportXPLT(QWidget* parent) : QDialog(parent), ui(new Ui::CD
 {
 	ui->setupUi(this);
 	setWindowTitle("Import XPLT");
+
+	m_nop = XPLT_READ_ALL_STATES;
+	m_maxStates = 10;
 }
 
 void CDlgImportXPLT::accept()
@@ -141,6 +157,9 @@ void CDlgImportXPLT::accept()
 	if (ui->pb1->isChecked()) m_nop = 0;
 	if (ui->pb2->isChecked()) m_nop = 1;
 	if (ui->pb3->isChecked()) m_nop = 2;
+	if (ui->pb4->isChecked()) m_nop = XPLT_READ_STATES_PAGED;
+
+	m_maxStates = ui->pmaxStates->value();
 
 	std::string s = ui->pitems->text().toStdString();
 	char buf[256] = {0}; 
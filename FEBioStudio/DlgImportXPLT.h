@@ -42,6 +42,7 @@ public:
 public:
 	int					m_nop;
 	std::vector<int>	m_item;
+	int					m_maxStates;	// max states in memory when reading states on demand
 
 private:
 	Ui::CDlgImportXPLT* ui;
@@ -62,6 +62,10 @@ public:
 	QCheckBox* editCmd;
 	QLineEdit*	cmd;
 
+	QCheckBox*	addToQueue;
+	QSpinBox*	threads;
+	QSpinBox*	priority;
+
 	QGroupBox*	febops;
 	QWidget*	jobFolder;
 
@@ -143,6 +147,17 @@ public:
 		ext->addRow("Config file:", configLayout);
 		ext->addRow("Task name:", taskName);
 		ext->addRow("Task control file:", taskFile);
+		ext->addRow("Add to run queue:", addToQueue = new QCheckBox(""));
+		ext->addRow("Threads:", threads = new QSpinBox);
+		ext->addRow("Priority:", priority = new QSpinBox);
+
+		addToQueue->setWhatsThis("Run the job in the background together with other queued jobs. Only for local launch configurations.");
+		threads->setRange(1, 1024);
+		threads->setValue(1);
+		threads->setEnabled(false);
+		priority->setRange(-100, 100);
+		priority->setValue(0);
+		priority->setEnabled(false);
 
 		writeNotes->setChecked(true);
 
@@ -189,6 +204,8 @@ public:
 
 		QObject::connect(debug, SIGNAL(toggled(bool)), dlg, SLOT(updateDefaultCommand()));
 		QObject::connect(editCmd, SIGNAL(toggled(bool)), cmd, SLOT(setEnabled(bool)));
+		QObject::connect(addToQueue, SIGNAL(toggled(bool)), threads, SLOT(setEnabled(bool)));
+		QObject::connect(addToQueue, SIGNAL(toggled(bool)), priority, SLOT(setEnabled(bool)));
 		QObject::connect(selectConfigFile, SIGNAL(clicked()), dlg, SLOT(on_selectConfigFile()));
 		QObject::connect(configFile, SIGNAL(textChanged(const QString&)), dlg, SLOT(updateDefaultCommand()));
 		QObject::connect(taskName, SIGNAL(textChanged(const QString&)), dlg, SLOT(updateDefaultCommand()));
@@ -229,6 +246,28 @@ bool CDlgRun::HasDebugFlag()
 	return ui->debug->isChecked();
 }
 
+bool CDlgRun::AddToQueue()
+{
+	return ui->addToQueue->isChecked();
+}
+
+int CDlgRun::QueueThreads()
+{
+	return ui->threads->value();
+}
+
+int CDlgRun::QueuePriority()
+{
+	return ui->priority->value();
+}
+
+void CDlgRun::SetQueueOptions(bool addToQueue, int threads, int priority)
+{
+	ui->addToQueue->setChecked(addToQueue);
+	ui->threads->setValue(threads);
+	ui->priority->setValue(priority);
+}
+
 void CDlgRun::ShowFEBioSaveOptions(bool b)
 {
 	ui->febops->setVisible(b);
@@ -67,6 +67,12 @@ public:
 
 	QString CommandLine();
 
+	// run queue options
+	bool AddToQueue();
+	int QueueThreads();
+	int QueuePriority();
+	void SetQueueOptions(bool addToQueue, int threads, int priority);
+
 	void accept() override;
 
 protected slots:
@@ -50,6 +50,8 @@ SOFTWARE.*/
 #include "CColorButton.h"
 #include <GLWLib/convert.h>
 #include <PostLib/Palette.h>
+#include <PostLib/FEFieldCache.h>
+#include "CommandManager.h"
 #include "RepositoryPanel.h"
 #include "units.h"
 #include "DlgSetRepoFolder.h"
@@ -156,6 +158,9 @@ public:
 		addBoolProperty(&m_showNewDialog, "Show New dialog box");
 		addProperty("Recent files list", CProperty::Action)->info = QString("Clear");
 		addIntProperty(&m_autoSaveInterval, "AutoSave Interval (s)");
+		addIntProperty(&m_fieldCacheSize, "Field cache size (MB)");
+		addIntProperty(&m_undoMemory, "Undo memory budget (MB)");
+		addIntProperty(&m_jobThreads, "Run queue threads");
 	}
 
 	void SetPropertyValue(int i, const QVariant& v) override
@@ -178,6 +183,9 @@ public:
 	int		m_theme;
 	bool	m_showNewDialog;
 	int		m_autoSaveInterval;
+	int		m_fieldCacheSize;
+	int		m_undoMemory;
+	int		m_jobThreads;
 };
 
 //-----------------------------------------------------------------------------
@@ -1004,6 +1012,9 @@ void CDlgSettings::UpdateSettings()
 	ui->m_ui->m_theme = m_pwnd->currentTheme();
 	ui->m_ui->m_showNewDialog = m_pwnd->showNewDialog();
 	ui->m_ui->m_autoSaveInterval = m_pwnd->autoSaveInterval();
+	ui->m_ui->m_fieldCacheSize = Post::FEFieldCache::GetMaxSize();
+	ui->m_ui->m_undoMemory = CBasicCmdManager::GetMemoryBudget();
+	ui->m_ui->m_jobThreads = m_pwnd->jobThreadBudget();
 
 	ui->m_select->m_bconnect = view.m_bconn;
 	ui->m_select->m_ntagInfo = view.m_ntagInfo;
@@ -1134,6 +1145,9 @@ void CDlgSettings::apply()
 	m_pwnd->setClearCommandStackOnSave(ui->m_ui->m_bcmd);
 	m_pwnd->setShowNewDialog(ui->m_ui->m_showNewDialog);
 	m_pwnd->setAutoSaveInterval(ui->m_ui->m_autoSaveInterval);
+	Post::FEFieldCache::SetMaxSize(ui->m_ui->m_fieldCacheSize);
+	CBasicCmdManager::SetMemoryBudget(ui->m_ui->m_undoMemory);
+	m_pwnd->setJobThreadBudget(ui->m_ui->m_jobThreads);
 
 	int oldTheme = m_pwnd->currentTheme();
 	if (ui->m_ui->m_theme != oldTheme)
@@ -574,25 +574,27 @@ const std::string& CGLDocument::GetCommandErrorString() const
 }
 
 //-----------------------------------------------------------------------------
-void CGLDocument::UndoCommand()
+bool CGLDocument::UndoCommand()
 {
 	string cmdName = m_pCmd->GetUndoCmdName();
-	m_pCmd->UndoCommand();
+	bool ret = m_pCmd->UndoCommand();
 	SetModifiedFlag();
 	UpdateSelection();
 	CMainWindow* wnd = GetMainWindow();
-	wnd->AddLogEntry(QString("Undo last command (%1)\n").arg(QString::fromStdString(cmdName)));
+	if (ret) wnd->AddLogEntry(QString("Undo last command (%1)\n").arg(QString::fromStdString(cmdName)));
+	return ret;
 }
 
 //-----------------------------------------------------------------------------
-void CGLDocument::RedoCommand()
+bool CGLDocument::RedoCommand()
 {
 	string cmdName = m_pCmd->GetRedoCmdName();
-	m_pCmd->RedoCommand();
+	bool ret = m_pCmd->RedoCommand();
 	SetModifiedFlag();
 	UpdateSelection();
 	CMainWindow* wnd = GetMainWindow();
-	wnd->AddLogEntry(QString("Redo command (%1)\n").arg(QString::fromStdString(cmdName)));
+	if (ret) wnd->AddLogEntry(QString("Redo command (%1)\n").arg(QString::fromStdString(cmdName)));
+	return ret;
 }
 
 //-----------------------------------------------------------------------------
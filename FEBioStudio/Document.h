@@ -268,8 +268,8 @@ public:
 	void AddCommand(CCommand* pcmd, const std::string& s);
 	bool DoCommand(CCommand* pcmd, bool b = true);
 	bool DoCommand(CCommand* pcmd, const std::string& s, bool b = true);
-	void UndoCommand();
-	void RedoCommand();
+	bool UndoCommand();
+	bool RedoCommand();
 	const char* GetUndoCmdName();
 	const char* GetRedoCmdName();
 	void ClearCommandStack();
@@ -44,7 +44,8 @@ public:
 		COMPLETED,
 		FAILED,
 		CANCELLED,
-		RUNNING
+		RUNNING,
+		QUEUED
 	};
 
 public:
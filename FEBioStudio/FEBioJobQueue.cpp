@@ -0,0 +1,263 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#include "stdafx.h"
+#include "FEBioJobQueue.h"
+#include "FEBioJob.h"
+#include <QtCore/QFileInfo>
+#include <QtCore/QThread>
+#include <QtCore/QProcessEnvironment>
+#include <FSCore/FSDir.h>
+
+CFEBioJobQueue::CFEBioJobQueue(QObject* parent) : QObject(parent)
+{
+	m_threadBudget = QThread::idealThreadCount();
+	if (m_threadBudget < 1) m_threadBudget = 1;
+}
+
+CFEBioJobQueue::~CFEBioJobQueue()
+{
+	// don't leave any FEBio processes behind
+	for (QueueItem& item : m_running)
+	{
+		item.process->disconnect(this);
+		item.process->kill();
+		item.process->waitForFinished(1000);
+	}
+}
+
+void CFEBioJobQueue::SetThreadBudget(int n)
+{
+	m_threadBudget = (n < 1 ? 1 : n);
+	Schedule();
+}
+
+int CFEBioJobQueue::ThreadBudget() const
+{
+	return m_threadBudget;
+}
+
+int CFEBioJobQueue::UsedThreads() const
+{
+	int n = 0;
+	for (const QueueItem& item : m_running) n += item.threads;
+	return n;
+}
+
+bool CFEBioJobQueue::AddJob(CFEBioJob* job, int threads, int priority)
+{
+	if ((job == nullptr) || IsQueued(job) || IsRunning(job)) return false;
+
+	QueueItem item;
+	item.job = job;
+	item.threads = (threads < 1 ? 1 : threads);
+	item.priority = priority;
+	item.process = nullptr;
+
+	// insert after all jobs with the same or higher priority
+	std::vector<QueueItem>::iterator it = m_queue.begin();
+	while ((it != m_queue.end()) && (it->priority >= priority)) ++it;
+	m_queue.insert(it, item);
+
+	job->SetStatus(CFEBioJob::QUEUED);
+
+	Schedule();
+
+	return true;
+}
+
+bool CFEBioJobQueue::CancelJob(CFEBioJob* job)
+{
+	for (size_t i = 0; i < m_queue.size(); ++i)
+	{
+		if (m_queue[i].job == job)
+		{
+			m_queue.erase(m_queue.begin() + i);
+			job->SetStatus(CFEBioJob::CANCELLED);
+			emit jobFinished(job, -1);
+			return true;
+		}
+	}
+
+	for (QueueItem& item : m_running)
+	{
+		if (item.job == job)
+		{
+			// the job is finished when the process reports back
+			job->SetStatus(CFEBioJob::CANCELLED);
+			item.process->kill();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void CFEBioJobQueue::CancelAll()
+{
+	// cancel the waiting jobs first, so they don't get started when running jobs finish
+	while (m_queue.empty() == false) CancelJob(m_queue.back().job);
+
+	for (QueueItem& item : m_running)
+	{
+		item.job->SetStatus(CFEBioJob::CANCELLED);
+		item.process->kill();
+	}
+}
+
+int CFEBioJobQueue::QueuedJobs() const
+{
+	return (int)m_queue.size();
+}
+
+int CFEBioJobQueue::RunningJobs() const
+{
+	return (int)m_running.size();
+}
+
+bool CFEBioJobQueue::IsQueued(CFEBioJob* job) const
+{
+	for (const QueueItem& item : m_queue) if (item.job == job) return true;
+	return false;
+}
+
+bool CFEBioJobQueue::IsRunning(CFEBioJob* job) const
+{
+	for (const QueueItem& item : m_running) if (item.job == job) return true;
+	return false;
+}
+
+bool CFEBioJobQueue::HasJobs(CDocument* doc) const
+{
+	for (const QueueItem& item : m_queue) if (item.job->GetDocument() == doc) return true;
+	for (const QueueItem& item : m_running) if (item.job->GetDocument() == doc) return true;
+	return false;
+}
+
+QString CFEBioJobQueue::OutputFileName(CFEBioJob* job)
+{
+	QFileInfo fi(QString::fromStdString(job->GetLogFileName()));
+	return fi.absolutePath() + "/" + fi.completeBaseName() + ".out";
+}
+
+void CFEBioJobQueue::GetLaunchCommand(CFEBioJob* job, QString& program, QStringList& args, QString& workingDir)
+{
+	// extract the working directory and file title from the file path
+	QFileInfo fileInfo(QString::fromStdString(job->GetFEBFileName()));
+	workingDir = fileInfo.absolutePath();
+	QString fileName = fileInfo.fileName();
+
+	// do string substitution
+	std::string sprogram = FSDir::expandMacros(job->GetLaunchConfig()->path);
+	program = QString::fromStdString(sprogram);
+
+	// extract the arguments
+	QString cmd = QString::fromStdString(job->m_cmd);
+	args = cmd.split(" ", Qt::SkipEmptyParts);
+
+	std::string configFile = job->GetConfigFileName();
+
+	args.replaceInStrings("$(Filename)", fileName);
+	args.replaceInStrings("$(ConfigFile)", QString::fromStdString(configFile));
+}
+
+void CFEBioJobQueue::Schedule()
+{
+	// Start jobs in order as long as they fit in the budget. We stop at the first job 
+	// that doesn't fit, so that large jobs can't be passed indefinitely by smaller ones.
+	while (m_queue.empty() == false)
+	{
+		QueueItem item = m_queue.front();
+		if ((m_running.empty() == false) && (UsedThreads() + item.threads > m_threadBudget)) break;
+
+		m_queue.erase(m_queue.begin());
+		StartJob(item);
+	}
+}
+
+void CFEBioJobQueue::StartJob(QueueItem& item)
+{
+	CFEBioJob* job = item.job;
+
+	QString program, workingDir;
+	QStringList args;
+	GetLaunchCommand(job, program, args, workingDir);
+
+	QProcess* process = new QProcess(this);
+	process->setProcessChannelMode(QProcess::MergedChannels);
+	process->setStandardOutputFile(OutputFileName(job));
+	if (workingDir.isEmpty() == false) process->setWorkingDirectory(workingDir);
+
+	// limit the number of threads FEBio will use
+	QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+	env.insert("OMP_NUM_THREADS", QString::number(item.threads));
+	process->setProcessEnvironment(env);
+
+	// (Queued connections, since a failed start may be reported from within start.)
+	QObject::connect(process, SIGNAL(finished(int, QProcess::ExitStatus)), this, SLOT(onProcessFinished(int, QProcess::ExitStatus)), Qt::QueuedConnection);
+	QObject::connect(process, SIGNAL(errorOccurred(QProcess::ProcessError)), this, SLOT(onProcessError(QProcess::ProcessError)), Qt::QueuedConnection);
+
+	item.process = process;
+	m_running.push_back(item);
+
+	job->SetStatus(CFEBioJob::RUNNING);
+	process->start(program, args);
+
+	emit jobStarted(job);
+}
+
+void CFEBioJobQueue::onProcessFinished(int exitCode, QProcess::ExitStatus status)
+{
+	FinishJob(qobject_cast<QProcess*>(sender()), (status == QProcess::NormalExit ? exitCode : -1));
+}
+
+void CFEBioJobQueue::onProcessError(QProcess::ProcessError err)
+{
+	// only a failed start is not followed by a finished signal
+	if (err == QProcess::FailedToStart) FinishJob(qobject_cast<QProcess*>(sender()), -1);
+}
+
+void CFEBioJobQueue::FinishJob(QProcess* process, int exitCode)
+{
+	for (size_t i = 0; i < m_running.size(); ++i)
+	{
+		if (m_running[i].process == process)
+		{
+			CFEBioJob* job = m_running[i].job;
+			m_running.erase(m_running.begin() + i);
+			process->deleteLater();
+
+			if (job->GetStatus() != CFEBioJob::CANCELLED)
+				job->SetStatus(exitCode == 0 ? CFEBioJob::COMPLETED : CFEBioJob::FAILED);
+
+			emit jobFinished(job, exitCode);
+			break;
+		}
+	}
+
+	// see if we can start the next jobs
+	Schedule();
+}
@@ -0,0 +1,104 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#pragma once
+#include <QObject>
+#include <QProcess>
+#include <QStringList>
+#include <vector>
+
+class CFEBioJob;
+class CDocument;
+
+//-----------------------------------------------------------------------------
+// Runs local FEBio jobs concurrently. Jobs are started in order of priority 
+// (and in the order they were added for equal priority) as long as the number 
+// of threads they use stays within the thread budget. Each job gets its own 
+// process with OMP_NUM_THREADS set, and its output is written to a separate file.
+class CFEBioJobQueue : public QObject
+{
+	Q_OBJECT
+
+	struct QueueItem
+	{
+		CFEBioJob*	job;
+		int			threads;	// number of OpenMP threads
+		int			priority;	// higher priority jobs run first
+		QProcess*	process;	// only set while running
+	};
+
+public:
+	CFEBioJobQueue(QObject* parent = nullptr);
+	~CFEBioJobQueue();
+
+	// total number of threads that the running jobs may use
+	void SetThreadBudget(int n);
+	int ThreadBudget() const;
+
+	// number of threads used by the running jobs
+	int UsedThreads() const;
+
+	// add a job to the queue
+	// (A job that needs more threads than the budget runs when no other job is running.)
+	bool AddJob(CFEBioJob* job, int threads, int priority = 0);
+
+	// remove a waiting job, or kill a running one
+	bool CancelJob(CFEBioJob* job);
+	void CancelAll();
+
+	int QueuedJobs() const;
+	int RunningJobs() const;
+
+	bool IsQueued(CFEBioJob* job) const;
+	bool IsRunning(CFEBioJob* job) const;
+
+	// see if any job of this document is waiting or running
+	bool HasJobs(CDocument* doc) const;
+
+	// file that receives the job's console output
+	static QString OutputFileName(CFEBioJob* job);
+
+	// get the program, arguments and working directory for launching a job
+	static void GetLaunchCommand(CFEBioJob* job, QString& program, QStringList& args, QString& workingDir);
+
+signals:
+	void jobStarted(CFEBioJob* job);
+	void jobFinished(CFEBioJob* job, int exitCode);
+
+private slots:
+	void onProcessFinished(int exitCode, QProcess::ExitStatus status);
+	void onProcessError(QProcess::ProcessError err);
+
+private:
+	void Schedule();
+	void StartJob(QueueItem& item);
+	void FinishJob(QProcess* process, int exitCode);
+
+private:
+	std::vector<QueueItem>	m_queue;	// waiting jobs, sorted by priority
+	std::vector<QueueItem>	m_running;	// running jobs
+	int		m_threadBudget;
+};
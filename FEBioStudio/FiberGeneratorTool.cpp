@@ -30,6 +30,7 @@ SOFTWARE.*/
 #include "MainWindow.h"
 #include <MeshTools/GradientMap.h>
 #include <MeshTools/LaplaceSolver.h>
+#include <MathLib/PCGSolver.h>
 #include <GeomLib/GObject.h>
 #include <MeshTools/FENodeData.h>
 #include <QLineEdit>
@@ -56,6 +57,7 @@ public:
 
 	QComboBox*	m_matList;
 
+	QComboBox*	m_solver;
 	QLineEdit*	m_maxIters;
 	QLineEdit*	m_tol;
 	QLineEdit*	m_sor;
@@ -83,6 +85,10 @@ public:
 		QFormLayout* f = new QFormLayout;
 		f->setContentsMargins(0,0,0,0);
 		f->addRow("Material:", m_matList = new QComboBox);
+		f->addRow("Solver:", m_solver = new QComboBox);
+		m_solver->addItem("Conjugate gradient (IC0)");
+		m_solver->addItem("Conjugate gradient (Jacobi)");
+		m_solver->addItem("SOR relaxation");
 		f->addRow("Max iterations:", m_maxIters = new QLineEdit); m_maxIters->setText(QString::number(1000));
 		f->addRow("Tolerance:", m_tol = new QLineEdit); m_tol->setText(QString::number(1e-4));
 		f->addRow("SOR parameter:", m_sor = new QLineEdit); m_sor->setText(QString::number(1.0));
@@ -277,7 +283,9 @@ void CFiberGeneratorTool::OnApply()
 	int maxIter = ui->m_maxIters->text().toInt();
 	double tol = ui->m_tol->text().toDouble();
 	double w = ui->m_sor->text().toDouble();
+	int solver = ui->m_solver->currentIndex();
 
+	wnd->AddLogEntry(QString("solver        = %1\n").arg(ui->m_solver->currentText()));
 	wnd->AddLogEntry(QString("max iters     = %1\n").arg(maxIter));
 	wnd->AddLogEntry(QString("tolerance     = %1\n").arg(tol));
 	wnd->AddLogEntry(QString("SOR parameter = %1\n").arg(w));
@@ -287,6 +295,12 @@ void CFiberGeneratorTool::OnApply()
 	L.SetMaxIterations(maxIter);
 	L.SetTolerance(tol);
 	L.SetRelaxation(w);
+	if (solver == 2) L.SetMethod(LaplaceSolver::RELAXATION);
+	else
+	{
+		L.SetMethod(LaplaceSolver::CONJUGATE_GRADIENT);
+		L.SetPreconditioner(solver == 0 ? PCGSolver::IC0 : PCGSolver::JACOBI);
+	}
 	bool b = L.Solve(pm, val, bn, 1);
 	int niters = L.GetIterationCount();
 	wnd->AddLogEntry(QString("%1").arg(b ? "Converged!\n" : "NOT converged!\n"));
@@ -646,19 +646,27 @@ void MathPlot::draw(QPainter& p)
 
 	p.setPen(QPen(m_col, 2));
 
-	CMathParser mp;
+	CMathExpression mp;
+	mp.AddVariable("x");
+	if (mp.Compile(m_math) == false) return;
 
 	QRectF vr = m_graph->m_viewRect;
 	QRect sr = m_graph->ScreenRect();
 
+	// evaluate the function at all sample points
+	std::vector<double> xs, ys;
+	for (int i = sr.left(); i < sr.right(); i += 2)
+		xs.push_back(vr.left() + (i - sr.left())*(vr.right() - vr.left()) / (sr.right() - sr.left()));
+	ys.resize(xs.size());
+	const double* vars[] = { xs.data() };
+	const int stride[] = { 1 };
+	mp.Eval((int)xs.size(), vars, stride, ys.data());
+
 	QPoint p0, p1;
-	int ierr = 0;
-	for (int i=sr.left(); i < sr.right(); i += 2)
+	for (int n = 0, i = sr.left(); i < sr.right(); i += 2, ++n)
 	{
-		double x = vr.left() + (i - sr.left())*(vr.right() - vr.left())/ (sr.right() - sr.left());
-		mp.set_variable("x", x);
-
-		double y = mp.eval(m_math.c_str(), ierr);
+		double x = xs[n];
+		double y = ys[n];
 		
 		p1 = m_graph->ViewToScreen(QPointF(x,y));
 
@@ -1811,7 +1819,7 @@ void CModelGraphWindow::addObjectData(int n)
 
 	Post::FEPostModel::PlotObject* po = fem.GetPlotObject(n);
 
-	for (int j = 0; j < nsteps; j++) xdata[j] = fem.GetState(j + m_firstState)->m_time;
+	for (int j = 0; j < nsteps; j++) xdata[j] = fem.GetTimeValue(j + m_firstState);
 
 	for (int j = 0; j < nsteps; ++j)
 	{
@@ -1865,7 +1873,7 @@ void CModelGraphWindow::addProbeData(Post::GLProbe* probe)
 	vector<float> xdata(nsteps);
 	vector<float> ydata(nsteps);
 
-	for (int j = 0; j < nsteps; j++) xdata[j] = fem.GetState(j + m_firstState)->m_time;
+	for (int j = 0; j < nsteps; j++) xdata[j] = fem.GetTimeValue(j + m_firstState);
 
 	for (int j = 0; j < nsteps; ++j)
 	{
@@ -1888,7 +1896,7 @@ void CModelGraphWindow::addRulerData(Post::GLRuler* ruler)
 	vector<float> xdata(nsteps);
 	vector<float> ydata(nsteps);
 
-	for (int j = 0; j < nsteps; j++) xdata[j] = fem.GetState(j + m_firstState)->m_time;
+	for (int j = 0; j < nsteps; j++) xdata[j] = fem.GetTimeValue(j + m_firstState);
 
 	for (int j = 0; j < nsteps; ++j)
 	{
@@ -1911,7 +1919,7 @@ void CModelGraphWindow::addMusclePathData(Post::GLMusclePath* musclePath)
 	vector<float> xdata(nsteps);
 	vector<float> ydata(nsteps);
 
-	for (int j = 0; j < nsteps; j++) xdata[j] = fem.GetState(j + m_firstState)->m_time;
+	for (int j = 0; j < nsteps; j++) xdata[j] = fem.GetTimeValue(j + m_firstState);
 
 	for (int j = 0; j < nsteps; ++j)
 	{
@@ -1932,138 +1940,21 @@ void CModelGraphWindow::addSelectedNodes()
 	Post::FEPostModel& fem = *doc->GetFEModel();
 	Post::FEPostMesh& mesh = *fem.GetFEMesh(0);
 
-	int nsteps = m_lastState - m_firstState + 1;
-	vector<float> xdata(nsteps);
-	vector<float> ydata(nsteps);
-
 	// get the selected nodes
+	vector<int> sel;
+	QStringList labels;
 	int NN = mesh.Nodes();
-	switch (m_xtype)
-	{
-	case 0: // time values
-	{
-		for (int i = 0; i<NN; i++)
-		{
-			FENode& node = mesh.Node(i);
-			if (node.IsSelected())
-			{
-				for (int j = 0; j<nsteps; j++) xdata[j] = fem.GetState(j + m_firstState)->m_time;
-
-				// evaluate y-field
-				TrackNodeHistory(i, &ydata[0], m_dataY, m_firstState, m_lastState);
-
-				CPlotData* plot = nextData();
-				plot->setLabel(QString("N%1").arg(i + 1));
-				for (int j = 0; j<nsteps; ++j) plot->addPoint(xdata[j], ydata[j]);
-			}
-		}
-	}
-	break;
-	case 1: // step values
-	{
-		for (int i = 0; i<NN; i++)
-		{
-			FENode& node = mesh.Node(i);
-			if (node.IsSelected())
-			{
-				for (int j = 0; j<nsteps; j++) xdata[j] = (float)j + 1.f + m_firstState;
-
-				// evaluate y-field
-				TrackNodeHistory(i, &ydata[0], m_dataY, m_firstState, m_lastState);
-
-				CPlotData* plot = nextData();
-				plot->setLabel(QString("N%1").arg(i + 1));
-				for (int j = 0; j<nsteps; ++j) plot->addPoint(xdata[j], ydata[j]);
-			}
-		}
-	}
-	break;
-	case 2: // scatter
+	for (int i = 0; i < NN; i++)
 	{
-		for (int i = 0; i<NN; i++)
+		FENode& node = mesh.Node(i);
+		if (node.IsSelected())
 		{
-			FENode& node = mesh.Node(i);
-			if (node.IsSelected())
-			{
-				TrackNodeHistory(i, &xdata[0], m_dataX, m_firstState, m_lastState);
-
-				// evaluate y-field
-				TrackNodeHistory(i, &ydata[0], m_dataY, m_firstState, m_lastState);
-
-				CPlotData* plot = nextData();
-				plot->setLabel(QString("N%1").arg(i + 1));
-				for (int j = 0; j<nsteps; ++j) plot->addPoint(xdata[j], ydata[j]);
-			}
+			sel.push_back(i);
+			labels << QString("N%1").arg(i + 1);
 		}
 	}
-	break;
-	case 3: // time-scatter
-	{
-		vector<int> sel;
-		for (int i = 0; i < NN; i++)
-		{
-			FENode& node = mesh.Node(i);
-			if (node.IsSelected()) sel.push_back(i);
-		}
 
-		if (sel.empty() == false)
-		{
-			int states = fem.GetStates();
-
-			int state0 = m_firstState;
-			int state1 = m_lastState;
-
-			if (state0 < 0) state0 = 0;
-			if (state0 >= states) state0 = states - 1;
-
-			if (state1 < 0) state1 = 0;
-			if (state1 >= states) state1 = states - 1;
-
-			if (state1 < state0)
-			{
-				int tmp = state0;
-				state0 = state1;
-				state1 = tmp;
-			}
-
-			int nsteps = state1 - state0 + 1;
-			if (nsteps > 32) nsteps = 32;
-			for (int i = state0; i < state0 + nsteps; ++i)
-			{
-				CPlotData* plot = nextData();
-				plot->setLabel(QString("%1").arg(fem.GetState(i)->m_time));
-			}
-
-			for (int i = 0; i < (int)sel.size(); i++)
-			{
-				FENode& node = mesh.Node(sel[i]);
-				if (node.IsSelected())
-				{
-					// evaluate x-field
-					TrackNodeHistory(sel[i], &xdata[0], m_dataX, state0, state0 + nsteps - 1);
-
-					// evaluate y-field
-					TrackNodeHistory(sel[i], &ydata[0], m_dataY, state0, state0 + nsteps - 1);
-
-					for (int j = 0; j < nsteps; ++j)
-					{
-						CPlotData& p = GetPlotWidget()->getPlotData(j);
-						p.addPoint(xdata[j], ydata[j]);
-					}
-				}
-			}
-
-			// sort the plots 
-			int nplots = GetPlotWidget()->plots();
-			for (int i = 0; i < nplots; ++i)
-			{
-				CPlotData& data = GetPlotWidget()->getPlotData(i);
-				data.sort();
-			}
-		}
-	}
-	break;
-	}
+	addItemPlots(0, sel, labels);
 }
 
 //-----------------------------------------------------------------------------
@@ -2088,7 +1979,7 @@ void CModelGraphWindow::addSelectedEdges()
 			switch (m_xtype)
 			{
 			case 0:
-				for (int j = 0; j<nsteps; j++) xdata[j] = fem.GetState(j + m_firstState)->m_time;
+				for (int j = 0; j<nsteps; j++) xdata[j] = fem.GetTimeValue(j + m_firstState);
 				break;
 			case 1:
 				for (int j = 0; j<nsteps; j++) xdata[j] = (float)j + 1.f + m_firstState;
@@ -2114,264 +2005,163 @@ void CModelGraphWindow::addSelectedFaces()
 	Post::FEPostModel& fem = *doc->GetFEModel();
 	Post::FEPostMesh& mesh = *fem.GetFEMesh(0);
 
-	int nsteps = m_lastState - m_firstState + 1;
-	vector<float> xdata(nsteps);
-	vector<float> ydata(nsteps);
-
 	// get the selected faces
+	vector<int> sel;
+	QStringList labels;
 	int NF = mesh.Faces();
-	switch (m_xtype)
+	for (int i = 0; i < NF; ++i)
 	{
-	case 0:
-		for (int i = 0; i < NF; ++i)
+		FEFace& f = mesh.Face(i);
+		if (f.IsSelected())
 		{
-			FEFace& f = mesh.Face(i);
-			if (f.IsSelected())
-			{
-				// evaluate x-field
-				for (int j = 0; j < nsteps; j++) xdata[j] = fem.GetState(j + m_firstState)->m_time;
-
-				// evaluate y-field
-				TrackFaceHistory(i, &ydata[0], m_dataY, m_firstState, m_lastState);
-
-				CPlotData* plot = nextData();
-				plot->setLabel(QString("F%1").arg(i + 1));
-				for (int j = 0; j < nsteps; ++j) plot->addPoint(xdata[j], ydata[j]);
-			}
+			sel.push_back(i);
+			labels << QString("F%1").arg(i + 1);
 		}
-		break;
-	case 1:
-		for (int i = 0; i < NF; ++i)
-		{
-			FEFace& f = mesh.Face(i);
-			if (f.IsSelected())
-			{
-				for (int j = 0; j < nsteps; j++) xdata[j] = (float)j + 1.f + m_firstState;
-
-				// evaluate y-field
-				TrackFaceHistory(i, &ydata[0], m_dataY, m_firstState, m_lastState);
+	}
 
-				CPlotData* plot = nextData();
-				plot->setLabel(QString("F%1").arg(i + 1));
-				for (int j = 0; j < nsteps; ++j) plot->addPoint(xdata[j], ydata[j]);
-			}
-		}
-		break;
-	case 2:
-		for (int i = 0; i < NF; ++i)
-		{
-			FEFace& f = mesh.Face(i);
-			if (f.IsSelected())
-			{
-				// evaluate x-field
-				TrackFaceHistory(i, &xdata[0], m_dataX, m_firstState, m_lastState);
+	addItemPlots(1, sel, labels);
+}
 
-				// evaluate y-field
-				TrackFaceHistory(i, &ydata[0], m_dataY, m_firstState, m_lastState);
+//-----------------------------------------------------------------------------
+void CModelGraphWindow::addSelectedElems()
+{
+	CPostDocument* doc = GetPostDoc();
+	Post::FEPostModel& fem = *doc->GetFEModel();
+	Post::FEPostMesh& mesh = *fem.GetFEMesh(0);
 
-				CPlotData* plot = nextData();
-				plot->setLabel(QString("F%1").arg(i + 1));
-				for (int j = 0; j < nsteps; ++j) plot->addPoint(xdata[j], ydata[j]);
-			}
-		}
-		break;
-	case 3:	// time-scatter
+	// get the selected elements
+	vector<int> sel;
+	QStringList labels;
+	int NE = mesh.Elements();
+	for (int i = 0; i < NE; i++)
 	{
-		vector<int> sel;
-		for (int i = 0; i < NF; i++)
-		{
-			FEFace& face = mesh.Face(i);
-			if (face.IsSelected()) sel.push_back(i);
-		}
-
-		if (sel.empty() == false)
+		FEElement_& e = mesh.ElementRef(i);
+		if (e.IsSelected())
 		{
-			int nsteps = m_lastState - m_firstState + 1;
-			if (nsteps > 32) nsteps = 32;
-			for (int i = m_firstState; i < m_firstState + nsteps; ++i)
-			{
-				CPlotData* plot = nextData();
-				plot->setLabel(QString("%1").arg(fem.GetState(i)->m_time));
-			}
-
-			for (int i = 0; i < (int)sel.size(); i++)
-			{
-				FEFace& face = mesh.Face(sel[i]);
-
-				// evaluate x-field
-				TrackFaceHistory(sel[i], &xdata[0], m_dataX, m_firstState, m_lastState);
-
-				// evaluate y-field
-				TrackFaceHistory(sel[i], &ydata[0], m_dataY, m_firstState, m_lastState);
-
-				for (int j = 0; j < nsteps; ++j)
-				{
-					CPlotData& p = GetPlotWidget()->getPlotData(j);
-					p.addPoint(xdata[j], ydata[j]);
-				}
-			}
-
-			// sort the plots 
-			CPlotWidget* w = GetPlotWidget();
-			int nplots = w->plots();
-			for (int i = 0; i < nplots; ++i)
-			{
-				CPlotData& data = GetPlotWidget()->getPlotData(i);
-				data.sort();
-			}
-
-			if (w->autoRangeUpdate())
-				w->fitToData(false);
+			sel.push_back(i);
+			labels << QString("E%1").arg(e.GetID());
 		}
 	}
-	break;
-	}
+
+	addItemPlots(2, sel, labels);
 }
 
 //-----------------------------------------------------------------------------
-void CModelGraphWindow::addSelectedElems()
+// Add the plots for a list of nodes (ntype = 0), faces (ntype = 1) or elements (ntype = 2).
+void CModelGraphWindow::addItemPlots(int ntype, const std::vector<int>& sel, const QStringList& labels)
 {
+	if (sel.empty()) return;
+
 	CPostDocument* doc = GetPostDoc();
 	Post::FEPostModel& fem = *doc->GetFEModel();
-	Post::FEPostMesh& mesh = *fem.GetFEMesh(0);
+	int nsel = (int)sel.size();
 
-	int nsteps = m_lastState - m_firstState + 1;
-	vector<float> xdata(nsteps);
-	vector<float> ydata(nsteps);
-
-	// get the selected elements
-	int NE = mesh.Elements();
 	switch (m_xtype)
 	{
-	case 0:
-		for (int i = 0; i < NE; i++)
+	case 0: // time values
+	case 1: // step values
+	case 2: // scatter
+	{
+		// evaluate y-field
+		vector<float> xval, yval;
+		int nsteps = TrackHistory(ntype, sel, yval, m_dataY, m_firstState, m_lastState);
+		if (nsteps == 0) return;
+
+		// evaluate x-field
+		if (m_xtype == 2) TrackHistory(ntype, sel, xval, m_dataX, m_firstState, m_lastState);
+		else
 		{
-			FEElement_& e = mesh.ElementRef(i);
-			if (e.IsSelected())
-			{
-				// evaluate x-field
-				for (int j = 0; j < nsteps; j++) xdata[j] = fem.GetState(j + m_firstState)->m_time;
+			xval.resize(nsteps);
+			for (int j = 0; j < nsteps; j++) xval[j] = (m_xtype == 0 ? fem.GetTimeValue(j + m_firstState) : (float)j + 1.f + m_firstState);
+		}
 
-				// evaluate y-field
-				TrackElementHistory(i, &ydata[0], m_dataY, m_firstState, m_lastState);
+		for (int i = 0; i < nsel; ++i)
+		{
+			const float* x = (m_xtype == 2 ? &xval[i*nsteps] : &xval[0]);
+			const float* y = &yval[i*nsteps];
 
-				CPlotData* plot = nextData();
-				for (int j = 0; j < nsteps; ++j) plot->addPoint(xdata[j], ydata[j]);
-				plot->setLabel(QString("E%1").arg(e.GetID()));
-			}
+			CPlotData* plot = nextData();
+			plot->setLabel(labels[i]);
+			for (int j = 0; j < nsteps; ++j) plot->addPoint(x[j], y[j]);
 		}
-		break;
-	case 1:
-		for (int i = 0; i < NE; i++)
-		{
-			FEElement_& e = mesh.ElementRef(i);
-			if (e.IsSelected())
-			{
-				// evaluate x-field
-				for (int j = 0; j < nsteps; j++) xdata[j] = (float)j + 1.f + m_firstState;
+	}
+	break;
+	case 3: // time-scatter
+	{
+		int states = fem.GetStates();
 
-				// evaluate y-field
-				TrackElementHistory(i, &ydata[0], m_dataY, m_firstState, m_lastState);
+		int state0 = m_firstState;
+		int state1 = m_lastState;
 
-				CPlotData* plot = nextData();
-				for (int j = 0; j < nsteps; ++j) plot->addPoint(xdata[j], ydata[j]);
-				plot->setLabel(QString("E%1").arg(e.GetID()));
-			}
-		}
-		break;
-	case 2:
-		for (int i = 0; i < NE; i++)
-		{
-			FEElement_& e = mesh.ElementRef(i);
-			if (e.IsSelected())
-			{
-				// evaluate x-field
-				TrackElementHistory(i, &xdata[0], m_dataX, m_firstState, m_lastState);
+		if (state0 < 0) state0 = 0;
+		if (state0 >= states) state0 = states - 1;
 
-				// evaluate y-field
-				TrackElementHistory(i, &ydata[0], m_dataY, m_firstState, m_lastState);
+		if (state1 < 0) state1 = 0;
+		if (state1 >= states) state1 = states - 1;
 
-				CPlotData* plot = nextData();
-				for (int j = 0; j < nsteps; ++j) plot->addPoint(xdata[j], ydata[j]);
-				plot->setLabel(QString("E%1").arg(e.GetID()));
-			}
-		}
-		break;
-	case 3:	// time-scatter
-	{
-		vector<int> sel;
-		for (int i = 0; i < NE; i++)
+		if (state1 < state0)
 		{
-			FEElement_& e = mesh.ElementRef(i);
-			if (e.IsSelected()) sel.push_back(i);
+			int tmp = state0;
+			state0 = state1;
+			state1 = tmp;
 		}
 
-		if (sel.empty() == false)
+		int nsteps = state1 - state0 + 1;
+		if (nsteps > 32) nsteps = 32;
+		for (int i = state0; i < state0 + nsteps; ++i)
 		{
-			int nsteps = m_lastState - m_firstState + 1;
-			if (nsteps > 32) nsteps = 32;
-			for (int i = m_firstState; i < m_firstState + nsteps; ++i)
-			{
-				CPlotData* plot = nextData();
-				plot->setLabel(QString("%1").arg(fem.GetState(i)->m_time));
-			}
-
-			for (int i = 0; i < (int)sel.size(); i++)
-			{
-				FEElement_& e = mesh.ElementRef(sel[i]);
-				if (e.IsSelected())
-				{
-					// evaluate x-field
-					TrackElementHistory(sel[i], &xdata[0], m_dataX, m_firstState, m_lastState);
-
-					// evaluate y-field
-					TrackElementHistory(sel[i], &ydata[0], m_dataY, m_firstState, m_lastState);
+			CPlotData* plot = nextData();
+			plot->setLabel(QString("%1").arg(fem.GetTimeValue(i)));
+		}
 
-					for (int j = 0; j < nsteps; ++j)
-					{
-						CPlotData& p = GetPlotWidget()->getPlotData(j);
-						p.addPoint(xdata[j], ydata[j]);
-					}
-				}
-			}
+		// evaluate x- and y-field
+		vector<float> xval, yval;
+		TrackHistory(ntype, sel, xval, m_dataX, state0, state0 + nsteps - 1);
+		TrackHistory(ntype, sel, yval, m_dataY, state0, state0 + nsteps - 1);
 
-			// sort the plots 
-			CPlotWidget* w = GetPlotWidget();
-			int nplots = w->plots();
-			for (int i = 0; i < nplots; ++i)
+		for (int i = 0; i < nsel; i++)
+		{
+			for (int j = 0; j < nsteps; ++j)
 			{
-				CPlotData& data = GetPlotWidget()->getPlotData(i);
-				data.sort();
+				CPlotData& p = GetPlotWidget()->getPlotData(j);
+				p.addPoint(xval[i*nsteps + j], yval[i*nsteps + j]);
 			}
+		}
 
-			if (w->autoRangeUpdate())
-				w->fitToData(false);
+		// sort the plots 
+		CPlotWidget* w = GetPlotWidget();
+		int nplots = w->plots();
+		for (int i = 0; i < nplots; ++i)
+		{
+			CPlotData& data = GetPlotWidget()->getPlotData(i);
+			data.sort();
 		}
+
+		if (w->autoRangeUpdate())
+			w->fitToData(false);
 	}
 	break;
 	}
 }
 
 //-----------------------------------------------------------------------------
-// Calculate time history of a node
-void CModelGraphWindow::TrackNodeHistory(int node, float* pval, int nfield, int nmin, int nmax)
+// Calculate the time history of a list of nodes (ntype = 0), faces (ntype = 1) or elements (ntype = 2).
+// The values are stored in an item-by-time matrix and the nr of time steps is returned.
+int CModelGraphWindow::TrackHistory(int ntype, const std::vector<int>& items, std::vector<float>& val, int nfield, int nmin, int nmax)
 {
 	CPostDocument* doc = GetPostDoc();
 	Post::FEPostModel& fem = *doc->GetFEModel();
 
-	int nsteps = fem.GetStates();
-	if (nmin <       0) nmin = 0;
-	if (nmax == -1) nmax = nsteps - 1;
-	if (nmax >= nsteps) nmax = nsteps - 1;
-	if (nmax <    nmin) nmax = nmin;
-	int nn = nmax - nmin + 1;
-
-	Post::NODEDATA nd;
-	for (int n = 0; n<nn; n++)
+	switch (ntype)
 	{
-		fem.EvaluateNode(node, n + nmin, nfield, nd);
-		pval[n] = nd.m_val;
+	case 0: return fem.EvaluateNodeHistory(items, nfield, nmin, nmax, val);
+	case 1: return fem.EvaluateFaceHistory(items, nfield, nmin, nmax, val);
+	case 2: return fem.EvaluateElemHistory(items, nfield, nmin, nmax, val);
+	default:
+		assert(false);
 	}
+	val.clear();
+	return 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -2396,46 +2186,3 @@ void CModelGraphWindow::TrackEdgeHistory(int edge, float* pval, int nfield, int
 	}
 }
 
-//-----------------------------------------------------------------------------
-// Calculate time history of a face
-void CModelGraphWindow::TrackFaceHistory(int nface, float* pval, int nfield, int nmin, int nmax)
-{
-	CPostDocument* doc = GetPostDoc();
-	Post::FEPostModel& fem = *doc->GetFEModel();
-
-	int nsteps = fem.GetStates();
-	if (nmin <       0) nmin = 0;
-	if (nmax == -1) nmax = nsteps - 1;
-	if (nmax >= nsteps) nmax = nsteps - 1;
-	if (nmax <    nmin) nmax = nmin;
-	int nn = nmax - nmin + 1;
-
-	float data[FEFace::MAX_NODES], val;
-	for (int n = 0; n<nn; n++)
-	{
-		fem.EvaluateFace(nface, n + nmin, nfield, data, val);
-		pval[n] = val;
-	}
-}
-
-//-----------------------------------------------------------------------------
-// Calculate time history of an element
-void CModelGraphWindow::TrackElementHistory(int nelem, float* pval, int nfield, int nmin, int nmax)
-{
-	CPostDocument* doc = GetPostDoc();
-	Post::FEPostModel& fem = *doc->GetFEModel();
-
-	int nsteps = fem.GetStates();
-	if (nmin <       0) nmin = 0;
-	if (nmax == -1) nmax = nsteps - 1;
-	if (nmax >= nsteps) nmax = nsteps - 1;
-	if (nmax <    nmin) nmax = nmin;
-	int nn = nmax - nmin + 1;
-
-	float data[FEElement::MAX_NODES] = { 0.f }, val;
-	for (int n = 0; n<nn; n++)
-	{
-		fem.EvaluateElement(nelem, n + nmin, nfield, data, val);
-		pval[n] = val;
-	}
-}
@@ -26,7 +26,7 @@ SOFTWARE.*/
 
 #pragma once
 #include <QMainWindow>
-#include <MathLib/MathParser.h>
+#include <MathLib/MathExpression.h>
 #include "PlotWidget.h"
 #include "Document.h"
 
@@ -406,16 +406,15 @@ public:
 
 private:
 	// track mesh data
-	void TrackElementHistory(int nelem, float* pval, int nfield, int nmin = 0, int nmax = -1);
-	void TrackFaceHistory(int nface, float* pval, int nfield, int nmin = 0, int nmax = -1);
+	int TrackHistory(int ntype, const std::vector<int>& items, std::vector<float>& val, int nfield, int nmin = 0, int nmax = -1);
 	void TrackEdgeHistory(int edge, float* pval, int nfield, int nmin = 0, int nmax = -1);
-	void TrackNodeHistory(int node, float* pval, int nfield, int nmin = 0, int nmax = -1);
 
 private:
 	void addSelectedNodes();
 	void addSelectedEdges();
 	void addSelectedFaces();
 	void addSelectedElems();
+	void addItemPlots(int ntype, const std::vector<int>& sel, const QStringList& labels);
 	void addObjectData(int n);
 	void addProbeData(Post::GLProbe* probe);
 	void addRulerData(Post::GLRuler* ruler);
@@ -84,6 +84,7 @@ SOFTWARE.*/
 #endif
 #include "welcomePage.h"
 #include <PostLib/Palette.h>
+#include <PostLib/FEFieldCache.h>
 
 extern GLColor col[];
 
@@ -233,6 +234,14 @@ CMainWindow::CMainWindow(bool reset, QWidget* parent) : QMainWindow(parent), ui(
 	QObject::connect(ui->m_autoSaveTimer, &QTimer::timeout, this, &CMainWindow::autosave);
 	ui->m_autoSaveTimer->start(ui->m_autoSaveInterval*1000);
 
+	// Timer for following the plot file of a running job
+	ui->m_followTimer = new QTimer(this);
+	QObject::connect(ui->m_followTimer, &QTimer::timeout, this, &CMainWindow::onFollowTimer);
+
+	// report on the jobs in the run queue
+	QObject::connect(ui->m_jobQueue, &CFEBioJobQueue::jobStarted, this, &CMainWindow::onQueuedJobStarted);
+	QObject::connect(ui->m_jobQueue, &CFEBioJobQueue::jobFinished, this, &CMainWindow::onQueuedJobFinished);
+
 	// Auto Update Check
 	if(ui->m_updaterPresent)
 	{
@@ -337,7 +346,7 @@ void CMainWindow::UpdateTab(CDocument* doc)
 		if (path.isEmpty() == false) ui->tab->setTabToolTip(n, path); else ui->tab->setTabToolTip(n, "");
 
 		CFEBioJob* activeJob = CFEBioJob::GetActiveJob();
-		if (activeJob && (activeJob->GetDocument() == doc))
+		if ((activeJob && (activeJob->GetDocument() == doc)) || ui->m_jobQueue->HasJobs(doc))
 		{
 			file += "[running]";
 		}
@@ -855,6 +864,12 @@ void CMainWindow::OpenPostFile(const QString& fileName, CModelDocument* modelDoc
 		if (ext.compare("xplt", Qt::CaseInsensitive) == 0)
 		{
 			xpltFileReader* xplt = new xpltFileReader(doc->GetFEModel());
+
+			// if this is the plot file of the running job, keep reading its states as they come in
+			CFEBioJob* job = CFEBioJob::GetActiveJob();
+			if (job && ui->m_process && (QFileInfo(fileName) == QFileInfo(QString::fromStdString(job->GetPlotFileName()))))
+				xplt->SetFollowMode(true);
+
 			if (showLoadOptions)
 			{
 				CDlgImportXPLT dlg(this);
@@ -862,6 +877,7 @@ void CMainWindow::OpenPostFile(const QString& fileName, CModelDocument* modelDoc
 				{
 					xplt->SetReadStateFlag(dlg.m_nop);
 					xplt->SetReadStatesList(dlg.m_item);
+					xplt->SetMaxPagedStates(dlg.m_maxStates);
 				}
 				else
 				{
@@ -894,6 +910,11 @@ void CMainWindow::OpenPostFile(const QString& fileName, CModelDocument* modelDoc
 	}
 	else
 	{
+		CFEBioJob* job = CFEBioJob::GetActiveJob();
+		xpltFileReader* xplt = dynamic_cast<xpltFileReader*>(doc->GetFileReader());
+		if (xplt && job && ui->m_process && (QFileInfo(fileName) == QFileInfo(QString::fromStdString(job->GetPlotFileName()))))
+			xplt->SetFollowMode(true);
+
 		ReadFile(doc, fileName, doc->GetFileReader(), QueuedFile::RELOAD_DOCUMENT);
 	}
 }
@@ -1609,6 +1630,21 @@ int CMainWindow::autoSaveInterval()
 	return ui->m_autoSaveInterval;
 }
 
+void CMainWindow::setJobThreadBudget(int n)
+{
+	ui->m_jobQueue->SetThreadBudget(n);
+}
+
+int CMainWindow::jobThreadBudget()
+{
+	return ui->m_jobQueue->ThreadBudget();
+}
+
+bool CMainWindow::IsJobInRunQueue(CFEBioJob* job)
+{
+	return (ui->m_jobQueue->IsQueued(job) || ui->m_jobQueue->IsRunning(job));
+}
+
 bool CMainWindow::updaterPresent()
 {
 	return ui->m_updaterPresent;
@@ -1644,7 +1680,10 @@ void CMainWindow::writeSettings()
 	settings.setValue("theme", ui->m_theme);
 	settings.setValue("showNewDialogBox", ui->m_showNewDialog);
 	settings.setValue("autoSaveInterval", ui->m_autoSaveInterval);
+	settings.setValue("jobThreadBudget", ui->m_jobQueue->ThreadBudget());
 	settings.setValue("defaultUnits", ui->m_defaultUnits);
+	settings.setValue("fieldCacheSize", Post::FEFieldCache::GetMaxSize());
+	settings.setValue("undoMemoryBudget", CBasicCmdManager::GetMemoryBudget());
 	settings.setValue("bgColor1", (int)vs.m_col1);
 	settings.setValue("bgColor2", (int)vs.m_col2);
 	settings.setValue("fgColor", (int)vs.m_fgcol);
@@ -1733,7 +1772,10 @@ void CMainWindow::readSettings()
 	ui->m_theme = settings.value("theme", 0).toInt();
 	ui->m_showNewDialog = settings.value("showNewDialogBox", true).toBool();
 	ui->m_autoSaveInterval = settings.value("autoSaveInterval", 600).toInt();
+	ui->m_jobQueue->SetThreadBudget(settings.value("jobThreadBudget", ui->m_jobQueue->ThreadBudget()).toInt());
 	ui->m_defaultUnits = settings.value("defaultUnits", 0).toInt();
+	Post::FEFieldCache::SetMaxSize(settings.value("fieldCacheSize", Post::FEFieldCache::GetMaxSize()).toInt());
+	CBasicCmdManager::SetMemoryBudget(settings.value("undoMemoryBudget", CBasicCmdManager::GetMemoryBudget()).toInt());
 	vs.m_col1 = GLColor(settings.value("bgColor1", (int)vs.m_col1).toInt());
 	vs.m_col2 = GLColor(settings.value("bgColor2", (int)vs.m_col2).toInt());
 	vs.m_fgcol = GLColor(settings.value("fgColor", (int)vs.m_fgcol).toInt());
@@ -2126,7 +2168,7 @@ void CMainWindow::CloseView(int n, bool forceClose)
 
 	// make sure this doc has no active jobs running.
 	CFEBioJob* activeJob = CFEBioJob::GetActiveJob();
-	if (activeJob && (activeJob->GetDocument() == doc))
+	if ((activeJob && (activeJob->GetDocument() == doc)) || ui->m_jobQueue->HasJobs(doc))
 	{
 		QMessageBox::warning(this, "FEBio Studio", "This model has an active job running and cannot be closed.\n");
 		return;
@@ -2741,6 +2783,12 @@ void CMainWindow::DeleteAllJobs()
 	CModelDocument* doc = dynamic_cast<CModelDocument*>(GetDocument());
 	if (doc == nullptr) return;
 
+	if (ui->m_jobQueue->HasJobs(doc))
+	{
+		QMessageBox::warning(this, "FEBio Studio", "Jobs cannot be deleted while they are in the run queue.");
+		return;
+	}
+
 	QString txt("Are you sure you want to delete all jobs?\nThis cannot be undone.");
 
 	if (QMessageBox::question(this, "FEBio Studio", txt, QMessageBox::Ok | QMessageBox::Cancel) == QMessageBox::Ok)
@@ -2956,20 +3004,17 @@ void CMainWindow::RunFEBioJob(CFEBioJob* job)
 		return;
 	}
 
-	QString cmd = QString::fromStdString(job->m_cmd);
-
-	// get the FEBio job file path
-	string febFile = job->GetFEBFileName();
+	// make sure the job isn't already in the run queue
+	if (ui->m_jobQueue->IsQueued(job) || ui->m_jobQueue->IsRunning(job))
+	{
+		QMessageBox::critical(this, "FEBio Studio", "Cannot start job since it is already in the run queue");
+		return;
+	}
 
 	// clear output for next job
 	ClearOutput();
 	ShowLogPanel();
 
-	// extract the working directory and file title from the file path
-	QFileInfo fileInfo(QString::fromStdString(febFile));
-	QString workingDir = fileInfo.absolutePath();
-	QString fileName = fileInfo.fileName();
-
 	// set this as the active job
 	CFEBioJob::SetActiveJob(job);
 
@@ -2977,6 +3022,10 @@ void CMainWindow::RunFEBioJob(CFEBioJob* job)
 
 	if(job->GetLaunchConfig()->type == LOCAL)
 	{
+		QString program, workingDir;
+		QStringList args;
+		CFEBioJobQueue::GetLaunchCommand(job, program, args, workingDir);
+
 		// create new process
 		ui->m_process = new QProcess(this);
 		ui->m_process->setProcessChannelMode(QProcess::MergedChannels);
@@ -2985,20 +3034,6 @@ void CMainWindow::RunFEBioJob(CFEBioJob* job)
 			AddLogEntry(QString("Setting current working directory to: %1\n").arg(workingDir));
 			ui->m_process->setWorkingDirectory(workingDir);
 		}
-		QString program = QString::fromStdString(job->GetLaunchConfig()->path);
-
-		// do string substitution
-		string sprogram = program.toStdString();
-		sprogram = FSDir::expandMacros(sprogram);
-		program = QString::fromStdString(sprogram);
-
-		// extract the arguments
-		QStringList args = cmd.split(" ", Qt::SkipEmptyParts);
-
-		std::string configFile = job->GetConfigFileName();
-
-		args.replaceInStrings("$(Filename)", fileName);
-		args.replaceInStrings("$(ConfigFile)", QString::fromStdString(configFile));
 
 		// get ready
 		AddLogEntry(QString("Starting FEBio: %1\n").arg(args.join(" ")));
@@ -3014,6 +3049,9 @@ void CMainWindow::RunFEBioJob(CFEBioJob* job)
 		UpdateModel(job, false);
 		ui->m_process->start(program, args);
 
+		// check the plot file for new states once a second (if it's open)
+		ui->m_followTimer->start(1000);
+
 		// show the output window
 		ui->logPanel->parentWidget()->raise();
 		ui->logPanel->ShowOutput();
@@ -186,6 +186,13 @@ public:
 	void setAutoSaveInterval(int interval);
 	int autoSaveInterval();
 
+	// max number of threads used by the jobs in the run queue
+	void setJobThreadBudget(int n);
+	int jobThreadBudget();
+
+	// is the job waiting or running in the run queue?
+	bool IsJobInRunQueue(CFEBioJob* job);
+
 	// autoUpdate Check
 	bool updaterPresent();
 	bool updateAvailable();
@@ -561,6 +568,12 @@ public slots:
 	void onRunFinished(int exitCode, QProcess::ExitStatus es);
 	void onReadyRead();
 	void onErrorOccurred(QProcess::ProcessError err);
+	void onFollowTimer();
+	void onQueuedJobStarted(CFEBioJob* job);
+	void onQueuedJobFinished(CFEBioJob* job, int exitCode);
+
+	// read the new states of a running job's plot file, if it is open
+	bool ReadNewJobStates(CFEBioJob* job, bool stopFollowing = false);
 
 	void onExportMaterials(const vector<GMaterial*>& matList);
 	void onExportAllMaterials();
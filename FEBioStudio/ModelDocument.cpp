@@ -195,6 +195,14 @@ void CModelDocument::DeleteObject(FSObject* po)
 {
 	FEModel& fem = *GetFEModel();
 
+	// the run queue keeps a pointer to its jobs
+	CFEBioJob* pjob = dynamic_cast<CFEBioJob*>(po);
+	if (pjob && m_wnd->IsJobInRunQueue(pjob))
+	{
+		QMessageBox::warning(m_wnd, "FEBio Studio", "Jobs cannot be deleted while they are in the run queue.");
+		return;
+	}
+
 	if (po == GetActiveItem()) SetActiveItem(nullptr);
 
 	if (dynamic_cast<FEStep*>(po))
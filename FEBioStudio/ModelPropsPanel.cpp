@@ -980,7 +980,7 @@ void CModelPropsPanel::addSelection(int n)
 				}
 				else
 				{
-					list<int> l = pg->CopyItems();
+					vector<int> l = pg->CopyItems();
 					pdoc->DoCommand(new CCmdAddToItemListBuilder(pl, l));
 				}
 			}
@@ -1029,7 +1029,7 @@ void CModelPropsPanel::addSelection(int n)
 				}
 				else
 				{
-					list<int> l = pg->CopyItems();
+					vector<int> l = pg->CopyItems();
 					pdoc->DoCommand(new CCmdAddToItemListBuilder(pl, l));
 				}
 			}
@@ -1075,7 +1075,7 @@ void CModelPropsPanel::addSelection(int n)
 				}
 				else
 				{
-					list<int> l = pg->CopyItems();
+					vector<int> l = pg->CopyItems();
 					pdoc->DoCommand(new CCmdAddToItemListBuilder(pl, l));
 				}
 			}
@@ -1140,7 +1140,7 @@ void CModelPropsPanel::addSelection(int n)
 			}
 			else
 			{
-				list<int> l = pg->CopyItems();
+				vector<int> l = pg->CopyItems();
 				pdoc->DoCommand(new CCmdAddToItemListBuilder(pl, l));
 			}
 		}
@@ -1184,7 +1184,7 @@ void CModelPropsPanel::subSelection(int n)
 			// subtract from the current list
 			if (pg->Type() == pl->Type())
 			{
-				list<int> l = pg->CopyItems();
+				vector<int> l = pg->CopyItems();
 				pdoc->DoCommand(new CCmdRemoveFromItemListBuilder(pl, l));
 			}
 
@@ -1207,7 +1207,7 @@ void CModelPropsPanel::subSelection(int n)
 			// subtract from the current list
 			if (pg->Type() == pl->Type())
 			{
-				list<int> l = pg->CopyItems();
+				vector<int> l = pg->CopyItems();
 				pdoc->DoCommand(new CCmdRemoveFromItemListBuilder(pl, l));
 			}
 
@@ -1234,7 +1234,7 @@ void CModelPropsPanel::subSelection(int n)
 			// subtract from the current list
 			if (pg->Type() == pl->Type())
 			{
-				list<int> l = pg->CopyItems();
+				vector<int> l = pg->CopyItems();
 				pdoc->DoCommand(new CCmdRemoveFromItemListBuilder(pl, l));
 			}
 
@@ -1262,7 +1262,7 @@ void CModelPropsPanel::subSelection(int n)
 			// subtract from the current list
 			if (pg->Type() == pl->Type())
 			{
-				list<int> l = pg->CopyItems();
+				vector<int> l = pg->CopyItems();
 				pdoc->DoCommand(new CCmdRemoveFromItemListBuilder(pl, l));
 			}
 
@@ -1312,7 +1312,7 @@ void CModelPropsPanel::subSelection(int n)
 
 		if (pg->Type() == pl->Type())
 		{
-			list<int> l = pg->CopyItems();
+			vector<int> l = pg->CopyItems();
 			pdoc->DoCommand(new CCmdRemoveFromItemListBuilder(pl, l));
 		}
 		SetSelection(0, pl);
@@ -1340,7 +1340,7 @@ void CModelPropsPanel::delSelection(int n)
 		if (pl)
 		{
 			CSelectionBox* sel = ui->selectionPanel(n);
-			list<int> items;
+			vector<int> items;
 			sel->getSelectedItems(items);
 
 			pdoc->DoCommand(new CCmdRemoveFromItemListBuilder(pl, items));
@@ -1361,7 +1361,7 @@ void CModelPropsPanel::delSelection(int n)
 
 		if (pl)
 		{
-			list<int> items;
+			vector<int> items;
 			sel->getSelectedItems(items);
 			pdoc->DoCommand(new CCmdRemoveFromItemListBuilder(pl, items));
 			SetSelection(n, pl);
@@ -1379,7 +1379,7 @@ void CModelPropsPanel::delSelection(int n)
 		else if (dynamic_cast<FEItemListBuilder*>(m_currentObject))
 		{
 			pl = dynamic_cast<FEItemListBuilder*>(m_currentObject);
-			list<int> items;
+			vector<int> items;
 			sel->getSelectedItems(items);
 			pdoc->DoCommand(new CCmdRemoveFromItemListBuilder(pl, items));
 			SetSelection(n, pl);
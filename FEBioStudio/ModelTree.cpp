@@ -278,7 +278,7 @@ class CFEBioJobProps : public CPropertyList
 public:
 	CFEBioJobProps(CMainWindow* wnd, CModelViewer* tree, CFEBioJob* job) : m_wnd(wnd), m_tree(tree), m_job(job)
 	{
-		addProperty("Status", CProperty::Enum)->setEnumValues(QStringList() << "NONE" << "NORMAL TERMINATION" << "ERROR TERMINATION" << "CANCELLED" << "RUNNING").setFlags(CProperty::Visible);
+		addProperty("Status", CProperty::Enum)->setEnumValues(QStringList() << "NONE" << "NORMAL TERMINATION" << "ERROR TERMINATION" << "CANCELLED" << "RUNNING" << "QUEUED").setFlags(CProperty::Visible);
 		addProperty("FEBio File", CProperty::ExternalLink)->setFlags(CProperty::Editable|CProperty::Visible);
 		addProperty("Plot File" , CProperty::InternalLink)->setFlags(CProperty::Editable|CProperty::Visible);
 		addProperty("Log File" , CProperty::ExternalLink)->setFlags(CProperty::Editable|CProperty::Visible);
@@ -1097,6 +1097,7 @@ void CModelTree::UpdateJobs(QTreeWidgetItem* t1, CModelDocument* doc)
 		CFEBioJob* job = doc->GetFEBioJob(i);
 		QString name = QString::fromStdString(job->GetName());
 		if (job->GetStatus() == CFEBioJob::RUNNING) name += " [RUNNING]";
+		if (job->GetStatus() == CFEBioJob::QUEUED) name += " [QUEUED]";
 		QTreeWidgetItem* t2 = AddTreeItem(t1, name, MT_JOB, 0, job, new CFEBioJobProps(m_view->GetMainWindow(), m_view, job), new CJobValidator(job), SHOW_PROPERTY_FORM);
 /*
 		CPostDoc* doc = job->GetPostDoc();
@@ -971,8 +971,7 @@ void CPostModelPanel::on_postModel_itemDoubleClicked(QTreeWidgetItem* treeItem,
 	FENodeSet* pn = dynamic_cast<FENodeSet*>(po);
 	if (pn)
 	{
-		std::list<int> items = pn->CopyItems();
-		std::vector<int> vitems(items.begin(), items.end());
+		std::vector<int> vitems = pn->CopyItems();
 		doc->SetItemMode(ITEM_NODE);
 		doc->DoCommand(new CCmdSelectFENodes(pn->GetMesh(), vitems, false));
 	}
@@ -988,8 +987,7 @@ void CPostModelPanel::on_postModel_itemDoubleClicked(QTreeWidgetItem* treeItem,
 	FEEdgeSet* pe = dynamic_cast<FEEdgeSet*>(po);
 	if (pe)
 	{
-		std::list<int> items = pe->CopyItems();
-		std::vector<int> vitems(items.begin(), items.end());
+		std::vector<int> vitems = pe->CopyItems();
 		doc->SetItemMode(ITEM_EDGE);
 		doc->DoCommand(new CCmdSelectFEEdges(pe->GetMesh(), vitems, false));
 	}
@@ -997,8 +995,7 @@ void CPostModelPanel::on_postModel_itemDoubleClicked(QTreeWidgetItem* treeItem,
 	FESurface* ps = dynamic_cast<FESurface*>(po);
 	if (ps)
 	{
-		std::list<int> items = ps->CopyItems();
-		std::vector<int> vitems(items.begin(), items.end());
+		std::vector<int> vitems = ps->CopyItems();
 		doc->SetItemMode(ITEM_FACE);
 		doc->DoCommand(new CCmdSelectFaces(ps->GetMesh(), vitems, false));
 	}
@@ -1013,8 +1010,7 @@ void CPostModelPanel::on_postModel_itemDoubleClicked(QTreeWidgetItem* treeItem,
 	FEPart* pg = dynamic_cast<FEPart*>(po);
 	if (pg)
 	{
-		std::list<int> items = pg->CopyItems();
-		std::vector<int> vitems(items.begin(), items.end());
+		std::vector<int> vitems = pg->CopyItems();
 		doc->SetItemMode(ITEM_ELEM);
 		doc->DoCommand(new CCmdSelectElements(pg->GetMesh(), vitems, false));
 	}
@@ -1247,9 +1243,7 @@ void CPostModelPanel::OnSelectNodes()
 		CPostDocument* pdoc = GetActiveDocument();
 		FEMesh* mesh = pdoc->GetFEModel()->GetFEMesh(0);
 		pdoc->SetItemMode(ITEM_NODE);
-		list<int> items = pg2->CopyItems();
-		vector<int> pgl;
-		pgl.insert(pgl.begin(), items.begin(), items.end());
+		vector<int> pgl = pg2->CopyItems();
 		pdoc->DoCommand(new CCmdSelectFENodes(mesh, pgl, false));
 	}
 
@@ -1277,9 +1271,7 @@ void CPostModelPanel::OnSelectFaces()
 		CPostDocument* pdoc = GetActiveDocument();
 		FEMesh* mesh = pdoc->GetFEModel()->GetFEMesh(0);
 		pdoc->SetItemMode(ITEM_FACE);
-		list<int> items = pg2->CopyItems();
-		vector<int> pgl;
-		pgl.insert(pgl.begin(), items.begin(), items.end());
+		vector<int> pgl = pg2->CopyItems();
 		pdoc->DoCommand(new CCmdSelectFaces(mesh, pgl, false));
 	}
 
@@ -1305,9 +1297,7 @@ void CPostModelPanel::OnSelectElements()
 	if (pg2)
 	{
 		pdoc->SetItemMode(ITEM_ELEM);
-		list<int> items = pg2->CopyItems();
-		vector<int> pgl;
-		pgl.insert(pgl.begin(), items.begin(), items.end());
+		vector<int> pgl = pg2->CopyItems();
 		pdoc->DoCommand(new CCmdSelectElements(mesh, pgl, false));
 	}
 
@@ -1330,9 +1320,7 @@ void CPostModelPanel::OnHideElements()
 	::FEPart* pg2 = dynamic_cast<::FEPart*>(po);
 	if (pg2)
 	{
-		list<int> items = pg2->CopyItems();
-		vector<int> pgl;
-		pgl.insert(pgl.begin(), items.begin(), items.end());
+		vector<int> pgl = pg2->CopyItems();
 		pdoc->DoCommand(new CCmdHideElements(mesh, pgl));
 	}
 
@@ -360,8 +360,8 @@ bool PostSessionFileWriter::Write(const char* szfile)
 				el.add_attribute("name", pg->GetName());
 				xml.add_branch(el);
 				{
-					std::list<int> items = pg->CopyItems();
-					std::list<int>::iterator it = items.begin();
+					std::vector<int> items = pg->CopyItems();
+					std::vector<int>::iterator it = items.begin();
 					int N = items.size();
 					int l[16];
 					for (int n = 0; n < N; n += 16)
@@ -382,8 +382,8 @@ bool PostSessionFileWriter::Write(const char* szfile)
 				el.add_attribute("name", pg->GetName());
 				xml.add_branch(el);
 				{
-					std::list<int> items = pg->CopyItems();
-					std::list<int>::iterator it = items.begin();
+					std::vector<int> items = pg->CopyItems();
+					std::vector<int>::iterator it = items.begin();
 					int N = items.size();
 					int l[16];
 					for (int n = 0; n < N; n += 16)
@@ -404,8 +404,8 @@ bool PostSessionFileWriter::Write(const char* szfile)
 				el.add_attribute("name", pg->GetName());
 				xml.add_branch(el);
 				{
-					std::list<int> items = pg->CopyItems();
-					std::list<int>::iterator it = items.begin();
+					std::vector<int> items = pg->CopyItems();
+					std::vector<int>::iterator it = items.begin();
 					int N = items.size();
 					int l[16];
 					for (int n = 0; n < N; n += 16)
@@ -426,8 +426,8 @@ bool PostSessionFileWriter::Write(const char* szfile)
 				el.add_attribute("name", pg->GetName());
 				xml.add_branch(el);
 				{
-					std::list<int> items = pg->CopyItems();
-					std::list<int>::iterator it = items.begin();
+					std::vector<int> items = pg->CopyItems();
+					std::vector<int>::iterator it = items.begin();
 					int N = items.size();
 					int l[16];
 					for (int n = 0; n < N; n += 16)
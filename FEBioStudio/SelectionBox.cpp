@@ -358,30 +358,6 @@ void CSelectionBox::getAllNames(QStringList& names)
 	}
 }
 
-void CSelectionBox::getSelectedItems(list<int>& sel)
-{
-	if (ui->m_collapsed)
-	{
-		QListWidgetItem* w = ui->list->item(0);
-		if (w && w->isSelected())
-		{
-			for (int i = 0; i < m_items.size(); ++i) sel.push_back(m_items[i].m_data);
-		}
-	}
-	else
-	{
-		QModelIndexList selItems = ui->list->selectionModel()->selectedRows();
-		if (selItems.empty() == false)
-		{
-			for (QModelIndexList::iterator it = selItems.begin(); it != selItems.end(); ++it)
-			{
-				int row = it->row();
-				sel.push_back(m_items[row].m_data);
-			}
-		}
-	}
-}
-
 void CSelectionBox::removeSelectedItems()
 {
 	if (ui->m_collapsed == false)
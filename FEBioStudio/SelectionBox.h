@@ -70,7 +70,6 @@ public:
 	void removeData(const vector<int>& data);
 
 	void getSelectedItems(vector<int>& sel);
-	void getSelectedItems(list<int>& sel);
 
 	void removeSelectedItems();
 
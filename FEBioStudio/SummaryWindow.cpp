@@ -139,7 +139,7 @@ void CSummaryWindow::Update(bool breset, bool bfit)
 	// allocate data
 	vector<double> x(nsteps);
 	// add the data series
-	for (int i=0; i<nsteps; i++) x[i] = pfem->GetState(i)->m_time;
+	for (int i=0; i<nsteps; i++) x[i] = pfem->GetTimeValue(i);
 
 	CPlotData* dataMax = new CPlotData;
 	CPlotData* dataMin = new CPlotData;
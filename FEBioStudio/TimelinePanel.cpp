@@ -72,8 +72,8 @@ void CTimelinePanel::Update(bool reset)
 				int nstates = fem.GetStates();
 				for (int i = 0; i < nstates; ++i)
 				{
-					data[i].first = fem.GetState(i)->m_time;
-					data[i].second = fem.GetState(i)->m_status;
+					data[i].first = fem.GetTimeValue(i);
+					data[i].second = fem.GetStateStatus(i);
 				}
 
 				ui->timeline->setTimePoints(data);
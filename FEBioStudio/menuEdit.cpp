@@ -57,7 +57,10 @@ void CMainWindow::on_actionUndo_triggered()
 
 	if (doc->CanUndo())
 	{
-		doc->UndoCommand();
+		if (doc->UndoCommand() == false)
+		{
+			QMessageBox::critical(this, "FEBio Studio", QString("Undo failed:\n%1").arg(QString::fromStdString(doc->GetCommandErrorString())));
+		}
 		UpdateModel();
 		Update();
 	}
@@ -70,7 +73,10 @@ void CMainWindow::on_actionRedo_triggered()
 
 	if (doc->CanRedo())
 	{
-		doc->RedoCommand();
+		if (doc->RedoCommand() == false)
+		{
+			QMessageBox::critical(this, "FEBio Studio", QString("Redo failed:\n%1").arg(QString::fromStdString(doc->GetCommandErrorString())));
+		}
 		UpdateModel();
 		Update();
 	}
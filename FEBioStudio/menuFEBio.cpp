@@ -36,13 +36,6 @@ SOFTWARE.*/
 
 void CMainWindow::on_actionFEBioRun_triggered()
 {
-	// First, check that a job is not running yet
-	if (ui->m_process && (ui->m_process->state() != QProcess::NotRunning))
-	{
-		QMessageBox::information(this, "FEBio Studio", "An FEBio job is already running.\nYou must wait till the job is finished or stop it.");
-		return;
-	}
-
 	// name of last job that was run
 	static QString lastJobName;
 
@@ -126,6 +119,12 @@ void CMainWindow::on_actionFEBioRun_triggered()
 	dlg.ShowAdvancedSettings(showAdvancedSettings);
 	dlg.SetDebugFlag(debugFlag);
 
+	// run queue options
+	static bool addToQueue = false;
+	static int queueThreads = 1;
+	static int queuePriority = 0;
+	dlg.SetQueueOptions(addToQueue, queueThreads, queuePriority);
+
 	if (modelDoc && modelDoc->FEBioJobs() > 0)
 	{
 		CFEBioJob* job = modelDoc->GetFEBioJob(0);
@@ -147,6 +146,25 @@ void CMainWindow::on_actionFEBioRun_triggered()
 		showAdvancedSettings = dlg.AdvancedSettingsShown();
 		debugFlag = dlg.HasDebugFlag();
 
+		addToQueue = dlg.AddToQueue();
+		queueThreads = dlg.QueueThreads();
+		queuePriority = dlg.QueuePriority();
+
+		// Queued jobs run in the background, but only one other job can run at a time
+		if (addToQueue == false)
+		{
+			if (ui->m_process && (ui->m_process->state() != QProcess::NotRunning))
+			{
+				QMessageBox::information(this, "FEBio Studio", "An FEBio job is already running.\nYou must wait till the job is finished or stop it.");
+				return;
+			}
+		}
+		else if (ui->m_launch_configs.at(dlg.GetLaunchConfig()).type != LOCAL)
+		{
+			QMessageBox::information(this, "FEBio Studio", "Only jobs with a local launch configuration can be added to the run queue.");
+			return;
+		}
+
 		// get the working directory and job name
 		jobPath = dlg.GetWorkingDirectory();
 		jobName = dlg.GetJobName();
@@ -177,6 +195,20 @@ void CMainWindow::on_actionFEBioRun_triggered()
 			job = modelDoc->FindFEBioJob(jobName.toStdString());
 		}
 
+		// we can't touch a job's files while it's waiting or running
+		if (job && (ui->m_jobQueue->IsQueued(job) || ui->m_jobQueue->IsRunning(job)))
+		{
+			QMessageBox::information(this, "FEBio Studio", "This job is already in the run queue.");
+			return;
+		}
+
+		// nor while it is running interactively
+		if (job && (job == CFEBioJob::GetActiveJob()))
+		{
+			QMessageBox::information(this, "FEBio Studio", "This job is already running.\nYou must wait till the job is finished or stop it.");
+			return;
+		}
+
 		// update with the selected launch configuration index
 		lastLaunchConfigIndex = dlg.GetLaunchConfig();
 
@@ -242,7 +274,13 @@ void CMainWindow::on_actionFEBioRun_triggered()
 		}
 
 		// run the job
-		RunFEBioJob(job);
+		if (addToQueue)
+		{
+			ui->m_jobQueue->AddJob(job, queueThreads, queuePriority);
+			UpdateModel(job, false);
+			AddLogEntry(QString("Added FEBio job \"%1\" to the run queue (%2 running, %3 waiting)\n").arg(jobName).arg(ui->m_jobQueue->RunningJobs()).arg(ui->m_jobQueue->QueuedJobs()));
+		}
+		else RunFEBioJob(job);
 	}
 }
 
@@ -260,6 +298,13 @@ void CMainWindow::on_actionFEBioStop_triggered()
 			CFEBioJob::SetActiveJob(nullptr);
 		}
 	}
+	else if (ui->m_jobQueue->RunningJobs() + ui->m_jobQueue->QueuedJobs() > 0)
+	{
+		if (QMessageBox::question(this, "FEBio Studio", "Do you want to stop all jobs in the run queue?") == QMessageBox::Yes)
+		{
+			ui->m_jobQueue->CancelAll();
+		}
+	}
 	else QMessageBox::information(this, "FEBio Studio", "No FEBio job is running.");
 }
 
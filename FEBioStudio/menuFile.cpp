@@ -107,11 +107,13 @@ SOFTWARE.*/
 #include "FileThread.h"
 #include "DlgExportAscii.h"
 #include "DlgExportVTK.h"
+#include "DlgExportVTU.h"
 #include <PostLib/FEFEBioExport.h>
 #include <PostLib/FEAsciiExport.h>
 #include <PostLib/VRMLExporter.h>
 #include <PostLib/FENikeExport.h>
 #include <PostLib/FEVTKExport.h>
+#include <PostLib/FEVTUExport.h>
 #include <PostLib/FELSDYNAPlot.h>
 #include <PostLib/BYUExport.h>
 #include <PostLib/FEVTKImport.h>
@@ -909,7 +911,8 @@ void CMainWindow::SavePostDoc()
 		<< "NIKE3D files (*.n)"
 		<< "VTK files (*.vtk)"
 		<< "LSDYNA database (*.d3plot)"
-		<< "Abaqus files (*.inp)";
+		<< "Abaqus files (*.inp)"
+		<< "VTU files (*.vtu *.pvd)";
 
 	QFileDialog dlg(this, "Save");
 	dlg.setFileMode(QFileDialog::AnyFile);
@@ -1051,6 +1054,20 @@ void CMainWindow::SavePostDoc()
 			error = "Failed writing Abaqus file.";
 		}
 		break;
+		case 11:
+		{
+			CDlgExportVTU dlg(fem, this);
+			if (dlg.exec())
+			{
+				Post::FEVTUExport w;
+				w.ExportAllStates(dlg.m_allStates);
+				w.SetCompression(dlg.m_compress);
+				w.SetFieldSelection(dlg.m_fields);
+				bret = w.Save(fem, szfilename);
+				error = "Failed writing VTU file";
+			}
+		}
+		break;
 		default:
 			assert(false);
 			error = "Unknown file type";
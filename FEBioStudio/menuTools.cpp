@@ -40,9 +40,11 @@ SOFTWARE.*/
 #include "ModelDocument.h"
 #include "PostDocument.h"
 #include "DlgStartThread.h"
+#include "FileThread.h"
 #include <PostLib/FEKinemat.h>
 #include <PostLib/FELSDYNAimport.h>
 #include <PostGL/GLModel.h>
+#include <XPLTLib/xpltFileReader.h>
 
 void CMainWindow::on_actionCurveEditor_triggered()
 {
@@ -391,12 +393,17 @@ void CMainWindow::on_actionLayerInfo_triggered()
 
 void CMainWindow::onRunFinished(int exitCode, QProcess::ExitStatus es)
 {
+	ui->m_followTimer->stop();
+
 	CFEBioJob* job = CFEBioJob::GetActiveJob();
 	if (job)
 	{
 		job->SetStatus(exitCode == 0 ? CFEBioJob::COMPLETED : CFEBioJob::FAILED);
 		CFEBioJob::SetActiveJob(nullptr);
 
+		// if the plot file is already open, read the last states
+		bool followed = ReadNewJobStates(job, true);
+
 		QString sret = (exitCode == 0 ? "NORMAL TERMINATION" : "ERROR TERMINATION");
 		QString jobName = QString::fromStdString(job->GetName());
 		QString msg = QString("FEBio job \"%1 \" has finished:\n\n%2\n").arg(jobName).arg(sret);
@@ -404,7 +411,11 @@ void CMainWindow::onRunFinished(int exitCode, QProcess::ExitStatus es)
 		QString logmsg = QString("FEBio job \"%1 \" has finished: %2\n").arg(jobName).arg(sret);
 		AddLogEntry(logmsg);
 
-		if (exitCode == 0)
+		if ((exitCode == 0) && followed)
+		{
+			QMessageBox::information(this, "Run FEBio", msg);
+		}
+		else if (exitCode == 0)
 		{
 			msg += "\nDo you wish to load the results?";
 			if (QMessageBox::question(this, "Run FEBio", msg) == QMessageBox::Yes)
@@ -439,9 +450,100 @@ void CMainWindow::onReadyRead()
 	AddOutputEntry(s);
 }
 
+void CMainWindow::onQueuedJobStarted(CFEBioJob* job)
+{
+	QString jobName = QString::fromStdString(job->GetName());
+	AddLogEntry(QString("FEBio job \"%1\" started (output: %2)\n").arg(jobName).arg(CFEBioJobQueue::OutputFileName(job)));
+	UpdateModel(job, false);
+	UpdateTab(job->GetDocument());
+}
+
+void CMainWindow::onQueuedJobFinished(CFEBioJob* job, int exitCode)
+{
+	QString sret;
+	switch (job->GetStatus())
+	{
+	case CFEBioJob::COMPLETED: sret = "NORMAL TERMINATION"; break;
+	case CFEBioJob::CANCELLED: sret = "CANCELLED"; break;
+	default:
+		sret = "ERROR TERMINATION";
+	}
+
+	QString jobName = QString::fromStdString(job->GetName());
+	AddLogEntry(QString("FEBio job \"%1\" has finished: %2\n").arg(jobName).arg(sret));
+	UpdateModel(job, false);
+	UpdateTab(job->GetDocument());
+
+	if ((ui->m_jobQueue->QueuedJobs() == 0) && (ui->m_jobQueue->RunningJobs() == 0))
+		AddLogEntry("All jobs in the run queue have finished.\n");
+}
+
+void CMainWindow::onFollowTimer()
+{
+	CFEBioJob* job = CFEBioJob::GetActiveJob();
+	if ((job == nullptr) || (ui->m_process == nullptr))
+	{
+		ui->m_followTimer->stop();
+		return;
+	}
+	ReadNewJobStates(job);
+}
+
+// If the plot file of the job is open and followed, read the states that were added since
+// the last time. If the file can no longer be followed (e.g. it was overwritten), it is reloaded.
+// Returns false if the plot file is not open, or can't be followed.
+bool CMainWindow::ReadNewJobStates(CFEBioJob* job, bool stopFollowing)
+{
+	if (job == nullptr) return false;
+
+	CPostDocument* doc = dynamic_cast<CPostDocument*>(FindDocument(job->GetPlotFileName()));
+	if ((doc == nullptr) || (doc->IsValid() == false)) return false;
+
+	// wait if the document is queued for reloading
+	for (QueuedFile& qf : m_fileQueue) if (qf.m_doc == doc) return false;
+
+	xpltFileReader* xplt = dynamic_cast<xpltFileReader*>(doc->GetFileReader());
+	if ((xplt == nullptr) || (xplt->IsFollowing() == false)) return false;
+
+	int oldStates = doc->GetStates();
+	int newStates = xplt->ReadNewStates();
+	if (stopFollowing || (newStates < 0)) xplt->StopFollowing();
+	if (newStates < 0)
+	{
+		// reload the file, and keep following it if the job is still running
+		QString fileName = QString::fromStdString(job->GetPlotFileName());
+		AddLogEntry(QString("Reloading %1\n").arg(fileName));
+		if (stopFollowing == false) xplt->SetFollowMode(true);
+		ReadFile(doc, fileName, xplt, QueuedFile::RELOAD_DOCUMENT);
+		return true;
+	}
+
+	if (newStates > 0)
+	{
+		// extend the time range and keep showing the last state, if we were doing so already
+		int states = doc->GetStates();
+		TIMESETTINGS& time = doc->GetTimeSettings();
+		if (time.m_end == oldStates - 1) time.m_end = states - 1;
+		if (doc->GetActiveState() == oldStates - 1) doc->SetActiveState(states - 1);
+		else doc->UpdateFEModel();
+
+		if (GetDocument() == doc)
+		{
+			UpdatePostToolbar();
+			if (ui->timePanel && ui->timePanel->isVisible()) ui->timePanel->Update(false);
+			UpdateGraphs(false);
+			RedrawGL();
+		}
+	}
+
+	return true;
+}
+
 void CMainWindow::onErrorOccurred(QProcess::ProcessError err)
 {
 	// make sure we don't have an active job since onRunFinished will not be called!
+	ui->m_followTimer->stop();
+	ReadNewJobStates(CFEBioJob::GetActiveJob(), true);
 	CFEBioJob::SetActiveJob(nullptr);
 
 	// suppress an error if user stopped FEBio job
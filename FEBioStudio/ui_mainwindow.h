@@ -71,6 +71,7 @@ SOFTWARE.*/
 #include "UpdateChecker.h"
 #include "XMLEditor.h"
 #include "WebDefines.h"
+#include "FEBioJobQueue.h"
 
 #include <vector>
 
@@ -251,6 +252,8 @@ public:
 	QProcess*	m_process;
 	bool		m_bkillProcess;
 
+	CFEBioJobQueue*	m_jobQueue;	// runs local jobs concurrently
+
 	int			m_theme;	// 0 = default, 1 = dark
 	bool		m_clearUndoOnSave;
 
@@ -265,6 +268,8 @@ public:
 	QTimer* m_autoSaveTimer;
 	int m_autoSaveInterval;
 
+	QTimer* m_followTimer;	// reads new states from the plot file of a running job
+
 	int		m_defaultUnits;
 
 	CUpdateWidget m_updateWidget;
@@ -309,6 +314,8 @@ public:
 		m_process = 0;
 		m_bkillProcess = false;
 
+		m_jobQueue = new CFEBioJobQueue(wnd);
+
 		m_isAnimating = false;
 
 		curveWnd = 0;
@@ -49,7 +49,8 @@ SOFTWARE.*/
 // 3.12: Added shell nodal normal flag to GPart
 // 3.13: Added "relative" flag to FERigidDisplacement. 
 // 3.14: Added additional meshing parameters to FEQuartDogBone.
-#define SAVE_VERSION	0x0003000E
+// 3.15: Mesh nodes, elements, faces, and edges are stored as bulk arrays.
+#define SAVE_VERSION	0x0003000F
 
 // lowest supported version number
 #define MIN_PRV_VERSION	0x0001000D
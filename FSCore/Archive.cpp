@@ -30,6 +30,24 @@ SOFTWARE.*/
 #include "zlib.h"
 static z_stream strm;
 
+#ifdef WIN32
+#define ftell64(a)     _ftelli64(a)
+#define fseek64(a,b,c) _fseeki64(a,b,c)
+#endif
+
+#ifdef LINUX // same for Linux and Mac OS X
+#define ftell64(a)     ftello(a)
+#define fseek64(a,b,c) fseeko(a,b,c)
+#endif
+
+#ifdef __APPLE__ // same for Linux and Mac OS X
+#define ftell64(a)     ftello(a)
+#define fseek64(a,b,c) fseeko(a,b,c)
+#endif
+
+// size of the (uncompressed) blocks of bulk arrays
+#define ARRAY_BLOCK_SIZE	1048576		// = 1M
+
 using std::stringstream;
 
 //=============================================================================
@@ -82,6 +100,7 @@ IOFileStream::IOFileStream(FILE* fp, bool owner)
 {
 	m_bufsize = 262144;	// = 256K
 	m_current = 0;
+	m_flushed = 0;
 	m_buf = new unsigned char[m_bufsize];
 	m_pout = new unsigned char[m_bufsize];
 	m_ncompress = 0;
@@ -114,6 +133,8 @@ bool IOFileStream::Append(const char* szfile)
 bool IOFileStream::Create(const char* szfile)
 {
 	m_fp = fopen(szfile, "wb");
+	m_current = 0;
+	m_flushed = 0;
 	return (m_fp != 0);
 }
 
@@ -210,6 +231,7 @@ void IOFileStream::Flush()
 	else
 	{
 		if (m_fp) fwrite(m_buf, m_current, 1, m_fp);
+		m_flushed += m_current;
 	}
 
 	// flush the file
@@ -219,6 +241,32 @@ void IOFileStream::Flush()
 	m_current = 0;
 }
 
+void IOFileStream::Overwrite(size_t pos, const void* pd, size_t nsize)
+{
+	assert(m_ncompress == 0);
+	const unsigned char* pdata = (const unsigned char*)pd;
+
+	// the part that was already flushed to the file
+	if (pos < m_flushed)
+	{
+		size_t n = m_flushed - pos;
+		if (n > nsize) n = nsize;
+		fseek64(m_fp, pos, SEEK_SET);
+		fwrite(pdata, 1, n, m_fp);
+		fseek64(m_fp, 0, SEEK_END);
+		pos += n;
+		pdata += n;
+		nsize -= n;
+	}
+
+	// the part that is still in the buffer
+	if (nsize > 0)
+	{
+		assert(pos + nsize <= m_flushed + m_current);
+		memcpy(m_buf + (pos - m_flushed), pdata, nsize);
+	}
+}
+
 size_t IOFileStream::read(void* pd, size_t Size, size_t Count)
 {
 	return fread(pd, Size, Count, m_fp);
@@ -412,6 +460,67 @@ IArchive::IOResult IArchive::read(std::vector<double>& v)
 	return IO_OK;
 }
 
+IArchive::IOResult IArchive::ReadArray(std::function<void* (size_t)> alloc)
+{
+	int format = ARRAY_FORMAT_RAW;
+	unsigned long long nsize = 0;
+	bool hasData = false;
+	while (OpenChunk() == IO_OK)
+	{
+		switch (GetChunkID())
+		{
+		case CID_ARRAY_FORMAT: read(format); break;
+		case CID_ARRAY_SIZE: 
+			if (fread(&nsize, sizeof(nsize), 1, m_fp) != 1) return IO_ERROR;
+			if (m_bswap) bswap(nsize);
+			break;
+		case CID_ARRAY_DATA:
+			{
+				hasData = true;
+				unsigned char* pd = (unsigned char*)alloc((size_t)nsize);
+				if ((nsize > 0) && (pd == nullptr)) return IO_ERROR;
+				if (format == ARRAY_FORMAT_RAW)
+				{
+					if (fread(pd, 1, (size_t)nsize, m_fp) != nsize) return IO_ERROR;
+				}
+				else if (format == ARRAY_FORMAT_ZLIB)
+				{
+					// each block is stored as (uncompressed size, compressed size, compressed data)
+					std::vector<unsigned char> zbuf;
+					unsigned long long n = 0;
+					while (n < nsize)
+					{
+						unsigned int nraw = 0, nz = 0;
+						if (read(nraw) != IO_OK) return IO_ERROR;
+						if (read(nz) != IO_OK) return IO_ERROR;
+						if (n + nraw > nsize) return IO_ERROR;
+
+						zbuf.resize(nz);
+						if (fread(&zbuf[0], 1, nz, m_fp) != nz) return IO_ERROR;
+
+						uLongf ndst = nraw;
+						if (uncompress(pd + n, &ndst, &zbuf[0], nz) != Z_OK) return IO_ERROR;
+						if (ndst != nraw) return IO_ERROR;
+						n += nraw;
+					}
+				}
+				else return IO_ERROR;
+			}
+			break;
+		}
+		CloseChunk();
+	}
+
+	// empty arrays don't have a data chunk
+	if (hasData == false)
+	{
+		if (nsize != 0) return IO_ERROR;
+		alloc(0);
+	}
+
+	return IO_OK;
+}
+
 void IArchive::log(const char* sz, ...)
 {
 	if (sz == 0) return;
@@ -445,8 +554,10 @@ std::string IArchive::GetLog() const
 
 OArchive::OArchive()
 {
-	m_pRoot = 0;
-	m_pChunk = 0;
+	m_ncompress = 0;
+	m_arraySize = 0;
+	m_arrayEmpty = true;
+	m_blockSize = 0;
 }
 
 OArchive::~OArchive()
@@ -458,13 +569,10 @@ void OArchive::Close()
 {
 	if (m_fp.IsValid())
 	{
-		m_pRoot->Write(&m_fp);
+		// close all open chunks (including the root)
+		while (m_chunk.empty() == false) EndChunk();
 		m_fp.Close();
 	}
-
-	delete m_pRoot;
-	m_pRoot = 0;
-	m_pChunk = 0;
 }
 
 bool OArchive::Create(const char* szfile, unsigned int signature)
@@ -475,26 +583,110 @@ bool OArchive::Create(const char* szfile, unsigned int signature)
 	// write the master tag 
 	m_fp.Write(&signature, sizeof(int), 1);
 
-	assert(m_pRoot == 0);
-	m_pRoot = new OBranch(0);
-	m_pChunk = m_pRoot;
+	// open the root chunk
+	assert(m_chunk.empty());
+	BeginChunk(0);
 
 	return true;
 }
 
+void OArchive::WriteHeader(unsigned int nid, unsigned int nsize)
+{
+	m_fp.Write(&nid, sizeof(unsigned int), 1);
+	m_fp.Write(&nsize, sizeof(unsigned int), 1);
+}
+
 void OArchive::BeginChunk(unsigned int id)
 {
-	// create a new branch
-	OBranch* pbranch = new OBranch(id);
+	// write the header. The size is filled in when the chunk is closed.
+	m_fp.Write(&id, sizeof(unsigned int), 1);
+	m_chunk.push(m_fp.Position());
+	unsigned int nsize = 0;
+	m_fp.Write(&nsize, sizeof(unsigned int), 1);
+}
 
-	// attach it to the current branch
-	m_pChunk->AddChild(pbranch);
+void OArchive::EndChunk()
+{
+	assert(m_chunk.empty() == false);
+	size_t pos = m_chunk.top(); m_chunk.pop();
 
-	// move the current branch pointer
-	m_pChunk = pbranch;
+	size_t nsize = m_fp.Position() - pos - sizeof(unsigned int);
+	assert(nsize <= 0xFFFFFFFF);
+	unsigned int n = (unsigned int)nsize;
+	m_fp.Overwrite(pos, &n, sizeof(unsigned int));
 }
 
-void OArchive::EndChunk()
+void OArchive::BeginArray(unsigned int nid, size_t nsize)
 {
-	m_pChunk = m_pChunk->GetParent();
+	int format = (m_ncompress > 0 ? ARRAY_FORMAT_ZLIB : ARRAY_FORMAT_RAW);
+	unsigned long long nbytes = nsize;
+
+	// NOTE: The data chunk is omitted for empty arrays, since empty leaf chunks are not read correctly.
+	BeginChunk(nid);
+	WriteChunk(CID_ARRAY_FORMAT, format);
+	WriteChunk(CID_ARRAY_SIZE, nbytes);
+	if (nsize > 0) BeginChunk(CID_ARRAY_DATA);
+
+	m_arraySize = nsize;
+	m_arrayEmpty = (nsize == 0);
+	m_blockSize = 0;
+	if ((m_ncompress > 0) && (nsize > 0))
+	{
+		m_block.resize(ARRAY_BLOCK_SIZE);
+		m_zblock.resize(compressBound(ARRAY_BLOCK_SIZE));
+	}
+}
+
+void OArchive::WriteArrayData(const void* pd, size_t nsize)
+{
+	assert(nsize <= m_arraySize);
+	m_arraySize -= nsize;
+
+	if (m_ncompress == 0)
+	{
+		m_fp.Write((void*)pd, 1, nsize);
+		return;
+	}
+
+	// collect the data in blocks and compress each full block
+	const unsigned char* pdata = (const unsigned char*)pd;
+	while (nsize > 0)
+	{
+		size_t n = ARRAY_BLOCK_SIZE - m_blockSize;
+		if (n > nsize) n = nsize;
+		memcpy(&m_block[m_blockSize], pdata, n);
+		m_blockSize += n;
+		pdata += n;
+		nsize -= n;
+
+		if (m_blockSize == ARRAY_BLOCK_SIZE) FlushArrayBlock();
+	}
+}
+
+void OArchive::FlushArrayBlock()
+{
+	if (m_blockSize == 0) return;
+
+	uLongf nz = (uLongf)m_zblock.size();
+	int ret = compress2(&m_zblock[0], &nz, &m_block[0], (uLong)m_blockSize, m_ncompress);
+	assert(ret == Z_OK);
+
+	unsigned int nraw = (unsigned int)m_blockSize;
+	unsigned int nzip = (unsigned int)nz;
+	m_fp.Write(&nraw, sizeof(unsigned int), 1);
+	m_fp.Write(&nzip, sizeof(unsigned int), 1);
+	m_fp.Write(&m_zblock[0], 1, nz);
+
+	m_blockSize = 0;
+}
+
+void OArchive::EndArray()
+{
+	assert(m_arraySize == 0);
+	if (m_ncompress > 0) FlushArrayBlock();
+	m_block.clear();
+	m_zblock.clear();
+
+	if (m_arrayEmpty == false) EndChunk();	// CID_ARRAY_DATA
+	EndChunk();	// array
 }
@@ -35,6 +35,8 @@ SOFTWARE.*/
 #include <list>
 #include <string>
 #include "memtool.h"
+#include <vector>
+#include <functional>
 //using namespace std;
 
 using std::string;
@@ -79,6 +81,12 @@ public:
 
 	void Flush();
 
+	// number of bytes written since the file was created (only for uncompressed streams)
+	size_t Position() const { return m_flushed + m_current; }
+
+	// overwrite data that was written earlier (only for uncompressed streams)
+	void Overwrite(size_t pos, const void* pd, size_t nsize);
+
 	// \todo temporary reading functions. Needs to be replaced with buffered functions
 	size_t read(void* pd, size_t Size, size_t Count);
 	long tell();
@@ -98,11 +106,22 @@ private:
 	bool	m_fileOwner;
 	size_t	m_bufsize;		//!< buffer size
 	size_t	m_current;		//!< current index
+	size_t	m_flushed;		//!< number of bytes flushed to file
 	unsigned char*	m_buf;	//!< buffer
 	unsigned char*	m_pout;	//!< temp buffer when writing
 	int		m_ncompress;	//!< compression level
 };
 
+//-----------------------------------------------------------------------------
+// chunk IDs of the bulk arrays written with OArchive::WriteArray
+#define CID_ARRAY_FORMAT	0x00000001
+#define CID_ARRAY_SIZE		0x00000002
+#define CID_ARRAY_DATA		0x00000003
+
+// formats of bulk arrays
+#define ARRAY_FORMAT_RAW	0		// uncompressed data
+#define ARRAY_FORMAT_ZLIB	1		// blocks of zlib-compressed data
+
 //----------------------
 // Input archive
 
@@ -200,6 +219,18 @@ public:
 	IOResult read(std::vector<int>& v);
 	IOResult read(std::vector<double>& v);
 
+	// Read an array that was written with OArchive::WriteArray. 
+	// The alloc function is called with the array size (in bytes) and must return a buffer of that size.
+	IOResult ReadArray(std::function<void* (size_t)> alloc);
+
+	template <class T> IOResult ReadArray(std::vector<T>& v)
+	{
+		return ReadArray([&](size_t nbytes) -> void* {
+			v.resize(nbytes / sizeof(T));
+			return (v.empty() ? nullptr : &v[0]);
+		});
+	}
+
 	template <class T>
 	IOResult read(std::vector<T>& v)
 	{
@@ -399,6 +430,9 @@ protected:
 	int		m_nsize;
 };
 
+//-----------------------------------------------------------------------------
+// The output archive writes the chunks directly to the file. The size of a 
+// chunk is written when the chunk is closed. 
 class OArchive  
 {
 public:
@@ -419,32 +453,75 @@ public:
 
 	void WriteChunk(unsigned int nid, char* sz)
 	{
-		m_pChunk->AddChild(new OLeaf<const char*>(nid, sz));
+		WriteChunk(nid, (const char*)sz);
 	}
 
 	void WriteChunk(unsigned int nid, const char* sz)
 	{
-		m_pChunk->AddChild(new OLeaf<const char*>(nid, sz));
+		int l = (int)strlen(sz);
+		unsigned int nsize = l + sizeof(int);
+		WriteHeader(nid, nsize);
+		m_fp.Write(&l, sizeof(int), 1);
+		m_fp.Write((void*)sz, sizeof(char), l);
 	}
 
 	void WriteChunk(unsigned int nid, const string& s)
 	{
-		m_pChunk->AddChild(new OLeaf<const char*>(nid, s.c_str()));
+		WriteChunk(nid, s.c_str());
 	}
 
 	template <typename T> void WriteChunk(unsigned int nid, T* po, int n)
 	{
-		m_pChunk->AddChild(new OLeaf<T*>(nid, po, n));
+		assert(n > 0);
+		WriteHeader(nid, sizeof(T)*n);
+		m_fp.Write((void*)po, sizeof(T), n);
+	}
+
+	template <typename T> void WriteChunk(unsigned int nid, const std::vector<T>& a)
+	{
+		assert(a.empty() == false);
+		WriteHeader(nid, (unsigned int)(sizeof(T)*a.size()));
+		if (a.empty() == false) m_fp.Write((void*)&a[0], sizeof(T), a.size());
 	}
 
 	template <typename T> void WriteChunk(unsigned int nid, const T& o)
 	{
-		m_pChunk->AddChild(new OLeaf<T>(nid, o));
+		WriteHeader(nid, sizeof(T));
+		m_fp.Write((void*)&o, sizeof(T), 1);
+	}
+
+public:
+	// Set the compression level (0 - 9) of bulk arrays. Zero turns compression off.
+	void SetCompression(int n) { m_ncompress = n; }
+
+	// Write a bulk array. The data is passed in one or more calls to WriteArrayData
+	// between BeginArray and EndArray. The total size (in bytes) must be known in advance.
+	void BeginArray(unsigned int nid, size_t nsize);
+	void WriteArrayData(const void* pd, size_t nsize);
+	void EndArray();
+
+	template <typename T> void WriteArray(unsigned int nid, const std::vector<T>& a)
+	{
+		size_t nsize = sizeof(T)*a.size();
+		BeginArray(nid, nsize);
+		if (nsize > 0) WriteArrayData(&a[0], nsize);
+		EndArray();
 	}
 
+protected:
+	void WriteHeader(unsigned int nid, unsigned int nsize);
+
+	void FlushArrayBlock();
+
 protected:
 	IOFileStream	m_fp;		// the file pointer
 
-	OBranch*	m_pRoot;	// chunk tree root
-	OBranch*	m_pChunk;	// current chunk
+	stack<size_t>	m_chunk;	// file positions of the size fields of open chunks
+
+	int				m_ncompress;	// compression level of bulk arrays
+	size_t			m_arraySize;	// remaining bytes of current array
+	bool			m_arrayEmpty;	// current array has no data
+	std::vector<unsigned char>	m_block;	// uncompressed block data
+	std::vector<unsigned char>	m_zblock;	// compressed block data
+	size_t			m_blockSize;	// bytes in current block
 };
@@ -287,6 +287,10 @@ SOFTWARE.*/
 #define CID_MESH_SURFACE			0x00090011
 #define CID_MESH_NODESET			0x00090012
 #define CID_MESH_PARAMS				0x00090013
+#define CID_MESH_NODE_ARRAYS		0x00090014		// bulk array sections (3.15)
+#define CID_MESH_ELEMENT_ARRAYS		0x00090015
+#define CID_MESH_FACE_ARRAYS		0x00090016
+#define CID_MESH_EDGE_ARRAYS		0x00090017
 
 #define CID_MESH_NODE				0x00090100
 #define CID_MESH_NODE_GID			0x00090101
@@ -64,6 +64,15 @@ void inline bswap(double& g)
 	c[3] ^= c[4]; c[4] ^= c[3]; c[3] ^= c[4];
 }
 
+void inline bswap(unsigned long long& n)
+{
+	unsigned char* c = (unsigned char*)(&n);
+	c[0] ^= c[7]; c[7] ^= c[0]; c[0] ^= c[7];
+	c[1] ^= c[6]; c[6] ^= c[1]; c[1] ^= c[6];
+	c[2] ^= c[5]; c[5] ^= c[2]; c[2] ^= c[5];
+	c[3] ^= c[4]; c[4] ^= c[3]; c[3] ^= c[4];
+}
+
 template <typename T> void bswapv(T* pd, int n)
 {
 	for (int i = 0; i<n; ++i) bswap(pd[i]);
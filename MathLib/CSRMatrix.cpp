@@ -0,0 +1,99 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#include "CSRMatrix.h"
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+CSRMatrix::CSRMatrix() : m_nrows(0)
+{
+	m_off.assign(1, 0);
+}
+
+//-----------------------------------------------------------------------------
+void CSRMatrix::Clear()
+{
+	m_nrows = 0;
+	m_off.assign(1, 0);
+	m_col.clear();
+	m_val.clear();
+}
+
+//-----------------------------------------------------------------------------
+void CSRMatrix::Create(int N, const vector<int>& rowOffsets, const vector<int>& columns)
+{
+	m_nrows = N;
+	m_off = rowOffsets;
+	m_col = columns;
+	m_val.assign(m_col.size(), 0.0);
+}
+
+//-----------------------------------------------------------------------------
+void CSRMatrix::zero()
+{
+	std::fill(m_val.begin(), m_val.end(), 0.0);
+}
+
+//-----------------------------------------------------------------------------
+int CSRMatrix::find(int i, int j) const
+{
+	const int* c0 = Columns() + m_off[i];
+	const int* c1 = Columns() + m_off[i + 1];
+	const int* c = std::lower_bound(c0, c1, j);
+	if ((c == c1) || (*c != j)) return -1;
+	return m_off[i] + (int)(c - c0);
+}
+
+//-----------------------------------------------------------------------------
+bool CSRMatrix::add(int i, int j, double v)
+{
+	int k = find(i, j);
+	if (k < 0) return false;
+	m_val[k] += v;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+double CSRMatrix::diag(int i) const
+{
+	int k = find(i, i);
+	return (k < 0 ? 0.0 : m_val[k]);
+}
+
+//-----------------------------------------------------------------------------
+void CSRMatrix::mult(const vector<double>& x, vector<double>& y) const
+{
+	const int* off = RowOffsets();
+	const int* col = Columns();
+	const double* val = Values();
+#pragma omp parallel for schedule(static, 1024)
+	for (int i = 0; i < m_nrows; ++i)
+	{
+		double s = 0.0;
+		for (int k = off[i]; k < off[i + 1]; ++k) s += val[k] * x[col[k]];
+		y[i] = s;
+	}
+}
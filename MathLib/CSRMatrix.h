@@ -0,0 +1,82 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#pragma once
+#include <vector>
+
+using std::vector;
+
+//=============================================================================
+//! This class implements a sparse matrix in compressed row storage (CSR).
+
+//! All entries of a row are stored (i.e. symmetric matrices are not compressed)
+//! and the column indices of a row must be sorted.
+
+class CSRMatrix
+{
+public:
+	CSRMatrix();
+
+	// clear all data
+	void Clear();
+
+	// create the sparsity pattern of a N x N matrix
+	// rowOffsets has N+1 entries, columns has rowOffsets[N] entries
+	void Create(int N, const vector<int>& rowOffsets, const vector<int>& columns);
+
+	// return matrix size
+	int Rows() const { return m_nrows; }
+
+	// return number of stored entries
+	int NonZeroes() const { return (int)m_val.size(); }
+
+	// set all values to zero
+	void zero();
+
+	// find the index of entry (i,j) or -1 if it is not part of the sparsity pattern
+	int find(int i, int j) const;
+
+	// add to an entry of the sparsity pattern
+	bool add(int i, int j, double v);
+
+	// return diagonal value
+	double diag(int i) const;
+
+	// calculate y = A*x
+	void mult(const vector<double>& x, vector<double>& y) const;
+
+public:
+	const int* RowOffsets() const { return &m_off[0]; }
+	const int* Columns() const { return (m_col.empty() ? nullptr : &m_col[0]); }
+	double* Values() { return (m_val.empty() ? nullptr : &m_val[0]); }
+	const double* Values() const { return (m_val.empty() ? nullptr : &m_val[0]); }
+
+protected:
+	int				m_nrows;
+	vector<int>		m_off;	//!< row offsets
+	vector<int>		m_col;	//!< column indices
+	vector<double>	m_val;	//!< matrix values
+};
@@ -0,0 +1,386 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#include "stdafx.h"
+#include "MathExpression.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+//-----------------------------------------------------------------------------
+CMathExpression::CMathExpression()
+{
+	m_stackSize = 0;
+	m_bvalid = false;
+	m_sz = nullptr;
+	m_tok = END;
+	m_num = 0.0;
+	m_depth = 0;
+}
+
+//-----------------------------------------------------------------------------
+int CMathExpression::AddVariable(const std::string& name)
+{
+	for (size_t i = 0; i < m_var.size(); ++i)
+		if (m_var[i] == name) return (int)i;
+	m_var.push_back(name);
+	m_bvalid = false;
+	return (int)m_var.size() - 1;
+}
+
+//-----------------------------------------------------------------------------
+bool CMathExpression::Compile(const std::string& expr)
+{
+	m_prg.clear();
+	m_const.clear();
+	m_fnc1.clear();
+	m_fnc2.clear();
+	m_err.clear();
+	m_stackSize = 0;
+	m_bvalid = false;
+
+	m_sz = expr.c_str();
+	m_depth = 0;
+	if (this->expr() == false) return false;
+	if (m_tok != END) return error("unexpected character");
+
+	// figure out how much stack space we need
+	int sp = 0;
+	for (const Instruction& ins : m_prg)
+	{
+		switch (ins.op)
+		{
+		case OP_CONST: case OP_VAR: sp++; break;
+		case OP_NEG: case OP_FNC1: break;
+		default:
+			sp--;
+		}
+		if (sp > m_stackSize) m_stackSize = sp;
+	}
+	if (sp != 1) return error("invalid expression");
+
+	m_bvalid = true;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool CMathExpression::error(const char* sz)
+{
+	if (m_err.empty()) m_err = sz;
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+CMathExpression::Token CMathExpression::nextToken()
+{
+	while ((*m_sz == ' ') || (*m_sz == '\t')) m_sz++;
+
+	char ch = *m_sz;
+	switch (ch)
+	{
+	case 0:
+		return m_tok = END;
+	case '^': case '*': case '/': case '+': case '-': case '(': case ')': case ',':
+		m_sz++;
+		return m_tok = Token(ch);
+	default:
+		if (isdigit(ch) || (ch == '.'))
+		{
+			char* end = nullptr;
+			m_num = strtod(m_sz, &end);
+			if (end == m_sz) { m_sz++; error("bad token"); return m_tok = BAD; }
+			m_sz = end;
+			return m_tok = NUMBER;
+		}
+		else if (isalpha(ch))
+		{
+			m_name.clear();
+			while (isalnum(*m_sz)) m_name += *m_sz++;
+			return m_tok = NAME;
+		}
+	}
+	m_sz++;
+	error("bad token");
+	return m_tok = BAD;
+}
+
+//-----------------------------------------------------------------------------
+// add and subtract
+bool CMathExpression::expr()
+{
+	if (term() == false) return false;
+	for (;;)
+	{
+		switch (m_tok)
+		{
+		case PLUS : if (term() == false) return false; emit(OP_ADD); break;
+		case MINUS: if (term() == false) return false; emit(OP_SUB); break;
+		default:
+			return true;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// multiply and divide
+bool CMathExpression::term()
+{
+	if (power() == false) return false;
+	for (;;)
+	{
+		switch (m_tok)
+		{
+		case MUL: if (power() == false) return false; emit(OP_MUL); break;
+		case DIV: if (power() == false) return false; emit(OP_DIV); break;
+		default:
+			return true;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// power (left-associative, as in CMathParser)
+bool CMathExpression::power()
+{
+	if (prim() == false) return false;
+	while (m_tok == POW)
+	{
+		if (prim() == false) return false;
+		emit(OP_POW);
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// primaries
+bool CMathExpression::prim()
+{
+	nextToken();
+	switch (m_tok)
+	{
+	case NUMBER:
+		emitConst(m_num);
+		nextToken();
+		return true;
+	case NAME:
+	{
+		std::string name = m_name;
+
+		// variables
+		for (size_t i = 0; i < m_var.size(); ++i)
+		{
+			if (m_var[i] == name)
+			{
+				emit(OP_VAR, (int)i);
+				nextToken();
+				return true;
+			}
+		}
+
+		// constants
+		if (name == "pi") { emitConst(3.1415926535897932385); nextToken(); return true; }
+		if (name == "e" ) { emitConst(2.7182818284590452354); nextToken(); return true; }
+
+		// functions
+		FNC1 f1 = nullptr;
+		FNC2 f2 = nullptr;
+		if      (name == "cos"  ) f1 = cos;
+		else if (name == "sin"  ) f1 = sin;
+		else if (name == "tan"  ) f1 = tan;
+		else if (name == "ln"   ) f1 = log;
+		else if (name == "log"  ) f1 = log10;
+		else if (name == "sqrt" ) f1 = sqrt;
+		else if (name == "exp"  ) f1 = exp;
+		else if (name == "atan2") f2 = atan2;
+		else return error("unknown variable or function name");
+
+		if (nextToken() != LP) return error("'(' expected");
+		if (expr() == false) return false;
+		if (f2)
+		{
+			if (m_tok != COMMA) return error("',' expected");
+			if (expr() == false) return false;
+		}
+		if (m_tok != RP) return error("')' expected");
+		nextToken(); // eat ')'
+
+		if (f1) { m_fnc1.push_back(f1); emit(OP_FNC1, (int)m_fnc1.size() - 1); }
+		else { m_fnc2.push_back(f2); emit(OP_FNC2, (int)m_fnc2.size() - 1); }
+		return true;
+	}
+	case MINUS:
+		if (prim() == false) return false;
+		emit(OP_NEG);
+		return true;
+	case LP:
+		if (++m_depth > 256) return error("expression too complex");
+		if (expr() == false) return false;
+		m_depth--;
+		if (m_tok != RP) return error("')' expected");
+		nextToken(); // eat ')'
+		return true;
+	case BAD:
+		return error("bad token");
+	default:
+		return error("primary expected");
+	}
+}
+
+//-----------------------------------------------------------------------------
+void CMathExpression::emitConst(double v)
+{
+	m_const.push_back(v);
+	Instruction ins = { OP_CONST, (int)m_const.size() - 1 };
+	m_prg.push_back(ins);
+}
+
+//-----------------------------------------------------------------------------
+// Add an instruction. Operations on constants are evaluated right away.
+void CMathExpression::emit(OpCode op, int n)
+{
+	size_t N = m_prg.size();
+	if ((op == OP_NEG) || (op == OP_FNC1))
+	{
+		if ((N >= 1) && (m_prg[N - 1].op == OP_CONST))
+		{
+			double& a = m_const[m_prg[N - 1].n];
+			a = (op == OP_NEG ? -a : m_fnc1[n](a));
+			return;
+		}
+	}
+	else if ((op != OP_CONST) && (op != OP_VAR))
+	{
+		if ((N >= 2) && (m_prg[N - 1].op == OP_CONST) && (m_prg[N - 2].op == OP_CONST))
+		{
+			double& a = m_const[m_prg[N - 2].n];
+			double b = m_const[m_prg[N - 1].n];
+			switch (op)
+			{
+			case OP_ADD: a += b; break;
+			case OP_SUB: a -= b; break;
+			case OP_MUL: a *= b; break;
+			case OP_DIV: a /= b; break;
+			case OP_POW: a = pow(a, b); break;
+			case OP_FNC2: a = m_fnc2[n](a, b); break;
+			default:
+				break;
+			}
+			m_prg.pop_back();
+			return;
+		}
+	}
+
+	Instruction ins = { op, n };
+	m_prg.push_back(ins);
+}
+
+//-----------------------------------------------------------------------------
+double CMathExpression::Eval(const double* vars) const
+{
+	if (m_bvalid == false) return 0.0;
+
+	double buf[32];
+	std::vector<double> tmp;
+	double* s = buf;
+	if (m_stackSize > 32) { tmp.resize(m_stackSize); s = tmp.data(); }
+
+	int sp = -1;
+	for (const Instruction& ins : m_prg)
+	{
+		switch (ins.op)
+		{
+		case OP_CONST: s[++sp] = m_const[ins.n]; break;
+		case OP_VAR  : s[++sp] = vars[ins.n]; break;
+		case OP_NEG  : s[sp] = -s[sp]; break;
+		case OP_ADD  : s[sp - 1] += s[sp]; sp--; break;
+		case OP_SUB  : s[sp - 1] -= s[sp]; sp--; break;
+		case OP_MUL  : s[sp - 1] *= s[sp]; sp--; break;
+		case OP_DIV  : s[sp - 1] /= s[sp]; sp--; break;
+		case OP_POW  : s[sp - 1] = pow(s[sp - 1], s[sp]); sp--; break;
+		case OP_FNC1 : s[sp] = m_fnc1[ins.n](s[sp]); break;
+		case OP_FNC2 : s[sp - 1] = m_fnc2[ins.n](s[sp - 1], s[sp]); sp--; break;
+		}
+	}
+	return s[0];
+}
+
+//-----------------------------------------------------------------------------
+// The program is executed for a batch of items at a time. Each stack entry holds
+// the values of all items in the batch, so each instruction becomes a simple loop
+// that the compiler can vectorize.
+void CMathExpression::Eval(int n, const double* const* vars, const int* stride, double* result) const
+{
+	if (m_bvalid == false)
+	{
+		for (int i = 0; i < n; ++i) result[i] = 0.0;
+		return;
+	}
+
+	const int B = BATCH_SIZE;
+	std::vector<double> stack((size_t)m_stackSize * B);
+
+	for (int i0 = 0; i0 < n; i0 += B)
+	{
+		int m = (n - i0 < B ? n - i0 : B);
+		double* top = stack.data() - B;
+		for (const Instruction& ins : m_prg)
+		{
+			double* a = top - B;
+			double* b = top;
+			switch (ins.op)
+			{
+			case OP_CONST:
+			{
+				top += B;
+				double v = m_const[ins.n];
+				for (int i = 0; i < m; ++i) top[i] = v;
+			}
+			break;
+			case OP_VAR:
+			{
+				top += B;
+				const double* pv = vars[ins.n];
+				int ds = stride[ins.n];
+				if (ds == 0) { double v = pv[0]; for (int i = 0; i < m; ++i) top[i] = v; }
+				else if (ds == 1) { pv += i0; for (int i = 0; i < m; ++i) top[i] = pv[i]; }
+				else { pv += (size_t)i0*ds; for (int i = 0; i < m; ++i) top[i] = pv[(size_t)i*ds]; }
+			}
+			break;
+			case OP_NEG : for (int i = 0; i < m; ++i) b[i] = -b[i]; break;
+			case OP_ADD : for (int i = 0; i < m; ++i) a[i] += b[i]; top = a; break;
+			case OP_SUB : for (int i = 0; i < m; ++i) a[i] -= b[i]; top = a; break;
+			case OP_MUL : for (int i = 0; i < m; ++i) a[i] *= b[i]; top = a; break;
+			case OP_DIV : for (int i = 0; i < m; ++i) a[i] /= b[i]; top = a; break;
+			case OP_POW : for (int i = 0; i < m; ++i) a[i] = pow(a[i], b[i]); top = a; break;
+			case OP_FNC1: { FNC1 f = m_fnc1[ins.n]; for (int i = 0; i < m; ++i) b[i] = f(b[i]); } break;
+			case OP_FNC2: { FNC2 f = m_fnc2[ins.n]; for (int i = 0; i < m; ++i) a[i] = f(a[i], b[i]); top = a; } break;
+			}
+		}
+
+		for (int i = 0; i < m; ++i) result[i0 + i] = top[i];
+	}
+}
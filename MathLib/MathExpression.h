@@ -0,0 +1,112 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#pragma once
+#include <string>
+#include <vector>
+
+//=============================================================================
+// A compiled math expression. The expression is parsed once into a program for
+// a small stack machine, which can then be evaluated quickly for many different
+// values of the variables. The syntax is the same as that of CMathParser.
+// Variables are bound to slots, which must be defined before compiling.
+class CMathExpression
+{
+public:
+	// number of items evaluated together in a batch
+	enum { BATCH_SIZE = 128 };
+
+public:
+	CMathExpression();
+
+	// Add a variable and return its slot. Variables must be added before the 
+	// expression is compiled.
+	int AddVariable(const std::string& name);
+
+	// number of variables
+	int Variables() const { return (int)m_var.size(); }
+
+	// compile the expression. Returns false if the expression is invalid.
+	bool Compile(const std::string& expr);
+
+	// was the expression compiled successfully?
+	bool IsValid() const { return m_bvalid; }
+
+	// error message of the last compilation
+	const std::string& ErrorString() const { return m_err; }
+
+	// evaluate for one set of variable values (one value for each slot)
+	double Eval(const double* vars) const;
+
+	// Evaluate for n items. For each slot i, vars[i] points to the values of
+	// that variable, and stride[i] is the distance between consecutive values.
+	// Use a stride of zero for variables that have the same value for all items.
+	void Eval(int n, const double* const* vars, const int* stride, double* result) const;
+
+private:
+	enum OpCode {
+		OP_CONST, OP_VAR, OP_NEG, OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_POW, OP_FNC1, OP_FNC2
+	};
+
+	struct Instruction
+	{
+		OpCode	op;
+		int		n;		// index of constant, variable, or function
+	};
+
+	typedef double (*FNC1)(double);
+	typedef double (*FNC2)(double, double);
+
+	// parser
+	enum Token { NAME, NUMBER, END, PLUS = '+', MINUS = '-', MUL = '*', DIV = '/', POW = '^', LP = '(', RP = ')', COMMA = ',', BAD = 256 };
+	Token nextToken();
+	bool expr();
+	bool term();
+	bool power();
+	bool prim();
+	bool error(const char* sz);
+
+	// code generation (with constant folding)
+	void emit(OpCode op, int n = 0);
+	void emitConst(double v);
+
+private:
+	std::vector<std::string>	m_var;
+	std::vector<Instruction>	m_prg;
+	std::vector<double>			m_const;
+	std::vector<FNC1>			m_fnc1;
+	std::vector<FNC2>			m_fnc2;
+	int							m_stackSize;
+	bool						m_bvalid;
+	std::string					m_err;
+
+	// parser state
+	const char*	m_sz;
+	Token		m_tok;
+	double		m_num;
+	std::string	m_name;
+	int			m_depth;
+};
@@ -0,0 +1,225 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#include "PCGSolver.h"
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+static double dot(const vector<double>& a, const vector<double>& b)
+{
+	int N = (int)a.size();
+	double s = 0.0;
+#pragma omp parallel for reduction(+:s)
+	for (int i = 0; i < N; ++i) s += a[i] * b[i];
+	return s;
+}
+
+//-----------------------------------------------------------------------------
+PCGSolver::PCGSolver() : m_pA(0)
+{
+	m_pc = IC0;
+	m_maxIters = 1000;
+	m_tol = 1e-8;
+
+	m_usedPc = JACOBI;
+	m_niters = 0;
+	m_relNorm = 0.0;
+}
+
+//-----------------------------------------------------------------------------
+bool PCGSolver::Factor()
+{
+	CSRMatrix& A = *m_pA;
+	int N = A.Rows();
+
+	// the Jacobi preconditioner is also the fallback for IC0
+	m_usedPc = JACOBI;
+	m_Dinv.resize(N);
+	int nbad = 0;
+#pragma omp parallel for reduction(+:nbad)
+	for (int i = 0; i < N; ++i)
+	{
+		double d = A.diag(i);
+		if (d > 0.0) m_Dinv[i] = 1.0 / d;
+		else { m_Dinv[i] = 1.0; nbad++; }
+	}
+	if (nbad > 0) return false;
+
+	if ((m_pc == IC0) && FactorIC0()) m_usedPc = IC0;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Incomplete Cholesky factorization A = L*Lt, where L has the same sparsity
+// pattern as the lower triangular part of A.
+bool PCGSolver::FactorIC0()
+{
+	CSRMatrix& A = *m_pA;
+	int N = A.Rows();
+	const int* off = A.RowOffsets();
+	const int* col = A.Columns();
+	const double* val = A.Values();
+
+	// copy the lower triangular part
+	m_Loff.assign(N + 1, 0);
+	for (int i = 0; i < N; ++i)
+	{
+		int n = 0;
+		for (int k = off[i]; k < off[i + 1]; ++k) if (col[k] <= i) n++;
+		m_Loff[i + 1] = m_Loff[i] + n;
+	}
+	m_Lcol.resize(m_Loff[N]);
+	m_Lval.resize(m_Loff[N]);
+	for (int i = 0; i < N; ++i)
+	{
+		int m = m_Loff[i];
+		for (int k = off[i]; k < off[i + 1]; ++k)
+		{
+			if (col[k] <= i)
+			{
+				m_Lcol[m] = col[k];
+				m_Lval[m] = val[k];
+				m++;
+			}
+		}
+
+		// the diagonal must be the last entry
+		if ((m == m_Loff[i]) || (m_Lcol[m - 1] != i)) return false;
+	}
+
+	// do the factorization
+	for (int i = 0; i < N; ++i)
+	{
+		int i0 = m_Loff[i];
+		int di = m_Loff[i + 1] - 1;
+		for (int p = i0; p < di; ++p)
+		{
+			// subtract the product of rows i and j, up to column j
+			int j = m_Lcol[p];
+			int dj = m_Loff[j + 1] - 1;
+			double s = m_Lval[p];
+			int a = i0, b = m_Loff[j];
+			while ((a < p) && (b < dj))
+			{
+				if      (m_Lcol[a] < m_Lcol[b]) a++;
+				else if (m_Lcol[b] < m_Lcol[a]) b++;
+				else s -= m_Lval[a++] * m_Lval[b++];
+			}
+			m_Lval[p] = s / m_Lval[dj];
+		}
+
+		double d = m_Lval[di];
+		for (int p = i0; p < di; ++p) d -= m_Lval[p] * m_Lval[p];
+		if (d <= 0.0) return false;
+		m_Lval[di] = sqrt(d);
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void PCGSolver::Precondition(const vector<double>& r, vector<double>& z) const
+{
+	int N = (int)r.size();
+	if (m_usedPc == IC0)
+	{
+		// forward substitution: L y = r
+		for (int i = 0; i < N; ++i)
+		{
+			int di = m_Loff[i + 1] - 1;
+			double s = r[i];
+			for (int p = m_Loff[i]; p < di; ++p) s -= m_Lval[p] * z[m_Lcol[p]];
+			z[i] = s / m_Lval[di];
+		}
+
+		// backward substitution: Lt z = y
+		for (int i = N - 1; i >= 0; --i)
+		{
+			int di = m_Loff[i + 1] - 1;
+			z[i] /= m_Lval[di];
+			double zi = z[i];
+			for (int p = m_Loff[i]; p < di; ++p) z[m_Lcol[p]] -= m_Lval[p] * zi;
+		}
+	}
+	else
+	{
+#pragma omp parallel for
+		for (int i = 0; i < N; ++i) z[i] = m_Dinv[i] * r[i];
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool PCGSolver::Solve(vector<double>& x, const vector<double>& b)
+{
+	CSRMatrix& A = *m_pA;
+	int N = A.Rows();
+	m_niters = 0;
+	m_relNorm = 0.0;
+	if (N == 0) return true;
+
+	// initial residual
+	vector<double> r(N), z(N), p(N), q(N);
+	A.mult(x, q);
+#pragma omp parallel for
+	for (int i = 0; i < N; ++i) r[i] = b[i] - q[i];
+
+	double norm0 = sqrt(dot(r, r));
+	if (norm0 == 0.0) return true;
+	m_relNorm = 1.0;
+
+	Precondition(r, z);
+	p = z;
+	double rz = dot(r, z);
+
+	while (m_niters < m_maxIters)
+	{
+		A.mult(p, q);
+		double pq = dot(p, q);
+		if (pq <= 0.0) return false;	// matrix is not positive definite
+
+		double alpha = rz / pq;
+#pragma omp parallel for
+		for (int i = 0; i < N; ++i)
+		{
+			x[i] += alpha * p[i];
+			r[i] -= alpha * q[i];
+		}
+		m_niters++;
+
+		m_relNorm = sqrt(dot(r, r)) / norm0;
+		if (m_relNorm <= m_tol) break;
+
+		Precondition(r, z);
+		double rz1 = dot(r, z);
+		double beta = rz1 / rz;
+		rz = rz1;
+#pragma omp parallel for
+		for (int i = 0; i < N; ++i) p[i] = z[i] + beta * p[i];
+	}
+
+	return (m_relNorm <= m_tol);
+}
@@ -0,0 +1,92 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#pragma once
+#include "CSRMatrix.h"
+#include <vector>
+
+using std::vector;
+
+//-----------------------------------------------------------------------------
+//! Preconditioned conjugate gradient solver for symmetric positive definite 
+//! matrices. 
+
+//! The preconditioner is either the diagonal (Jacobi) or an incomplete 
+//! Cholesky factorization that keeps the sparsity pattern of the matrix (IC0).
+//! If the IC0 factorization breaks down, the solver reverts to Jacobi. 
+
+class PCGSolver
+{
+public:
+	enum Preconditioner {
+		JACOBI,
+		IC0
+	};
+
+public:
+	PCGSolver();
+
+	void SetMatrix(CSRMatrix* pA) { m_pA = pA; }
+
+	void SetPreconditioner(int n) { m_pc = n; }
+
+	void SetMaxIterations(int n) { m_maxIters = n; }
+
+	// relative residual norm tolerance
+	void SetTolerance(double tol) { m_tol = tol; }
+
+	//! build the preconditioner
+	bool Factor();
+
+	//! solve A x = b. On input, x is the initial guess.
+	bool Solve(vector<double>& x, const vector<double>& b);
+
+public: // output
+	int GetIterationCount() const { return m_niters; }
+	double GetRelativeNorm() const { return m_relNorm; }
+
+	// the preconditioner that was used
+	int GetPreconditioner() const { return m_usedPc; }
+
+private:
+	bool FactorIC0();
+	void Precondition(const vector<double>& r, vector<double>& z) const;
+
+private:
+	CSRMatrix*	m_pA;
+	int		m_pc;
+	int		m_maxIters;
+	double	m_tol;
+
+	int		m_usedPc;
+	vector<double>	m_Dinv;		//!< inverted diagonal (Jacobi)
+	vector<int>		m_Loff;		//!< row offsets of IC0 factor
+	vector<int>		m_Lcol;		//!< column indices of IC0 factor (diagonal last)
+	vector<double>	m_Lval;		//!< values of IC0 factor
+
+	int		m_niters;
+	double	m_relNorm;
+};
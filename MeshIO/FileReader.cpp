@@ -156,6 +156,13 @@ void FileReader::ClearErrors()
 	m_err.clear();
 }
 
+off_type FileReader::BytesLeft() const
+{
+	if (m_fp == 0) return 0;
+	off_type npos = ftell64(m_fp);
+	return (npos < m_nfilesize ? m_nfilesize - npos : 0);
+}
+
 float FileReader::GetFileProgress() const
 {
 	if (m_fp)
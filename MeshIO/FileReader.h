@@ -99,6 +99,9 @@ protected:
 	// get the file pointer
 	FILE* FilePtr();
 
+	// number of bytes between the current position and the end of the file
+	off_type BytesLeft() const;
+
 protected:
 	FILE*			m_fp;
 
@@ -29,20 +29,48 @@ SOFTWARE.*/
 #include <MeshTools/GModel.h>
 #include <XML/XMLReader.h>
 
+#include <zlib.h>
+
+#ifdef WIN32
+#define fseek64(a,b,c) _fseeki64(a,b,c)
+#define ftell64(a) _ftelli64(a)
+#else
+#define fseek64(a,b,c) fseeko(a,b,c)
+#define ftell64(a) ftello(a)
+#endif
+
+// number of bytes between the current file position and the end of the file
+static size_t fileBytesLeft(FILE* fp)
+{
+	int64_t pos = ftell64(fp);
+	if ((pos < 0) || (fseek64(fp, 0, SEEK_END) != 0)) return 0;
+	int64_t end = ftell64(fp);
+	fseek64(fp, pos, SEEK_SET);
+	return (end > pos ? (size_t)(end - pos) : 0);
+}
+
 class VTKDataArray
 {
 public:
 	enum Types
 	{
+		INT8,
 		UINT8,
+		INT16,
+		UINT16,
 		INT32,
+		UINT32,
 		INT64,
-		FLOAT32
+		UINT64,
+		FLOAT32,
+		FLOAT64
 	};
 
 	enum Format
 	{
-		ASCII
+		ASCII,
+		BINARY,
+		APPENDED
 	};
 
 public:
@@ -53,47 +81,41 @@ public:
 		m_numComps = 1;
 	}
 
-	VTKDataArray(const VTKDataArray& data)
-	{
-		m_type = data.m_type;
-		m_format = data.m_format;
-		m_numComps = data.m_numComps;
-
-		m_values_float = data.m_values_float;
-		m_values_int = data.m_values_int;
-	}
-
-	void operator = (const VTKDataArray& data)
-	{
-		m_type = data.m_type;
-		m_format = data.m_format;
-		m_numComps = data.m_numComps;
-
-		m_values_float = data.m_values_float;
-		m_values_int = data.m_values_int;
-	}
-
 	int	m_type;
 	int m_format;
 	int m_numComps;
 
-	size_t size() const
+	bool isFloat() const { return ((m_type == FLOAT32) || (m_type == FLOAT64)); }
+
+	// size of one value in bytes
+	int typeSize() const
 	{
 		switch (m_type)
 		{
-		case FLOAT32: return (m_values_float.size() / m_numComps); break;
-		case UINT8:
-		case INT32:
-		case INT64:
-			return (m_values_int.size() / m_numComps); break;
-			break;
+		case INT8: case UINT8: return 1;
+		case INT16: case UINT16: return 2;
+		case INT32: case UINT32: case FLOAT32: return 4;
+		case INT64: case UINT64: case FLOAT64: return 8;
 		default:
 			assert(false);
-			break;
 		}
 		return 0;
 	}
 
+	// total number of values (i.e. components)
+	size_t values() const { return (isFloat() ? m_values_float.size() : m_values_int.size()); }
+
+	void resize(size_t n)
+	{
+		if (isFloat()) m_values_float.resize(n); else m_values_int.resize(n);
+	}
+
+	size_t size() const
+	{
+		if (m_type < 0) { assert(false); return 0; }
+		return values() / m_numComps;
+	}
+
 	void get(int n, double* v) const { *v = m_values_float[n]; }
 	void get(int n, int*    v) const { *v = m_values_int[n]; }
 
@@ -101,6 +123,118 @@ public:
 	std::vector<int>		m_values_int;
 };
 
+//-----------------------------------------------------------------------------
+// Source of the bytes of binary data arrays.
+class VTKByteSource
+{
+public:
+	virtual ~VTKByteSource() {}
+
+	// read n bytes. Returns the number of bytes actually read.
+	virtual size_t read(void* pd, size_t n) = 0;
+
+	// upper bound on the number of bytes that can still be read
+	virtual size_t remaining() = 0;
+};
+
+// raw bytes from a file (appended data with raw encoding)
+class VTKRawSource : public VTKByteSource
+{
+public:
+	VTKRawSource(FILE* fp) : m_fp(fp) {}
+	size_t read(void* pd, size_t n) override { return fread(pd, 1, n, m_fp); }
+	size_t remaining() override { return fileBytesLeft(m_fp); }
+
+private:
+	FILE*	m_fp;
+};
+
+// Decodes base64 text, either from memory (inline binary data) or from a file 
+// (appended data with base64 encoding). VTK often encodes the header and the data
+// as separate base64 blocks, so padding characters may appear in the middle of the text.
+class VTKBase64Source : public VTKByteSource
+{
+public:
+	VTKBase64Source(const char* sz, size_t len) : m_sz(sz), m_len(len), m_pos(0), m_fp(nullptr) { init(); }
+	VTKBase64Source(FILE* fp) : m_sz(nullptr), m_len(0), m_pos(0), m_fp(fp) { m_buf.resize(65536); init(); }
+
+	size_t read(void* pd, size_t n) override
+	{
+		unsigned char* d = (unsigned char*)pd;
+		size_t nread = 0;
+		while (nread < n)
+		{
+			if (m_outPos < m_outLen) d[nread++] = m_out[m_outPos++];
+			else if (decodeQuad() == false) break;
+		}
+		return nread;
+	}
+
+	size_t remaining() override
+	{
+		size_t chars = (m_len - m_pos) + (m_fp ? fileBytesLeft(m_fp) : 0);
+		return (size_t)(m_outLen - m_outPos) + (chars / 4 + 1) * 3;
+	}
+
+private:
+	void init()
+	{
+		m_outPos = m_outLen = 0;
+		for (int i = 0; i < 256; ++i) m_lut[i] = -1;
+		const char* sz = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+		for (int i = 0; i < 64; ++i) m_lut[(unsigned char)sz[i]] = (signed char)i;
+		m_lut['='] = 64;
+	}
+
+	// get the next base64 character, skipping whitespace. Returns -1 at the end of the data.
+	int nextChar()
+	{
+		while (true)
+		{
+			if (m_pos >= m_len)
+			{
+				if (m_fp == nullptr) return -1;
+				m_sz = &m_buf[0];
+				m_len = fread(&m_buf[0], 1, m_buf.size(), m_fp);
+				m_pos = 0;
+				if (m_len == 0) return -1;
+			}
+			int c = m_lut[(unsigned char)m_sz[m_pos++]];
+			if (c >= 0) return c;
+			if (!isspace((unsigned char)m_sz[m_pos - 1])) return -1;
+		}
+	}
+
+	bool decodeQuad()
+	{
+		int c[4];
+		for (int i = 0; i < 4; ++i)
+		{
+			c[i] = nextChar();
+			if (c[i] < 0) return false;
+		}
+		if ((c[0] == 64) || (c[1] == 64)) return false;
+		unsigned int v = (c[0] << 18) | (c[1] << 12) | ((c[2] & 63) << 6) | (c[3] & 63);
+		m_out[0] = (unsigned char)(v >> 16);
+		m_out[1] = (unsigned char)(v >> 8);
+		m_out[2] = (unsigned char)(v);
+		m_outLen = (c[2] == 64 ? 1 : (c[3] == 64 ? 2 : 3));
+		m_outPos = 0;
+		return true;
+	}
+
+private:
+	const char*	m_sz;
+	size_t		m_len;
+	size_t		m_pos;
+	FILE*		m_fp;
+	std::vector<char>	m_buf;
+
+	signed char		m_lut[256];
+	unsigned char	m_out[3];
+	int				m_outPos, m_outLen;
+};
+
 template <class T> class VTKDataArrayReader
 {
 public:
@@ -156,26 +290,6 @@ public:
 		m_numCells = 0;
 	}
 
-	VTKPiece(const VTKPiece& piece)
-	{
-		m_numPoints = piece.m_numPoints;
-		m_numCells = piece.m_numCells;
-		m_points = piece.m_points;
-		m_cell_connect = piece.m_cell_connect;
-		m_cell_offsets = piece.m_cell_offsets;
-		m_cell_types = piece.m_cell_types;
-	}
-
-	void operator = (const VTKPiece& piece)
-	{
-		m_numPoints = piece.m_numPoints;
-		m_numCells = piece.m_numCells;
-		m_points = piece.m_points;
-		m_cell_connect = piece.m_cell_connect;
-		m_cell_offsets = piece.m_cell_offsets;
-		m_cell_types = piece.m_cell_types;
-	}
-
 	size_t Points() const { return m_points.size(); }
 	size_t Cells() const { return m_cell_types.size(); }
 
@@ -216,7 +330,7 @@ public:
 class VTKModel
 {
 public:
-	void AddPiece(const VTKPiece& piece) { m_pieces.push_back(piece); }
+	VTKPiece& AddPiece() { m_pieces.push_back(VTKPiece()); return m_pieces.back(); }
 
 	size_t Pieces() const { return m_pieces.size(); }
 
@@ -226,14 +340,65 @@ public:
 	std::vector<VTKPiece>	m_pieces;
 };
 
-VTUimport::VTUimport(FEProject& prj) : FEFileImport(prj)
+//-----------------------------------------------------------------------------
+static bool isLittleEndian()
+{
+	int n = 1;
+	return (*(char*)&n == 1);
+}
+
+// reverse the bytes of n values of size bytes each
+static void swapBytes(unsigned char* d, size_t n, int size)
+{
+	for (size_t i = 0; i < n; ++i, d += size)
+	{
+		for (int j = 0; j < size / 2; ++j)
+		{
+			unsigned char t = d[j]; d[j] = d[size - j - 1]; d[size - j - 1] = t;
+		}
+	}
+}
+
+// convert n values of the array's type from src and store them at the array's values, starting at offset
+static void convertValues(VTKDataArray& a, const unsigned char* src, size_t offset, size_t n)
 {
+	double* pf = (a.isFloat() ? a.m_values_float.data() + offset : nullptr);
+	int*    pi = (a.isFloat() ? nullptr : a.m_values_int.data() + offset);
+	switch (a.m_type)
+	{
+	case VTKDataArray::INT8   : { const signed char*        v = (const signed char*)src; for (size_t i = 0; i < n; ++i) pi[i] = (int)v[i]; } break;
+	case VTKDataArray::UINT8  : { const unsigned char*      v = src; for (size_t i = 0; i < n; ++i) pi[i] = (int)v[i]; } break;
+	case VTKDataArray::INT16  : { const short*              v = (const short*)src; for (size_t i = 0; i < n; ++i) pi[i] = (int)v[i]; } break;
+	case VTKDataArray::UINT16 : { const unsigned short*     v = (const unsigned short*)src; for (size_t i = 0; i < n; ++i) pi[i] = (int)v[i]; } break;
+	case VTKDataArray::INT32  : { const int*                v = (const int*)src; for (size_t i = 0; i < n; ++i) pi[i] = v[i]; } break;
+	case VTKDataArray::UINT32 : { const unsigned int*       v = (const unsigned int*)src; for (size_t i = 0; i < n; ++i) pi[i] = (int)v[i]; } break;
+	case VTKDataArray::INT64  : { const long long*          v = (const long long*)src; for (size_t i = 0; i < n; ++i) pi[i] = (int)v[i]; } break;
+	case VTKDataArray::UINT64 : { const unsigned long long* v = (const unsigned long long*)src; for (size_t i = 0; i < n; ++i) pi[i] = (int)v[i]; } break;
+	case VTKDataArray::FLOAT32: { const float*              v = (const float*)src; for (size_t i = 0; i < n; ++i) pf[i] = (double)v[i]; } break;
+	case VTKDataArray::FLOAT64: { const double*             v = (const double*)src; for (size_t i = 0; i < n; ++i) pf[i] = v[i]; } break;
+	}
+}
 
+// Can the values of this array be stored without conversion?
+static bool isNativeType(const VTKDataArray& a)
+{
+	return (a.m_type == VTKDataArray::FLOAT64) || (a.m_type == VTKDataArray::INT32) || (a.m_type == VTKDataArray::UINT32);
 }
 
-VTUimport::~VTUimport(void)
+//-----------------------------------------------------------------------------
+VTUimport::VTUimport(FEProject& prj) : FEFileImport(prj)
 {
+	m_headerSize = 4;
+	m_compressed = false;
+	m_swap = false;
+	m_fpData = nullptr;
+	m_dataStart = -1;
+	m_base64Data = false;
+}
 
+VTUimport::~VTUimport(void)
+{
+	if (m_fpData) fclose(m_fpData);
 }
 
 bool VTUimport::Load(const char* szfile)
@@ -251,6 +416,26 @@ bool VTUimport::Load(const char* szfile)
 	if (sztype == nullptr) return false;
 	if (strcmp(sztype, "UnstructuredGrid") != 0) return false;
 
+	// get the information we need for reading binary data
+	m_fileName = szfile;
+	m_dataStart = -1;
+	if (m_fpData) { fclose(m_fpData); m_fpData = nullptr; }
+
+	const char* szorder = tag.AttributeValue("byte_order", true);
+	bool bigEndian = (szorder && (strcmp(szorder, "BigEndian") == 0));
+	m_swap = (bigEndian == isLittleEndian());
+
+	const char* szheader = tag.AttributeValue("header_type", true);
+	m_headerSize = ((szheader && (strcmp(szheader, "UInt64") == 0)) ? 8 : 4);
+
+	const char* szcomp = tag.AttributeValue("compressor", true);
+	m_compressed = false;
+	if (szcomp)
+	{
+		if (strcmp(szcomp, "vtkZLibDataCompressor") == 0) m_compressed = true;
+		else return errf("Unsupported compressor %s", szcomp);
+	}
+
 	VTKModel vtk;
 
 	// parse the file
@@ -261,6 +446,10 @@ bool VTUimport::Load(const char* szfile)
 			if (tag == "UnstructuredGrid")
 			{
 				if (ParseUnstructuredGrid(tag, vtk) == false) return false;
+
+				// We're done. Note that we cannot continue reading since the 
+				// AppendedData section that may follow is not valid XML. 
+				break;
 			}
 			else return false;
 			++tag;
@@ -272,6 +461,7 @@ bool VTUimport::Load(const char* szfile)
 	}
 
 	xml.Close();
+	if (m_fpData) { fclose(m_fpData); m_fpData = nullptr; }
 
 	return BuildMesh(vtk);
 }
@@ -294,7 +484,7 @@ bool VTUimport::ParseUnstructuredGrid(XMLTag& tag, VTKModel& vtk)
 
 bool VTUimport::ParsePiece(XMLTag& tag, VTKModel& vtk)
 {
-	VTKPiece piece;
+	VTKPiece& piece = vtk.AddPiece();
 	piece.m_numPoints = tag.AttributeValue<int>("NumberOfPoints", -1);
 	if (piece.m_numPoints <= 0) return false;
 
@@ -318,8 +508,6 @@ bool VTUimport::ParsePiece(XMLTag& tag, VTKModel& vtk)
 	} 
 	while (!tag.isend());
 
-	vtk.AddPiece(piece);
-
 	return true;
 }
 
@@ -333,7 +521,7 @@ bool VTUimport::ParsePoints(XMLTag& tag, VTKPiece& piece)
 			VTKDataArray& points = piece.m_points;
 			if (ParseDataArray(tag, points) == false) return false;
 
-			if (points.m_type != VTKDataArray::FLOAT32) return false;
+			if (points.isFloat() == false) return false;
 			if (points.m_numComps != 3) return false;
 			if (points.m_values_float.size() != piece.m_numPoints * points.m_numComps) return false;
 
@@ -378,39 +566,227 @@ bool VTUimport::ParseCells(XMLTag& tag, VTKPiece& piece)
 
 bool VTUimport::ParseDataArray(XMLTag& tag, VTKDataArray& vtkDataArray)
 {
-	// make sure this is an ascii format
+	// get the format
 	const char* szformat = tag.AttributeValue("Format", true);
 	if (szformat == nullptr) szformat = tag.AttributeValue("format");
-	if (strcmp(szformat, "ascii") != 0) return false;
-	vtkDataArray.m_format = VTKDataArray::ASCII;
+	if      (strcmp(szformat, "ascii"   ) == 0) vtkDataArray.m_format = VTKDataArray::ASCII;
+	else if (strcmp(szformat, "binary"  ) == 0) vtkDataArray.m_format = VTKDataArray::BINARY;
+	else if (strcmp(szformat, "appended") == 0) vtkDataArray.m_format = VTKDataArray::APPENDED;
+	else return errf("Unknown data array format %s", szformat);
 
 	// get the type
 	const char* sztype = tag.AttributeValue("type");
 	if      (strcmp(sztype, "Float32") == 0) vtkDataArray.m_type = VTKDataArray::FLOAT32;
+	else if (strcmp(sztype, "Float64") == 0) vtkDataArray.m_type = VTKDataArray::FLOAT64;
+	else if (strcmp(sztype, "Int8"   ) == 0) vtkDataArray.m_type = VTKDataArray::INT8;
 	else if (strcmp(sztype, "UInt8"  ) == 0) vtkDataArray.m_type = VTKDataArray::UINT8;
+	else if (strcmp(sztype, "Int16"  ) == 0) vtkDataArray.m_type = VTKDataArray::INT16;
+	else if (strcmp(sztype, "UInt16" ) == 0) vtkDataArray.m_type = VTKDataArray::UINT16;
+	else if (strcmp(sztype, "Int32"  ) == 0) vtkDataArray.m_type = VTKDataArray::INT32;
+	else if (strcmp(sztype, "UInt32" ) == 0) vtkDataArray.m_type = VTKDataArray::UINT32;
 	else if (strcmp(sztype, "Int64"  ) == 0) vtkDataArray.m_type = VTKDataArray::INT64;
-	else if (strcmp(sztype, "Int32"  ) == 0) vtkDataArray.m_type = VTKDataArray::INT64;
+	else if (strcmp(sztype, "UInt64" ) == 0) vtkDataArray.m_type = VTKDataArray::UINT64;
 	else return errf("Unknown data array type %s", sztype);
 
 	// get the number of components
 	vtkDataArray.m_numComps = tag.AttributeValue<int>("NumberOfComponents", 1);
 
 	// get the value
-	if (vtkDataArray.m_type == VTKDataArray::FLOAT32)
+	if (vtkDataArray.m_format == VTKDataArray::BINARY)
+	{
+		// the value is base64 encoded
+		const char* sz = tag.szvalue();
+		VTKBase64Source src(sz, strlen(sz));
+		return ReadBinaryData(src, vtkDataArray);
+	}
+	else if (vtkDataArray.m_format == VTKDataArray::APPENDED)
+	{
+		int64_t offset = -1;
+		const char* szoff = tag.AttributeValue("offset", true);
+		if (szoff) offset = atoll(szoff);
+		if (offset < 0) return errf("Missing offset for appended data array.");
+
+		if (FindAppendedData() == false) return false;
+		if (fseek64(m_fpData, m_dataStart + offset, SEEK_SET) != 0) return errf("Error reading appended data.");
+
+		if (m_base64Data)
+		{
+			VTKBase64Source src(m_fpData);
+			return ReadBinaryData(src, vtkDataArray);
+		}
+		else
+		{
+			VTKRawSource src(m_fpData);
+			return ReadBinaryData(src, vtkDataArray);
+		}
+	}
+	else if (vtkDataArray.isFloat())
 	{
 		tag.value(vtkDataArray.m_values_float);
 	}
-	else if (vtkDataArray.m_type == VTKDataArray::UINT8)
+	else
 	{
 		tag.value2(vtkDataArray.m_values_int);
 	}
-	else if (vtkDataArray.m_type == VTKDataArray::INT32)
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Find the start of the appended data. This is the first character after the
+// underscore that follows the AppendedData tag.
+bool VTUimport::FindAppendedData()
+{
+	if (m_fpData) return true;
+
+	m_fpData = fopen(m_fileName.c_str(), "rb");
+	if (m_fpData == nullptr) return errf("Failed opening file %s.", m_fileName.c_str());
+
+	const char* sztag = "<AppendedData";
+	const int ntag = (int)strlen(sztag);
+	int nmatch = 0;
+	int64_t pos = 0;
+	int c;
+	while ((c = fgetc(m_fpData)) != EOF)
+	{
+		pos++;
+		if (c == sztag[nmatch]) nmatch++;
+		else nmatch = (c == sztag[0] ? 1 : 0);
+		if (nmatch == ntag) break;
+	}
+	if (nmatch != ntag) return errf("Failed to find AppendedData section.");
+
+	// read the attributes
+	std::string att;
+	while (((c = fgetc(m_fpData)) != EOF) && (c != '>')) { att += (char)c; pos++; }
+	if (c == EOF) return errf("Failed to find AppendedData section.");
+	pos++;
+
+	m_base64Data = true;
+	size_t n = att.find("encoding");
+	if (n != std::string::npos)
 	{
-		tag.value2(vtkDataArray.m_values_int);
+		n = att.find_first_of("\"'", n);
+		if ((n != std::string::npos) && (att.compare(n + 1, 3, "raw") == 0)) m_base64Data = false;
 	}
-	else if (vtkDataArray.m_type == VTKDataArray::INT64)
+
+	// the data starts after the underscore
+	while (((c = fgetc(m_fpData)) != EOF) && (c != '_')) pos++;
+	if (c == EOF) return errf("Failed to find AppendedData section.");
+	pos++;
+
+	m_dataStart = pos;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Reads a header value, i.e. a UInt32 or UInt64, depending on the header type.
+bool VTUimport::ReadHeader(VTKByteSource& src, size_t n, std::vector<unsigned long long>& v)
+{
+	v.resize(n);
+	unsigned char buf[8];
+	for (size_t i = 0; i < n; ++i)
 	{
-		tag.value2(vtkDataArray.m_values_int);
+		if (src.read(buf, (size_t)m_headerSize) != (size_t)m_headerSize) return false;
+		if (m_swap) swapBytes(buf, 1, m_headerSize);
+		if (m_headerSize == 8) { unsigned long long l; memcpy(&l, buf, 8); v[i] = l; }
+		else { unsigned int l; memcpy(&l, buf, 4); v[i] = l; }
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Reads the data of a binary data array (either inline or appended). The values
+// are decoded directly into the array's storage whenever they don't need to be 
+// converted. Otherwise, they are converted in blocks.
+bool VTUimport::ReadBinaryData(VTKByteSource& src, VTKDataArray& a)
+{
+	int tsize = a.typeSize();
+	std::vector<unsigned long long> h;
+	if (m_compressed == false)
+	{
+		// header is the number of bytes
+		if (ReadHeader(src, 1, h) == false) return errf("Error reading binary data array.");
+		size_t nbytes = (size_t)h[0];
+		if ((h[0] > src.remaining()) || ((nbytes % tsize) != 0)) return errf("Invalid size of binary data array.");
+		size_t nvals = nbytes / tsize;
+		a.resize(nvals);
+
+		if (isNativeType(a) && (m_swap == false))
+		{
+			void* pd = (a.isFloat() ? (void*)a.m_values_float.data() : (void*)a.m_values_int.data());
+			if (src.read(pd, nbytes) != nbytes) return errf("Error reading binary data array.");
+		}
+		else
+		{
+			const size_t blockSize = 65536;
+			std::vector<unsigned char> buf(blockSize * tsize);
+			for (size_t i = 0; i < nvals; i += blockSize)
+			{
+				size_t n = (nvals - i < blockSize ? nvals - i : blockSize);
+				if (src.read(buf.data(), n * tsize) != n * tsize) return errf("Error reading binary data array.");
+				if (m_swap) swapBytes(buf.data(), n, tsize);
+				convertValues(a, buf.data(), i, n);
+			}
+		}
+	}
+	else
+	{
+		// header: number of blocks, block size, size of last block, compressed block sizes
+		if (ReadHeader(src, 3, h) == false) return errf("Error reading binary data array.");
+		size_t nblocks = (size_t)h[0];
+		size_t blockSize = (size_t)h[1];
+		size_t lastSize = (size_t)h[2];
+		if (nblocks == 0) { a.resize(0); return true; }
+		if (lastSize == 0) lastSize = blockSize;
+
+		// don't trust the header values before checking them against the available input
+		if (h[0] > src.remaining() / m_headerSize) return errf("Invalid size of binary data array.");
+		if ((blockSize == 0) || (lastSize > blockSize) || ((blockSize % tsize) != 0)) return errf("Invalid size of binary data array.");
+		if (nblocks - 1 > (SIZE_MAX - lastSize) / blockSize) return errf("Invalid size of binary data array.");
+		size_t nbytes = (nblocks - 1) * blockSize + lastSize;
+
+		std::vector<unsigned long long> csize;
+		if (ReadHeader(src, nblocks, csize) == false) return errf("Error reading binary data array.");
+
+		// zlib cannot expand data by more than a factor of about 1000
+		size_t left = src.remaining();
+		unsigned long long ztotal = 0;
+		for (size_t i = 0; i < nblocks; ++i)
+		{
+			if (csize[i] > left - ztotal) return errf("Invalid size of binary data array.");
+			ztotal += csize[i];
+		}
+		if (nbytes / 1032 > ztotal + nblocks) return errf("Invalid size of binary data array.");
+
+		size_t nvals = nbytes / tsize;
+		a.resize(nvals);
+		bool direct = isNativeType(a) && (m_swap == false);
+		unsigned char* pd = (unsigned char*)(a.isFloat() ? (void*)a.m_values_float.data() : (void*)a.m_values_int.data());
+
+		std::vector<unsigned char> zbuf, buf;
+		if (direct == false) buf.resize(blockSize);
+		size_t offset = 0;
+		for (size_t i = 0; i < nblocks; ++i)
+		{
+			size_t usize = (i == nblocks - 1 ? lastSize : blockSize);
+			if ((usize % tsize) != 0) return errf("Error reading binary data array.");
+
+			zbuf.resize((size_t)csize[i]);
+			if (src.read(zbuf.data(), zbuf.size()) != zbuf.size()) return errf("Error reading binary data array.");
+
+			unsigned char* dst = (direct ? pd + offset : buf.data());
+			uLongf len = (uLongf)usize;
+			if ((uncompress(dst, &len, zbuf.data(), (uLong)zbuf.size()) != Z_OK) || (len != usize)) return errf("Error decompressing binary data array.");
+
+			if (direct == false)
+			{
+				if (m_swap) swapBytes(buf.data(), usize / tsize, tsize);
+				convertValues(a, buf.data(), offset / tsize, usize / tsize);
+			}
+			offset += usize;
+		}
 	}
 
 	return true;
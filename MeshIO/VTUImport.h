@@ -30,6 +30,7 @@ SOFTWARE.*/
 
 class XMLTag;
 class VTKDataArray;
+class VTKByteSource;
 class VTKPiece;
 class VTKModel;
 
@@ -49,5 +50,19 @@ private:
 	bool ParseCells(XMLTag& tag, VTKPiece& piece);
 	bool ParseDataArray(XMLTag& tag, VTKDataArray& vtkDataArray);
 
+	bool FindAppendedData();
+	bool ReadHeader(VTKByteSource& src, size_t n, std::vector<unsigned long long>& v);
+	bool ReadBinaryData(VTKByteSource& src, VTKDataArray& vtkDataArray);
+
 	bool BuildMesh(VTKModel& vtk);
+
+private:
+	std::string	m_fileName;
+	int		m_headerSize;	// size of header values (4 or 8 bytes)
+	bool	m_compressed;	// binary data is compressed with zlib
+	bool	m_swap;			// byte order of binary data differs from this machine
+
+	FILE*	m_fpData;		// file for reading appended data
+	int64_t	m_dataStart;	// file position of appended data
+	bool	m_base64Data;	// appended data is base64 encoded
 };
@@ -36,6 +36,7 @@ SOFTWARE.*/
 //! constructor
 FECoreMesh::FECoreMesh()
 {
+	m_elemTreeValid = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -44,6 +45,41 @@ FECoreMesh::~FECoreMesh()
 {
 }
 
+//-----------------------------------------------------------------------------
+// The tree stores up to 8 nodes per element. This always includes the corner nodes,
+// so the boxes contain all the (flat) element faces that are used for intersections.
+const FEFacetBVH& FECoreMesh::ElementSearchTree() const
+{
+	const int MN = 8;
+	int NE = Elements();
+	if ((m_elemTreeValid == false) || (m_elemTree.Facets() != NE))
+	{
+		int NN = Nodes();
+		vector<vec3d> r(NN);
+		for (int i = 0; i < NN; ++i) r[i] = m_Node[i].r;
+
+		vector<int> en(MN * NE, -1);
+		for (int i = 0; i < NE; ++i)
+		{
+			const FEElement_& el = ElementRef(i);
+			int ne = el.Nodes();
+			if (ne > MN) ne = MN;
+			for (int j = 0; j < ne; ++j) en[MN * i + j] = el.m_node[j];
+		}
+
+		m_elemTree.Build(en, r, MN);
+		m_elemTreeValid = true;
+	}
+	return m_elemTree;
+}
+
+//-----------------------------------------------------------------------------
+void FECoreMesh::ClearSearchTree()
+{
+	FEMeshBase::ClearSearchTree();
+	m_elemTreeValid = false;
+}
+
 //-----------------------------------------------------------------------------
 //! This function checks if all elements are of the type specified in the argument
 bool FECoreMesh::IsType(int ntype) const
@@ -129,6 +129,16 @@ public:
 	int CountFacePartitions() const;
 	int CountElementPartitions() const;
 	int CountSmoothingGroups() const;
+
+public:
+	// search tree over the elements, used for picking (see FaceSearchTree)
+	const FEFacetBVH& ElementSearchTree() const;
+
+	void ClearSearchTree() override;
+
+protected:
+	mutable FEFacetBVH	m_elemTree;			// element search tree
+	mutable bool		m_elemTreeValid;	// is the search tree up to date?
 };
 
 inline FEElement_* FECoreMesh::ElementPtr(int n) { return ((n >= 0) && (n<Elements()) ? &ElementRef(n) : 0); }
@@ -194,11 +194,11 @@ public:
 	int			m_lid;		// local ID (zero-based index into element array)
 	int			m_MatID;	// material id
 	float		m_tex;		// element texture coordinate
+	bool		m_Qactive;	//!< active local material orientation (placed here to avoid padding)
 
 public:
 	vec3d	m_fiber;	//!< fiber orientation \todo maybe I can add an element attribute section
 	mat3d	m_Q;		//!< local material orientation
-	bool	m_Qactive;	//!< active local material orientation
 	double	m_a0;		//!< cross-sectional area (only used by truss elements)
 	
 protected:
@@ -0,0 +1,209 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "FEFacetBVH.h"
+#include <algorithm>
+using namespace std;
+
+// max number of facets in a leaf
+const int BVH_LEAF_SIZE = 4;
+
+//-----------------------------------------------------------------------------
+FEFacetBVH::FEFacetBVH()
+{
+	m_nfn = 4;
+}
+
+//-----------------------------------------------------------------------------
+void FEFacetBVH::Build(const vector<int>& facetNodes, const vector<vec3d>& r, int nodesPerFacet)
+{
+	m_nfn = nodesPerFacet;
+	int NF = (int)facetNodes.size() / m_nfn;
+	m_fnode = facetNodes;
+	m_facet.resize(NF);
+	for (int i = 0; i < NF; ++i) m_facet[i] = i;
+
+	// facet centroids are used to split the facets
+	vector<vec3d> c(NF);
+	for (int i = 0; i < NF; ++i)
+	{
+		const int* fn = &m_fnode[m_nfn * i];
+		int nn = 0;
+		vec3d ci(0, 0, 0);
+		for (int j = 0; (j < m_nfn) && (fn[j] >= 0); ++j, ++nn) ci += r[fn[j]];
+		c[i] = ci / (double)nn;
+	}
+
+	m_node.clear();
+	if (NF == 0) return;
+	m_node.reserve(2 * (NF / BVH_LEAF_SIZE + 1));
+	build(0, NF, c);
+
+	Refit(r);
+}
+
+//-----------------------------------------------------------------------------
+// Build the subtree for facets [n0, n1) and return the index of its root.
+// Splitting at the median keeps the tree balanced, so the depth stays well
+// below the size of the traversal stacks.
+int FEFacetBVH::build(int n0, int n1, const vector<vec3d>& c)
+{
+	int n = (int)m_node.size();
+	m_node.push_back(NODE());
+	if (n1 - n0 <= BVH_LEAF_SIZE)
+	{
+		m_node[n].n0 = n0;
+		m_node[n].n1 = n1;
+		return n;
+	}
+
+	// split along the axis with the largest centroid extent
+	vec3d r0 = c[m_facet[n0]], r1 = r0;
+	for (int i = n0 + 1; i < n1; ++i)
+	{
+		const vec3d& ci = c[m_facet[i]];
+		if (ci.x < r0.x) r0.x = ci.x;
+		if (ci.y < r0.y) r0.y = ci.y;
+		if (ci.z < r0.z) r0.z = ci.z;
+		if (ci.x > r1.x) r1.x = ci.x;
+		if (ci.y > r1.y) r1.y = ci.y;
+		if (ci.z > r1.z) r1.z = ci.z;
+	}
+	vec3d dr = r1 - r0;
+	int ax = 0;
+	if (dr.y > dr.x) ax = 1;
+	if ((dr.z > dr.x) && (dr.z > dr.y)) ax = 2;
+
+	int nm = (n0 + n1) / 2;
+	nth_element(m_facet.begin() + n0, m_facet.begin() + nm, m_facet.begin() + n1, [&](int a, int b) {
+		return (ax == 0 ? c[a].x < c[b].x : (ax == 1 ? c[a].y < c[b].y : c[a].z < c[b].z));
+	});
+
+	// the left child always follows its parent
+	build(n0, nm, c);
+	int right = build(nm, n1, c);
+	m_node[n].n0 = -1;
+	m_node[n].n1 = right;
+	return n;
+}
+
+//-----------------------------------------------------------------------------
+void FEFacetBVH::facetBox(int i, const vector<vec3d>& r, vec3d& r0, vec3d& r1) const
+{
+	const int* fn = &m_fnode[m_nfn * i];
+	r0 = r1 = r[fn[0]];
+	for (int j = 1; (j < m_nfn) && (fn[j] >= 0); ++j)
+	{
+		const vec3d& rj = r[fn[j]];
+		if (rj.x < r0.x) r0.x = rj.x;
+		if (rj.y < r0.y) r0.y = rj.y;
+		if (rj.z < r0.z) r0.z = rj.z;
+		if (rj.x > r1.x) r1.x = rj.x;
+		if (rj.y > r1.y) r1.y = rj.y;
+		if (rj.z > r1.z) r1.z = rj.z;
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEFacetBVH::Refit(const vector<vec3d>& r)
+{
+	// children always come after their parents, so we can do this in reverse order
+	int NN = (int)m_node.size();
+	for (int n = NN - 1; n >= 0; --n)
+	{
+		NODE& node = m_node[n];
+		if (node.n0 >= 0)
+		{
+			facetBox(m_facet[node.n0], r, node.r0, node.r1);
+			for (int i = node.n0 + 1; i < node.n1; ++i)
+			{
+				vec3d a, b;
+				facetBox(m_facet[i], r, a, b);
+				if (a.x < node.r0.x) node.r0.x = a.x;
+				if (a.y < node.r0.y) node.r0.y = a.y;
+				if (a.z < node.r0.z) node.r0.z = a.z;
+				if (b.x > node.r1.x) node.r1.x = b.x;
+				if (b.y > node.r1.y) node.r1.y = b.y;
+				if (b.z > node.r1.z) node.r1.z = b.z;
+			}
+		}
+		else
+		{
+			const NODE& a = m_node[n + 1];
+			const NODE& b = m_node[node.n1];
+			node.r0.x = (a.r0.x < b.r0.x ? a.r0.x : b.r0.x);
+			node.r0.y = (a.r0.y < b.r0.y ? a.r0.y : b.r0.y);
+			node.r0.z = (a.r0.z < b.r0.z ? a.r0.z : b.r0.z);
+			node.r1.x = (a.r1.x > b.r1.x ? a.r1.x : b.r1.x);
+			node.r1.y = (a.r1.y > b.r1.y ? a.r1.y : b.r1.y);
+			node.r1.z = (a.r1.z > b.r1.z ? a.r1.z : b.r1.z);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+double FEFacetBVH::boxDistance2(const NODE& node, const vec3d& x)
+{
+	double dx = (x.x < node.r0.x ? node.r0.x - x.x : (x.x > node.r1.x ? x.x - node.r1.x : 0.0));
+	double dy = (x.y < node.r0.y ? node.r0.y - x.y : (x.y > node.r1.y ? x.y - node.r1.y : 0.0));
+	double dz = (x.z < node.r0.z ? node.r0.z - x.z : (x.z > node.r1.z ? x.z - node.r1.z : 0.0));
+	return dx*dx + dy*dy + dz*dz;
+}
+
+//-----------------------------------------------------------------------------
+// slab test for an infinite line. On return, [t0, t1] is the part of the line inside the box.
+bool FEFacetBVH::boxOnLine(const NODE& node, const vec3d& x, const vec3d& n, double& t0, double& t1)
+{
+	const double tol = 2e-2;
+	double tmin = -1e99, tmax = 1e99;
+	double xs[3] = { x.x, x.y, x.z };
+	double ns[3] = { n.x, n.y, n.z };
+	double a[3] = { node.r0.x, node.r0.y, node.r0.z };
+	double b[3] = { node.r1.x, node.r1.y, node.r1.z };
+	for (int i = 0; i < 3; ++i)
+	{
+		// inflate the box a little so that intersection tests that accept points just 
+		// outside a facet (typically within 1% of its size) still find them
+		double h = tol*(b[i] - a[i]) + 1e-12;
+		if (fabs(ns[i]) < 1e-15)
+		{
+			if ((xs[i] < a[i] - h) || (xs[i] > b[i] + h)) return false;
+		}
+		else
+		{
+			double ta = (a[i] - h - xs[i]) / ns[i];
+			double tb = (b[i] + h - xs[i]) / ns[i];
+			if (ta > tb) { double t = ta; ta = tb; tb = t; }
+			if (ta > tmin) tmin = ta;
+			if (tb < tmax) tmax = tb;
+			if (tmin > tmax) return false;
+		}
+	}
+	t0 = tmin;
+	t1 = tmax;
+	return true;
+}
@@ -0,0 +1,170 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <MathLib/math3d.h>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+//! Bounding volume hierarchy over the facets (triangles or quads) of a surface.
+//! The facets are defined by node indices into a position array. Other items
+//! (e.g. elements) can be stored as well by passing more nodes per facet. The hierarchy
+//! is built once and can be refit when the nodes move, as long as the facet
+//! connectivity doesn't change. Queries don't modify the tree and can be run
+//! from multiple threads.
+class FEFacetBVH
+{
+	struct NODE
+	{
+		vec3d	r0, r1;		// bounding box
+		int		n0, n1;		// range of facets (leaf), or -1 and index of right child (interior)
+	};
+
+public:
+	FEFacetBVH();
+
+	//! Build the hierarchy. Each facet has nodesPerFacet entries in facetNodes. 
+	//! Facets with fewer nodes must be padded with -1 (e.g. triangles when nodesPerFacet = 4).
+	void Build(const std::vector<int>& facetNodes, const std::vector<vec3d>& r, int nodesPerFacet = 4);
+
+	//! Update the bounding boxes for new nodal positions
+	void Refit(const std::vector<vec3d>& r);
+
+	//! number of facets
+	int Facets() const { return (int)m_facet.size(); }
+
+	//! Visit all facets whose bounding box is within distance sqrt(d2) of x. The callback
+	//! f(facet) can reduce d2 to shrink the search region. Closer boxes are visited first.
+	template <class F> void ForEachFacetNear(const vec3d& x, double& d2, F f) const;
+
+	//! Visit all facets whose bounding box intersects the (infinite) line x + t*n.
+	template <class F> void ForEachFacetOnLine(const vec3d& x, const vec3d& n, F f) const;
+
+	//! Visit all facets whose bounding box intersects the ray x + t*n, 0 <= t <= tmax. The callback
+	//! f(facet) can reduce tmax to shrink the search region. Closer boxes are visited first.
+	template <class F> void ForEachFacetOnRay(const vec3d& x, const vec3d& n, double& tmax, F f) const;
+
+private:
+	int build(int n0, int n1, const std::vector<vec3d>& c);
+	void facetBox(int i, const std::vector<vec3d>& r, vec3d& r0, vec3d& r1) const;
+
+	static double boxDistance2(const NODE& node, const vec3d& x);
+	static bool boxOnLine(const NODE& node, const vec3d& x, const vec3d& n, double& t0, double& t1);
+
+private:
+	std::vector<NODE>	m_node;		// tree nodes (parents always come before their children)
+	std::vector<int>	m_facet;	// facet indices, in tree order
+	std::vector<int>	m_fnode;	// facet nodes
+	int					m_nfn;		// nodes per facet
+};
+
+//-----------------------------------------------------------------------------
+template <class F> void FEFacetBVH::ForEachFacetNear(const vec3d& x, double& d2, F f) const
+{
+	if (m_node.empty()) return;
+
+	int stack[64], ns = 0;
+	stack[ns++] = 0;
+	while (ns > 0)
+	{
+		int n = stack[--ns];
+		const NODE& node = m_node[n];
+		if (boxDistance2(node, x) > d2) continue;
+
+		if (node.n0 >= 0)
+		{
+			for (int i = node.n0; i < node.n1; ++i) f(m_facet[i]);
+		}
+		else
+		{
+			// push the farthest child first, so the nearest is processed first
+			int a = n + 1, b = node.n1;
+			if (boxDistance2(m_node[a], x) < boxDistance2(m_node[b], x)) { int t = a; a = b; b = t; }
+			stack[ns++] = a;
+			stack[ns++] = b;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+template <class F> void FEFacetBVH::ForEachFacetOnLine(const vec3d& x, const vec3d& n, F f) const
+{
+	if (m_node.empty()) return;
+
+	int stack[64], ns = 0;
+	stack[ns++] = 0;
+	while (ns > 0)
+	{
+		int k = stack[--ns];
+		const NODE& node = m_node[k];
+		double t0, t1;
+		if (boxOnLine(node, x, n, t0, t1) == false) continue;
+
+		if (node.n0 >= 0)
+		{
+			for (int i = node.n0; i < node.n1; ++i) f(m_facet[i]);
+		}
+		else
+		{
+			stack[ns++] = k + 1;
+			stack[ns++] = node.n1;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+template <class F> void FEFacetBVH::ForEachFacetOnRay(const vec3d& x, const vec3d& n, double& tmax, F f) const
+{
+	if (m_node.empty()) return;
+
+	int stack[64], ns = 0;
+	stack[ns++] = 0;
+	while (ns > 0)
+	{
+		int k = stack[--ns];
+		const NODE& node = m_node[k];
+		double t0, t1;
+		if (boxOnLine(node, x, n, t0, t1) == false) continue;
+		if ((t1 < 0) || (t0 > tmax)) continue;
+
+		if (node.n0 >= 0)
+		{
+			for (int i = node.n0; i < node.n1; ++i) f(m_facet[i]);
+		}
+		else
+		{
+			// push the farthest child first, so the nearest is processed first
+			int a = k + 1, b = node.n1;
+			double ta0, ta1, tb0, tb1;
+			bool ba = boxOnLine(m_node[a], x, n, ta0, ta1);
+			bool bb = boxOnLine(m_node[b], x, n, tb0, tb1);
+			if (ba && bb && (ta0 < tb0)) { int t = a; a = b; b = t; }
+			stack[ns++] = a;
+			stack[ns++] = b;
+		}
+	}
+}
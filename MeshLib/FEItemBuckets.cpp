@@ -0,0 +1,72 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#include "FEItemBuckets.h"
+#include <algorithm>
+
+void FEItemBuckets::Build(int buckets, const std::vector<int>& keys, int stride)
+{
+	int N = (int)keys.size();
+	m_off.assign(buckets + 1, 0);
+#pragma omp parallel for
+	for (int i = 0; i < N; ++i)
+	{
+		int n = keys[i];
+		if (n >= 0)
+		{
+#pragma omp atomic
+			m_off[n + 1]++;
+		}
+	}
+
+	for (int i = 0; i < buckets; ++i) m_off[i + 1] += m_off[i];
+
+	m_item.resize(m_off[buckets]);
+	std::vector<int> pos(m_off.begin(), m_off.end() - 1);
+#pragma omp parallel for
+	for (int i = 0; i < N; ++i)
+	{
+		int n = keys[i];
+		if (n >= 0)
+		{
+			int k;
+#pragma omp atomic capture
+			k = pos[n]++;
+
+			m_item[k].eid = i / stride;
+			m_item[k].lid = i % stride;
+		}
+	}
+
+	// the fill order is not deterministic, so restore element order in each bucket
+#pragma omp parallel for schedule(static, 1024)
+	for (int i = 0; i < buckets; ++i)
+	{
+		std::sort(m_item.begin() + m_off[i], m_item.begin() + m_off[i + 1], [](const ITEM& a, const ITEM& b) {
+			return (a.eid < b.eid) || ((a.eid == b.eid) && (a.lid < b.lid));
+		});
+	}
+}
@@ -0,0 +1,61 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#pragma once
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Groups mesh items (element faces, edges, ...) into buckets, stored in 
+// compressed row format. The items are usually keyed by their lowest corner
+// node, so items that are the same always end up in the same bucket. This allows
+// the buckets to be processed independently, and in parallel.
+class FEItemBuckets
+{
+public:
+	// max nr of items per element (or face)
+	enum { MAX_ITEMS = 6 };
+
+	struct ITEM
+	{
+		int	eid;	// element (or face) index
+		int	lid;	// local item index
+	};
+
+public:
+	// keys[stride*i + j] is the bucket of item j of element i, or -1 if the item does not exist.
+	// The items in each bucket are sorted by element and local index.
+	void Build(int buckets, const std::vector<int>& keys, int stride = MAX_ITEMS);
+
+	int Buckets() const { return (int)m_off.size() - 1; }
+
+	int Size(int n) const { return m_off[n + 1] - m_off[n]; }
+
+	const ITEM& Item(int n, int i) const { return m_item[m_off[n] + i]; }
+
+private:
+	std::vector<int>	m_off;
+	std::vector<ITEM>	m_item;
+};
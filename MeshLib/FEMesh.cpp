@@ -32,6 +32,7 @@ SOFTWARE.*/
 #include "FENodeElementList.h"
 #include "FENodeFaceList.h"
 #include "FENodeEdgeList.h"
+#include "FEItemBuckets.h"
 #include "MeshTools/FENodeData.h"
 #include "MeshTools/FESurfaceData.h"
 #include "MeshTools/FEElementData.h"
@@ -769,6 +770,46 @@ bool FEMesh::ValidateEdges() const
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+static int lowestCornerNode(const FEFace& f)
+{
+	int nc = f.Edges();
+	int n = f.n[0];
+	for (int i = 1; i < nc; ++i) if (f.n[i] < n) n = f.n[i];
+	return n;
+}
+
+//-----------------------------------------------------------------------------
+// Puts all solid faces and shell faces of the mesh in buckets. 
+// Shell faces are stored with local index 0.
+static void BuildElementFaceBuckets(FEMesh& mesh, FEItemBuckets& EFB)
+{
+	const int M = FEItemBuckets::MAX_ITEMS;
+	int NE = mesh.Elements();
+	vector<int> keys(M * NE, -1);
+#pragma omp parallel for
+	for (int i = 0; i < NE; ++i)
+	{
+		FEElement_& el = mesh.ElementRef(i);
+		FEFace f;
+		if (el.IsShell())
+		{
+			el.GetShellFace(f);
+			keys[M * i] = lowestCornerNode(f);
+		}
+		else
+		{
+			int nf = el.Faces(); assert(nf <= M);
+			for (int j = 0; j < nf; ++j)
+			{
+				el.GetFace(j, f);
+				keys[M * i + j] = lowestCornerNode(f);
+			}
+		}
+	}
+	EFB.Build(mesh.Nodes(), keys);
+}
+
 //-----------------------------------------------------------------------------
 // This function finds the element neighbours.
 //
@@ -776,8 +817,10 @@ void FEMesh::UpdateElementNeighbors()
 {
 	// get number of elements
 	int elems = Elements();
+	int NN = Nodes();
 
 	// reset all element neighbor and face ptrs
+#pragma omp parallel for
 	for (int i = 0; i < elems; i++)
 	{
 		FEElement_& el = ElementRef(i);
@@ -788,126 +831,140 @@ void FEMesh::UpdateElementNeighbors()
 			el.m_face[j] = -1;
 		}
 	}
+	if ((elems == 0) || (NN == 0)) return;
 
-	// calculate the node-element table
-	FENodeElementList NET;
-	NET.Build(this);
+	// Group the solid and shell faces, the shell edges and the beam end points.
+	// Each bucket is then processed in element order, which gives the same 
+	// neighbors as a search over the node-element table.
+	const int M = FEItemBuckets::MAX_ITEMS;
+	FEItemBuckets EFB;
+	BuildElementFaceBuckets(*this, EFB);
 
-	// set up the element's neighbour pointers
-	FEEdge edge;
-	FEFace f1, f2, f3;
+	vector<int> edgeKeys(M * elems, -1), beamKeys(M * elems, -1);
+#pragma omp parallel for
+	for (int i = 0; i < elems; ++i)
+	{
+		FEElement_& el = ElementRef(i);
+		if (el.IsShell())
+		{
+			int ne = el.Edges(); assert(ne <= M);
+			for (int j = 0; j < ne; ++j)
+			{
+				FEEdge edge = el.GetEdge(j);
+				edgeKeys[M * i + j] = (edge.n[0] < edge.n[1] ? edge.n[0] : edge.n[1]);
+			}
+		}
+		else if (el.IsType(FE_BEAM2))
+		{
+			beamKeys[M * i    ] = el.m_node[0];
+			beamKeys[M * i + 1] = el.m_node[1];
+		}
+	}
+	FEItemBuckets EEB, BNB;
+	EEB.Build(NN, edgeKeys);
+	BNB.Build(NN, beamKeys);
 
-	// loop over all elements
-	for (int i = 0; i < elems; i++)
+#pragma omp parallel
 	{
-		FEElement_* pe = ElementPtr(i);
-		// do the solid elements first
-		int n = pe->Faces();
-		for (int j = 0; j < n; j++)
+		vector<FEFace> F;
+		vector<FEEdge> E;
+
+#pragma omp for schedule(dynamic, 1024)
+		for (int n = 0; n < NN; ++n)
 		{
-			// check if we already have a neighbor assigned
-			if (pe->m_nbr[j] == -1)
+			// solid elements
+			int nb = EFB.Size(n);
+			if (nb > 1)
 			{
-				// get the corresponding element face
-				pe->GetFace(j, f1);
-
-				// pick a node on the face
-				int inode = f1.n[0];
-				int nval = NET.Valence(inode);
-				bool bfound = false;
-
-				// search for shell neighbors first
-				// This is necessary since a shell can share a face with a solid. 
-				// This requires a bit of special handling, so we need to check for that first
-				for (int k = 0; k < nval; k++)
+				if ((int)F.size() < nb) F.resize(nb);
+				for (int a = 0; a < nb; ++a)
+				{
+					const FEItemBuckets::ITEM& it = EFB.Item(n, a);
+					FEElement_& el = ElementRef(it.eid);
+					if (el.IsShell()) el.GetShellFace(F[a]); else el.GetFace(it.lid, F[a]);
+				}
+
+				for (int a = 0; a < nb; ++a)
 				{
-					int nbe = NET.ElementIndex(inode, k);
-					FEElement_* pne = NET.Element(inode, k);
-					if ((pne != pe) && pne->IsShell())
+					const FEItemBuckets::ITEM& ia = EFB.Item(n, a);
+					FEElement_& ea = ElementRef(ia.eid);
+					if (ea.IsShell() || (ea.m_nbr[ia.lid] != -1)) continue;
+
+					// search for shell neighbors first
+					// This is necessary since a shell can share a face with a solid. 
+					bool bfound = false;
+					for (int b = 0; b < nb; ++b)
 					{
-						// get the shell surface facet
-						pne->GetShellFace(f2);
-						if (f1 == f2)
+						const FEItemBuckets::ITEM& ib = EFB.Item(n, b);
+						if ((ib.eid != ia.eid) && ElementRef(ib.eid).IsShell() && (F[a] == F[b]))
 						{
+							ea.m_nbr[ia.lid] = ib.eid;
 							bfound = true;
-							pe->m_nbr[j] = nbe;
 							break;
 						}
 					}
-				}
 
-				if (bfound == false)
-				{
 					// search for solid neighbors next
-					for (int k = 0; k < nval; k++)
+					if (bfound == false)
 					{
-						int nbe = NET.ElementIndex(inode, k);
-						FEElement_* pne = ElementPtr(nbe);
-						if ((pne != pe) && pne->IsSolid())
+						for (int b = 0; b < nb; ++b)
 						{
-							int l = pne->FindFace(f1);
-							if (l != -1)
+							const FEItemBuckets::ITEM& ib = EFB.Item(n, b);
+							FEElement_& eb = ElementRef(ib.eid);
+							if ((ib.eid != ia.eid) && eb.IsSolid() && (F[b] == F[a]))
 							{
-								bfound = true;
-								pe->m_nbr[j] = nbe;
-								pne->m_nbr[l] = i;
+								ea.m_nbr[ia.lid] = ib.eid;
+								eb.m_nbr[ib.lid] = ia.eid;
 								break;
 							}
 						}
 					}
 				}
 			}
-		}
 
-		// do the shell elements next
-		n = pe->Edges();
-		for (int j = 0; j < n; j++)
-		{
-			if (pe->m_nbr[j] == -1)
+			// shell elements
+			nb = EEB.Size(n);
+			if (nb > 1)
 			{
-				edge = pe->GetEdge(j);
+				if ((int)E.size() < nb) E.resize(nb);
+				for (int a = 0; a < nb; ++a)
+				{
+					const FEItemBuckets::ITEM& it = EEB.Item(n, a);
+					E[a] = ElementRef(it.eid).GetEdge(it.lid);
+				}
 
-				// find the neighbour element
-				int inode = edge.n[0];
-				int nval = NET.Valence(inode);
-				bool bfound = false;
-				for (int k = 0; k < nval; k++)
+				for (int a = 0; a < nb; ++a)
 				{
-					FEElement_* pne = NET.Element(inode, k);
-					if ((pne != pe) && (pe->is_equal(*pne) == false) && pne->IsShell())
+					const FEItemBuckets::ITEM& ia = EEB.Item(n, a);
+					FEElement_& ea = ElementRef(ia.eid);
+					if (ea.m_nbr[ia.lid] != -1) continue;
+
+					for (int b = 0; b < nb; ++b)
 					{
-						int l = pne->FindEdge(edge);
-						if (l != -1)
+						const FEItemBuckets::ITEM& ib = EEB.Item(n, b);
+						FEElement_& eb = ElementRef(ib.eid);
+						if ((ib.eid != ia.eid) && (E[a] == E[b]) && (ea.is_equal(eb) == false))
 						{
-							bfound = true;
-							pe->m_nbr[j] = NET.ElementIndex(inode, k);
-							pne->m_nbr[l] = i;
+							ea.m_nbr[ia.lid] = ib.eid;
+							eb.m_nbr[ib.lid] = ia.eid;
 							break;
 						}
 					}
 				}
 			}
-		}
 
-		// do the beam elements
-		if (pe->IsType(FE_BEAM2))
-		{
-			for (int j = 0; j < 2; ++j)
+			// beam elements
+			nb = BNB.Size(n);
+			for (int a = 0; a < nb; ++a)
 			{
-				pe->m_nbr[j] = -1;
-				pe->m_face[j] = -1;
-				int inode = pe->m_node[j];
-				int nval = NET.Valence(inode);
-				for (int k = 0; k < nval; ++k)
+				const FEItemBuckets::ITEM& ia = BNB.Item(n, a);
+				for (int b = 0; b < nb; ++b)
 				{
-					FEElement_* pne = NET.Element(inode, k);
-					if (pne != pe)
+					const FEItemBuckets::ITEM& ib = BNB.Item(n, b);
+					if (ib.eid != ia.eid)
 					{
-						if ((pne->IsType(FE_BEAM2)) && ((pne->m_node[0] == pe->m_node[j]) || (pne->m_node[1] == pe->m_node[j])))
-						{
-							pe->m_nbr[j] = NET.ElementIndex(inode, k);
-							break;
-						}
+						ElementRef(ia.eid).m_nbr[ia.lid] = ib.eid;
+						break;
 					}
 				}
 			}
@@ -919,7 +976,9 @@ void FEMesh::UpdateElementNeighbors()
 void FEMesh::MarkExteriorElements()
 {
 	// set exterior flags
-	for (int i = 0; i < Elements(); ++i)
+	int NE = Elements();
+#pragma omp parallel for
+	for (int i = 0; i < NE; ++i)
 	{
 		FEElement& el = Element(i);
 		if (el.IsSolid())
@@ -942,7 +1001,9 @@ void FEMesh::MarkExteriorElements()
 //-----------------------------------------------------------------------------
 void FEMesh::MarkExteriorFaces()
 {
-	for (int i = 0; i < Faces(); ++i)
+	int NF = Faces();
+#pragma omp parallel for
+	for (int i = 0; i < NF; ++i)
 	{
 		FEFace& face = Face(i);
 		face.SetExterior(face.m_elem[1].eid == -1);
@@ -952,7 +1013,9 @@ void FEMesh::MarkExteriorFaces()
 //-----------------------------------------------------------------------------
 void FEMesh::MarkExteriorEdges()
 {
-	for (int i = 0; i < Edges(); ++i)
+	int NC = Edges();
+#pragma omp parallel for
+	for (int i = 0; i < NC; ++i)
 	{
 		FEEdge& edge = Edge(i);
 		edge.SetExterior(edge.m_gid >= 0);
@@ -994,6 +1057,7 @@ void FEMesh::UpdateFaceElementTable()
 	if ((NF == 0) || (NE == 0)) return;
 
 	// clear all face-element connectivity
+#pragma omp parallel for
 	for (int i = 0; i<NF; ++i)
 	{
 		FEFace& f = Face(i);
@@ -1002,6 +1066,7 @@ void FEMesh::UpdateFaceElementTable()
 		f.m_elem[2].eid = -1; f.m_elem[2].lid = -1;
 	}
 
+#pragma omp parallel for
 	for (int i = 0; i<NE; ++i)
 	{
 		FEElement& el = Element(i);
@@ -1021,55 +1086,65 @@ void FEMesh::UpdateFaceElementTable()
 		}
 	}
 
-	// first build the node element table
-	FENodeElementList NET;
-	NET.Build(this);
-
-	// loop over all faces
-	FEFace f2;
-	for (int i = 0; i<NF; ++i)
-	{
-		FEFace& face = Face(i);
+	// put the element faces and the mesh faces in buckets
+	FEItemBuckets EFB;
+	BuildElementFaceBuckets(*this, EFB);
 
-		int n0 = face.n[0];
-		int nval = NET.Valence(n0);
-		int m = 0;
-
-		// check shell elements first
-		for (int j = 0; j < nval; ++j)
+	int NN = Nodes();
+	vector<int> keys(NF);
+#pragma omp parallel for
+	for (int i = 0; i < NF; ++i) keys[i] = lowestCornerNode(Face(i));
+	FEItemBuckets FB;
+	FB.Build(NN, keys, 1);
+
+	// process all faces in a bucket
+#pragma omp parallel
+	{
+		FEFace f2;
+#pragma omp for schedule(dynamic, 1024)
+		for (int n = 0; n < NN; ++n)
 		{
-			int eid = NET.ElementIndex(n0, j);
-			FEElement_* pej = ElementPtr(eid);
-
-			if (pej->IsShell())
+			int nfb = FB.Size(n);
+			int neb = EFB.Size(n);
+			for (int a = 0; a < nfb; ++a)
 			{
-				pej->GetShellFace(f2);
-				if (f2 == face)
+				int i = FB.Item(n, a).eid;
+				FEFace& face = Face(i);
+				int m = 0;
+
+				// check shell elements first
+				for (int j = 0; j < neb; ++j)
 				{
-					assert(m == 0);
-					if (m == 0)
+					int eid = EFB.Item(n, j).eid;
+					FEElement_* pej = ElementPtr(eid);
+
+					if (pej->IsShell())
 					{
-						face.m_elem[m].eid = eid;
-						face.m_elem[m++].lid = 0;
-						pej->m_face[0] = i;
+						pej->GetShellFace(f2);
+						if (f2 == face)
+						{
+							assert(m == 0);
+							if (m == 0)
+							{
+								face.m_elem[m].eid = eid;
+								face.m_elem[m++].lid = 0;
+								pej->m_face[0] = i;
+							}
+							break;
+						}
 					}
-					break;
 				}
-			}
-		}
-
-		// now, process solids
-		for (int j=0; j<nval; ++j)
-		{
-			int eid = NET.ElementIndex(n0, j);
-			FEElement_* pej = ElementPtr(eid);
 
-			// solid elements
-			int n = pej->Faces();
-			for (int k = 0; k<n; ++k)
-			{
-				if (pej->m_face[k] == -1)
+				// now, process solids
+				for (int j = 0; j < neb; ++j)
 				{
+					int eid = EFB.Item(n, j).eid;
+					int k = EFB.Item(n, j).lid;
+					FEElement_* pej = ElementPtr(eid);
+
+					// solid elements
+					if (pej->IsShell() || (pej->m_face[k] != -1)) continue;
+
 					pej->GetFace(k, f2);
 					if (f2 == face)
 					{
@@ -1123,10 +1198,10 @@ void FEMesh::UpdateFaceElementTable()
 						pej->m_face[k] = i;
 					}
 				}
+
+				assert(face.m_elem[0].eid != -1);
 			}
 		}
-
-		assert(face.m_elem[0].eid != -1);
 	}
 
 	MarkExteriorFaces();
@@ -1191,36 +1266,53 @@ void FEMesh::UpdateFaceNeighbors()
 	}
 	while (S.empty() == false);
 
-	// build the node-face table
-	FENodeFaceList NFT;
-	NFT.Build(this);
+	// put the face edges in buckets, keyed by their lowest end node
+	int NN = Nodes();
+	const int M = FEItemBuckets::MAX_ITEMS;
+	vector<int> keys(M * NF, -1);
+#pragma omp parallel for
+	for (int i = 0; i < NF; ++i)
+	{
+		FEFace& f = Face(i);
+		int n[4];
+		int ne = f.Edges();
+		for (int j = 0; j < ne; ++j)
+		{
+			f.m_nbr[j] = -1;
+			f.GetEdgeNodes(j, n);
+			keys[M * i + j] = (n[0] < n[1] ? n[0] : n[1]);
+		}
+	}
+	FEItemBuckets EB;
+	EB.Build(NN, keys);
 
 	// find all face neighbours
-	int n[4];
-	for (int i = 0; i<NF; ++i)
+	// The faces of a bucket are sorted, so we pick the same neighbor as a search over the node-face table.
+#pragma omp parallel for schedule(dynamic, 1024)
+	for (int k = 0; k < NN; ++k)
 	{
-		FEFace* pf = FacePtr(i);
-
-		int ne = pf->Edges();
-		for (int j = 0; j<ne; ++j)
+		int nb = EB.Size(k);
+		for (int a = 0; a < nb; ++a)
 		{
-			pf->GetEdgeNodes(j, n);
-			int nval = NFT.Valence(n[0]);
-			pf->m_nbr[j] = -1;
-			for (int k = 0; k<nval; ++k)
+			const FEItemBuckets::ITEM& ia = EB.Item(k, a);
+			FEFace* pf = FacePtr(ia.eid);
+			int n[4];
+			pf->GetEdgeNodes(ia.lid, n);
+			for (int b = 0; b < nb; ++b)
 			{
-				FEFace* pfn = NFT.Face(n[0], k);
-				if (pfn != pf)
+				const FEItemBuckets::ITEM& ib = EB.Item(k, b);
+				if (ib.eid == ia.eid) continue;
+
+				FEFace* pfn = FacePtr(ib.eid);
+
+				// See if the faces share an edge
+				if (pfn->HasEdge(n[0], n[1]) && (pf->m_ntag == pfn->m_ntag))
 				{
-					// See if the faces share an edge
-					if (pfn->HasEdge(n[0], n[1]) && (pf->m_ntag == pfn->m_ntag))
+					// see if they are both external or both internal
+					if (isValidFaceNeighbor(*pf, *pfn))
 					{
-						// see if they are both external or both internal
-						if (isValidFaceNeighbor(*pf, *pfn))
-						{
-							pf->m_nbr[j] = NFT.FaceIndex(n[0], k);
-							break;
-						}
+						pf->m_nbr[ia.lid] = ib.eid;
+						break;
 					}
 				}
 			}
@@ -1390,6 +1482,27 @@ FEMesh* FEMesh::ExtractFaces(bool selectedOnly)
 	return pm;
 }
 
+//-----------------------------------------------------------------------------
+// helper function for writing a bulk array of mesh item data. The function f(i)
+// returns the value of item i. Values are passed to the archive in batches.
+template <typename T, class F> static void writeArray(OArchive& ar, unsigned int nid, int items, F f)
+{
+	const int BATCH = 4096;
+	ar.BeginArray(nid, (size_t)items * sizeof(T));
+	std::vector<T> buf; buf.reserve(BATCH);
+	for (int i = 0; i < items; ++i)
+	{
+		buf.push_back(f(i));
+		if (buf.size() == BATCH)
+		{
+			ar.WriteArrayData(&buf[0], buf.size() * sizeof(T));
+			buf.clear();
+		}
+	}
+	if (buf.empty() == false) ar.WriteArrayData(&buf[0], buf.size() * sizeof(T));
+	ar.EndArray();
+}
+
 //-----------------------------------------------------------------------------
 // Save mesh data to archive
 //
@@ -1411,83 +1524,83 @@ void FEMesh::Save(OArchive &ar)
 	ar.EndChunk();
 
 	// write the nodes
-	ar.BeginChunk(CID_MESH_NODE_SECTION);
+	ar.BeginChunk(CID_MESH_NODE_ARRAYS);
 	{
-		FENode* pn = NodePtr();
-		for (int i=0; i<nodes; ++i, ++pn)
-		{
-			ar.BeginChunk(CID_MESH_NODE);
-			{
-				ar.WriteChunk(CID_MESH_NODE_GID, pn->m_gid);
-				ar.WriteChunk(CID_MESH_NODE_POSITION, pn->r);
-			}
-			ar.EndChunk();
-		}
+		writeArray<int  >(ar, CID_MESH_NODE_GID     , nodes, [=](int i) { return m_Node[i].m_gid; });
+		writeArray<vec3d>(ar, CID_MESH_NODE_POSITION, nodes, [=](int i) { return m_Node[i].r; });
 	}
 	ar.EndChunk();
 
 	// write the elements
-	ar.BeginChunk(CID_MESH_ELEMENT_SECTION);
+	ar.BeginChunk(CID_MESH_ELEMENT_ARRAYS);
 	{
-		for (int i=0; i<elems; ++i)
+		writeArray<int>(ar, CID_MESH_ELEMENT_TYPE, elems, [=](int i) { return m_Elem[i].Type(); });
+		writeArray<int>(ar, CID_MESH_ELEMENT_GID , elems, [=](int i) { return m_Elem[i].m_gid; });
+
+		size_t nn = 0, nh = 0;
+		bool hasFiber = false, hasQ = false, hasQactive = false;
+		mat3d I; I.unit();
+		for (int i = 0; i < elems; ++i)
 		{
-			FEElement_* pe = ElementPtr(i);
+			const FEElement& el = m_Elem[i];
+			nn += el.Nodes();
+			if (el.IsShell()) nh += el.Nodes();
+
+			const vec3d& f = el.m_fiber;
+			if ((f.x != 0) || (f.y != 0) || (f.z != 0)) hasFiber = true;
+			if (el.m_Qactive) hasQactive = true;
+			for (int k = 0; k < 3; ++k)
+				for (int l = 0; l < 3; ++l)
+					if (el.m_Q(k, l) != I(k, l)) hasQ = true;
+		}
+
+		ar.BeginArray(CID_MESH_ELEMENT_NODES, nn * sizeof(int));
+		for (int i = 0; i < elems; ++i) ar.WriteArrayData(m_Elem[i].m_node, m_Elem[i].Nodes() * sizeof(int));
+		ar.EndArray();
 
-			ar.BeginChunk(CID_MESH_ELEMENT);
+		if (nh > 0)
+		{
+			ar.BeginArray(CID_MESH_SHELL_THICKNESS, nh * sizeof(double));
+			for (int i = 0; i < elems; ++i)
 			{
-				int ntype = pe->Type();
-				ar.WriteChunk(CID_MESH_ELEMENT_TYPE    , ntype);
-				ar.WriteChunk(CID_MESH_ELEMENT_GID     , pe->m_gid);
-				ar.WriteChunk(CID_MESH_ELEMENT_NODES   , pe->m_node, pe->Nodes());
-				ar.WriteChunk(CID_MESH_ELEMENT_FIBER   , pe->m_fiber);
-				ar.WriteChunk(CID_MESH_ELEMENT_Q_ACTIVE, pe->m_Qactive);
-				ar.WriteChunk(CID_MESH_ELEMENT_Q       , pe->m_Q);
-				if (pe->IsShell())
-					ar.WriteChunk(CID_MESH_SHELL_THICKNESS , pe->m_h, pe->Nodes());
-//				ar.WriteChunk(CID_MESH_ELEMENT_MATERIAL, mid);
+				const FEElement& el = m_Elem[i];
+				if (el.IsShell()) ar.WriteArrayData(el.m_h, el.Nodes() * sizeof(double));
 			}
-			ar.EndChunk();
+			ar.EndArray();
 		}
+
+		if (hasFiber  ) writeArray<vec3d>(ar, CID_MESH_ELEMENT_FIBER   , elems, [=](int i) { return m_Elem[i].m_fiber; });
+		if (hasQactive) writeArray<char >(ar, CID_MESH_ELEMENT_Q_ACTIVE, elems, [=](int i) { return (char)(m_Elem[i].m_Qactive ? 1 : 0); });
+		if (hasQ      ) writeArray<mat3d>(ar, CID_MESH_ELEMENT_Q       , elems, [=](int i) { return m_Elem[i].m_Q; });
 	}
 	ar.EndChunk();
 
 	// write the faces
-	ar.BeginChunk(CID_MESH_FACE_SECTION);
+	ar.BeginChunk(CID_MESH_FACE_ARRAYS);
 	{
-		FEFace* pf = FacePtr();
-		for (int i=0; i<faces; ++i, ++pf)
-		{
-			ar.BeginChunk(CID_MESH_FACE);
-			{
-				int nn = pf->Nodes();
-				int ntype = pf->Type();
-				assert(ntype != FE_FACE_INVALID_TYPE);
-				ar.WriteChunk(CID_MESH_FACE_TYPE    , ntype);
-				ar.WriteChunk(CID_MESH_FACE_GID     , pf->m_gid);
-				ar.WriteChunk(CID_MESH_FACE_NODES   , pf->n, pf->Nodes());
-				ar.WriteChunk(CID_MESH_FACE_SMOOTHID, pf->m_sid);
-			}
-			ar.EndChunk();
-		}
+		writeArray<int>(ar, CID_MESH_FACE_TYPE    , faces, [=](int i) { assert(m_Face[i].Type() != FE_FACE_INVALID_TYPE); return m_Face[i].Type(); });
+		writeArray<int>(ar, CID_MESH_FACE_GID     , faces, [=](int i) { return m_Face[i].m_gid; });
+		writeArray<int>(ar, CID_MESH_FACE_SMOOTHID, faces, [=](int i) { return m_Face[i].m_sid; });
+
+		size_t nn = 0;
+		for (int i = 0; i < faces; ++i) nn += m_Face[i].Nodes();
+		ar.BeginArray(CID_MESH_FACE_NODES, nn * sizeof(int));
+		for (int i = 0; i < faces; ++i) ar.WriteArrayData(m_Face[i].n, m_Face[i].Nodes() * sizeof(int));
+		ar.EndArray();
 	}
 	ar.EndChunk();
 
 	// write the edges
-	ar.BeginChunk(CID_MESH_EDGE_SECTION);
+	ar.BeginChunk(CID_MESH_EDGE_ARRAYS);
 	{
-		FEEdge* pe = EdgePtr();
-		for (int i=0; i<edges; ++i, ++pe)
-		{
-			int nn = pe->Nodes();
-			int ntype = pe->Type();
-			ar.BeginChunk(CID_MESH_EDGE);
-			{
-				ar.WriteChunk(CID_MESH_EDGE_TYPE, ntype);
-				ar.WriteChunk(CID_MESH_EDGE_GID, pe->m_gid);
-				ar.WriteChunk(CID_MESH_EDGE_NODES, pe->n, nn);
-			}
-			ar.EndChunk();
-		}
+		writeArray<int>(ar, CID_MESH_EDGE_TYPE, edges, [=](int i) { return m_Edge[i].Type(); });
+		writeArray<int>(ar, CID_MESH_EDGE_GID , edges, [=](int i) { return m_Edge[i].m_gid; });
+
+		size_t nn = 0;
+		for (int i = 0; i < edges; ++i) nn += m_Edge[i].Nodes();
+		ar.BeginArray(CID_MESH_EDGE_NODES, nn * sizeof(int));
+		for (int i = 0; i < edges; ++i) ar.WriteArrayData(m_Edge[i].n, m_Edge[i].Nodes() * sizeof(int));
+		ar.EndArray();
 	}
 	ar.EndChunk();
 
@@ -1694,6 +1807,145 @@ void FEMesh::Load(IArchive& ar)
 				}
 			}
 			break;
+		case CID_MESH_NODE_ARRAYS:
+			{
+				vector<int> gid;
+				vector<vec3d> r;
+				while (IArchive::IO_OK == ar.OpenChunk())
+				{
+					int nid = ar.GetChunkID();
+					switch (nid)
+					{
+					case CID_MESH_NODE_GID     : ar.ReadArray(gid); break;
+					case CID_MESH_NODE_POSITION: ar.ReadArray(r); break;
+					}
+					ar.CloseChunk();
+				}
+				if (((int)gid.size() != nodes) || ((int)r.size() != nodes)) throw ReadError("error parsing CID_MESH_NODE_ARRAYS (FEMesh::Load)");
+
+				for (int i = 0; i < nodes; ++i)
+				{
+					FENode& node = m_Node[i];
+					node.m_gid = gid[i];
+					node.r = r[i];
+				}
+			}
+			break;
+		case CID_MESH_ELEMENT_ARRAYS:
+			{
+				vector<int> type, gid, elemNodes;
+				vector<double> h;
+				vector<vec3d> fiber;
+				vector<char> Qactive;
+				vector<mat3d> Q;
+				while (IArchive::IO_OK == ar.OpenChunk())
+				{
+					int nid = ar.GetChunkID();
+					switch (nid)
+					{
+					case CID_MESH_ELEMENT_TYPE    : ar.ReadArray(type); break;
+					case CID_MESH_ELEMENT_GID     : ar.ReadArray(gid); break;
+					case CID_MESH_ELEMENT_NODES   : ar.ReadArray(elemNodes); break;
+					case CID_MESH_SHELL_THICKNESS : ar.ReadArray(h); break;
+					case CID_MESH_ELEMENT_FIBER   : ar.ReadArray(fiber); break;
+					case CID_MESH_ELEMENT_Q_ACTIVE: ar.ReadArray(Qactive); break;
+					case CID_MESH_ELEMENT_Q       : ar.ReadArray(Q); break;
+					}
+					ar.CloseChunk();
+				}
+				if (((int)type.size() != elems) || ((int)gid.size() != elems)) throw ReadError("error parsing CID_MESH_ELEMENT_ARRAYS (FEMesh::Load)");
+				if ((fiber.empty() == false) && ((int)fiber.size() != elems)) throw ReadError("error parsing CID_MESH_ELEMENT_ARRAYS (FEMesh::Load)");
+				if ((Qactive.empty() == false) && ((int)Qactive.size() != elems)) throw ReadError("error parsing CID_MESH_ELEMENT_ARRAYS (FEMesh::Load)");
+				if ((Q.empty() == false) && ((int)Q.size() != elems)) throw ReadError("error parsing CID_MESH_ELEMENT_ARRAYS (FEMesh::Load)");
+
+				size_t nn = 0, nh = 0;
+				for (int i = 0; i < elems; ++i)
+				{
+					FEElement& el = m_Elem[i];
+					el.SetType(type[i]);
+					el.m_gid = gid[i];
+
+					int ne = el.Nodes();
+					if (nn + ne > elemNodes.size()) throw ReadError("error parsing CID_MESH_ELEMENT_ARRAYS (FEMesh::Load)");
+					for (int j = 0; j < ne; ++j) el.m_node[j] = elemNodes[nn + j];
+					nn += ne;
+
+					if (el.IsShell())
+					{
+						if (nh + ne > h.size()) throw ReadError("error parsing CID_MESH_ELEMENT_ARRAYS (FEMesh::Load)");
+						int n = (ne > 9 ? 9 : ne);
+						for (int j = 0; j < n; ++j) el.m_h[j] = h[nh + j];
+						nh += ne;
+					}
+
+					if (fiber.empty() == false) el.m_fiber = fiber[i];
+					if (Qactive.empty() == false) el.m_Qactive = (Qactive[i] != 0);
+					if (Q.empty() == false) el.m_Q = Q[i];
+				}
+			}
+			break;
+		case CID_MESH_FACE_ARRAYS:
+			{
+				vector<int> type, gid, sid, faceNodes;
+				while (IArchive::IO_OK == ar.OpenChunk())
+				{
+					int nid = ar.GetChunkID();
+					switch (nid)
+					{
+					case CID_MESH_FACE_TYPE    : ar.ReadArray(type); break;
+					case CID_MESH_FACE_GID     : ar.ReadArray(gid); break;
+					case CID_MESH_FACE_SMOOTHID: ar.ReadArray(sid); break;
+					case CID_MESH_FACE_NODES   : ar.ReadArray(faceNodes); break;
+					}
+					ar.CloseChunk();
+				}
+				if (((int)type.size() != faces) || ((int)gid.size() != faces) || ((int)sid.size() != faces)) throw ReadError("error parsing CID_MESH_FACE_ARRAYS (FEMesh::Load)");
+
+				size_t nn = 0;
+				for (int i = 0; i < faces; ++i)
+				{
+					FEFace& face = m_Face[i];
+					face.SetType((FEFaceType)type[i]);
+					face.m_gid = gid[i];
+					face.m_sid = sid[i];
+
+					int nf = face.Nodes();
+					if (nn + nf > faceNodes.size()) throw ReadError("error parsing CID_MESH_FACE_ARRAYS (FEMesh::Load)");
+					for (int j = 0; j < nf; ++j) face.n[j] = faceNodes[nn + j];
+					nn += nf;
+				}
+			}
+			break;
+		case CID_MESH_EDGE_ARRAYS:
+			{
+				vector<int> type, gid, edgeNodes;
+				while (IArchive::IO_OK == ar.OpenChunk())
+				{
+					int nid = ar.GetChunkID();
+					switch (nid)
+					{
+					case CID_MESH_EDGE_TYPE : ar.ReadArray(type); break;
+					case CID_MESH_EDGE_GID  : ar.ReadArray(gid); break;
+					case CID_MESH_EDGE_NODES: ar.ReadArray(edgeNodes); break;
+					}
+					ar.CloseChunk();
+				}
+				if (((int)type.size() != edges) || ((int)gid.size() != edges)) throw ReadError("error parsing CID_MESH_EDGE_ARRAYS (FEMesh::Load)");
+
+				size_t nn = 0;
+				for (int i = 0; i < edges; ++i)
+				{
+					FEEdge& edge = m_Edge[i];
+					edge.SetType((FEEdgeType)type[i]);
+					edge.m_gid = gid[i];
+
+					int ne = edge.Nodes();
+					if (nn + ne > edgeNodes.size()) throw ReadError("error parsing CID_MESH_EDGE_ARRAYS (FEMesh::Load)");
+					for (int j = 0; j < ne; ++j) edge.n[j] = edgeNodes[nn + j];
+					nn += ne;
+				}
+			}
+			break;
 		case CID_MESH_ELEMENT_SECTION:
 			{
 				int n = 0;
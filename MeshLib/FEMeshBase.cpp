@@ -30,6 +30,7 @@ SOFTWARE.*/
 //-----------------------------------------------------------------------------
 FEMeshBase::FEMeshBase()
 {
+	m_faceTreeValid = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -94,7 +95,7 @@ bool FEMeshBase::IsCreaseEdge(int n0, int n1)
 }
 
 //-----------------------------------------------------------------------------
-const vector<NodeFaceRef>& FEMeshBase::NodeFaceList(int n) const 
+NodeFaceRefList FEMeshBase::NodeFaceList(int n) const 
 { 
 	return m_NFL.FaceList(n); 
 }
@@ -217,6 +218,9 @@ void FEMeshBase::AutoSmooth(double angleDegrees)
 //
 void FEMeshBase::UpdateNormals()
 {
+	// the node positions may have changed
+	ClearSearchTree();
+
 	int NN = Nodes();
 	int NF = Faces();
 
@@ -332,6 +336,37 @@ void FEMeshBase::SmoothByPartition()
 	UpdateNormals();
 }
 
+//-----------------------------------------------------------------------------
+const FEFacetBVH& FEMeshBase::FaceSearchTree() const
+{
+	int NF = Faces();
+	if ((m_faceTreeValid == false) || (m_faceTree.Facets() != NF))
+	{
+		int NN = Nodes();
+		vector<vec3d> r(NN);
+		for (int i = 0; i < NN; ++i) r[i] = m_Node[i].r;
+
+		// only the face corners are used for intersections
+		vector<int> fn(4 * NF, -1);
+		for (int i = 0; i < NF; ++i)
+		{
+			const FEFace& f = m_Face[i];
+			int nc = (f.Shape() == FE_FACE_TRI ? 3 : 4);
+			for (int j = 0; j < nc; ++j) fn[4 * i + j] = f.n[j];
+		}
+
+		m_faceTree.Build(fn, r);
+		m_faceTreeValid = true;
+	}
+	return m_faceTree;
+}
+
+//-----------------------------------------------------------------------------
+void FEMeshBase::ClearSearchTree()
+{
+	m_faceTreeValid = false;
+}
+
 //-----------------------------------------------------------------------------
 void FEMeshBase::UpdateMesh()
 {
@@ -660,7 +695,7 @@ void FEMeshBase::GetNodeNeighbors(int inode, int levels, std::set<int>& nl1)
 		for (it = nl1.begin(); it != nl1.end(); ++it)
 		{
 			// get the node-face list
-			const vector<NodeFaceRef>& nfl = NodeFaceList(*it);
+			NodeFaceRefList nfl = NodeFaceList(*it);
 			int NF = nfl.size();
 
 			// add the other nodes
@@ -676,7 +711,7 @@ void FEMeshBase::GetNodeNeighbors(int inode, int levels, std::set<int>& nl1)
 		for (it = nl1.begin(); it != nl1.end(); ++it)
 		{
 			// get the node-face list
-			const vector<NodeFaceRef>& nfl = NodeFaceList(*it);
+			NodeFaceRefList nfl = NodeFaceList(*it);
 			int NF = nfl.size();
 
 			// add the other nodes
@@ -33,6 +33,7 @@ SOFTWARE.*/
 #include "FEFace.h"
 #include "FELineMesh.h"
 #include "FENodeFaceList.h"
+#include "FEFacetBVH.h"
 
 //-------------------------------------------------------------------
 // Base class for mesh classes.
@@ -108,7 +109,15 @@ public:
 
 	bool IsCreaseEdge(int n0, int n1);
 
-	const vector<NodeFaceRef>& NodeFaceList(int n) const;
+	NodeFaceRefList NodeFaceList(int n) const;
+
+public:
+	// search tree over the faces, used for picking. It is built on first use and
+	// cleared when the normals are updated (i.e. when the mesh or its nodes change).
+	const FEFacetBVH& FaceSearchTree() const;
+
+	// clear the search trees (call this when nodes are moved without updating the mesh)
+	virtual void ClearSearchTree();
 
 protected:
 	void RemoveEdges(int ntag);
@@ -118,6 +127,9 @@ protected:
 	std::vector<FEFace>		m_Face;	//!< FE faces
 
 	FENodeFaceList		m_NFL;
+
+	mutable FEFacetBVH	m_faceTree;			// face search tree
+	mutable bool		m_faceTreeValid;	// is the search tree up to date?
 };
 
 //-------------------------------------------------------------------
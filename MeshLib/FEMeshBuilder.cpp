@@ -25,6 +25,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.*/
 
 #include "FEMeshBuilder.h"
+#include "FEItemBuckets.h"
 #include "FEMesh.h"
 #include <GeomLib/GObject.h>
 #include <MeshLib/FEFaceEdgeList.h>
@@ -1892,8 +1893,11 @@ void FEMeshBuilder::AutoPartitionNodes()
 void FEMeshBuilder::BuildFaces()
 {
 	// let's count them first
-	int faces = 0;
+	// Solid faces are stored first, followed by the shell faces, 
+	// so we keep separate offsets for each element.
 	int elems = m_mesh.Elements();
+	vector<int> solidOffset(elems + 1, 0), shellOffset(elems + 1, 0);
+#pragma omp parallel for
 	for (int i = 0; i<elems; i++)
 	{
 		FEElement& el = m_mesh.Element(i);
@@ -1902,6 +1906,7 @@ void FEMeshBuilder::BuildFaces()
 		// we create a face if an element does not have a neighbor
 		// or if the neighbor has a different gid and is not a shell.
 		// Note that we need to make sure we don't double-count.
+		int faces = 0;
 		int n = el.Faces();
 		for (int j = 0; j<n; ++j)
 		{
@@ -1915,14 +1920,18 @@ void FEMeshBuilder::BuildFaces()
 				}
 			}
 		}
+		solidOffset[i + 1] = faces;
 
 		// shell elements always add a face
-		if (el.IsShell())
-		{
-			++faces;
-		}
+		shellOffset[i + 1] = (el.IsShell() ? 1 : 0);
 	}
 
+	// convert to offsets
+	for (int i = 0; i<elems; ++i) solidOffset[i + 1] += solidOffset[i];
+	shellOffset[0] = solidOffset[elems];
+	for (int i = 0; i<elems; ++i) shellOffset[i + 1] += shellOffset[i];
+	int faces = shellOffset[elems];
+
 	// make sure we have faces
 	if (faces == 0)
 	{
@@ -1934,14 +1943,13 @@ void FEMeshBuilder::BuildFaces()
 	m_mesh.m_Face.resize(faces);
 
 	// create the faces
-	FEFace* pf = m_mesh.FacePtr();
-	int nf = 0;
-
-	// solid elements
+#pragma omp parallel for
 	for (int i = 0; i<elems; i++)
 	{
 		FEElement& el = m_mesh.Element(i);
 
+		// solid elements
+		int nf = solidOffset[i];
 		int n = el.Faces();
 		for (int j = 0; j<n; j++)
 		{
@@ -1950,34 +1958,30 @@ void FEMeshBuilder::BuildFaces()
 			FEElement_* pen = (nbid == -1 ? 0 : m_mesh.ElementPtr(nbid));
 			if (pen == 0)
 			{
+				FEFace* pf = m_mesh.FacePtr(nf);
 				el.GetFace(j, *pf);
 				pf->SetExterior(true);
 				pf->SetID(nf + 1);
-				++pf; ++nf;
+				++nf;
 			}
 			else if ((el.m_gid < pen->m_gid) && (pen->IsShell() == false))
 			{
+				FEFace* pf = m_mesh.FacePtr(nf);
 				*pf = el.GetFace(j);
 				pf->SetExterior(false);
 				pf->SetID(nf + 1);
-				++pf; ++nf;
+				++nf;
 			}
 		}
-	}
-
-	// shell elements
-	for (int i = 0; i<elems; i++)
-	{
-		FEElement& el = m_mesh.Element(i);
 
 		// shell elements
-		int n = el.Edges();
-		if (n>0)
+		if (el.Edges() > 0)
 		{
+			nf = shellOffset[i];
+			FEFace* pf = m_mesh.FacePtr(nf);
 			el.GetShellFace(*pf);
 			pf->SetExterior(true);
 			pf->SetID(nf + 1);
-			++pf; ++nf;
 		}
 	}
 
@@ -1992,14 +1996,15 @@ void FEMeshBuilder::BuildEdges()
 	m_mesh.m_Edge.clear();
 
 	// tag all faces
-	for (int i = 0; i < m_mesh.Faces(); ++i) m_mesh.Face(i).m_ntag = i;
+	int NF = m_mesh.Faces();
+	for (int i = 0; i < NF; ++i) m_mesh.Face(i).m_ntag = i;
 
-	// keep node-edge table to prevent adding duplicate edges
+	// Collect the face edges that can become mesh edges, and put them
+	// in buckets, keyed by their lowest end node.
 	int NN = m_mesh.Nodes();
-	vector<vector<int> > NET(NN);
-
-	// loop over all faces
-	int NF = m_mesh.Faces();
+	const int M = FEItemBuckets::MAX_ITEMS;
+	vector<int> keys(M * NF, -1);
+#pragma omp parallel for
 	for (int i = 0; i<NF; ++i)
 	{
 		FEFace& f = m_mesh.Face(i);
@@ -2010,37 +2015,64 @@ void FEMeshBuilder::BuildEdges()
 			if (((pfn == 0) && f.IsExternal()) || (pfn && (f.m_ntag < pfn->m_ntag)))
 			{
 				FEEdge e = f.GetEdge(j);
+				keys[M * i + j] = (e.n[0] < e.n[1] ? e.n[0] : e.n[1]);
+			}
+		}
+	}
+	FEItemBuckets EB;
+	EB.Build(NN, keys);
 
-				// see if this node already exists
-				bool bfound = false;
-				vector<int>& net = NET[e.n[0]];
-				for (int l = 0; l < net.size(); ++l)
-				{
-					FEEdge& el = m_mesh.Edge(net[l]);
-					if (el == e)
-					{
-						// the edge already exists, so don't add it
-						bfound = true;
-						break;
-					}
-				}
-
-				// If not, then process and add
-				if (bfound == false)
+	// Only the first of a set of equal edges is added. The edges of a bucket are 
+	// sorted by face, so this is the same edge that a single pass over the faces would add.
+#pragma omp parallel for schedule(dynamic, 1024)
+	for (int n = 0; n < NN; ++n)
+	{
+		int nb = EB.Size(n);
+		for (int a = 1; a < nb; ++a)
+		{
+			const FEItemBuckets::ITEM& ia = EB.Item(n, a);
+			FEEdge ea = m_mesh.Face(ia.eid).GetEdge(ia.lid);
+			for (int b = 0; b < a; ++b)
+			{
+				const FEItemBuckets::ITEM& ib = EB.Item(n, b);
+				if (m_mesh.Face(ib.eid).GetEdge(ib.lid) == ea)
 				{
-					e.m_gid = ((pfn == 0) || (f.m_gid != pfn->m_gid) ? 0 : -1);
-					e.SetID((int)m_mesh.m_Edge.size() + 1);
-					e.SetExterior(e.m_gid == 0);
-
-					int edgeIndex = m_mesh.Edges();
-					m_mesh.m_Edge.push_back(e);
-					NET[e.n[0]].push_back(edgeIndex);
-					NET[e.n[1]].push_back(edgeIndex);
+					keys[M * ia.eid + ia.lid] = -1;
+					break;
 				}
 			}
 		}
 	}
 
+	// number the edges in face order
+	vector<int> offset(NF + 1, 0);
+	for (int i = 0; i < NF; ++i)
+	{
+		int m = 0;
+		for (int j = 0; j < M; ++j) if (keys[M * i + j] >= 0) m++;
+		offset[i + 1] = offset[i] + m;
+	}
+
+	// create the edges
+	m_mesh.m_Edge.resize(offset[NF]);
+#pragma omp parallel for
+	for (int i = 0; i<NF; ++i)
+	{
+		FEFace& f = m_mesh.Face(i);
+		int edgeIndex = offset[i];
+		for (int j = 0; j<M; ++j)
+		{
+			if (keys[M * i + j] < 0) continue;
+
+			FEFace* pfn = m_mesh.FacePtr(f.m_nbr[j]);
+			FEEdge e = f.GetEdge(j);
+			e.m_gid = ((pfn == 0) || (f.m_gid != pfn->m_gid) ? 0 : -1);
+			e.SetID(edgeIndex + 1);
+			e.SetExterior(e.m_gid == 0);
+			m_mesh.Edge(edgeIndex++) = e;
+		}
+	}
+
 	m_mesh.RebuildEdgeData();
 }
 
@@ -0,0 +1,258 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "FEMeshPositionDelta.h"
+#include "FEMesh.h"
+#include <zlib.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+static bool sameVec(const vec3d& a, const vec3d& b)
+{
+	return ((a.x == b.x) && (a.y == b.y) && (a.z == b.z));
+}
+
+//-----------------------------------------------------------------------------
+static bool sameElement(const FEElement_& a, const FEElement_& b)
+{
+	if (a.Type() != b.Type()) return false;
+	if ((a.m_gid != b.m_gid) || (a.m_MatID != b.m_MatID) || (a.m_nid != b.m_nid)) return false;
+	if (a.GetFEState() != b.GetFEState()) return false;
+
+	int ne = a.Nodes();
+	for (int j = 0; j < ne; ++j) if (a.m_node[j] != b.m_node[j]) return false;
+	if (a.IsShell())
+	{
+		int nh = (ne > 9 ? 9 : ne);
+		for (int j = 0; j < nh; ++j) if (a.m_h[j] != b.m_h[j]) return false;
+	}
+
+	if (sameVec(a.m_fiber, b.m_fiber) == false) return false;
+	if (a.m_Qactive != b.m_Qactive) return false;
+	for (int k = 0; k < 3; ++k)
+		for (int l = 0; l < 3; ++l)
+			if (a.m_Q(k, l) != b.m_Q(k, l)) return false;
+	if (a.m_a0 != b.m_a0) return false;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+FEMeshPositionDelta::FEMeshPositionDelta()
+{
+	m_nodes = 0;
+	m_fp = nullptr;
+	m_zsize = 0;
+}
+
+//-----------------------------------------------------------------------------
+FEMeshPositionDelta::~FEMeshPositionDelta()
+{
+	Clear();
+}
+
+//-----------------------------------------------------------------------------
+void FEMeshPositionDelta::Clear()
+{
+	m_nodes = 0;
+	m_node.clear(); m_node.shrink_to_fit();
+	m_pos.clear(); m_pos.shrink_to_fit();
+	if (m_fp) fclose(m_fp);
+	m_fp = nullptr;
+	m_zsize = 0;
+}
+
+//-----------------------------------------------------------------------------
+bool FEMeshPositionDelta::PositionsOnly(const FEMeshBase& meshA, const FEMeshBase& meshB)
+{
+	if (&meshA == &meshB) return false;
+
+	// compare nodes
+	int NN = meshA.Nodes();
+	if (meshB.Nodes() != NN) return false;
+	for (int i = 0; i < NN; ++i)
+	{
+		const FENode& na = meshA.Node(i);
+		const FENode& nb = meshB.Node(i);
+		if ((na.m_gid != nb.m_gid) || (na.m_nid != nb.m_nid) || (na.GetFEState() != nb.GetFEState())) return false;
+	}
+
+	// compare faces
+	int NF = meshA.Faces();
+	if (meshB.Faces() != NF) return false;
+	for (int i = 0; i < NF; ++i)
+	{
+		const FEFace& fa = meshA.Face(i);
+		const FEFace& fb = meshB.Face(i);
+		if ((fa.Type() != fb.Type()) || (fa.m_gid != fb.m_gid) || (fa.m_sid != fb.m_sid)) return false;
+		if (fa.GetFEState() != fb.GetFEState()) return false;
+		int nf = fa.Nodes();
+		for (int j = 0; j < nf; ++j) if (fa.n[j] != fb.n[j]) return false;
+	}
+
+	// compare edges
+	int NC = meshA.Edges();
+	if (meshB.Edges() != NC) return false;
+	for (int i = 0; i < NC; ++i)
+	{
+		const FEEdge& ea = meshA.Edge(i);
+		const FEEdge& eb = meshB.Edge(i);
+		if ((ea.Type() != eb.Type()) || (ea.m_gid != eb.m_gid)) return false;
+		if (ea.GetFEState() != eb.GetFEState()) return false;
+		int ne = ea.Nodes();
+		for (int j = 0; j < ne; ++j) if (ea.n[j] != eb.n[j]) return false;
+	}
+
+	// compare elements
+	const FECoreMesh* pa = dynamic_cast<const FECoreMesh*>(&meshA);
+	const FECoreMesh* pb = dynamic_cast<const FECoreMesh*>(&meshB);
+	if ((pa == nullptr) != (pb == nullptr)) return false;
+	if (pa)
+	{
+		int NE = pa->Elements();
+		if (pb->Elements() != NE) return false;
+		for (int i = 0; i < NE; ++i)
+		{
+			if (sameElement(pa->ElementRef(i), pb->ElementRef(i)) == false) return false;
+		}
+	}
+
+	// We don't compare mesh data, so we only accept meshes without it.
+	const FEMesh* ma = dynamic_cast<const FEMesh*>(&meshA);
+	const FEMesh* mb = dynamic_cast<const FEMesh*>(&meshB);
+	if (ma && (ma->MeshDataFields() > 0)) return false;
+	if (mb && (mb->MeshDataFields() > 0)) return false;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FEMeshPositionDelta::Build(const FEMeshBase& meshA, const FEMeshBase& meshB)
+{
+	Clear();
+
+	int NN = meshA.Nodes();
+	assert(meshB.Nodes() == NN);
+	for (int i = 0; i < NN; ++i)
+	{
+		const vec3d& ra = meshA.Node(i).r;
+		if (sameVec(ra, meshB.Node(i).r) == false)
+		{
+			m_node.push_back(i);
+			m_pos.push_back(ra);
+		}
+	}
+	m_node.shrink_to_fit();
+	m_pos.shrink_to_fit();
+	m_nodes = (int)m_node.size();
+}
+
+//-----------------------------------------------------------------------------
+bool FEMeshPositionDelta::Swap(FEMeshBase& mesh)
+{
+	if (Restore() == false) return false;
+	assert((int)m_node.size() == m_nodes);
+
+#pragma omp parallel for
+	for (int i = 0; i < m_nodes; ++i)
+	{
+		FENode& node = mesh.Node(m_node[i]);
+		vec3d r = node.r;
+		node.r = m_pos[i];
+		m_pos[i] = r;
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEMeshPositionDelta::Spill()
+{
+	if (IsSpilled() || (m_nodes == 0)) return true;
+
+	// pack the data in one buffer
+	size_t ni = m_node.size() * sizeof(int);
+	size_t nr = m_pos.size() * sizeof(vec3d);
+	std::vector<unsigned char> buf(ni + nr);
+	memcpy(&buf[0], &m_node[0], ni);
+	memcpy(&buf[ni], &m_pos[0], nr);
+
+	// compress it
+	uLongf nz = compressBound((uLong)buf.size());
+	std::vector<unsigned char> zbuf(nz);
+	if (compress2(&zbuf[0], &nz, &buf[0], (uLong)buf.size(), Z_BEST_SPEED) != Z_OK) return false;
+
+	// write it to a temporary file. The file is deleted when it is closed.
+	FILE* fp = tmpfile();
+	if (fp == nullptr) return false;
+	if (fwrite(&zbuf[0], 1, nz, fp) != nz)
+	{
+		fclose(fp);
+		return false;
+	}
+
+	m_fp = fp;
+	m_zsize = nz;
+	m_node.clear(); m_node.shrink_to_fit();
+	m_pos.clear(); m_pos.shrink_to_fit();
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEMeshPositionDelta::Restore()
+{
+	if (m_fp == nullptr) return true;
+
+	std::vector<unsigned char> zbuf(m_zsize);
+	rewind(m_fp);
+	if (fread(&zbuf[0], 1, m_zsize, m_fp) != m_zsize) return false;
+
+	size_t ni = m_nodes * sizeof(int);
+	size_t nr = m_nodes * sizeof(vec3d);
+	std::vector<unsigned char> buf(ni + nr);
+	uLongf nsize = (uLongf)buf.size();
+	if (uncompress(&buf[0], &nsize, &zbuf[0], (uLong)m_zsize) != Z_OK) return false;
+	if (nsize != buf.size()) return false;
+
+	m_node.resize(m_nodes);
+	m_pos.resize(m_nodes);
+	memcpy(&m_node[0], &buf[0], ni);
+	memcpy(&m_pos[0], &buf[ni], nr);
+
+	fclose(m_fp);
+	m_fp = nullptr;
+	m_zsize = 0;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+size_t FEMeshPositionDelta::MemoryUsage() const
+{
+	return sizeof(FEMeshPositionDelta) + m_node.capacity() * sizeof(int) + m_pos.capacity() * sizeof(vec3d);
+}
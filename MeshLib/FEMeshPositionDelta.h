@@ -0,0 +1,83 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <MathLib/math3d.h>
+#include <vector>
+#include <stdio.h>
+
+class FEMeshBase;
+
+//-----------------------------------------------------------------------------
+// This class stores the node positions that differ between two meshes that
+// otherwise have the same nodes, elements, faces, and edges. It is used to undo
+// and redo operations that only move nodes, without keeping a copy of the mesh.
+// The stored positions can be compressed and moved to a temporary file. 
+class FEMeshPositionDelta
+{
+public:
+	FEMeshPositionDelta();
+	~FEMeshPositionDelta();
+
+	// Check if the two meshes only differ in their node positions
+	static bool PositionsOnly(const FEMeshBase& meshA, const FEMeshBase& meshB);
+
+	// Store the positions of meshA that differ from meshB.
+	void Build(const FEMeshBase& meshA, const FEMeshBase& meshB);
+
+	// Swap the stored positions with the node positions of the mesh. 
+	// Calling this again will restore the mesh's positions.
+	// Note that the mesh still needs to be updated afterwards.
+	// Returns false if the positions could not be read back from the temporary file.
+	bool Swap(FEMeshBase& mesh);
+
+	// Compress the positions and move them to a temporary file.
+	bool Spill();
+
+	// Are the positions stored in a file?
+	bool IsSpilled() const { return (m_fp != nullptr); }
+
+	// number of nodes that are stored
+	int Nodes() const { return m_nodes; }
+
+	// memory used by this object (in bytes)
+	size_t MemoryUsage() const;
+
+	// clear all data
+	void Clear();
+
+private:
+	bool Restore();
+
+private:
+	int					m_nodes;	// nodes stored
+	std::vector<int>	m_node;		// node indices
+	std::vector<vec3d>	m_pos;		// node positions
+
+	FILE*	m_fp;		// temporary file with compressed positions
+	size_t	m_zsize;	// size of compressed data
+};
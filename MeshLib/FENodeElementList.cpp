@@ -25,6 +25,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.*/
 
 #include "FENodeElementList.h"
+#include <algorithm>
 
 FENodeElementList::FENodeElementList()
 {
@@ -39,13 +40,35 @@ void FENodeElementList::Build(FECoreMesh* pm)
 {
 	m_pm = pm;
 	assert(m_pm);
+	m_off.clear();
 	m_elem.clear();
 
 	int NN = m_pm->Nodes();
 	int NE = m_pm->Elements();
 	if ((NE == 0) || (NN == 0)) return;
 
-	m_elem.resize(NN);
+	// count the valence of each node
+	m_off.assign(NN + 1, 0);
+#pragma omp parallel for
+	for (int i=0; i<NE; ++i)
+	{
+		FEElement_& el = m_pm->ElementRef(i);
+		int ne = el.Nodes();
+		for (int j=0; j<ne; ++j)
+		{
+			int n = el.m_node[j];
+#pragma omp atomic
+			m_off[n + 1]++;
+		}
+	}
+
+	// convert to offsets
+	for (int i=0; i<NN; ++i) m_off[i + 1] += m_off[i];
+
+	// fill the element list
+	m_elem.resize(m_off[NN]);
+	vector<int> pos(m_off.begin(), m_off.end() - 1);
+#pragma omp parallel for
 	for (int i=0; i<NE; ++i)
 	{
 		FEElement_& el = m_pm->ElementRef(i);
@@ -54,26 +77,36 @@ void FENodeElementList::Build(FECoreMesh* pm)
 		{
 			int n = el.m_node[j];
 
-			vector<NodeElemRef>& lj = m_elem[n];
+			int k;
+#pragma omp atomic capture
+			k = pos[n]++;
 
-			NodeElemRef ref;
+			NodeElemRef& ref = m_elem[k];
 			ref.eid = i;
 			ref.nid = j;
 			ref.pe = &el;
-
-			lj.push_back(ref);
 		}
 	}
+
+	// the fill order is not deterministic, so restore element order for each node
+#pragma omp parallel for schedule(static, 1024)
+	for (int i=0; i<NN; ++i)
+	{
+		std::sort(m_elem.begin() + m_off[i], m_elem.begin() + m_off[i + 1], [](const NodeElemRef& a, const NodeElemRef& b) {
+			return (a.eid < b.eid) || ((a.eid == b.eid) && (a.nid < b.nid));
+		});
+	}
 }
 
 void FENodeElementList::Clear()
 {
+	m_off.clear();
 	m_elem.clear();
 }
 
 bool FENodeElementList::IsEmpty() const
 {
-	return m_elem.empty();
+	return m_off.empty();
 }
 
 bool FENodeElementList::HasElement(int node, int iel) const
@@ -87,8 +120,8 @@ bool FENodeElementList::HasElement(int node, int iel) const
 
 vector<int> FENodeElementList::ElementIndexList(int n) const
 {
-	vector<int> l;
 	int nval = Valence(n);
+	vector<int> l; l.reserve(nval);
 	for (int i=0; i<nval; ++i)
 	{
 		l.push_back(ElementIndex(n, i));
@@ -30,6 +30,7 @@ SOFTWARE.*/
 //using namespace std;
 
 #include "FECoreMesh.h"
+#include "FENodeRefList.h"
 
 //-----------------------------------------------------------------------------
 // the first index is the element number
@@ -40,6 +41,12 @@ struct NodeElemRef {
 	FEElement_*	pe;	// pointer to element
 };
 
+typedef FENodeRefList<NodeElemRef>	NodeElemRefList;
+
+//-----------------------------------------------------------------------------
+// Node-to-element adjacency, stored in compressed row format: the elements of
+// node n are m_elem[m_off[n]] ... m_elem[m_off[n+1]-1].
+
 class FENodeElementList
 {
 public:
@@ -52,16 +59,17 @@ public:
 
 	bool IsEmpty() const;
 
-	int Valence(int n) const { return (int)m_elem[n].size(); }
-	FEElement_* Element(int n, int j) { return m_elem[n][j].pe; }
-	int ElementIndex(int n, int j) const { return m_elem[n][j].eid; }
+	int Valence(int n) const { return m_off[n + 1] - m_off[n]; }
+	FEElement_* Element(int n, int j) { return m_elem[m_off[n] + j].pe; }
+	int ElementIndex(int n, int j) const { return m_elem[m_off[n] + j].eid; }
 
 	bool HasElement(int node, int iel) const;
 
 	vector<int> ElementIndexList(int n) const;
-	const vector<NodeElemRef>& ElementList(int n) const { return m_elem[n]; }
+	NodeElemRefList ElementList(int n) const { return NodeElemRefList(m_elem.data() + m_off[n], Valence(n)); }
 
 protected:
 	FECoreMesh*	m_pm;
-	vector< vector<NodeElemRef> >	m_elem;
+	vector<int>			m_off;	// offset into element list (size = nodes + 1)
+	vector<NodeElemRef>	m_elem;	// element list
 };
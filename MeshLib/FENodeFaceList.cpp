@@ -27,6 +27,7 @@ SOFTWARE.*/
 #include "FENodeFaceList.h"
 #include "FEMeshBase.h"
 #include "FEFace.h"
+#include <algorithm>
 
 //-----------------------------------------------------------------------------
 FENodeFaceList::FENodeFaceList()
@@ -42,13 +43,14 @@ FENodeFaceList::~FENodeFaceList(void)
 //-----------------------------------------------------------------------------
 void FENodeFaceList::Clear()
 {
+	m_off.clear();
 	m_face.clear();
 }
 
 //-----------------------------------------------------------------------------
 bool FENodeFaceList::IsEmpty() const
 {
-	return m_face.empty();
+	return m_off.empty();
 }
 
 //-----------------------------------------------------------------------------
@@ -78,7 +80,9 @@ void FENodeFaceList::Build(FEMeshBase* pm)
 	int NN = m.Nodes();
 	int NF = m.Faces();
 
-	m_face.resize(NN);
+	// count the valence of each node
+	m_off.assign(NN + 1, 0);
+#pragma omp parallel for
 	for (int i=0; i<NF; ++i)
 	{
 		FEFace& f = m.Face(i);
@@ -86,16 +90,45 @@ void FENodeFaceList::Build(FEMeshBase* pm)
 		for (int j = 0; j<nf; ++j)
 		{
 			int n = f.n[j];
-			vector<NodeFaceRef>& li = m_face[n];
+#pragma omp atomic
+			m_off[n + 1]++;
+		}
+	}
+
+	// convert to offsets
+	for (int i=0; i<NN; ++i) m_off[i + 1] += m_off[i];
 
-			NodeFaceRef ref;
+	// fill the face list
+	m_face.resize(m_off[NN]);
+	vector<int> pos(m_off.begin(), m_off.end() - 1);
+#pragma omp parallel for
+	for (int i=0; i<NF; ++i)
+	{
+		FEFace& f = m.Face(i);
+		int nf = f.Nodes();
+		for (int j = 0; j<nf; ++j)
+		{
+			int n = f.n[j];
+
+			int k;
+#pragma omp atomic capture
+			k = pos[n]++;
+
+			NodeFaceRef& ref = m_face[k];
 			ref.fid = i;
 			ref.nid = j;
 			ref.pf = &f;
-
-			li.push_back(ref);
 		}
 	}
+
+	// the fill order is not deterministic, so restore face order for each node
+#pragma omp parallel for schedule(static, 1024)
+	for (int i=0; i<NN; ++i)
+	{
+		std::sort(m_face.begin() + m_off[i], m_face.begin() + m_off[i + 1], [](const NodeFaceRef& a, const NodeFaceRef& b) {
+			return (a.fid < b.fid) || ((a.fid == b.fid) && (a.nid < b.nid));
+		});
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -123,11 +156,13 @@ int FENodeFaceList::FindFace(const FEFace& f)
 bool FENodeFaceList::Sort(int node)
 {
 	int nval = Valence(node);
+	if (nval == 0) return true;
+	NodeFaceRef* nfl = &m_face[m_off[node]];
 	vector<NodeFaceRef> fl; fl.reserve(nval);
 
 	for (int i=0; i<nval; ++i) Face(node, i)->m_ntag = 0;
 
-	NodeFaceRef ref = m_face[node][0];
+	NodeFaceRef ref = nfl[0];
 	ref.pf->m_ntag = 1;
 	fl.push_back(ref);
 	bool bdone = false;
@@ -159,8 +194,8 @@ bool FENodeFaceList::Sort(int node)
 				}
 				assert(k < nval);
 
-				fl.push_back(m_face[node][k]);
-				ref = m_face[node][k];
+				fl.push_back(nfl[k]);
+				ref = nfl[k];
 				bdone = false;
 			}
 		}
@@ -170,14 +205,15 @@ bool FENodeFaceList::Sort(int node)
 	// for non-manifold topologies this algorithm
 	// can fail. In that case, we return false
 	if ((int)fl.size() != nval) return false;
-	m_face[node] = fl;
+	std::copy(fl.begin(), fl.end(), nfl);
 
 	return true;
 }
 
-const vector<NodeFaceRef>& FENodeFaceList::FaceList(int n) const
+//-----------------------------------------------------------------------------
+NodeFaceRefList FENodeFaceList::FaceList(int n) const
 { 
-	return m_face[n]; 
+	return NodeFaceRefList(m_face.data() + m_off[n], Valence(n));
 }
 
 //-----------------------------------------------------------------------------
@@ -202,8 +238,8 @@ int FENodeFaceList::FindFace(int inode, int n[10], int m)
 		assert(false);
 	};
 
-	vector<NodeFaceRef>& ni = m_face[inode];
-	int nf = (int)ni.size();
+	NodeFaceRefList ni = FaceList(inode);
+	int nf = ni.size();
 	for (int i = 0; i<nf; ++i)
 	{
 		FEFace& f = m_pm->Face(ni[i].fid);
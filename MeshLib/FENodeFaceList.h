@@ -25,6 +25,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.*/
 #pragma once
 #include <vector>
+#include "FENodeRefList.h"
 
 class FEFace;
 class FEMeshBase;
@@ -35,6 +36,12 @@ struct NodeFaceRef {
 	FEFace*	pf;		// face pointer
 };
 
+typedef FENodeRefList<NodeFaceRef>	NodeFaceRefList;
+
+//-----------------------------------------------------------------------------
+// Node-to-face adjacency, stored in compressed row format: the faces of node n
+// are m_face[m_off[n]] ... m_face[m_off[n+1]-1].
+
 class FENodeFaceList
 {
 public:
@@ -48,9 +55,9 @@ public:
 
 	bool IsEmpty() const;
 
-	int Valence(int i) const { return (int) m_face[i].size(); }
-	FEFace* Face(int n, int i) { return m_face[n][i].pf; }
-	int FaceIndex(int n, int i) { return m_face[n][i].fid; }
+	int Valence(int i) const { return m_off[i + 1] - m_off[i]; }
+	FEFace* Face(int n, int i) { return m_face[m_off[n] + i].pf; }
+	int FaceIndex(int n, int i) { return m_face[m_off[n] + i].fid; }
 
 	bool HasFace(int n, FEFace* pf);
 
@@ -58,12 +65,13 @@ public:
 
 	int FindFace(int inode, int n[10], int m);
 
-	const std::vector<NodeFaceRef>& FaceList(int n) const;
+	NodeFaceRefList FaceList(int n) const;
 
 protected:
 	bool Sort(int node);
 
 protected:
 	FEMeshBase*	m_pm;
-	std::vector< std::vector<NodeFaceRef> >	m_face;
+	std::vector<int>			m_off;	// offset into face list (size = nodes + 1)
+	std::vector<NodeFaceRef>	m_face;	// face list
 };
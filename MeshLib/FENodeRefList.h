@@ -0,0 +1,51 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+
+//-----------------------------------------------------------------------------
+// Light-weight, read-only view of the references of one node in a compressed
+// (offset/value) node adjacency list. The view remains valid until the list
+// it was taken from is rebuilt or cleared.
+template <class T> class FENodeRefList
+{
+public:
+	FENodeRefList() : m_p(nullptr), m_n(0) {}
+	FENodeRefList(const T* p, int n) : m_p(p), m_n(n) {}
+
+	int size() const { return m_n; }
+	bool empty() const { return (m_n == 0); }
+
+	const T& operator [] (int i) const { return m_p[i]; }
+
+	const T* begin() const { return m_p; }
+	const T* end() const { return m_p + m_n; }
+
+private:
+	const T*	m_p;
+	int			m_n;
+};
@@ -168,14 +168,15 @@ bool FindFaceIntersection(const Ray& ray, const FEMeshBase& mesh, Intersection&
 {
 	vec3d rn[10];
 
-	int faces = mesh.Faces();
 	vec3d r, rmin;
 	double gmin = 1e99;
 	bool b = false;
 
+	// only faces whose bounding box is hit before the current closest intersection are tested
+	double tmax = 1e99;
 	q.m_index = -1;
 	Intersection tmp;
-	for (int i=0; i<faces; ++i)
+	mesh.FaceSearchTree().ForEachFacetOnRay(ray.origin, ray.direction, tmax, [&](int i)
 	{
 		const FEFace& face = mesh.Face(i);
 		if (face.IsVisible())
@@ -209,9 +210,11 @@ bool FindFaceIntersection(const Ray& ray, const FEMeshBase& mesh, Intersection&
 				// signed distance
 				float distance = ray.direction*(tmp.point - ray.origin);
 
-				if ((distance > 0.f) && (distance < gmin))
+				// (on ties, the lowest face index wins)
+				if ((distance > 0.f) && ((distance < gmin) || ((distance == gmin) && (i < q.m_index))))
 				{
 					gmin = distance;
+					tmax = gmin;
 					rmin = q.point;
 					b = true;
 					q.m_index = i;
@@ -221,7 +224,7 @@ bool FindFaceIntersection(const Ray& ray, const FEMeshBase& mesh, Intersection&
 				}
 			}
 		}
-	}
+	});
 
 	return b;
 }
@@ -275,15 +278,22 @@ bool FindElementIntersection(const Ray& ray, const FEMesh& mesh, Intersection& q
 {
 	vec3d rn[10];
 
-	int elems = mesh.Elements();
 	vec3d r, rmin;
 	float gmin = 1e30f;
 	bool b = false;
 
+	// The elements are visited in order of distance, not index. To pick the same element
+	// on ties as a loop over all elements would, we keep track of where the closest 
+	// intersection came from: solid faces only win ties from earlier faces, and shells
+	// win ties from solid faces and earlier shells.
+	int imin = -1, jmin = -1;
+	bool bshell = false;
+
 	FEFace face;
 	q.m_index = -1;
 	Intersection tmp;
-	for (int i = 0; i<elems; ++i)
+	double tmax = 1e30;
+	mesh.ElementSearchTree().ForEachFacetOnRay(ray.origin, ray.direction, tmax, [&](int i)
 	{
 		const FEElement& elem = mesh.Element(i);
 		if (elem.IsVisible() && (elem.IsSelected() == selectionState))
@@ -331,9 +341,12 @@ bool FindElementIntersection(const Ray& ray, const FEMesh& mesh, Intersection& q
 					// signed distance
 					float distance = ray.direction*(tmp.point - ray.origin);
 
-					if ((distance > 0.f) && (distance < gmin))
+					bool btie = (distance == gmin) && !bshell && ((i < imin) || ((i == imin) && (j < jmin)));
+					if ((distance > 0.f) && ((distance < gmin) || btie))
 					{
 						gmin = distance;
+						tmax = gmin;
+						imin = i; jmin = j; bshell = false;
 						rmin = q.point;
 						b = true;
 						q.m_index = i;
@@ -375,9 +388,12 @@ bool FindElementIntersection(const Ray& ray, const FEMesh& mesh, Intersection& q
 					// signed distance
 					float distance = ray.direction*(tmp.point - ray.origin);
 
-					if ((distance > 0.f) && (distance <= gmin))
+					bool btie = (distance == gmin) && ((bshell == false) || (i > imin));
+					if ((distance > 0.f) && ((distance < gmin) || btie))
 					{
 						gmin = distance;
+						tmax = gmin;
+						imin = i; jmin = -1; bshell = true;
 						rmin = q.point;
 						b = true;
 						q.m_index = i;
@@ -388,7 +404,7 @@ bool FindElementIntersection(const Ray& ray, const FEMesh& mesh, Intersection& q
 				}
 			}
 		}
-	}
+	});
 
 	return b;
 }
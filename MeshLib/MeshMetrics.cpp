@@ -1078,7 +1078,7 @@ double Curvature(FEMesh& mesh, int node, int measure, int levels, int maxIters,
 	vec3f r0 = to_vec3f(mesh.Node(node).pos());
 
 	// get the node-face list
-	const vector<NodeFaceRef>& nfl = mesh.NodeFaceList(node);
+	NodeFaceRefList nfl = mesh.NodeFaceList(node);
 	int NF = nfl.size();
 
 	// estimate surface normal
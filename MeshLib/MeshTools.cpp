@@ -409,25 +409,29 @@ std::vector<vec3d> FindAllIntersections(FEMeshBase& mesh, const vec3d& x, const
 //-----------------------------------------------------------------------------
 bool FindIntersection(FEMeshBase& mesh, const vec3d& x, const vec3d& n, vec3d& q, bool snap)
 {
-	int NF = mesh.Faces();
 	vec3d r, rmin;
 	double g, gmin = 1e99;
 	bool b = false;
 	int imin = -1;
-	for (int i = 0; i<NF; ++i)
+
+	// only faces whose bounding box is hit before the current closest intersection are tested
+	double tmax = 1e99;
+	mesh.FaceSearchTree().ForEachFacetOnRay(x, n, tmax, [&](int i)
 	{
 		FEFace& f = mesh.Face(i);
 		if (FindIntersection(mesh, f, x, n, r, g))
 		{
-			if ((g > 0.0) && (g < gmin))
+			// (on ties, the lowest face index wins)
+			if ((g > 0.0) && ((g < gmin) || ((g == gmin) && (i < imin))))
 			{
 				gmin = g;
+				tmax = g;
 				rmin = r;
 				b = true;
 				imin = i;
 			}
 		}
-	}
+	});
 
 	if (b) 
 	{
@@ -35,28 +35,29 @@ FEDataVariable::FEDataVariable()
 	m_v[1] = "";
 	m_v[2] = "";
 
-	m_mth.set_variable("x", 0);
-	m_mth.set_variable("y", 0);
-	m_mth.set_variable("z", 0);
+	for (int i = 0; i < 3; ++i)
+	{
+		m_mth[i].AddVariable("x");
+		m_mth[i].AddVariable("y");
+		m_mth[i].AddVariable("z");
+	}
 }
 
 //-----------------------------------------------------------------------------
 void FEDataVariable::SetString(int n, const char* sz)
 {
 	m_v[n] = string(sz);
+	m_mth[n].Compile(m_v[n]);
 }
 
 //-----------------------------------------------------------------------------
 vec3d FEDataVariable::Value(vec3d &r)
 {
-	m_mth.set_variable("x", r.x);
-	m_mth.set_variable("y", r.y);
-	m_mth.set_variable("z", r.z);
+	double x[3] = { r.x, r.y, r.z };
 
 	vec3d v(0,0,0);
-	int ierr;
-	v.x = m_mth.eval(m_v[0].c_str(), ierr);
-	v.y = m_mth.eval(m_v[1].c_str(), ierr);
-	v.z = m_mth.eval(m_v[2].c_str(), ierr);
+	v.x = m_mth[0].Eval(x);
+	v.y = m_mth[1].Eval(x);
+	v.z = m_mth[2].Eval(x);
 	return v;
 }
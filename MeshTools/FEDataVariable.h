@@ -27,7 +27,7 @@ SOFTWARE.*/
 #pragma once
 #include <FSCore/FSObject.h>
 #include <MathLib/math3d.h>
-#include <MathLib/MathParser.h>
+#include <MathLib/MathExpression.h>
 #include <string>
 //using namespace std;
 
@@ -51,7 +51,7 @@ private:
 	FEDataVariable(const FEDataVariable& v) {}
 
 protected:
-	string		m_v[3];
-	int			m_nID;
-	CMathParser	m_mth;
+	string			m_v[3];
+	int				m_nID;
+	CMathExpression	m_mth[3];	// compiled expressions of m_v
 };
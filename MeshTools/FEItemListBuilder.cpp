@@ -25,6 +25,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.*/
 
 #include "FEItemListBuilder.h"
+#include <algorithm>
+#include <iterator>
 
 int FEItemListBuilder::m_ncount = 1;
 
@@ -54,10 +56,9 @@ void FEItemListBuilder::Save(OArchive& ar)
 	ar.WriteChunk(NAME, GetName());
 	ar.WriteChunk(SIZE, N);
 
-	Iterator it = m_Item.begin();
-	for (int i=0; i<N; ++i, ++it)
+	for (int i=0; i<N; ++i)
 	{
-		ar.WriteChunk(ITEM, (*it));
+		ar.WriteChunk(ITEM, m_Item[i]);
 	}
 }
 
@@ -76,7 +77,7 @@ void FEItemListBuilder::Load(IArchive &ar)
 		case ID: ar.read(n); SetID(n); break;
 		case NAME: { char sz[256]; ar.read(sz); SetName(sz); } break;
 		case MESHID: break;	//--> obsolete
-		case SIZE: ar.read(N); break;
+		case SIZE: ar.read(N); m_Item.reserve(N); break;
 		case ITEM: ar.read(n); m_Item.push_back(n); break;
 		default:
 			throw ReadError("unknown CID in FEItemListBuilder::Load");
@@ -86,53 +87,56 @@ void FEItemListBuilder::Load(IArchive &ar)
 	assert((int) m_Item.size() == N);
 }
 
-void FEItemListBuilder::add(const std::list<int>& nodeList)
+void FEItemListBuilder::add(const std::vector<int>& nodeList)
 {
 	m_Item.insert(m_Item.end(), nodeList.begin(), nodeList.end());
 }
 
 void FEItemListBuilder::remove(int n)
 {
-	if (m_Item.empty()) return;
-	Iterator pi = m_Item.begin();
-	for (int i=0; i<n; ++i) pi++;
-	m_Item.erase(pi);
+	if ((n < 0) || (n >= (int)m_Item.size())) return;
+	m_Item.erase(m_Item.begin() + n);
 }
 
-void FEItemListBuilder::Merge(list<int>& o)
+// sort a list and remove duplicates
+static void sortUnique(std::vector<int>& l)
 {
-	m_Item.insert(m_Item.end(), o.begin(), o.end());
-
-	if (m_Item.empty() == false)
-	{
-		// sort the items
-		m_Item.sort();
+	std::sort(l.begin(), l.end());
+	l.erase(std::unique(l.begin(), l.end()), l.end());
+}
 
-		// remove duplicates
-		Iterator it1 = m_Item.begin(); 
-		Iterator it2 = it1; it2++;
+void FEItemListBuilder::Merge(const std::vector<int>& o)
+{
+	sortUnique(m_Item);
+	std::vector<int> b(o);
+	sortUnique(b);
+
+	std::vector<int> c;
+	c.reserve(m_Item.size() + b.size());
+	std::set_union(m_Item.begin(), m_Item.end(), b.begin(), b.end(), std::back_inserter(c));
+	m_Item.swap(c);
+}
 
-		while (it2 != m_Item.end())
-		{
-			if (*it1 == *it2) it2 = m_Item.erase(it2);
-			else { it1 = it2; it2++; }
-		}
-	}
+void FEItemListBuilder::Subtract(const std::vector<int>& o)
+{
+	sortUnique(m_Item);
+	std::vector<int> b(o);
+	sortUnique(b);
+
+	std::vector<int> c;
+	c.reserve(m_Item.size());
+	std::set_difference(m_Item.begin(), m_Item.end(), b.begin(), b.end(), std::back_inserter(c));
+	m_Item.swap(c);
 }
 
-void FEItemListBuilder::Subtract(list<int>& o)
+void FEItemListBuilder::Intersect(const std::vector<int>& o)
 {
-	m_Item.sort();
-	// NOTE: This algorithm assumes that both lists are sorted
-	Iterator it  = m_Item.begin();
-	Iterator it2 = o.begin();
-	while ((it != m_Item.end()) && (it2 != o.end()))
-	{
-		if (*it == *it2)
-		{
-			it = m_Item.erase(it);
-			++it2;
-		}
-		else ++it;
-	}
+	sortUnique(m_Item);
+	std::vector<int> b(o);
+	sortUnique(b);
+
+	std::vector<int> c;
+	c.reserve(std::min(m_Item.size(), b.size()));
+	std::set_intersection(m_Item.begin(), m_Item.end(), b.begin(), b.end(), std::back_inserter(c));
+	m_Item.swap(c);
 }
@@ -28,7 +28,7 @@ SOFTWARE.*/
 #include "FEItemList.h"
 #include <FSCore/FSObject.h>
 #include <FEMLib/FECoreModel.h>
-#include <list>
+#include <vector>
 
 //-----------------------------------------------------------------------------
 enum ITEMLIST_TYPE {
@@ -56,14 +56,16 @@ enum DOMAIN_TYPE
 // This class is an abstract base class for any class that can build FEItem lists.
 // Currently this is the GItem class for geometry objects and FEGroup class for
 // FE meshes. Each derived class must be able to define how to build FEItem lists.
+// The item IDs are stored in a contiguous array. The set operations (Merge, 
+// Subtract, Intersect) leave the items sorted and without duplicates.
 //
 class FEItemListBuilder : public FSObject
 {
 public:
 	enum {ID, NAME, MESHID, SIZE, ITEM};
 
-	typedef std::list<int>::iterator Iterator;
-	typedef std::list<int>::const_iterator ConstIterator;
+	typedef std::vector<int>::iterator Iterator;
+	typedef std::vector<int>::const_iterator ConstIterator;
 
 public:
 	FEItemListBuilder(int ntype);
@@ -78,7 +80,7 @@ public:
 
 	void clear() { m_Item.clear(); }
 	void add(int n) { m_Item.push_back(n); }
-	void add(const std::list<int>& nodeList);
+	void add(const std::vector<int>& nodeList);
 	void remove(int i);
 	int size() const { return (int)m_Item.size(); }
 	Iterator begin() { return m_Item.begin(); }
@@ -96,13 +98,16 @@ public:
 
 	int Type() { return m_ntype; }
 
-	void Merge(list<int>& o);
-	void Subtract(list<int>& o);
+	// set operations
+	void Merge(const std::vector<int>& o);
+	void Subtract(const std::vector<int>& o);
+	void Intersect(const std::vector<int>& o);
 
-	list<int> CopyItems() { return m_Item; }
+	std::vector<int> CopyItems() const { return m_Item; }
+	const std::vector<int>& Items() const { return m_Item; }
 
 protected:
-	list<int>	m_Item;
+	std::vector<int>	m_Item;
 
 	int	m_ntype;
 
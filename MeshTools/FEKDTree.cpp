@@ -0,0 +1,151 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEKDTree.h"
+#include <algorithm>
+using namespace std;
+
+// ranges with at most this many points are searched linearly
+const int KDTREE_LEAF_SIZE = 8;
+
+//-----------------------------------------------------------------------------
+// The tree is stored implicitly: the node of the range [n0, n1) is the point at
+// the middle of the range, and its two children are the ranges on either side.
+FEKDTree::FEKDTree()
+{
+}
+
+//-----------------------------------------------------------------------------
+void FEKDTree::Build(const vector<vec3d>& pts)
+{
+	int N = (int)pts.size();
+	m_node.resize(N);
+	for (int i = 0; i < N; ++i)
+	{
+		m_node[i].r = pts[i];
+		m_node[i].i = i;
+		m_node[i].ax = 0;
+	}
+
+	build(0, N);
+}
+
+//-----------------------------------------------------------------------------
+void FEKDTree::build(int n0, int n1)
+{
+	if (n1 - n0 <= KDTREE_LEAF_SIZE) return;
+
+	// split along the axis with the largest extent
+	vec3d r0 = m_node[n0].r, r1 = m_node[n0].r;
+	for (int i = n0 + 1; i < n1; ++i)
+	{
+		const vec3d& r = m_node[i].r;
+		if (r.x < r0.x) r0.x = r.x;
+		if (r.y < r0.y) r0.y = r.y;
+		if (r.z < r0.z) r0.z = r.z;
+		if (r.x > r1.x) r1.x = r.x;
+		if (r.y > r1.y) r1.y = r.y;
+		if (r.z > r1.z) r1.z = r.z;
+	}
+	vec3d dr = r1 - r0;
+	int ax = 0;
+	if (dr.y > dr.x) ax = 1;
+	if ((dr.z > dr.x) && (dr.z > dr.y)) ax = 2;
+
+	// partition the range around the median
+	int nm = (n0 + n1) / 2;
+	nth_element(m_node.begin() + n0, m_node.begin() + nm, m_node.begin() + n1, [=](const NODE& a, const NODE& b) {
+		return (ax == 0 ? a.r.x < b.r.x : (ax == 1 ? a.r.y < b.r.y : a.r.z < b.r.z));
+	});
+	m_node[nm].ax = ax;
+
+	build(n0, nm);
+	build(nm + 1, n1);
+}
+
+//-----------------------------------------------------------------------------
+int FEKDTree::FindClosest(const vec3d& x) const
+{
+	double d2;
+	return FindClosest(x, d2);
+}
+
+//-----------------------------------------------------------------------------
+int FEKDTree::FindClosest(const vec3d& x, double& d2) const
+{
+	int imin = -1;
+	d2 = 0.0;
+	if (m_node.empty()) return -1;
+
+	find(0, (int)m_node.size(), x, imin, d2);
+	return m_node[imin].i;
+}
+
+//-----------------------------------------------------------------------------
+void FEKDTree::find(int n0, int n1, const vec3d& x, int& imin, double& dmin) const
+{
+	if (n1 - n0 <= KDTREE_LEAF_SIZE)
+	{
+		for (int i = n0; i < n1; ++i)
+		{
+			const vec3d& r = m_node[i].r;
+			double d = (r.x - x.x)*(r.x - x.x) + (r.y - x.y)*(r.y - x.y) + (r.z - x.z)*(r.z - x.z);
+			if ((imin == -1) || (d < dmin) || ((d == dmin) && (m_node[i].i < m_node[imin].i)))
+			{
+				imin = i;
+				dmin = d;
+			}
+		}
+		return;
+	}
+
+	// check the node itself
+	int nm = (n0 + n1) / 2;
+	const vec3d& r = m_node[nm].r;
+	double d = (r.x - x.x)*(r.x - x.x) + (r.y - x.y)*(r.y - x.y) + (r.z - x.z)*(r.z - x.z);
+	if ((imin == -1) || (d < dmin) || ((d == dmin) && (m_node[nm].i < m_node[imin].i)))
+	{
+		imin = nm;
+		dmin = d;
+	}
+
+	// search the near side first and only visit the far side
+	// if it can still contain a closer point
+	int ax = m_node[nm].ax;
+	double dx = (ax == 0 ? x.x - r.x : (ax == 1 ? x.y - r.y : x.z - r.z));
+	if (dx < 0)
+	{
+		find(n0, nm, x, imin, dmin);
+		if (dx*dx <= dmin) find(nm + 1, n1, x, imin, dmin);
+	}
+	else
+	{
+		find(nm + 1, n1, x, imin, dmin);
+		if (dx*dx <= dmin) find(n0, nm, x, imin, dmin);
+	}
+}
@@ -0,0 +1,67 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <MathLib/math3d.h>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+//! Static k-d tree for closest point queries on a point set. The tree is built
+//! once and is not modified by queries, so it can be queried from multiple
+//! threads at the same time.
+class FEKDTree
+{
+public:
+	struct NODE
+	{
+		vec3d	r;	// position of point
+		int		i;	// index of point in the original set
+		int		ax;	// split axis (interior nodes only)
+	};
+
+public:
+	FEKDTree();
+
+	//! build the tree for the given point set
+	void Build(const std::vector<vec3d>& pts);
+
+	//! number of points in the tree
+	int Points() const { return (int)m_node.size(); }
+
+	//! find the index of the point closest to x (returns -1 if the tree is empty)
+	int FindClosest(const vec3d& x) const;
+
+	//! same as above, but also returns the squared distance
+	int FindClosest(const vec3d& x, double& d2) const;
+
+private:
+	void build(int n0, int n1);
+	void find(int n0, int n1, const vec3d& x, int& imin, double& dmin) const;
+
+private:
+	std::vector<NODE>	m_node;	// points, in tree order
+};
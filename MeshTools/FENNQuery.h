@@ -26,6 +26,7 @@ SOFTWARE.*/
 
 #pragma once
 #include <MathLib/math3d.h>
+#include "FEKDTree.h"
 #include <vector>
 
 //-----------------------------------------------------------------------------
@@ -33,15 +34,6 @@ SOFTWARE.*/
 
 class FENNQuery  
 {
-public:
-	struct NODE
-	{
-		int		i;	// index of node
-		vec3d	r;	// position of node
-		double	d1;	// distance to pivot 1
-		double	d2;	// distance to pivot 2
-	};
-
 public:
 	FENNQuery(std::vector<vec3d>* ps = 0);
 	virtual ~FENNQuery();
@@ -55,15 +47,9 @@ public:
 	//! find the neirest neighbour of r
 	int Find(vec3d x);	
 
-protected:
-	int FindRadius(double r);
-
 protected:
 	std::vector<vec3d>*	m_ps;	//!< the node array to search
-	std::vector<NODE>	m_bk;	// BK tree
-
-	vec3d	m_q1;	// pivot 1
-	vec3d	m_q2;	// pivot 2
+	FEKDTree			m_tree;	//!< search tree
 
 	int		m_imin;	// last found index
 };
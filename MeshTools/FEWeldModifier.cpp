@@ -28,6 +28,140 @@ SOFTWARE.*/
 #include "FEWeldModifier.h"
 #include <MeshLib/FEMeshBuilder.h>
 #include <MeshLib/FESurfaceMesh.h>
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+// Uniform grid that is used to find weld candidates. The cell size is at least
+// the weld threshold, so all points within the threshold of a point lie in the
+// 27 cells around it. Cells are stored as a sorted list of keys so lookups are
+// read-only and can be done from multiple threads.
+class FEWeldGrid
+{
+public:
+	FEWeldGrid(const vector<vec3d>& r, double threshold) : m_r(r)
+	{
+		int n = (int)r.size();
+		m_r0 = m_r1 = (n > 0 ? r[0] : vec3d(0, 0, 0));
+		for (int i = 1; i < n; ++i)
+		{
+			const vec3d& ri = r[i];
+			if (ri.x < m_r0.x) m_r0.x = ri.x;
+			if (ri.y < m_r0.y) m_r0.y = ri.y;
+			if (ri.z < m_r0.z) m_r0.z = ri.z;
+			if (ri.x > m_r1.x) m_r1.x = ri.x;
+			if (ri.y > m_r1.y) m_r1.y = ri.y;
+			if (ri.z > m_r1.z) m_r1.z = ri.z;
+		}
+
+		// the cell coordinates are packed in 21 bits each, so make sure
+		// the grid never exceeds that resolution
+		double L = m_r1.x - m_r0.x;
+		if (m_r1.y - m_r0.y > L) L = m_r1.y - m_r0.y;
+		if (m_r1.z - m_r0.z > L) L = m_r1.z - m_r0.z;
+		m_h = threshold;
+		if (m_h < L / MAX_CELLS) m_h = L / MAX_CELLS;
+		if (m_h <= 0.0) m_h = 1.0;
+
+		// sort the points by cell
+		vector< pair<long long, int> > tmp(n);
+#pragma omp parallel for
+		for (int i = 0; i < n; ++i)
+		{
+			int c[3]; cell(r[i], c);
+			tmp[i] = pair<long long, int>(key(c[0], c[1], c[2]), i);
+		}
+		std::sort(tmp.begin(), tmp.end());
+
+		m_key.resize(n);
+		m_item.resize(n);
+		for (int i = 0; i < n; ++i)
+		{
+			m_key[i] = tmp[i].first;
+			m_item[i] = tmp[i].second;
+		}
+	}
+
+	// call f(j) for all points j that lie in the cells around point i
+	template <class F> void ForEachCandidate(int i, F f) const
+	{
+		int c[3]; cell(m_r[i], c);
+		for (int a = c[0] - 1; a <= c[0] + 1; ++a)
+			for (int b = c[1] - 1; b <= c[1] + 1; ++b)
+				for (int d = c[2] - 1; d <= c[2] + 1; ++d)
+				{
+					if ((a < 0) || (b < 0) || (d < 0) || (a > MAX_CELLS) || (b > MAX_CELLS) || (d > MAX_CELLS)) continue;
+					long long k = key(a, b, d);
+					vector<long long>::const_iterator it = std::lower_bound(m_key.begin(), m_key.end(), k);
+					for (size_t l = it - m_key.begin(); (l < m_key.size()) && (m_key[l] == k); ++l) f(m_item[l]);
+				}
+	}
+
+private:
+	void cell(const vec3d& r, int* c) const
+	{
+		c[0] = (int)((r.x - m_r0.x) / m_h);
+		c[1] = (int)((r.y - m_r0.y) / m_h);
+		c[2] = (int)((r.z - m_r0.z) / m_h);
+	}
+
+	long long key(int i, int j, int k) const
+	{
+		return ((long long)i << 42) | ((long long)j << 21) | (long long)k;
+	}
+
+private:
+	enum { MAX_CELLS = (1 << 20) };
+
+	const vector<vec3d>&	m_r;
+	vec3d		m_r0, m_r1;		// bounding box
+	double		m_h;			// cell size
+	vector<long long>	m_key;	// sorted cell keys
+	vector<int>			m_item;	// point index for each key
+};
+
+//-----------------------------------------------------------------------------
+// union-find helpers. The root of each set is always its smallest member, so
+// the resulting partition does not depend on the order in which pairs are merged.
+static int weldRoot(vector<int>& parent, int i)
+{
+	while (parent[i] != i)
+	{
+		parent[i] = parent[parent[i]];
+		i = parent[i];
+	}
+	return i;
+}
+
+static void weldUnion(vector<int>& parent, int a, int b)
+{
+	a = weldRoot(parent, a);
+	b = weldRoot(parent, b);
+	if (a < b) parent[b] = a;
+	else if (b < a) parent[a] = b;
+}
+
+//-----------------------------------------------------------------------------
+// Assign each selected node to the first node of its cluster and move that node
+// to the cluster's centroid. On input, parent contains the union-find forest
+// over the selection list, and r the positions of the selected nodes.
+static void weldClusters(const vector<int>& sel, vector<int>& parent, vector<vec3d>& r, vector<int>& order)
+{
+	int n = (int)sel.size();
+	vector<vec3d> c(n, vec3d(0, 0, 0));
+	vector<int> m(n, 0);
+	for (int i = 0; i < n; ++i)
+	{
+		int ri = weldRoot(parent, i);
+		order[sel[i]] = sel[ri];
+		c[ri] += r[i];
+		m[ri]++;
+	}
+
+	for (int i = 0; i < n; ++i)
+	{
+		if (m[i] > 1) r[i] = c[i] / (double)m[i];
+	}
+}
 
 //! constructor
 FEWeldNodes::FEWeldNodes() : FEModifier("Weld nodes")
@@ -86,36 +220,41 @@ void FEWeldNodes::UpdateNodes(FEMesh* pm)
 	double threshold = GetFloatValue(0);
 	double eps = threshold*threshold;
 
-	// loop over the selected nodes
 	int n = (int) sel.size();
-	for (int i=0; i<n-1; ++i)
-		for (int j=i+1; j<n; ++j)
-		{
-			int ni = m_order[sel[i]];
-			int nj = m_order[sel[j]];
-
-			if (ni != nj)
-			{
-				// calculate distance between nodes
-				vec3d& ri = m.Node(ni).r;
-				vec3d& rj = m.Node(nj).r;
+	vector<vec3d> r(n);
+	for (int i=0; i<n; ++i) r[i] = m.Node(sel[i]).r;
 
+	// find all pairs of selected nodes that are within the threshold
+	FEWeldGrid grid(r, threshold);
+	vector< pair<int, int> > pairs;
+#pragma omp parallel
+	{
+		vector< pair<int, int> > local;
+#pragma omp for schedule(dynamic, 256) nowait
+		for (int i=0; i<n; ++i)
+		{
+			const vec3d& ri = r[i];
+			grid.ForEachCandidate(i, [&](int j) {
+				if (j <= i) return;
+				const vec3d& rj = r[j];
 				double d = (ri.x-rj.x)*(ri.x-rj.x)+(ri.y-rj.y)*(ri.y-rj.y)+(ri.z-rj.z)*(ri.z-rj.z);
-				if (d <= eps)
-				{
-					// weld nodes ni and nj
-					m_order[sel[j]] = ni;
-
-					// move nodes to the average of the two
-					ri = (ri+rj)*0.5;
-				}
-			}
+				if (d <= eps) local.push_back(pair<int, int>(i, j));
+			});
 		}
+#pragma omp critical
+		pairs.insert(pairs.end(), local.begin(), local.end());
+	}
 
-	// reassign node numbers
-	for (int i=0; i<nodes; ++i)
+	// merge the pairs into clusters
+	vector<int> parent(n);
+	for (int i=0; i<n; ++i) parent[i] = i;
+	for (size_t i=0; i<pairs.size(); ++i) weldUnion(parent, pairs[i].first, pairs[i].second);
+
+	// weld each cluster to its first node
+	weldClusters(sel, parent, r, m_order);
+	for (int i=0; i<n; ++i)
 	{
-		if (m_order[i] != i) m_order[i] = m_order[ m_order[i] ];
+		if (m_order[sel[i]] == sel[i]) m.Node(sel[i]).r = r[i];
 	}
 }
 
@@ -339,53 +478,45 @@ void FEWeldSurfaceNodes::UpdateNodes(FESurfaceMesh* pm)
 	double threshold = GetFloatValue(0);
 	double eps = threshold * threshold;
 
-	// loop over the selected nodes
 	int n = (int)sel.size();
-	for (int i = 0; i < n - 1; ++i)
+	vector<vec3d> r(n);
+	for (int i = 0; i < n; ++i) r[i] = m.Node(sel[i]).r;
+
+	// for each node, find the closest node further down the list
+	FEWeldGrid grid(r, threshold);
+	vector<int> closest(n, -1);
+#pragma omp parallel for schedule(dynamic, 256)
+	for (int i = 0; i < n; ++i)
 	{
-		int ni = m_order[sel[i]];
-		vec3d& ri = m.Node(ni).r;
-
-		// find the closest node
+		const vec3d& ri = r[i];
 		int jmin = -1;
 		double dmin = 0.0;
-		for (int j = i + 1; j < n; ++j)
-		{
-			int nj = m_order[sel[j]];
-
-			if (ni != nj)
+		grid.ForEachCandidate(i, [&](int j) {
+			if (j <= i) return;
+			const vec3d& rj = r[j];
+			double d = (ri.x - rj.x)*(ri.x - rj.x) + (ri.y - rj.y)*(ri.y - rj.y) + (ri.z - rj.z)*(ri.z - rj.z);
+			if ((d <= eps) && ((jmin == -1) || (d < dmin) || ((d == dmin) && (j < jmin))))
 			{
-				// calculate distance between nodes
-				vec3d& rj = m.Node(nj).r;
-
-				double d = (ri.x - rj.x)*(ri.x - rj.x) + (ri.y - rj.y)*(ri.y - rj.y) + (ri.z - rj.z)*(ri.z - rj.z);
-				if ((d <= eps) && ((d < dmin) || jmin == -1))
-				{
-					jmin = j;
-					dmin = d;
-				}
+				jmin = j;
+				dmin = d;
 			}
-		}
-
-		if (jmin != -1)
-		{
-			int nj = m_order[sel[jmin]];
-
-			vec3d& ri = m.Node(ni).r;
-			vec3d& rj = m.Node(nj).r;
-
-			// weld nodes ni and nj
-			m_order[sel[jmin]] = ni;
+		});
+		closest[i] = jmin;
+	}
 
-			// move nodes to the average of the two
-			ri = (ri + rj)*0.5;
-		}
+	// merge the pairs into clusters
+	vector<int> parent(n);
+	for (int i = 0; i < n; ++i) parent[i] = i;
+	for (int i = 0; i < n; ++i)
+	{
+		if (closest[i] != -1) weldUnion(parent, i, closest[i]);
 	}
 
-	// reassign node numbers
-	for (int i = 0; i < nodes; ++i)
+	// weld each cluster to its first node
+	weldClusters(sel, parent, r, m_order);
+	for (int i = 0; i < n; ++i)
 	{
-		if (m_order[i] != i) m_order[i] = m_order[m_order[i]];
+		if (m_order[sel[i]] == sel[i]) m.Node(sel[i]).r = r[i];
 	}
 }
 
@@ -26,6 +26,7 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "ICPRegistration.h"
+#include "FEKDTree.h"
 #include <GeomLib/GObject.h>
 #include <MeshLib/FEMesh.h>
 
@@ -161,6 +162,10 @@ Transform GICPRegistration::Register(const vector<vec3d>& X, const vector<vec3d>
 	for (int i=1; i<NP; ++i) box += P[i];
 	double R = box.Radius();
 
+	// the target set doesn't change, so we only need to build the search tree once
+	FEKDTree tree;
+	tree.Build(X);
+
 	// reserve space for the Y-vector
 	// (stores the closest points in X to P)
 	vector<vec3d> Y(NP);
@@ -174,7 +179,7 @@ Transform GICPRegistration::Register(const vector<vec3d>& X, const vector<vec3d>
 	for (m_iters = 1; m_iters < m_maxiter; m_iters++)
 	{
 		// Compute the closest point set Y
-		ClosestPointSet(X, P, Y);
+		ClosestPointSet(tree, X, P, Y);
 
 		// compute the registration
 		Q = Register(P0, Y, &m_err);
@@ -192,10 +197,9 @@ Transform GICPRegistration::Register(const vector<vec3d>& X, const vector<vec3d>
 	return Q;
 }
 
-void GICPRegistration::ClosestPointSet(const vector<vec3d>& X, const vector<vec3d>& P, vector<vec3d>& Y)
+void GICPRegistration::ClosestPointSet(const FEKDTree& tree, const vector<vec3d>& X, const vector<vec3d>& P, vector<vec3d>& Y)
 {
-	// get the vector sizes
-	int NX = (int) X.size();
+	// get the vector size
 	int NP = (int) P.size();
 
 	// make sure Y is the right size
@@ -204,20 +208,11 @@ void GICPRegistration::ClosestPointSet(const vector<vec3d>& X, const vector<vec3
 
 	// Find the closest node int X for each point in P
 	// and store in Y
+#pragma omp parallel for
 	for (int i = 0; i<NP; i++)
 	{
-		double min_dist = 1e99;
-		const vec3d& Pi = P[i];
-		for(int j = 0; j<NX; j++)
-		{
-			const vec3d& Xj = X[j];
-			double dist = (Pi - Xj).Length();
-			if (dist < min_dist)
-			{
-				min_dist = dist;
-				Y[i] = Xj;
-			}
-		}
+		int j = tree.FindClosest(P[i]);
+		Y[i] = X[j];
 	}
 }
 
@@ -30,9 +30,13 @@ SOFTWARE.*/
 #include <MeshLib/FENodeNodeList.h>
 #include <MeshLib/FENodeElementList.h>
 #include <MeshLib/MeshMetrics.h>
+#include <MathLib/PCGSolver.h>
+#include <algorithm>
 
 LaplaceSolver::LaplaceSolver()
 {
+	m_method = RELAXATION;
+	m_pc = PCGSolver::IC0;
 	m_maxIters = 1000;
 	m_tol = 1e-4;
 	m_w = 1.0;
@@ -40,6 +44,16 @@ LaplaceSolver::LaplaceSolver()
 	m_niters = 0;
 }
 
+void LaplaceSolver::SetMethod(int n)
+{
+	m_method = n;
+}
+
+void LaplaceSolver::SetPreconditioner(int n)
+{
+	m_pc = n;
+}
+
 void LaplaceSolver::SetMaxIterations(int n)
 {
 	m_maxIters = n;
@@ -121,7 +135,8 @@ bool LaplaceSolver::Solve(FEMesh* pm, vector<double>& val, vector<int>& bn, int
 
 	// calculate the element volumes
 	vector<double> Ve(NE, 0.0);
-	for (int i = 0; i < elist.size(); ++i)
+#pragma omp parallel for
+	for (int i = 0; i < (int)elist.size(); ++i)
 	{
 		int eid = elist[i];
 		FEElement& el = pm->Element(eid);
@@ -157,6 +172,11 @@ bool LaplaceSolver::Solve(FEMesh* pm, vector<double>& val, vector<int>& bn, int
 	}
 	assert(nc == nodeList.size());
 
+	if (m_method == CONJUGATE_GRADIENT)
+	{
+		return SolvePCG(pm, val, bn, elist, Ve, elemTag);
+	}
+
 	// create Node-Node list
 	FENodeNodeList NNL(pm);
 
@@ -287,3 +307,143 @@ bool LaplaceSolver::Solve(FEMesh* pm, vector<double>& val, vector<int>& bn, int
 
 	return (m_relNorm < m_tol);
 }
+
+// collect the equation numbers of the free nodes connected to a node
+static void nodeRow(FEMesh* pm, const FENodeElementList& NEL, const vector<int>& eq, int node, int elemTag, vector<int>& row)
+{
+	row.clear();
+	int nval = NEL.Valence(node);
+	for (int j = 0; j < nval; ++j)
+	{
+		const FEElement_& el = pm->ElementRef(NEL.ElementIndex(node, j));
+		if (el.m_ntag == elemTag)
+		{
+			int ne = el.Nodes();
+			for (int k = 0; k < ne; ++k)
+			{
+				int nk = eq[el.m_node[k]];
+				if (nk >= 0) row.push_back(nk);
+			}
+		}
+	}
+	std::sort(row.begin(), row.end());
+	row.erase(std::unique(row.begin(), row.end()), row.end());
+}
+
+// Assembles the stiffness matrix for the free nodes and solves it with
+// a preconditioned conjugate gradient method. The matrix entries are the 
+// same as the edge weights of the relaxation method.
+bool LaplaceSolver::SolvePCG(FEMesh* pm, vector<double>& val, const vector<int>& bn, const vector<int>& elist, const vector<double>& Ve, int elemTag)
+{
+	// number the free nodes
+	int NN = pm->Nodes();
+	vector<int> eq(NN, -1);
+	int neq = 0;
+	for (int i = 0; i < NN; ++i)
+	{
+		if (bn[i] == 0) eq[i] = neq++;
+	}
+	if (neq == 0) return true;
+
+	// build the sparsity pattern
+	FENodeElementList NEL;
+	NEL.Build(pm);
+
+	vector<int> rowOffsets(neq + 1, 0);
+#pragma omp parallel
+	{
+		vector<int> row;
+#pragma omp for schedule(static, 1024)
+		for (int i = 0; i < NN; ++i)
+		{
+			if (eq[i] >= 0)
+			{
+				nodeRow(pm, NEL, eq, i, elemTag, row);
+				rowOffsets[eq[i] + 1] = (int)row.size();
+			}
+		}
+	}
+	for (int i = 0; i < neq; ++i) rowOffsets[i + 1] += rowOffsets[i];
+
+	vector<int> columns(rowOffsets[neq]);
+#pragma omp parallel
+	{
+		vector<int> row;
+#pragma omp for schedule(static, 1024)
+		for (int i = 0; i < NN; ++i)
+		{
+			if (eq[i] >= 0)
+			{
+				nodeRow(pm, NEL, eq, i, elemTag, row);
+				std::copy(row.begin(), row.end(), columns.begin() + rowOffsets[eq[i]]);
+			}
+		}
+	}
+
+	CSRMatrix K;
+	K.Create(neq, rowOffsets, columns);
+
+	// assemble the stiffness matrix and the contribution of the fixed nodes
+	vector<double> R(neq, 0.0);
+	double* Kv = K.Values();
+#pragma omp parallel for schedule(dynamic, 64)
+	for (int n = 0; n < (int)elist.size(); ++n)
+	{
+		int eid = elist[n];
+		FEElement& el = pm->Element(eid);
+		int ne = el.Nodes();
+
+		// shape function gradients at the element nodes
+		vec3d G[FEElement::MAX_NODES][FEElement::MAX_NODES];
+		for (int a = 0; a < ne; ++a)
+			for (int k = 0; k < ne; ++k) G[a][k] = FEMeshMetrics::ShapeGradient(*pm, el, a, k);
+
+		double w = Ve[eid] / ne;
+		for (int a = 0; a < ne; ++a)
+		{
+			int ia = eq[el.m_node[a]];
+			if (ia < 0) continue;
+
+			for (int b = 0; b < ne; ++b)
+			{
+				double Kab = 0.0;
+				for (int k = 0; k < ne; ++k) Kab += G[a][k] * G[b][k];
+				Kab *= w;
+
+				int jb = eq[el.m_node[b]];
+				if (jb >= 0)
+				{
+					int m = K.find(ia, jb); assert(m >= 0);
+#pragma omp atomic
+					Kv[m] += Kab;
+				}
+				else
+				{
+					double rb = Kab * val[el.m_node[b]];
+#pragma omp atomic
+					R[ia] -= rb;
+				}
+			}
+		}
+	}
+
+	// solve, using the current values as initial guess
+	vector<double> x(neq);
+	for (int i = 0; i < NN; ++i) if (eq[i] >= 0) x[eq[i]] = val[i];
+
+	PCGSolver solver;
+	solver.SetMatrix(&K);
+	solver.SetPreconditioner(m_pc);
+	solver.SetMaxIterations(m_maxIters);
+	solver.SetTolerance(m_tol);
+	m_relNorm = 1.0;
+	if (solver.Factor() == false) return false;
+
+	bool bconv = solver.Solve(x, R);
+	m_niters = solver.GetIterationCount();
+	m_relNorm = solver.GetRelativeNorm();
+
+	for (int i = 0; i < NN; ++i) if (eq[i] >= 0) val[i] = x[eq[i]];
+
+	return bconv;
+}
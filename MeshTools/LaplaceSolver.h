@@ -36,13 +36,23 @@ class FEMesh;
 //! This class solves the Laplace equation using an iterative method
 class LaplaceSolver
 {
+public:
+	enum Method {
+		RELAXATION,			// nodal (SOR) relaxation
+		CONJUGATE_GRADIENT	// preconditioned CG on the assembled stiffness matrix
+	};
+
 public:
 	LaplaceSolver();
 
+	void SetMethod(int n);
 	void SetMaxIterations(int n);
 	void SetTolerance(double a);
 	void SetRelaxation(double w);
 
+	// set the preconditioner for the CG method (see PCGSolver)
+	void SetPreconditioner(int n);
+
 	// Solves the Laplace equation on the mesh.
 	// Input: val = initial values for all nodes
 	//        bn  = boundary flags: 0 = free, 1 = fixed
@@ -53,8 +63,13 @@ public: // output
 	int GetIterationCount() const;
 	double GetRelativeNorm() const;
 
+private:
+	bool SolvePCG(FEMesh* pm, vector<double>& val, const vector<int>& bn, const vector<int>& elist, const vector<double>& Ve, int elemTag);
+
 private:
 	// input parameters
+	int		m_method;	//!< solution method
+	int		m_pc;		//!< CG preconditioner
 	int		m_maxIters;	//!< max nr of iterations
 	double	m_tol;	//!< convergence tolerance
 	double	m_w;	//!< relaxation parameter
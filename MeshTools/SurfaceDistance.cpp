@@ -28,6 +28,8 @@ SOFTWARE.*/
 #include "SurfaceDistance.h"
 #include <MeshLib/FEMesh.h>
 #include <GeomLib/GObject.h>
+#include <MeshLib/FEFacetBVH.h>
+#include "FEKDTree.h"
 
 CSurfaceDistance::CSurfaceDistance()
 {
@@ -125,7 +127,22 @@ bool CSurfaceDistance::NormalProject(GObject* pso, GObject* pmo, vector<double>&
 		nu[i].Normalize();
 	}
 
+	// build the search tree over the reference surface
+	int NE = pm->Elements();
+	vector<vec3d> rm(pm->Nodes());
+	for (int j=0; j<pm->Nodes(); ++j) rm[j] = pm->Node(j).r;
+	vector<int> fn(4*NE, -1);
+	for (int j=0; j<NE; ++j)
+	{
+		FEElement& el = pm->Element(j);
+		assert(el.IsType(FE_TRI3));
+		for (int k=0; k<3; ++k) fn[4*j + k] = el.m_node[k];
+	}
+	FEFacetBVH bvh;
+	bvh.Build(fn, rm);
+
 	// repeat for all nodes
+#pragma omp parallel for schedule(dynamic, 64)
 	for (int i=0; i<nodes; ++i)
 	{
 		FENode& nodei = ps->Node(i);
@@ -146,16 +163,15 @@ bool CSurfaceDistance::NormalProject(GObject* pso, GObject* pmo, vector<double>&
 		double t2ri = t2*ri;
 
 		double Dmin, D2min = -1.0;
+		int jmin = -1;
 
 		// look for closest node on reference surface
-		int NE = pm->Elements();
-		for (int j=0; j<NE; ++j)
+		// (only triangles whose bounding box intersects the ray can be candidates)
+		bvh.ForEachFacetOnLine(ri, ni, [&](int j)
 		{
-			FEElement& el = pm->Element(j);
-			assert(el.IsType(FE_TRI3));
-			vec3d r0 = pm->Node(el.m_node[0]).r;
-			vec3d r1 = pm->Node(el.m_node[1]).r;
-			vec3d r2 = pm->Node(el.m_node[2]).r;
+			vec3d r0 = rm[fn[4*j    ]];
+			vec3d r1 = rm[fn[4*j + 1]];
+			vec3d r2 = rm[fn[4*j + 2]];
 
 			// in order for this triangle to be a candidate the points cannot all lie on the same side of the test planes.
 			bool bcont = true;
@@ -215,16 +231,18 @@ bool CSurfaceDistance::NormalProject(GObject* pso, GObject* pmo, vector<double>&
 						{
 							// we have a winner !
 							double d2 = t*t;
-							if ((d2 < D2min) || (D2min < 0.0))
+							// (ties go to the lowest triangle, as if they were visited in order)
+							if ((d2 < D2min) || (D2min < 0.0) || ((d2 == D2min) && (j < jmin)))
 							{
 								Dmin = t;
 								D2min = d2;
+								jmin = j;
 							}
 						}
 					}
 				}
 			}
-		}
+		});
 
 		if (D2min < 0)
 		{
@@ -262,7 +280,14 @@ bool CSurfaceDistance::ClosestPoint(GObject* pso, GObject* pmo, vector<double>&
 	// get the number of nodes
 	int nodes = ps->Nodes();
 
+	// build the search tree over the master nodes
+	vector<vec3d> rm(pm->Nodes());
+	for (int j=0; j<pm->Nodes(); ++j) rm[j] = pm->Node(j).r;
+	FEKDTree tree;
+	tree.Build(rm);
+
 	// repeat for all nodes
+#pragma omp parallel for
 	for (int i=0; i<nodes; ++i)
 	{
 		FENode& nodei = ps->Node(i);
@@ -273,24 +298,9 @@ bool CSurfaceDistance::ClosestPoint(GObject* pso, GObject* pmo, vector<double>&
 		// convert it to the local coordinate in the master object
 		ri = pmo->GetTransform().GlobalToLocal(ri);
 
-		// repeat over all master nodes
+		// find the closest master node
 		double Dmin = 0.0;
-		for (int j=0; j<pm->Nodes(); ++j)
-		{
-			// get the position of the master node
-			vec3d& rj = pm->Node(j).r;
-
-			// separation vector
-			vec3d r = rj - ri;
-
-			// square length
-			double d2 = r*r;
-
-			if ((d2 < Dmin)||(j==0))
-			{
-				Dmin = d2;
-			}			
-		}
+		tree.FindClosest(ri, Dmin);
 
 		dist[i] = sqrt(Dmin);
 	}
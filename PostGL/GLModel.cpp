@@ -177,12 +177,7 @@ void CGLModel::ResetAllStates()
 	FEPostModel* fem = GetFEModel();
 	if ((fem == 0) || (fem->GetStates() == 0)) return;
 
-	int N = fem->GetStates();
-	for (int i=0; i<N; ++i)
-	{
-		FEState* ps = fem->GetState(i);
-		ps->m_nField = -1;
-	}
+	fem->ResetAllStates();
 }
 
 //-----------------------------------------------------------------------------
@@ -34,6 +34,12 @@ using namespace Post;
 
 bool Post::DataScale(FEPostModel& fem, int nfield, double scale)
 {
+	// the filtered data is stored in the states, so we need all of them in memory
+	fem.LoadAllStates();
+
+	// the field's values will change, so the states need to reevaluate
+	fem.ResetAllStates();
+
 	Post::FEPostMesh& mesh = *fem.GetFEMesh(0);
 	float fscale = (float) scale;
 	// loop over all states
@@ -393,6 +399,12 @@ bool Post::DataScale(FEPostModel& fem, int nfield, double scale)
 //-----------------------------------------------------------------------------
 bool Post::DataScaleVec3(FEPostModel& fem, int nfield, vec3d scale)
 {
+	// the filtered data is stored in the states, so we need all of them in memory
+	fem.LoadAllStates();
+
+	// the field's values will change, so the states need to reevaluate
+	fem.ResetAllStates();
+
 	Post::FEPostMesh& mesh = *fem.GetFEMesh(0);
 
 	vec3f fscale = to_vec3f(scale);
@@ -696,6 +708,12 @@ bool DataSmoothStep(FEPostModel& fem, int nfield, double theta)
 // Apply a smoothing operation on data
 bool Post::DataSmooth(FEPostModel& fem, int nfield, double theta, int niters)
 {
+	// the filtered data is stored in the states, so we need all of them in memory
+	fem.LoadAllStates();
+
+	// the field's values will change, so the states need to reevaluate
+	fem.ResetAllStates();
+
 	for (int n = 0; n<niters; ++n) 
 	{
 		if (DataSmoothStep(fem, nfield, theta) == false) return false;
@@ -715,6 +733,12 @@ double flt_err(double d, double s) { return fabs(d - s); }
 //-----------------------------------------------------------------------------
 bool Post::DataArithmetic(FEPostModel& fem, int nfield, int nop, int noperand)
 {
+	// the filtered data is stored in the states, so we need all of them in memory
+	fem.LoadAllStates();
+
+	// the field's values will change, so the states need to reevaluate
+	fem.ResetAllStates();
+
 	int ndst = FIELD_CODE(nfield);
 	int nsrc = FIELD_CODE(noperand);
 
@@ -912,6 +936,12 @@ bool Post::DataArithmetic(FEPostModel& fem, int nfield, int nop, int noperand)
 //-----------------------------------------------------------------------------
 bool Post::DataGradient(FEPostModel& fem, int vecField, int sclField)
 {
+	// the filtered data is stored in the states, so we need all of them in memory
+	fem.LoadAllStates();
+
+	// the field's values will change, so the states need to reevaluate
+	fem.ResetAllStates();
+
 	int nvec = FIELD_CODE(vecField);
 	int nscl = FIELD_CODE(sclField);
 
@@ -1242,6 +1272,9 @@ void extractElemDataComponentNODE(Data_Type ntype, Post::FEMeshData& dst, Post::
 
 FEDataField* Post::DataComponent(FEPostModel& fem, FEDataField* pdf, int ncomp, const std::string& sname)
 {
+	// the filtered data is stored in the states, so we need all of them in memory
+	fem.LoadAllStates();
+
 	if (pdf == 0) return 0;
 
 	int nclass = pdf->DataClass();
@@ -1308,6 +1341,12 @@ FEDataField* Post::DataComponent(FEPostModel& fem, FEDataField* pdf, int ncomp,
 // Calculate the fractional anisotropy of a tensor field
 bool Post::DataFractionalAnsisotropy(FEPostModel& fem, int scalarField, int tensorField)
 {
+	// the filtered data is stored in the states, so we need all of them in memory
+	fem.LoadAllStates();
+
+	// the field's values will change, so the states need to reevaluate
+	fem.ResetAllStates();
+
 	int ntns = FIELD_CODE(tensorField);
 	int nscl = FIELD_CODE(scalarField);
 
@@ -1360,6 +1399,9 @@ bool Post::DataFractionalAnsisotropy(FEPostModel& fem, int scalarField, int tens
 // convert between formats
 FEDataField* Post::DataConvert(FEPostModel& fem, FEDataField* dataField, int newFormat, const std::string& name)
 {
+	// the filtered data is stored in the states, so we need all of them in memory
+	fem.LoadAllStates();
+
 	if (dataField == nullptr) return nullptr;
 
 	int nclass = dataField->DataClass();
@@ -1482,6 +1524,9 @@ FEDataField* Post::DataConvert(FEPostModel& fem, FEDataField* dataField, int new
 
 FEDataField* Post::DataEigenTensor(FEPostModel& fem, FEDataField* dataField, const std::string& name)
 {
+	// the filtered data is stored in the states, so we need all of them in memory
+	fem.LoadAllStates();
+
 	int dataType = dataField->Type();
 	int nfmt = dataField->Format();
 	int nclass = dataField->DataClass();
@@ -1531,6 +1576,9 @@ FEDataField* Post::DataEigenTensor(FEPostModel& fem, FEDataField* dataField, con
 
 FEDataField* Post::DataTimeRate(FEPostModel& fem, FEDataField* dataField, const std::string& name)
 {
+	// the filtered data is stored in the states, so we need all of them in memory
+	fem.LoadAllStates();
+
 	if (dataField == nullptr) return nullptr;
 
 	int nclass = dataField->DataClass();
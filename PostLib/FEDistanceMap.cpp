@@ -106,7 +106,7 @@ void Post::FEDistanceMap::Surface::BuildNodeList(Post::FEPostMesh& mesh)
 	}
 
 	// create the node-facet look-up table
-	m_NLT.resize(Nodes());
+	m_NLT.assign(Nodes(), vector<int>());
 	for (int i=0; i<Faces(); ++i)
 	{
 		FEFace& f = mesh.Face(m_face[i]);
@@ -114,9 +114,35 @@ void Post::FEDistanceMap::Surface::BuildNodeList(Post::FEPostMesh& mesh)
 		for (int j=0; j<nf; ++j)
 		{
 			int inode = m_lnode[MN*i+j];
-			m_NLT[inode].push_back(m_face[i]);
+			m_NLT[inode].push_back(i);
 		}
 	}
+
+	// store the facet nodes for the search tree
+	// (all nodes are stored, since a midside node can be the closest node)
+	m_fnode.assign(MN*Faces(), -1);
+	for (int i=0; i<Faces(); ++i)
+	{
+		FEFace& f = mesh.Face(m_face[i]);
+		int nf = f.Nodes();
+		for (int j=0; j<nf; ++j) m_fnode[MN*i + j] = m_lnode[MN*i + j];
+	}
+	m_pos.clear();
+}
+
+//-----------------------------------------------------------------------------
+// The search tree is built for the first state and refit for all others,
+// since the facet connectivity doesn't change between states.
+void Post::FEDistanceMap::Surface::UpdatePositions(Post::FEPostModel& fem, int ntime)
+{
+	bool bbuild = m_pos.empty();
+
+	int NN = Nodes();
+	m_pos.resize(NN);
+	for (int i=0; i<NN; ++i) m_pos[i] = fem.NodePosition(m_node[i], ntime);
+
+	if (bbuild) m_bvh.Build(m_fnode, m_pos, FEFace::MAX_NODES);
+	else m_bvh.Refit(m_pos);
 }
 
 //-----------------------------------------------------------------------------
@@ -178,14 +204,18 @@ void Post::FEDistanceMap::Apply()
 		FEState* ps = fem.GetState(n);
 		Post::FEFaceData<float, DATA_NODE>* df = dynamic_cast<Post::FEFaceData<float, DATA_NODE>*>(&ps->m_Data[nfield]);
 
+		// get the node positions for this state
+		m_surf1.UpdatePositions(fem, n);
+		m_surf2.UpdatePositions(fem, n);
+
 		// loop over all nodes of surface 1
-		vector<float> a(m_surf1.Nodes());
-		for (int i = 0; i < m_surf1.Nodes(); ++i)
+		int N1 = m_surf1.Nodes();
+		vector<float> a(N1);
+#pragma omp parallel for
+		for (int i = 0; i < N1; ++i)
 		{
-			int inode = m_surf1.m_node[i];
-			FENode& node = mesh.Node(inode);
-			vec3f r = fem.NodePosition(inode, n);
-			vec3f q = project(m_surf2, r, n);
+			vec3f r = to_vec3f(m_surf1.m_pos[i]);
+			vec3f q = project(m_surf2, r);
 			a[i] = (q - r).Length();
 			if (m_bsigned)
 			{
@@ -198,13 +228,13 @@ void Post::FEDistanceMap::Apply()
 		df->add(a, m_surf1.m_face, m_surf1.m_lnode, nf1);
 
 		// loop over all nodes of surface 2
-		vector<float> b(m_surf2.Nodes());
-		for (int i = 0; i < m_surf2.Nodes(); ++i)
+		int N2 = m_surf2.Nodes();
+		vector<float> b(N2);
+#pragma omp parallel for
+		for (int i = 0; i < N2; ++i)
 		{
-			int inode = m_surf2.m_node[i];
-			FENode& node = mesh.Node(inode);
-			vec3f r = fem.NodePosition(inode, n);
-			vec3f q = project(m_surf1, r, n);
+			vec3f r = to_vec3f(m_surf2.m_pos[i]);
+			vec3f q = project(m_surf1, r);
 			b[i] = (q - r).Length();
 			if (m_bsigned)
 			{
@@ -219,44 +249,44 @@ void Post::FEDistanceMap::Apply()
 }
 
 //-----------------------------------------------------------------------------
-vec3f Post::FEDistanceMap::project(Post::FEDistanceMap::Surface& surf, vec3f& r, int ntime)
+vec3f Post::FEDistanceMap::project(Post::FEDistanceMap::Surface& surf, vec3f& r)
 {
-	Post::FEPostModel& fem = *GetModel();
-	Post::FEPostMesh& mesh = *fem.GetFEMesh(0);
-
 	// find the closest surface node
-	vec3f q = fem.NodePosition(surf.m_node[0], ntime);
-	float Dmin = (q - r)*(q - r);
+	// (only nodes of facets whose bounding box is closer than the current best can be closer)
+	vec3d x(r);
 	int imin = 0;
-	for (int i=1; i<surf.Nodes(); ++i)
-	{
-		vec3f p = fem.NodePosition(surf.m_node[i], ntime);
-		float D = (p - r)*(p - r);
-		if (D < Dmin)
+	double Dmin = (surf.m_pos[0] - x)*(surf.m_pos[0] - x);
+	const int MN = FEFace::MAX_NODES;
+	surf.m_bvh.ForEachFacetNear(x, Dmin, [&](int facet) {
+		const int* fn = &surf.m_fnode[MN*facet];
+		for (int j=0; (j<MN) && (fn[j] >= 0); ++j)
 		{
-			q = p;
-			Dmin = D;
-			imin = i;
+			int k = fn[j];
+			double D = (surf.m_pos[k] - x)*(surf.m_pos[k] - x);
+			if ((D < Dmin) || ((D == Dmin) && (k < imin)))
+			{
+				Dmin = D;
+				imin = k;
+			}
 		}
-	}
+	});
+	vec3f q = to_vec3f(surf.m_pos[imin]);
+	float D2min = (q - r)*(q - r);
 
 	// loop over all facets connected to this node
 	vector<int>& FT = surf.m_NLT[imin];
 	for (int i=0; i<(int) FT.size(); ++i)
 	{
-		// get the i-th facet
-		FEFace& face = mesh.Face(FT[i]);
-
 		// project r onto the the facet
 		vec3f p;
-		if (ProjectToFacet(face, r, ntime, p))
+		if (ProjectToFacet(surf, FT[i], r, p))
 		{
 			// return the closest projection
 			float D = (p - r)*(p - r);
-			if (D < Dmin)
+			if (D < D2min)
 			{
 				q = p;
-				Dmin = D;
+				D2min = D;
 			}
 		}
 	}
@@ -265,18 +295,15 @@ vec3f Post::FEDistanceMap::project(Post::FEDistanceMap::Surface& surf, vec3f& r,
 }
 
 //-----------------------------------------------------------------------------
-bool Post::FEDistanceMap::ProjectToFacet(FEFace& f, vec3f& x, int ntime, vec3f& q)
+bool Post::FEDistanceMap::ProjectToFacet(Post::FEDistanceMap::Surface& surf, int facet, vec3f& x, vec3f& q)
 {
-	Post::FEPostModel& fem = *GetModel();
-
 	// get the mesh to which this surface belongs
-	Post::FEPostMesh& mesh = *fem.GetFEMesh(0);
-	
-	// number of element nodes
-	int nf = f.Nodes();
-	
-	// get the elements nodal positions
+	Post::FEPostMesh& mesh = *GetModel()->GetFEMesh(0);
+	FEFace& f = mesh.Face(surf.m_face[facet]);
+
+	// get the facet's nodal positions
 	const int MN = FEFace::MAX_NODES;
+	const int* fn = &surf.m_fnode[4*facet];
 	vec3f y[MN];
 	
 	// calculate normal projection of x onto element
@@ -287,7 +314,7 @@ bool Post::FEDistanceMap::ProjectToFacet(FEFace& f, vec3f& x, int ntime, vec3f&
 	case FE_FACE_TRI7:
 	case FE_FACE_TRI10:
 		{
-			for (int i = 0; i<3; ++i) y[i] = fem.NodePosition(f.n[i], ntime);
+			for (int i = 0; i<3; ++i) y[i] = to_vec3f(surf.m_pos[fn[i]]);
 			return ProjectToTriangle(y, x, q, m_tol);
 		}
 		break;
@@ -295,7 +322,7 @@ bool Post::FEDistanceMap::ProjectToFacet(FEFace& f, vec3f& x, int ntime, vec3f&
 	case FE_FACE_QUAD8:
 	case FE_FACE_QUAD9:
 		{
-			for (int i = 0; i<4; ++i) y[i] = fem.NodePosition(f.n[i], ntime);
+			for (int i = 0; i<4; ++i) y[i] = to_vec3f(surf.m_pos[fn[i]]);
 			return ProjectToQuad(y, x, q, m_tol);
 		}
 		break;
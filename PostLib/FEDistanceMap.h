@@ -26,6 +26,7 @@ SOFTWARE.*/
 
 #pragma once
 #include "FEDataField.h"
+#include <MeshLib/FEFacetBVH.h>
 
 namespace Post {
 
@@ -45,13 +46,20 @@ private:
 
 		int Nodes() { return (int) m_node.size(); }
 
+		// update the node positions and the search tree for a state
+		void UpdatePositions(FEPostModel& fem, int ntime);
+
 	public:
 		vector<int>	m_face;		// face list
 		vector<int>	m_node;		// node list
 		vector<int>	m_lnode;	// local node list
 		vector<vec3f> m_norm;	// node normals
 
-		vector<vector<int> >	m_NLT;	// node-facet look-up table
+		vector<vector<int> >	m_NLT;	// node-facet look-up table (local facet indices)
+
+		vector<int>		m_fnode;	// facet nodes (local node indices, FEFace::MAX_NODES per facet, padded with -1)
+		vector<vec3d>	m_pos;		// node positions of the current state
+		FEFacetBVH		m_bvh;		// search tree over facets
 	};
 
 public:
@@ -78,10 +86,10 @@ protected:
 	void BuildNormalList(FEDistanceMap::Surface& s);
 
 	// project r onto the surface
-	vec3f project(Surface& surf, vec3f& r, int ntime);
+	vec3f project(Surface& surf, vec3f& r);
 
-	// project r onto a facet
-	bool ProjectToFacet(FEFace& face, vec3f& r, int ntime, vec3f& q);
+	// project r onto a facet of the surface
+	bool ProjectToFacet(Surface& surf, int facet, vec3f& r, vec3f& q);
 
 protected:
 	Surface			m_surf1;
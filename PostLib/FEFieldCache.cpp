@@ -0,0 +1,218 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEFieldCache.h"
+#include "FEState.h"
+#include "FEPostMesh.h"
+using namespace Post;
+
+//-----------------------------------------------------------------------------
+int FEFieldCache::m_maxSizeMB = 256;
+
+//-----------------------------------------------------------------------------
+void FEFieldCache::SetMaxSize(int nsizeMB) { m_maxSizeMB = (nsizeMB < 0 ? 0 : nsizeMB); }
+int FEFieldCache::GetMaxSize() { return m_maxSizeMB; }
+
+//-----------------------------------------------------------------------------
+FEFieldCache::FEFieldCache()
+{
+	m_size = 0;
+}
+
+//-----------------------------------------------------------------------------
+FEFieldCache::~FEFieldCache()
+{
+	Clear();
+}
+
+//-----------------------------------------------------------------------------
+void FEFieldCache::Store(FEState* ps)
+{
+	int nfield = ps->m_nField;
+	if ((nfield < 0) || (m_maxSizeMB == 0)) return;
+
+	// if we already have it, we only need to move it to the front
+	std::list<Entry*>::iterator it;
+	for (it = m_entries.begin(); it != m_entries.end(); ++it)
+	{
+		Entry* e = *it;
+		if ((e->m_state == ps) && (e->m_nfield == nfield))
+		{
+			m_entries.erase(it);
+			m_entries.push_front(e);
+			return;
+		}
+	}
+
+	Entry* e = new Entry;
+	e->m_state = ps;
+	e->m_nfield = nfield;
+
+	int NN = (int)ps->m_NODE.size();
+	e->m_nodeVal.resize(NN);
+	e->m_nodeTag.resize(NN);
+	for (int i = 0; i < NN; ++i)
+	{
+		e->m_nodeVal[i] = ps->m_NODE[i].m_val;
+		e->m_nodeTag[i] = ps->m_NODE[i].m_ntag;
+	}
+
+	int NF = (int)ps->m_FACE.size();
+	e->m_faceVal.resize(NF);
+	e->m_faceTag.resize(NF);
+	for (int i = 0; i < NF; ++i)
+	{
+		e->m_faceVal[i] = ps->m_FACE[i].m_val;
+		e->m_faceTag[i] = ps->m_FACE[i].m_ntag;
+	}
+
+	int NE = (int)ps->m_ELEM.size();
+	e->m_elemVal.resize(NE);
+	e->m_elemActive.resize(NE);
+	for (int i = 0; i < NE; ++i)
+	{
+		e->m_elemVal[i] = ps->m_ELEM[i].m_val;
+		e->m_elemActive[i] = ((ps->m_ELEM[i].m_state & StatusFlags::ACTIVE) != 0);
+	}
+
+	e->m_elemData = ps->m_ElemData;
+	e->m_faceData = ps->m_FaceData;
+
+	e->m_size = NN*(sizeof(float) + sizeof(int)) + NF*(sizeof(float) + sizeof(int)) + NE*sizeof(float) + NE / 8 + e->m_elemData.memorySize() + e->m_faceData.memorySize();
+
+	// make room for the new entry
+	size_t maxSize = (size_t)m_maxSizeMB * 1024 * 1024;
+	if (e->m_size > maxSize) { delete e; return; }
+	Trim(maxSize - e->m_size);
+
+	m_entries.push_front(e);
+	m_size += e->m_size;
+}
+
+//-----------------------------------------------------------------------------
+bool FEFieldCache::Restore(FEState* ps, int nfield)
+{
+	std::list<Entry*>::iterator it;
+	for (it = m_entries.begin(); it != m_entries.end(); ++it)
+	{
+		Entry* e = *it;
+		if ((e->m_state == ps) && (e->m_nfield == nfield))
+		{
+			// make sure the state still matches the cached data
+			int NN = (int)ps->m_NODE.size();
+			int NF = (int)ps->m_FACE.size();
+			int NE = (int)ps->m_ELEM.size();
+			if ((NN != (int)e->m_nodeVal.size()) || (NF != (int)e->m_faceVal.size()) || (NE != (int)e->m_elemVal.size()))
+			{
+				m_size -= e->m_size;
+				m_entries.erase(it);
+				delete e;
+				return false;
+			}
+
+			for (int i = 0; i < NN; ++i)
+			{
+				ps->m_NODE[i].m_val = e->m_nodeVal[i];
+				ps->m_NODE[i].m_ntag = e->m_nodeTag[i];
+			}
+
+			for (int i = 0; i < NF; ++i)
+			{
+				ps->m_FACE[i].m_val = e->m_faceVal[i];
+				ps->m_FACE[i].m_ntag = e->m_faceTag[i];
+			}
+
+			// the element's active flag is stored on the mesh, so we need to restore that as well
+			FEPostMesh& mesh = *ps->GetFEMesh();
+			for (int i = 0; i < NE; ++i)
+			{
+				ELEMDATA& d = ps->m_ELEM[i];
+				FEElement_& el = mesh.ElementRef(i);
+				d.m_val = e->m_elemVal[i];
+				if (e->m_elemActive[i])
+				{
+					d.m_state |= StatusFlags::ACTIVE;
+					el.Activate();
+				}
+				else
+				{
+					d.m_state &= ~StatusFlags::ACTIVE;
+					el.Deactivate();
+				}
+			}
+
+			ps->m_ElemData = e->m_elemData;
+			ps->m_FaceData = e->m_faceData;
+			ps->m_nField = nfield;
+
+			// move it to the front of the list
+			m_entries.erase(it);
+			m_entries.push_front(e);
+			return true;
+		}
+	}
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+void FEFieldCache::Remove(FEState* ps)
+{
+	std::list<Entry*>::iterator it = m_entries.begin();
+	while (it != m_entries.end())
+	{
+		Entry* e = *it;
+		if (e->m_state == ps)
+		{
+			m_size -= e->m_size;
+			delete e;
+			it = m_entries.erase(it);
+		}
+		else ++it;
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEFieldCache::Clear()
+{
+	std::list<Entry*>::iterator it;
+	for (it = m_entries.begin(); it != m_entries.end(); ++it) delete (*it);
+	m_entries.clear();
+	m_size = 0;
+}
+
+//-----------------------------------------------------------------------------
+void FEFieldCache::Trim(size_t maxSize)
+{
+	while (!m_entries.empty() && (m_size > maxSize))
+	{
+		Entry* e = m_entries.back();
+		m_size -= e->m_size;
+		delete e;
+		m_entries.pop_back();
+	}
+}
@@ -0,0 +1,96 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include <list>
+#include <vector>
+#include "ValArray.h"
+
+namespace Post {
+
+class FEState;
+
+//-----------------------------------------------------------------------------
+// This class caches the evaluated values of fields. When a state switches to 
+// another field, the values of the old field are stored here so that switching 
+// back to that field does not require a reevaluation. The cache is shared by
+// all the states of a model and the least recently used entries are removed 
+// when the cache exceeds its maximum size.
+class FEFieldCache
+{
+	struct Entry
+	{
+		FEState*	m_state;
+		int			m_nfield;
+
+		std::vector<float>	m_nodeVal;
+		std::vector<int>	m_nodeTag;
+		std::vector<float>	m_faceVal;
+		std::vector<int>	m_faceTag;
+		std::vector<float>	m_elemVal;
+		std::vector<bool>	m_elemActive;
+		ValArray	m_elemData;
+		ValArray	m_faceData;
+
+		size_t		m_size;	// memory used by this entry (in bytes)
+	};
+
+public:
+	FEFieldCache();
+	~FEFieldCache();
+
+	// store the values of the state's currently evaluated field
+	void Store(FEState* ps);
+
+	// copy the values of field nfield back into the state.
+	// Returns false if the field was not found in the cache.
+	bool Restore(FEState* ps, int nfield);
+
+	// remove all the entries of a state
+	void Remove(FEState* ps);
+
+	// remove all entries
+	void Clear();
+
+	// memory currently used by the cache (in bytes)
+	size_t Size() const { return m_size; }
+
+public:
+	// set the max size of the cache (in MB). Setting it to zero disables the cache.
+	static void SetMaxSize(int nsizeMB);
+	static int GetMaxSize();
+
+private:
+	void Trim(size_t maxSize);
+
+private:
+	std::list<Entry*>	m_entries;	// most recently used entries first
+	size_t				m_size;
+
+	static int	m_maxSizeMB;
+};
+}
@@ -30,79 +30,100 @@ SOFTWARE.*/
 
 using namespace Post;
 
-FEMathData::FEMathData(FEState* state, FEMathDataField* pdf) : FENodeData_T<float>(state, pdf)
+// variable slots of the math data equations
+enum { MATH_X, MATH_Y, MATH_Z, MATH_T, MATH_VARS };
+
+void Post::CompileMathDataEquation(CMathExpression& exp, const std::string& eq)
 {
-	m_pdf = pdf;
+	if (exp.Variables() == 0)
+	{
+		exp.AddVariable("x");
+		exp.AddVariable("y");
+		exp.AddVariable("z");
+		exp.AddVariable("t");
+	}
+	exp.Compile(eq);
 }
 
-// evaluate all the nodal data for this state
-void FEMathData::eval(int n, float* pv)
+//-----------------------------------------------------------------------------
+// Helper class for evaluating the equations of a math data field over a range of nodes.
+class MathDataEvaluator
 {
-	FEPostModel& fem = *GetFEModel();
-
-
-	double time = m_state->m_time;
-
-	FEPostMesh& mesh = *m_state->GetFEMesh();
-
-	CMathParser math;
-	math.set_variable("t", time);
-
-	int ierr;
-	FENode& node = mesh.Node(n);
+public:
+	MathDataEvaluator(FEState& state, int nbegin, int nend) : m_n(nend - nbegin)
+	{
+		FEPostModel& fem = *state.GetFEModel();
+		int ntime = state.GetID();
+		m_t = (double)state.m_time;
+
+		m_x.resize(m_n); m_y.resize(m_n); m_z.resize(m_n);
+		for (int i = 0; i < m_n; ++i)
+		{
+			vec3f r = fem.NodePosition(nbegin + i, ntime);
+			m_x[i] = r.x; m_y[i] = r.y; m_z[i] = r.z;
+		}
+		m_val.resize(m_n);
+	}
 
-	vec3f r = fem.NodePosition(n, m_state->GetID());
-	math.set_variable("x", (double)r.x);
-	math.set_variable("y", (double)r.y);
-	math.set_variable("z", (double)r.z);
+	// evaluate the expression for all nodes. The values are returned in a buffer owned by this class.
+	const double* eval(const CMathExpression& exp)
+	{
+		const double* vars[MATH_VARS] = { m_x.data(), m_y.data(), m_z.data(), &m_t };
+		const int stride[MATH_VARS] = { 1, 1, 1, 0 };
+		exp.Eval(m_n, vars, stride, m_val.data());
+		return m_val.data();
+	}
 
-	const std::string& eq = m_pdf->EquationString();
+private:
+	int		m_n;
+	double	m_t;
+	std::vector<double>	m_x, m_y, m_z, m_val;
+};
 
-	double v = math.eval(eq.c_str(), ierr);
+//-----------------------------------------------------------------------------
+FEMathData::FEMathData(FEState* state, FEMathDataField* pdf) : FENodeData_T<float>(state, pdf)
+{
+	m_pdf = pdf;
+}
 
-	if (pv) *pv = (float) v;
+// evaluate the nodal data for this state
+void FEMathData::eval(int n, float* pv)
+{
+	if (pv) eval(n, n + 1, pv);
 }
 
+void FEMathData::eval(int nbegin, int nend, float* pv)
+{
+	MathDataEvaluator math(*m_state, nbegin, nend);
+	const double* v = math.eval(m_pdf->Expression());
+	for (int i = 0; i < nend - nbegin; ++i) pv[i] = (float)v[i];
+}
 
+//-----------------------------------------------------------------------------
 FEMathVec3Data::FEMathVec3Data(FEState* state, FEMathVec3DataField* pdf) : FENodeData_T<vec3f>(state, pdf)
 {
 	m_pdf = pdf;
 }
 
-// evaluate all the nodal data for this state
+// evaluate the nodal data for this state
 void FEMathVec3Data::eval(int n, vec3f* pv)
 {
-	FEPostModel& fem = *GetFEModel();
-
-	FEState& state = *m_state;
-	int ntime = state.GetID();
-	double time = (double)state.m_time;
-
-	FEPostMesh& mesh = *state.GetFEMesh();
-
-	CMathParser math;
-	math.set_variable("t", time);
-
-	int ierr;
-	FENode& node = mesh.Node(n);
-
-	vec3f r = fem.NodePosition(n, ntime);
-	math.set_variable("x", (double)r.x);
-	math.set_variable("y", (double)r.y);
-	math.set_variable("z", (double)r.z);
-
-	const std::string& x = m_pdf->EquationString(0);
-	const std::string& y = m_pdf->EquationString(1);
-	const std::string& z = m_pdf->EquationString(2);
-
-	vec3f v;
-	v.x = (float)math.eval(x.c_str(), ierr);
-	v.y = (float)math.eval(y.c_str(), ierr);
-	v.z = (float)math.eval(z.c_str(), ierr);
+	if (pv) eval(n, n + 1, pv);
+}
 
-	if (pv) *pv = v;
+void FEMathVec3Data::eval(int nbegin, int nend, vec3f* pv)
+{
+	MathDataEvaluator math(*m_state, nbegin, nend);
+	int N = nend - nbegin;
+	const double* v = math.eval(m_pdf->Expression(0));
+	for (int i = 0; i < N; ++i) pv[i].x = (float)v[i];
+	v = math.eval(m_pdf->Expression(1));
+	for (int i = 0; i < N; ++i) pv[i].y = (float)v[i];
+	v = math.eval(m_pdf->Expression(2));
+	for (int i = 0; i < N; ++i) pv[i].z = (float)v[i];
 }
 
+//-----------------------------------------------------------------------------
 FEMathMat3Data::FEMathMat3Data(FEState* state, FEMathMat3DataField* pdf) : FENodeData_T<mat3f>(state, pdf)
 {
 	m_pdf = pdf;
@@ -111,33 +132,16 @@ FEMathMat3Data::FEMathMat3Data(FEState* state, FEMathMat3DataField* pdf) : FENod
 // evaluate the nodal data for this state
 void FEMathMat3Data::eval(int n, mat3f* pv)
 {
-	if (pv == nullptr) return;
-
-	FEPostModel& fem = *GetFEModel();
-
-	FEState& state = *m_state;
-	int ntime = state.GetID();
-	double time = (double)state.m_time;
-
-	FEPostMesh& mesh = *state.GetFEMesh();
-
-	CMathParser math;
-	math.set_variable("t", time);
-
-	int ierr;
-	FENode& node = mesh.Node(n);
-
-	vec3f r = fem.NodePosition(n, ntime);
-	math.set_variable("x", (double)r.x);
-	math.set_variable("y", (double)r.y);
-	math.set_variable("z", (double)r.z);
+	if (pv) eval(n, n + 1, pv);
+}
 
-	float m[9] = { 0.f };
-	for (int i = 0; i < 9; ++i)
+void FEMathMat3Data::eval(int nbegin, int nend, mat3f* pv)
+{
+	MathDataEvaluator math(*m_state, nbegin, nend);
+	int N = nend - nbegin;
+	for (int k = 0; k < 9; ++k)
 	{
-		const std::string& eq = m_pdf->EquationString(i);
-		m[i] = (float) math.eval(eq.c_str(), ierr);
+		const double* v = math.eval(m_pdf->Expression(k));
+		for (int i = 0; i < N; ++i) pv[i](k / 3, k % 3) = (float)v[i];
 	}
-
-	*pv = mat3f(m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8]);
 }
@@ -26,10 +26,14 @@ SOFTWARE.*/
 
 #pragma once
 #include "FEMeshData_T.h"
-#include <MathLib/MathParser.h>
+#include <MathLib/MathExpression.h>
 
 namespace Post {
 
+// Compile the equation of a math data field. The equations can use the
+// nodal coordinates (x, y, z) and the time (t).
+void CompileMathDataEquation(CMathExpression& exp, const std::string& eq);
+
 class FEMathDataField;
 class FEMathVec3DataField;
 class FEMathMat3DataField;
@@ -42,6 +46,9 @@ public:
 	// evaluate the nodal data for this state
 	void eval(int n, float* pv) override;
 
+	// evaluate a range of nodes
+	void eval(int nbegin, int nend, float* pv) override;
+
 private:
 	FEMathDataField*	m_pdf;
 };
@@ -54,6 +61,9 @@ public:
 	// evaluate the nodal data for this state
 	void eval(int n, vec3f* pv) override;
 
+	// evaluate a range of nodes
+	void eval(int nbegin, int nend, vec3f* pv) override;
+
 private:
 	FEMathVec3DataField*	m_pdf;
 };
@@ -66,6 +76,9 @@ public:
 	// evaluate the nodal data for this state
 	void eval(int n, mat3f* pv) override;
 
+	// evaluate a range of nodes
+	void eval(int nbegin, int nend, mat3f* pv) override;
+
 private:
 	FEMathMat3DataField*	m_pdf;
 };
@@ -82,7 +95,7 @@ public:
 	FEDataField* Clone() const override
 	{
 		FEMathDataField* pd = new FEMathDataField(m_fem);
-		pd->m_eq = m_eq;
+		pd->SetEquationString(m_eq);
 		return pd;
 	}
 
@@ -92,12 +105,15 @@ public:
 		return new FEMathData(pstate, this);
 	}
 
-	void SetEquationString(const std::string& eq) { m_eq = eq; }
+	void SetEquationString(const std::string& eq) { m_eq = eq; CompileMathDataEquation(m_exp, eq); }
 
 	const std::string& EquationString() const { return m_eq; }
 
+	const CMathExpression& Expression() const { return m_exp; }
+
 private:
-	std::string	m_eq;		//!< equation string
+	std::string		m_eq;		//!< equation string
+	CMathExpression	m_exp;		//!< compiled equation
 };
 
 class FEMathVec3DataField : public FEDataField
@@ -114,9 +130,7 @@ public:
 	FEDataField* Clone() const override
 	{
 		FEMathVec3DataField* pd = new FEMathVec3DataField(m_fem);
-		pd->m_eq[0] = m_eq[0];
-		pd->m_eq[1] = m_eq[1];
-		pd->m_eq[2] = m_eq[2];
+		pd->SetEquationStrings(m_eq[0], m_eq[1], m_eq[2]);
 		return pd;
 	}
 
@@ -128,17 +142,20 @@ public:
 
 	void SetEquationStrings(const std::string& x, const std::string& y, const std::string& z)
 	{
-		m_eq[0] = x; 
-		m_eq[1] = y;
-		m_eq[2] = z;
+		SetEquationString(0, x);
+		SetEquationString(1, y);
+		SetEquationString(2, z);
 	}
 
-	void SetEquationString(int n, const std::string& eq) { m_eq[n] = eq; }
+	void SetEquationString(int n, const std::string& eq) { m_eq[n] = eq; CompileMathDataEquation(m_exp[n], eq); }
 
 	const std::string& EquationString(int n) const { return m_eq[n]; }
 
+	const CMathExpression& Expression(int n) const { return m_exp[n]; }
+
 private:
-	std::string	m_eq[3];		//!< equation string
+	std::string		m_eq[3];		//!< equation string
+	CMathExpression	m_exp[3];		//!< compiled equations
 };
 
 class FEMathMat3DataField : public FEDataField
@@ -152,7 +169,7 @@ public:
 	FEDataField* Clone() const override
 	{
 		FEMathMat3DataField* pd = new FEMathMat3DataField(m_fem);
-		for (int i = 0; i < 9; ++i) pd->m_eq[i] = m_eq[i];
+		for (int i = 0; i < 9; ++i) pd->SetEquationString(i, m_eq[i]);
 		return pd;
 	}
 
@@ -167,16 +184,19 @@ public:
 		const std::string& m10, const std::string& m11, const std::string& m12,
 		const std::string& m20, const std::string& m21, const std::string& m22)
 	{
-		m_eq[0] = m00; m_eq[1] = m01; m_eq[2] = m02;
-		m_eq[3] = m10; m_eq[4] = m11; m_eq[5] = m12;
-		m_eq[6] = m20; m_eq[7] = m21; m_eq[8] = m22;
+		SetEquationString(0, m00); SetEquationString(1, m01); SetEquationString(2, m02);
+		SetEquationString(3, m10); SetEquationString(4, m11); SetEquationString(5, m12);
+		SetEquationString(6, m20); SetEquationString(7, m21); SetEquationString(8, m22);
 	}
 
-	void SetEquationString(int n, const std::string& eq) { m_eq[n] = eq; }
+	void SetEquationString(int n, const std::string& eq) { m_eq[n] = eq; CompileMathDataEquation(m_exp[n], eq); }
 
 	const std::string& EquationString(int n) const { return m_eq[n]; }
 
+	const CMathExpression& Expression(int n) const { return m_exp[n]; }
+
 private:
-	std::string	m_eq[9];		//!< equation string
+	std::string		m_eq[9];		//!< equation string
+	CMathExpression	m_exp[9];		//!< compiled equations
 };
 }
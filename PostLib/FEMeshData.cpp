@@ -1192,31 +1192,17 @@ void FECurvature::level(int n, int l, set<int>& nl1)
 	vector<int> nl2; nl2.reserve(64);
 	for (int k=0; k<=l; ++k)
 	{
-		// reset face marks
+		// faces visited on this level
+		// (kept local instead of using the face tags, since faces are evaluated in parallel)
+		set<int> visited;
 		set<int>::iterator it;
-		for (it = nl1.begin(); it != nl1.end(); ++it)
-		{
-			// get the node-face list
-			const vector<NodeFaceRef>& nfl = pmesh->NodeFaceList(*it);
-			int NF = nfl.size();
-
-			// add the other nodes
-			for (int i=0; i<NF; ++i)
-			{
-				if (m_face[nfl[i].fid] == 1)
-				{
-					FEFace& f = pmesh->Face(nfl[i].fid); 
-					f.m_ntag = 0;
-				}
-			}
-		}
 
 		// loop over all nodes
 		nl2.clear();
 		for (it = nl1.begin(); it != nl1.end(); ++it)
 		{
 			// get the node-face list
-			const vector<NodeFaceRef>& nfl = pmesh->NodeFaceList(*it);
+			NodeFaceRefList nfl = pmesh->NodeFaceList(*it);
 			int NF = nfl.size();
 
 			// add the other nodes
@@ -1225,11 +1211,10 @@ void FECurvature::level(int n, int l, set<int>& nl1)
 				FEFace& f = pmesh->Face(nfl[i].fid);
 				if (m_face[nfl[i].fid] == 1)
 				{
-					if (f.m_ntag == 0)
+					if (visited.insert(nfl[i].fid).second)
 					{
 						int ne = f.Nodes();
 						for (int j=0; j<ne; ++j) if (f.n[j] != *it) nl2.push_back(f.n[j]);
-						f.m_ntag = 1;
 					}
 				}
 			}
@@ -1275,7 +1260,7 @@ float FECurvature::nodal_curvature(int n, int measure)
 	vec3f r0 = pfem->NodePosition(n, ntime);
 
 	// get the node-face list
-	const vector<NodeFaceRef>& nfl = pmesh->NodeFaceList(n);
+	NodeFaceRefList nfl = pmesh->NodeFaceList(n);
 	int NF = nfl.size();
 
 	// estimate surface normal
@@ -1335,31 +1320,17 @@ void FEPrincCurvatureVector::level(int n, int l, set<int>& nl1)
 	vector<int> nl2; nl2.reserve(64);
 	for (int k=0; k<=l; ++k)
 	{
-		// reset face marks
+		// faces visited on this level
+		// (kept local instead of using the face tags, since faces are evaluated in parallel)
+		set<int> visited;
 		set<int>::iterator it;
-		for (it = nl1.begin(); it != nl1.end(); ++it)
-		{
-			// get the node-face list
-			const vector<NodeFaceRef>& nfl = pmesh->NodeFaceList(*it);
-			int NF = nfl.size();
-
-			// add the other nodes
-			for (int i=0; i<NF; ++i)
-			{
-				if (m_face[nfl[i].fid] == 1)
-				{
-					FEFace& f = pmesh->Face(nfl[i].fid); 
-					f.m_ntag = 0;
-				}
-			}
-		}
 
 		// loop over all nodes
 		nl2.clear();
 		for (it = nl1.begin(); it != nl1.end(); ++it)
 		{
 			// get the node-face list
-			const vector<NodeFaceRef>& nfl = pmesh->NodeFaceList(*it);
+			NodeFaceRefList nfl = pmesh->NodeFaceList(*it);
 			int NF = nfl.size();
 
 			// add the other nodes
@@ -1368,11 +1339,10 @@ void FEPrincCurvatureVector::level(int n, int l, set<int>& nl1)
 				FEFace& f = pmesh->Face(nfl[i].fid);
 				if (m_face[nfl[i].fid] == 1)
 				{
-					if (f.m_ntag == 0)
+					if (visited.insert(nfl[i].fid).second)
 					{
 						int ne = f.Nodes();
 						for (int j=0; j<ne; ++j) if (f.n[j] != *it) nl2.push_back(f.n[j]);
-						f.m_ntag = 1;
 					}
 				}
 			}
@@ -1418,7 +1388,7 @@ vec3f FEPrincCurvatureVector::nodal_curvature(int n, int m)
 	vec3f r0 = pfem->NodePosition(n, ntime);
 
 	// get the node-face list
-	const vector<NodeFaceRef>& nfl = pmesh->NodeFaceList(n);
+	NodeFaceRefList nfl = pmesh->NodeFaceList(n);
 	int NF = nfl.size();
 
 	// estimate surface normal
@@ -1793,6 +1763,26 @@ void FEElemPressure::eval(int n, float* pv)
 	else *pv = 0.f;
 }
 
+//-----------------------------------------------------------------------------
+void FEElemPressure::eval(int nbegin, int nend, float* pv)
+{
+	if (nend <= nbegin) return;
+
+	// get stress field
+	FEState& state = *GetFEState();
+	FEMeshData& rd = state.m_Data[m_nstress];
+	FEElemData_T<mat3fs,DATA_ITEM>& dm = dynamic_cast<FEElemData_T<mat3fs,DATA_ITEM>&>(rd);
+
+	// evaluate all the stresses at once
+	vector<mat3fs> s(nend - nbegin);
+	dm.eval(nbegin, nend, &s[0]);
+
+	// evaluate pressure
+	for (int n = nbegin; n < nend; ++n)
+	{
+		pv[n - nbegin] = (dm.active(n) ? -s[n - nbegin].tr() / 3.f : 0.f);
+	}
+}
 
 //=============================================================================
 // Element nodal pressure
@@ -1882,3 +1872,35 @@ void FESolidStress::eval(int n, mat3fs* pv)
 	}
 	else *pv = mat3fs(0.f,0.f,0.f,0.f,0.f,0.f);
 }
+
+//-----------------------------------------------------------------------------
+void FESolidStress::eval(int nbegin, int nend, mat3fs* pv)
+{
+	if (nend <= nbegin) return;
+
+	// get stress and fluid pressure fields
+	FEState& state = *GetFEState();
+	FEElemData_T<mat3fs,DATA_ITEM>& dm = dynamic_cast<FEElemData_T<mat3fs,DATA_ITEM>&>(state.m_Data[m_nstress]);
+	FEElemData_T<float,DATA_ITEM>& dmp = dynamic_cast<FEElemData_T<float,DATA_ITEM>&>(state.m_Data[m_nflp]);
+
+	// evaluate all the stresses and pressures at once
+	int N = nend - nbegin;
+	vector<float> p(N);
+	dm.eval(nbegin, nend, pv);
+	dmp.eval(nbegin, nend, &p[0]);
+
+	for (int n = nbegin; n < nend; ++n)
+	{
+		mat3fs& m = pv[n - nbegin];
+		if (dm.active(n))
+		{
+			if (dmp.active(n))
+			{
+				m.x += p[n - nbegin];
+				m.y += p[n - nbegin];
+				m.z += p[n - nbegin];
+			}
+		}
+		else m = mat3fs(0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+	}
+}
@@ -58,6 +58,13 @@ public:
 	virtual void eval(int n, T* pv) = 0;
 	virtual bool active(int n) { return true; }
 
+	// evaluate the nodes in the range [nbegin, nend). The values are stored in pv[0] ... pv[nend - nbegin - 1].
+	// Derived classes can override this if they can do better than evaluating each node separately.
+	virtual void eval(int nbegin, int nend, T* pv)
+	{
+		for (int n = nbegin; n < nend; ++n) eval(n, pv + (n - nbegin));
+	}
+
 	static Data_Type Type  () { return FEMeshDataTraits<T>::Type  (); }
 	static Data_Format Format() { return DATA_ITEM; }
 	static Data_Class Class() { return CLASS_NODE; }
@@ -71,6 +78,7 @@ template <typename T> class FENodeData : public FENodeData_T<T>
 public:
 	FENodeData(FEState* state, FEDataField* pdf) : FENodeData_T<T>(state, pdf) { m_data.resize(state->GetFEMesh()->Nodes()); }
 	void eval(int n, T* pv) { (*pv) = m_data[n]; }
+	void eval(int nbegin, int nend, T* pv) { for (int n = nbegin; n < nend; ++n) pv[n - nbegin] = m_data[n]; }
 	void copy(FENodeData<T>& d) { m_data = d.m_data; }
 
 	int size() const { return (int) m_data.size(); }
@@ -126,6 +134,18 @@ public:
 	virtual void eval(int n, T* pv) = 0;
 	virtual bool active(int n) { return true; }
 
+	// evaluate the faces in the range [nbegin, nend). For DATA_ITEM and DATA_REGION formats, the value of face n
+	// is stored in pv[n - nbegin], otherwise the nodal values start at pv[(n - nbegin)*FEFace::MAX_NODES].
+	// Faces that are not active are skipped.
+	virtual void eval(int nbegin, int nend, T* pv)
+	{
+		const int stride = ((fmt == DATA_ITEM) || (fmt == DATA_REGION) ? 1 : FEFace::MAX_NODES);
+		for (int n = nbegin; n < nend; ++n)
+		{
+			if (active(n)) eval(n, pv + (n - nbegin)*stride);
+		}
+	}
+
 	static Data_Type Type  () { return FEMeshDataTraits<T>::Type  (); }
 	static Data_Format Format() { return fmt; }
 	static Data_Class Class() { return CLASS_FACE; }
@@ -145,6 +165,10 @@ public:
 			m_face.assign(state->GetFEMesh()->Faces(), -1); 
 	}
 	void eval(int n, T* pv) { (*pv) = m_data[m_face[n]]; }
+	void eval(int nbegin, int nend, T* pv)
+	{
+		for (int n = nbegin; n < nend; ++n) if (m_face[n] >= 0) pv[n - nbegin] = m_data[m_face[n]];
+	}
 	bool active(int n) { return (m_face[n] >= 0); }
 	void copy(FEFaceData<T,DATA_ITEM>& d) { m_data = d.m_data; }
 	bool add(int n, const T& d)
@@ -178,6 +202,10 @@ public:
 			m_face.assign(state->GetFEMesh()->Faces(), -1); 
 	}
 	void eval(int n, T* pv) { (*pv) = m_data[m_face[n]]; }
+	void eval(int nbegin, int nend, T* pv)
+	{
+		for (int n = nbegin; n < nend; ++n) if (m_face[n] >= 0) pv[n - nbegin] = m_data[m_face[n]];
+	}
 	bool active(int n) { return (m_face[n] >= 0); }
 	void copy(FEFaceData<T,DATA_ITEM>& d) { m_data = d.m_data; }
 	bool add(vector<int>& item, const T& v) 
@@ -438,6 +466,18 @@ public:
 	virtual void eval(int n, T* pv) = 0;
 	virtual bool active(int n) { return true; }
 
+	// evaluate the elements in the range [nbegin, nend). For DATA_ITEM and DATA_REGION formats, the value of element n
+	// is stored in pv[n - nbegin], otherwise the nodal values start at pv[(n - nbegin)*FEElement::MAX_NODES].
+	// Elements that are not active are skipped.
+	virtual void eval(int nbegin, int nend, T* pv)
+	{
+		const int stride = ((fmt == DATA_ITEM) || (fmt == DATA_REGION) ? 1 : FEElement::MAX_NODES);
+		for (int n = nbegin; n < nend; ++n)
+		{
+			if (active(n)) eval(n, pv + (n - nbegin)*stride);
+		}
+	}
+
 	static Data_Type Type  () { return FEMeshDataTraits<T>::Type  (); }
 	static Data_Format Format() { return fmt; }
 	static Data_Class Class() { return CLASS_ELEM; }
@@ -456,6 +496,10 @@ public:
 		m_elem.assign(state->GetFEMesh()->Elements(), -1); 
 	}
 	void eval(int n, T* pv) { assert(m_elem[n] >= 0); (*pv) = m_data[m_elem[n]]; }
+	void eval(int nbegin, int nend, T* pv)
+	{
+		for (int n = nbegin; n < nend; ++n) if (m_elem[n] >= 0) pv[n - nbegin] = m_data[m_elem[n]];
+	}
 	void set(int n, const T& v) { assert(m_elem[n] >= 0); m_data[m_elem[n]] = v; }
 	void copy(FEElementData<T, DATA_ITEM>& d) { m_data = d.m_data; }
 	bool active(int n) { return (m_elem.empty() == false) && (m_elem[n] >= 0); }
@@ -487,6 +531,10 @@ public:
 			m_elem.assign(state->GetFEMesh()->Elements(), -1); 
 	}
 	void eval(int n, T* pv) { assert(m_elem[n] >= 0); (*pv) = m_data[m_elem[n]]; }
+	void eval(int nbegin, int nend, T* pv)
+	{
+		for (int n = nbegin; n < nend; ++n) if (m_elem[n] >= 0) pv[n - nbegin] = m_data[m_elem[n]];
+	}
 	void copy(FEElementData<T, DATA_REGION>& d) { m_data = d.m_data; }
 	bool active(int n) { return (m_elem.empty() == false) && (m_elem[n] >= 0); }
 	void add(vector<int>& item, const T& v) 
@@ -962,6 +1010,7 @@ class FEElemPressure : public FEElemData_T<float, DATA_ITEM>
 public:
 	FEElemPressure(FEState* state, FEDataField* pdf);
 	void eval(int n, float* pv);
+	void eval(int nbegin, int nend, float* pv);
 private:
 	int	m_nstress;	// stress field
 };
@@ -984,6 +1033,7 @@ class FESolidStress : public FEElemData_T<mat3fs, DATA_ITEM>
 public:
 	FESolidStress(FEState* state, FEDataField* pdf);
 	void eval(int n, mat3fs* pv);
+	void eval(int nbegin, int nend, mat3fs* pv);
 private:
 	int	m_nstress;	// total stress field
 	int	m_nflp;		// fluid pressure field
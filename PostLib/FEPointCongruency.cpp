@@ -254,7 +254,7 @@ float FEPointCongruency::nodal_curvature(int nid, vec3f& sn, int m)
 	vec3f r0 = to_vec3f(pm->Node(nid).pos());
 
 	// get the node-face list
-	const vector<NodeFaceRef>& nfl = m_NFL.FaceList(nid);
+	NodeFaceRefList nfl = m_NFL.FaceList(nid);
 	int NF = nfl.size();
 
 	// array of nodal points
@@ -491,39 +491,27 @@ void FEPointCongruency::level(int n, int l, set<int>& nl1)
 	vector<int> nl2; nl2.reserve(64);
 	for (int k=0; k<=l; ++k)
 	{
-		// reset face marks
+		// faces visited on this level
+		// (kept local instead of using the face tags, since faces are evaluated in parallel)
+		set<int> visited;
 		set<int>::iterator it;
-		for (it = nl1.begin(); it != nl1.end(); ++it)
-		{
-			// get the node-face list
-			const vector<NodeFaceRef>& nfl = m_NFL.FaceList(*it);
-			int NF = nfl.size();
-
-			// add the other nodes
-			for (int i=0; i<NF; ++i)
-			{
-				FEFace& f = pmesh->Face(nfl[i].fid); 
-				f.m_ntag = 0;
-			}
-		}
 
 		// loop over all nodes
 		nl2.clear();
 		for (it = nl1.begin(); it != nl1.end(); ++it)
 		{
 			// get the node-face list
-			const vector<NodeFaceRef>& nfl = m_NFL.FaceList(*it);
+			NodeFaceRefList nfl = m_NFL.FaceList(*it);
 			int NF = nfl.size();
 
 			// add the other nodes
 			for (int i=0; i<NF; ++i)
 			{
 				FEFace& f = pmesh->Face(nfl[i].fid);
-				if (f.m_ntag == 0)
+				if (visited.insert(nfl[i].fid).second)
 				{
 					int ne = f.Nodes();
 					for (int j=0; j<ne; ++j) if (f.n[j] != *it) nl2.push_back(f.n[j]);
-					f.m_ntag = 1;
 				}
 			}
 		}
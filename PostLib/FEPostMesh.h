@@ -59,7 +59,7 @@ public:
 	//! clean mesh and all data
 	void ClearAll();
 
-	const vector<NodeElemRef>& NodeElemList(int n) const { return m_NEL.ElementList(n); }
+	NodeElemRefList NodeElemList(int n) const { return m_NEL.ElementList(n); }
 
 public:
 	// --- G E O M E T R Y ---
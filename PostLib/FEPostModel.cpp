@@ -69,6 +69,9 @@ FEPostModel::FEPostModel()
 	m_nTime = 0;
 	m_fTime = 0.f;
 
+	m_stateLoader = nullptr;
+	m_maxPagedStates = 0;
+
 	m_pThis = this;
 }
 
@@ -108,7 +111,7 @@ FEPostModel* FEPostModel::GetInstance()
 //-----------------------------------------------------------------------------
 FEState* FEPostModel::CurrentState()
 {
-	return m_State[m_nTime];
+	return GetState(m_nTime);
 }
 
 //-----------------------------------------------------------------------------
@@ -116,6 +119,9 @@ void FEPostModel::SetCurrentTimeIndex(int ntime)
 {
 	m_nTime = ntime;
 	m_fTime = GetTimeValue(m_nTime);
+
+	// make sure the active state is loaded
+	if (m_stateLoader && (ntime >= 0) && (ntime < GetStates())) PageIn(m_State[ntime]);
 }
 
 //-----------------------------------------------------------------------------
@@ -130,15 +136,16 @@ void FEPostModel::SetTimeValue(float ftime)
 //
 int FEPostModel::GetClosestTime(double t)
 {
-	FEState& s0 = *GetState(0);
+	// (we only need the time values, so no need to page in any states)
+	FEState& s0 = *m_State[0];
 	if (s0.m_time >= t) return 0;
 
-	FEState& s1 = *GetState(GetStates() - 1);
+	FEState& s1 = *m_State[GetStates() - 1];
 	if (s1.m_time <= t) return GetStates() - 1;
 
 	for (int i = 1; i<GetStates(); ++i)
 	{
-		FEState& s = *GetState(i);
+		FEState& s = *m_State[i];
 		if (s.m_time >= t) return i - 1;
 	}
 	return GetStates() - 1;
@@ -148,7 +155,7 @@ int FEPostModel::GetClosestTime(double t)
 //-----------------------------------------------------------------------------
 float FEPostModel::GetTimeValue(int ntime)
 {
-	return GetState(ntime)->m_time;
+	return m_State[ntime]->m_time;
 }
 
 //-----------------------------------------------------------------------------
@@ -243,6 +250,83 @@ void FEPostModel::ClearStates()
 	for (int i=0; i<(int) m_State.size(); i++) delete m_State[i];
 	m_State.clear();
 	m_nTime = 0;
+
+	// the state loader is only valid for the states it created
+	m_stateLoader = nullptr;
+	m_pagedStates.clear();
+
+	m_fieldCache.Clear();
+}
+
+//-----------------------------------------------------------------------------
+void FEPostModel::SetStateLoader(FEStateLoader* loader, int maxStates)
+{
+	// we need at least a few states in memory, since some evaluations
+	// (e.g. time derivatives) access more than one state at a time.
+	if (maxStates < 3) maxStates = 3;
+
+	m_stateLoader = loader;
+	m_maxPagedStates = maxStates;
+
+	if (loader == nullptr) LoadAllStates();
+}
+
+//-----------------------------------------------------------------------------
+void FEPostModel::LoadAllStates()
+{
+	if (m_stateLoader)
+	{
+		for (int i = 0; i < (int)m_State.size(); ++i)
+		{
+			FEState* ps = m_State[i];
+			if (ps->m_bpaged && (ps->IsLoaded() == false))
+			{
+				ps->AllocateData();
+				m_stateLoader->LoadState(ps);
+			}
+		}
+	}
+
+	// no more paging for these states
+	for (int i = 0; i < (int)m_State.size(); ++i) m_State[i]->m_bpaged = false;
+	m_pagedStates.clear();
+	m_stateLoader = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void FEPostModel::PageIn(FEState* ps)
+{
+	if (ps->m_bpaged == false) return;
+
+	// most of the time we'll be accessing the same state over and over again
+	if (!m_pagedStates.empty() && (m_pagedStates.front() == ps)) return;
+
+	if (ps->IsLoaded())
+	{
+		// move it to the front of the list
+		m_pagedStates.remove(ps);
+		m_pagedStates.push_front(ps);
+		return;
+	}
+
+	// read the state's data
+	ps->AllocateData();
+	if (m_stateLoader->LoadState(ps) == false)
+	{
+		assert(false);
+	}
+	m_pagedStates.push_front(ps);
+
+	// release the least recently used states, but never the active one
+	FEState* activeState = ((m_nTime >= 0) && (m_nTime < (int)m_State.size()) ? m_State[m_nTime] : nullptr);
+	while ((int)m_pagedStates.size() > m_maxPagedStates)
+	{
+		std::list<FEState*>::iterator it = --m_pagedStates.end();
+		if (*it == activeState) --it;
+
+		(*it)->ClearData();
+		m_pagedStates.erase(it);
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -279,6 +363,8 @@ void FEPostModel::DeleteState(int n)
 	int N = m_State.size();
 	assert((n>=0) && (n<N));
 	for (int i=0; i<n; ++i) ++it;
+	m_pagedStates.remove(*it);
+	m_fieldCache.Remove(*it);
 	m_State.erase(it);
 
 	// reindex the states
@@ -342,6 +428,9 @@ FEDataField* FEPostModel::CopyDataField(FEDataField* pd, const char* sznewname)
 	}
 	else pdcopy->SetName(sznewname);
 
+	// the copied data is stored in the states, so we can't page them anymore
+	LoadAllStates();
+
 	// Add it to the model
 	AddDataField(pdcopy);
 
@@ -675,6 +764,9 @@ FEDataField* FEPostModel::CreateCachedCopy(FEDataField* pd, const char* sznewnam
 	FEDataField* pdcopy = createCachedDataField(pd);
 	if (pdcopy == 0) return 0;
 
+	// the cached data is stored in the states, so we can't page them anymore
+	LoadAllStates();
+
 	// Add it to the model
 	AddDataField(pdcopy, sznewname);
 
@@ -807,11 +899,12 @@ void FEPostModel::DeleteDataField(FEDataField* pd)
 	if (m == -1) { assert(false); return; }
 
 	// remove this field from all states
+	// (paged out states don't have any data)
 	int NS = GetStates();
 	for (int i=0; i<NS; ++i)
 	{
-		FEState* ps = GetState(i);
-		ps->m_Data.erase(m);
+		FEState* ps = m_State[i];
+		if (ps->IsLoaded()) ps->m_Data.erase(m);
 	}
 	m_pDM->DeleteDataField(pd);
 
@@ -827,10 +920,11 @@ void FEPostModel::AddDataField(FEDataField* pd, const std::string& name)
 	m_pDM->AddDataField(pd, name);
 
 	// now add new data for each of the states
+	// (paged out states will create the data when they are paged in)
 	vector<FEState*>::iterator it;
 	for (it=m_State.begin(); it != m_State.end(); ++it)
 	{
-		(*it)->m_Data.push_back(pd->CreateData(*it));
+		if ((*it)->IsLoaded()) (*it)->m_Data.push_back(pd->CreateData(*it));
 	}
 
 	// update all dependants
@@ -846,6 +940,9 @@ void FEPostModel::AddDataField(FEDataField* pd, vector<int>& L)
 	// add the data field to the data manager
 	m_pDM->AddDataField(pd);
 
+	// the face list is stored in the state data, so we can't page the states anymore
+	LoadAllStates();
+
 	// now add new meshdata for each of the states
 	vector<FEState*>::iterator it;
 	for (it=m_State.begin(); it != m_State.end(); ++it)
@@ -934,7 +1031,7 @@ void FEPostModel::GetElementCoords(int iel, int ntime, vec3f* r)
 {
 	FEPostMesh* mesh = GetState(ntime)->GetFEMesh();
 	FEElement_& elem = mesh->ElementRef(iel);
-	NODEDATA* pn = &m_State[ntime]->m_NODE[0];
+	NODEDATA* pn = &GetState(ntime)->m_NODE[0];
 
 	for (int i=0; i<elem.Nodes(); i++)
 		r[i] = pn[ elem.m_node[i] ].m_rt;
@@ -990,6 +1087,9 @@ void FEPostModel::AddDependant(FEModelDependant* pc)
 //-----------------------------------------------------------------------------
 void FEPostModel::UpdateDependants()
 {
+	// the data fields may have changed, so the cached values are no longer reliable
+	m_fieldCache.Clear();
+
 	int N = m_Dependants.size();
 	for (int i=0; i<N; ++i) m_Dependants[i]->Update(this);
 }
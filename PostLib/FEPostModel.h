@@ -30,9 +30,11 @@ SOFTWARE.*/
 #include "FEMaterial.h"
 #include "FEState.h"
 #include "FEDataManager.h"
+#include "FEFieldCache.h"
 #include "GLObject.h"
 #include <FSCore/box.h>
 #include <vector>
+#include <list>
 //using namespace std;
 
 namespace Post {
@@ -58,6 +60,21 @@ public:
 	virtual void Update(FEPostModel* pfem) = 0;
 };
 
+//-----------------------------------------------------------------------------
+// Base class for classes that can (re)load the data of a state on demand.
+// This is used when the states are paged in from file instead of all being
+// kept in memory.
+class FEStateLoader
+{
+public:
+	FEStateLoader() {}
+	virtual ~FEStateLoader() {}
+
+	// This function is called when the data of a paged state needs to be read.
+	// The data of the state will already be allocated.
+	virtual bool LoadState(FEState* ps) = 0;
+};
+
 //-----------------------------------------------------------------------------
 // Class that describes an FEPostModel. A model consists of a mesh (in the future
 // there can be multiple meshes to support remeshing), a list of materials
@@ -170,7 +187,26 @@ public:
 	int GetStates() { return (int) m_State.size(); }
 
 	//! retrieve pointer to a state
-	FEState* GetState(int nstate) { return m_State[nstate]; }
+	//! (This will load the state's data if the state was paged out)
+	FEState* GetState(int nstate) { FEState* ps = m_State[nstate]; if (m_stateLoader) PageIn(ps); return ps; }
+
+	//! get the status flag of a state (does not page in the state)
+	int GetStateStatus(int nstate) { return m_State[nstate]->m_status; }
+
+	// --- S T A T E   P A G I N G ---
+	//! Set the state loader. When set, only the last maxStates states that were
+	//! accessed are kept in memory. The other (paged) states are reloaded on demand. 
+	void SetStateLoader(FEStateLoader* loader, int maxStates);
+
+	//! get the state loader
+	FEStateLoader* GetStateLoader() { return m_stateLoader; }
+
+	//! Load all states and turn off paging. Call this before storing data 
+	//! in the states that cannot be reloaded from file (e.g. data filters)
+	void LoadAllStates();
+
+	//! get the max number of paged states that are kept in memory
+	int GetMaxPagedStates() const { return m_maxPagedStates; }
 
 	//! Add a new data field
 	void AddDataField(FEDataField* pd, const std::string& name = "");
@@ -203,6 +239,13 @@ public:
 	// --- E V A L U A T I O N ---
 	bool Evaluate(int nfield, int ntime, bool breset = false);
 
+	// Force all states to reevaluate their field, e.g. when the field's values changed.
+	// (This also clears the field cache.)
+	void ResetAllStates();
+
+	// clear the cached field values
+	void ClearFieldCache();
+
 	// get the nodal coordinates of an element at time
 	void GetElementCoords(int iel, int ntime, vec3f* r);
 
@@ -215,6 +258,14 @@ public:
 	// evaluate based on point
 	void EvaluateNode(const vec3f& r, int ntime, int nfield, NODEDATA& d);
 
+	// --- T I M E   H I S T O R Y ---
+	// Evaluate a field for a list of items over the states [nmin, nmax] (nmax = -1 means up to the last state).
+	// The values are returned as an item-by-time matrix, i.e. val[i*nsteps + n] is the value of item[i] 
+	// at state nmin + n. The return value is nsteps, the number of states that were evaluated.
+	int EvaluateNodeHistory(const vector<int>& items, int nfield, int nmin, int nmax, vector<float>& val);
+	int EvaluateFaceHistory(const vector<int>& items, int nfield, int nmin, int nmax, vector<float>& val);
+	int EvaluateElemHistory(const vector<int>& items, int nfield, int nmin, int nmax, vector<float>& val);
+
 	// evaluate vector functions
 	vec3f EvaluateNodeVector(int n, int ntime, int nvec);
 	bool EvaluateFaceVector(int n, int ntime, int nvec, vec3f& r);
@@ -277,6 +328,9 @@ protected:
 	void EvalNodeField(int ntime, int nfield);
 	void EvalFaceField(int ntime, int nfield);
 	void EvalElemField(int ntime, int nfield);
+
+	// Helper function for state paging
+	void PageIn(FEState* ps);
 	
 protected:
 	string	m_name;		// name (as displayed in model viewer)
@@ -305,6 +359,14 @@ protected:
 	FEDataManager*		m_pDM;		// the Data Manager
 	int					m_ndisp;	// vector field defining the displacement
 
+	// --- P A G I N G ---
+	FEStateLoader*		m_stateLoader;		// loads paged states on demand
+	int					m_maxPagedStates;	// max nr of paged states kept in memory
+	std::list<FEState*>	m_pagedStates;		// paged states currently in memory (most recently used first)
+
+	// --- E V A L U A T I O N ---
+	FEFieldCache		m_fieldCache;	// values of previously evaluated fields
+
 	// dependants
 	vector<FEModelDependant*>	m_Dependants;
 
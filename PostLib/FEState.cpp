@@ -86,50 +86,12 @@ FERefState::FERefState(FEPostModel* fem)
 
 //-----------------------------------------------------------------------------
 // Constructor
-FEState::FEState(float time, FEPostModel* fem, Post::FEPostMesh* pmesh) : m_fem(fem), m_mesh(pmesh)
+FEState::FEState(float time, FEPostModel* fem, Post::FEPostMesh* pmesh, bool allocData) : m_fem(fem), m_mesh(pmesh)
 {
 	m_id = -1;
 	m_ref = nullptr; // will be set by model
-
-	Post::FEPostMesh& mesh = *m_mesh;
-
-	int nodes = mesh.Nodes();
-	int edges = mesh.Edges();
-	int elems = mesh.Elements();
-	int faces = mesh.Faces();
-
-	// allocate storage
-	m_NODE.resize(nodes);
-	m_EDGE.resize(edges);
-	m_ELEM.resize(elems);
-	m_FACE.resize(faces);
-
-	// allocate element data
-	for (int i=0; i<elems; ++i)
-	{
-		FEElement_& el = mesh.ElementRef(i);
-		int ne = el.Nodes();
-		m_ElemData.append(ne);
-	}
-
-	// allocate face data
-	for (int i=0; i<faces; ++i)
-	{
-		FEFace& face = mesh.Face(i);
-		int nf = face.Nodes();
-		m_FaceData.append(nf);
-	}
-
-	// initialize data
-	for (int i=0; i<nodes; ++i) m_NODE[i].m_rt = to_vec3f(mesh.Node(i).r);
-	for (int i=0; i<elems; ++i)
-	{
-		m_ELEM[i].m_state = StatusFlags::VISIBLE;
-		m_ELEM[i].m_h[0] = 0.f;
-		m_ELEM[i].m_h[1] = 0.f;
-		m_ELEM[i].m_h[2] = 0.f;
-		m_ELEM[i].m_h[3] = 0.f;
-	}
+	m_bpaged = false;
+	m_bloaded = false;
 
 	int ptObjs = fem->PointObjects();
 	m_objPt.resize(ptObjs);
@@ -192,10 +154,60 @@ FEState::FEState(float time, FEPostModel* fem, Post::FEPostMesh* pmesh) : m_fem(
 	m_nField = -1;
 	m_status = 0;
 
+	// The data can be allocated later (e.g. when the state is paged in)
+	if (allocData) AllocateData();
+}
+
+//-----------------------------------------------------------------------------
+void FEState::AllocateData()
+{
+	Post::FEPostMesh& mesh = *m_mesh;
+
+	int nodes = mesh.Nodes();
+	int edges = mesh.Edges();
+	int elems = mesh.Elements();
+	int faces = mesh.Faces();
+
+	// allocate storage
+	m_NODE.resize(nodes);
+	m_EDGE.resize(edges);
+	m_ELEM.resize(elems);
+	m_FACE.resize(faces);
+
+	// allocate element data
+	m_ElemData.clear();
+	for (int i=0; i<elems; ++i)
+	{
+		FEElement_& el = mesh.ElementRef(i);
+		int ne = el.Nodes();
+		m_ElemData.append(ne);
+	}
+
+	// allocate face data
+	m_FaceData.clear();
+	for (int i=0; i<faces; ++i)
+	{
+		FEFace& face = mesh.Face(i);
+		int nf = face.Nodes();
+		m_FaceData.append(nf);
+	}
+
+	// initialize data
+	for (int i=0; i<nodes; ++i) m_NODE[i].m_rt = to_vec3f(mesh.Node(i).r);
+	for (int i=0; i<elems; ++i)
+	{
+		m_ELEM[i].m_state = StatusFlags::VISIBLE;
+		m_ELEM[i].m_h[0] = 0.f;
+		m_ELEM[i].m_h[1] = 0.f;
+		m_ELEM[i].m_h[2] = 0.f;
+		m_ELEM[i].m_h[3] = 0.f;
+	}
+
 	// get the data manager
-	FEDataManager* pdm = fem->GetDataManager();
+	FEDataManager* pdm = m_fem->GetDataManager();
 
 	// Nodal data
+	m_Data.clear();
 	int N = pdm->DataFields();
 	FEDataFieldPtr it = pdm->FirstDataField();
 	for (int i=0; i<N; ++i, ++it)
@@ -203,6 +215,26 @@ FEState::FEState(float time, FEPostModel* fem, Post::FEPostMesh* pmesh) : m_fem(
 		FEDataField& d = *(*it);
 		m_Data.push_back(d.CreateData(this));
 	}
+
+	m_nField = -1;
+	m_bloaded = true;
+}
+
+//-----------------------------------------------------------------------------
+void FEState::ClearData()
+{
+	// make sure the memory is actually released
+	vector<NODEDATA>().swap(m_NODE);
+	vector<EDGEDATA>().swap(m_EDGE);
+	vector<FACEDATA>().swap(m_FACE);
+	vector<ELEMDATA>().swap(m_ELEM);
+	m_ElemData = ValArray();
+	m_FaceData = ValArray();
+	m_Data.clear();
+
+	// the evaluated field is no longer valid
+	m_nField = -1;
+	m_bloaded = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -242,6 +274,8 @@ FEState::FEState(float time, FEPostModel* pfem, FEState* pstate) : m_fem(pfem)
 	m_nField = -1;
 	m_status = 0;
 	m_mesh = pstate->m_mesh;
+	m_bpaged = false;
+	m_bloaded = true;
 
 	RebuildData();
 
@@ -136,7 +136,7 @@ public:
 class FEState
 {
 public:
-	FEState(float time, FEPostModel* fem, FEPostMesh* mesh);
+	FEState(float time, FEPostModel* fem, FEPostMesh* mesh, bool allocData = true);
 	FEState(float time, FEPostModel* fem, FEState* state);
 
 	void SetID(int n);
@@ -152,12 +152,23 @@ public:
 
 	void RebuildData();
 
+	// allocate the (mesh) data of this state
+	void AllocateData();
+
+	// release the (mesh) data of this state
+	// This is used when the state is paged out
+	void ClearData();
+
+	// see if the mesh data is allocated
+	bool IsLoaded() const { return m_bloaded; }
+
 public:
 	float	m_time;		// time value
 	int		m_nField;	// the field whos values are contained in m_pval
 	int		m_id;		// index in state array of FEPostModel
 	bool	m_bsmooth;
 	int		m_status;	// status flag
+	bool	m_bpaged;	// the state's data can be released and reloaded on demand
 
 	vector<NODEDATA>	m_NODE;		// nodal data
 	vector<EDGEDATA>	m_EDGE;		// edge data
@@ -177,5 +188,8 @@ public:
 	FEPostModel*	m_fem;	//!< model this state belongs to
 	FERefState*		m_ref;	//!< the reference state for this state
 	FEPostMesh*		m_mesh;	//!< The mesh this state uses
+
+private:
+	bool	m_bloaded;	//!< is the mesh data allocated?
 };
 }
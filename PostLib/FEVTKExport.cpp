@@ -197,32 +197,36 @@ void FEVTKExport::WriteCells(FEState* ps)
 	for (int j = 0; j<m.Elements(); ++j)
     {
 		FEElement_& el = m.ElementRef(j);
-        int vtk_type;
-        switch (el.Type()) {
-            case FE_HEX8   : vtk_type = VTK_HEXAHEDRON; break;
-            case FE_TET4   : vtk_type = VTK_TETRA; break;
-            case FE_PENTA6 : vtk_type = VTK_WEDGE; break;
-            case FE_PYRA5  : vtk_type = VTK_PYRAMID; break;
-            case FE_QUAD4  : vtk_type = VTK_QUAD; break;
-            case FE_TRI3   : vtk_type = VTK_TRIANGLE; break;
-            case FE_BEAM2  : vtk_type = VTK_LINE; break;
-            case FE_HEX20  : vtk_type = VTK_QUADRATIC_HEXAHEDRON; break;
-            case FE_QUAD8  : vtk_type = VTK_QUADRATIC_QUAD; break;
-            case FE_BEAM3  : vtk_type = VTK_QUADRATIC_EDGE; break;
-            case FE_TET10  : vtk_type = VTK_QUADRATIC_TETRA; break;
-            case FE_TET15  : vtk_type = VTK_QUADRATIC_TETRA; break;
-            case FE_PENTA15: vtk_type = VTK_QUADRATIC_WEDGE; break;
-            case FE_HEX27  : vtk_type = VTK_QUADRATIC_HEXAHEDRON; break;
-            case FE_PYRA13 : vtk_type = VTK_QUADRATIC_PYRAMID; break;
-            case FE_TRI6   : vtk_type = VTK_QUADRATIC_TRIANGLE; break;
-            case FE_QUAD9  : vtk_type = VTK_QUADRATIC_QUAD; break;
-            default: vtk_type = -1; break;
-        }
-            
+        int vtk_type = GetVTKCellType(el.Type());
         fprintf(m_fp, "%d\n", vtk_type);
     }
 }
 
+//-----------------------------------------------------------------------------
+int FEVTKExport::GetVTKCellType(int elemType)
+{
+	switch (elemType) {
+		case FE_HEX8   : return VTK_HEXAHEDRON;
+		case FE_TET4   : return VTK_TETRA;
+		case FE_PENTA6 : return VTK_WEDGE;
+		case FE_PYRA5  : return VTK_PYRAMID;
+		case FE_QUAD4  : return VTK_QUAD;
+		case FE_TRI3   : return VTK_TRIANGLE;
+		case FE_BEAM2  : return VTK_LINE;
+		case FE_HEX20  : return VTK_QUADRATIC_HEXAHEDRON;
+		case FE_QUAD8  : return VTK_QUADRATIC_QUAD;
+		case FE_BEAM3  : return VTK_QUADRATIC_EDGE;
+		case FE_TET10  : return VTK_QUADRATIC_TETRA;
+		case FE_TET15  : return VTK_QUADRATIC_TETRA;
+		case FE_PENTA15: return VTK_QUADRATIC_WEDGE;
+		case FE_HEX27  : return VTK_QUADRATIC_HEXAHEDRON;
+		case FE_PYRA13 : return VTK_QUADRATIC_PYRAMID;
+		case FE_TRI6   : return VTK_QUADRATIC_TRIANGLE;
+		case FE_QUAD9  : return VTK_QUADRATIC_QUAD;
+	}
+	return -1;
+}
+
 //-----------------------------------------------------------------------------
 void FEVTKExport::WritePointData(FEState* ps)
 {
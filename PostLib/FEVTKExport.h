@@ -40,11 +40,15 @@ public:
 
 	void ExportAllStates(bool b);
 
+public:
+	// these are also used by the VTU exporter
+	static int GetVTKCellType(int elemType);
+	static bool FillNodeDataArray(vector<float>& val, FEMeshData& data);
+	static bool FillElementNodeDataArray(vector<float>& val, FEMeshData& meshData);
+	static bool FillElemDataArray(vector<float>& val, FEMeshData& data, FEPart& part);
+
 private:
 	bool WriteState(const char* szname, FEState* ps);
-	bool FillNodeDataArray(vector<float>& val, FEMeshData& data);
-	bool FillElementNodeDataArray(vector<float>& val, FEMeshData& meshData);
-	bool FillElemDataArray(vector<float>& val, FEMeshData& data, FEPart& part);
     
 private:
 	void WriteHeader(FEState* ps);
@@ -77,6 +77,7 @@ FEVTKimport::FEVTKimport(FEPostModel* fem) : FEFileReader(fem)
 	m_isUnstructuredGrid = false;
 	m_readingPointData = false;
 	m_readingCellData = false;
+	m_binary = false;
 	m_vtk = nullptr;
 }
 
@@ -95,6 +96,7 @@ bool FEVTKimport::Load(const char* szfile)
 	m_isUnstructuredGrid = false;
 	m_readingPointData = false;
 	m_readingCellData = false;
+	m_binary = false;
 
 	if (m_vtk) delete m_vtk;
 	m_vtk = new VTKModel;
@@ -179,7 +181,8 @@ bool FEVTKimport::ProcessSeries(const char* szfile)
 
 bool FEVTKimport::readFile(const char* szfile)
 {
-	if (!Open(szfile, "rt")) return errf("Failed opening file %s.", szfile);
+	// open in binary mode, since the data sections could be binary
+	if (!Open(szfile, "rb")) return errf("Failed opening file %s.", szfile);
 
 	if (readHeader() == false) return false;
 
@@ -254,13 +257,88 @@ bool FEVTKimport::readHeader()
 	// skip the second line (title)
 	ch = fgets(szline, 255, m_fp); if (ch == 0) return false;
 
-	// third line should be BINARY or ASCII (we only support ASCII)
+	// third line should be BINARY or ASCII
 	ch = fgets(szline, 255, m_fp); if (ch == 0) return false;
-	if (strstr(ch, "ASCII") == 0) return errf("Only ASCII files are read");
+	if      (strstr(ch, "ASCII" ) != 0) m_binary = false;
+	else if (strstr(ch, "BINARY") != 0) m_binary = true;
+	else return errf("Unknown file format");
 
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// size in bytes of the legacy VTK data types
+static int vtkTypeSize(const char* sztype)
+{
+	if ((strcmp(sztype, "unsigned_char" ) == 0) || (strcmp(sztype, "char"          ) == 0)) return 1;
+	if ((strcmp(sztype, "unsigned_short") == 0) || (strcmp(sztype, "short"         ) == 0)) return 2;
+	if ((strcmp(sztype, "unsigned_int"  ) == 0) || (strcmp(sztype, "int"           ) == 0)) return 4;
+	if ((strcmp(sztype, "float"         ) == 0)) return 4;
+	if ((strcmp(sztype, "double"        ) == 0)) return 8;
+	if ((strcmp(sztype, "vtktypeint64"  ) == 0) || (strcmp(sztype, "vtktypeuint64" ) == 0)) return 8;
+	if ((strcmp(sztype, "unsigned_long" ) == 0) || (strcmp(sztype, "long"          ) == 0)) return 8;
+	return 0;
+}
+
+// convert n big-endian values of the given type
+template <class T> static void vtkConvertBinary(const char* sztype, const unsigned char* src, size_t n, T* dst)
+{
+	int size = vtkTypeSize(sztype);
+	bool isSigned = (strncmp(sztype, "unsigned", 8) != 0) && (strcmp(sztype, "vtktypeuint64") != 0);
+	bool isFloat = (strcmp(sztype, "float") == 0) || (strcmp(sztype, "double") == 0);
+	for (size_t i = 0; i < n; ++i, src += size)
+	{
+		unsigned long long u = 0;
+		for (int j = 0; j < size; ++j) u = (u << 8) | src[j];
+
+		if (isFloat)
+		{
+			if (size == 4) { unsigned int w = (unsigned int)u; float f; memcpy(&f, &w, 4); dst[i] = (T)f; }
+			else { double d; memcpy(&d, &u, 8); dst[i] = (T)d; }
+		}
+		else if (isSigned && (size < 8))
+		{
+			// sign extend
+			long long m = 1LL << (8 * size - 1);
+			dst[i] = (T)(((long long)u ^ m) - m);
+		}
+		else dst[i] = (T)(isSigned ? (long long)u : u);
+	}
+}
+
+// read n big-endian values. The file must have at least n values left, which is
+// checked before allocating, since n comes from the file.
+template <class T> static bool vtkReadBinary(FILE* fp, size_t bytesLeft, const char* sztype, size_t n, std::vector<T>& v)
+{
+	int size = vtkTypeSize(sztype);
+	if (size == 0) return false;
+	if (n > bytesLeft / size) return false;
+	v.resize(n);
+
+	// read in blocks, converting straight into the destination
+	const size_t blockSize = 65536;
+	std::vector<unsigned char> buf(blockSize * size);
+	for (size_t i = 0; i < n; i += blockSize)
+	{
+		size_t m = (n - i < blockSize ? n - i : blockSize);
+		if (fread(buf.data(), size, m, fp) != m) return false;
+		vtkConvertBinary(sztype, buf.data(), m, v.data() + i);
+	}
+	return true;
+}
+
+bool FEVTKimport::readBinary(const char* sztype, size_t n, std::vector<double>& v)
+{
+	if (vtkReadBinary(m_fp, (size_t)BytesLeft(), sztype, n, v) == false) return errf("An error occured while reading binary data.");
+	return true;
+}
+
+bool FEVTKimport::readBinary(const char* sztype, size_t n, std::vector<int>& v)
+{
+	if (vtkReadBinary(m_fp, (size_t)BytesLeft(), sztype, n, v) == false) return errf("An error occured while reading binary data.");
+	return true;
+}
+
 bool FEVTKimport::readDataSet(char* szline)
 {
 	if (strstr(szline, "POLYDATA"))
@@ -284,6 +362,22 @@ bool FEVTKimport::readPoints(char* szline)
 
 	m_vtk->m_pt.resize(nodes);
 
+	if (m_binary)
+	{
+		char sztype[64] = { 0 };
+		sscanf(szline, "%*s %*d %63s", sztype);
+		std::vector<double> v;
+		if (readBinary(sztype, 3 * (size_t)nodes, v) == false) return false;
+		for (int i = 0; i < nodes; ++i)
+		{
+			vec3f& r = m_vtk->m_pt[i];
+			r.x = (float)v[3 * i];
+			r.y = (float)v[3 * i + 1];
+			r.z = (float)v[3 * i + 2];
+		}
+		return true;
+	}
+
 	// read the nodes
 	//Check how many nodes are there in each line
 	char* ch = readLine(szline); if (ch == 0) return false;
@@ -333,13 +427,28 @@ bool FEVTKimport::readPolygons(char* szline)
 
 	// read the elements
 	m_vtk->m_el.resize(elems);
+
+	// binary data is stored as one list of ints
+	std::vector<int> data;
+	if (m_binary && (readBinary("int", size, data) == false)) return false;
+	size_t pos = 0;
+
 	int n[9];
 	for (int i = 0; i < elems; ++i)
 	{
 		VTKModel::CELL& el = m_vtk->m_el[i];
-		if (readLine(szline) == nullptr) return false;
+		if (m_binary)
+		{
+			if ((pos >= data.size()) || (data[pos] < 0) || (data[pos] > 8) || (pos + data[pos] >= data.size())) return errf("Invalid polygon data.");
+			for (int j = 0; j <= data[pos]; ++j) n[j] = data[pos + j];
+			pos += data[pos] + 1;
+		}
+		else
+		{
+			if (readLine(szline) == nullptr) return false;
+			int nread = sscanf(szline, "%d%d%d%d%d%d%d%d%d", &n[0], &n[1], &n[2], &n[3], &n[4], &n[5], &n[6], &n[7], &n[8]);
+		}
 
-		int nread = sscanf(szline, "%d%d%d%d%d%d%d%d%d", &n[0], &n[1], &n[2], &n[3], &n[4], &n[5], &n[6], &n[7], &n[8]);
 		int min = 0;
 		switch (n[0])
 		{
@@ -377,15 +486,30 @@ bool FEVTKimport::readCells(char* szline)
 
 	// read the elements
 	m_vtk->m_el.resize(elems);
+
+	// binary data is stored as one list of ints
+	std::vector<int> data;
+	if (m_binary && (readBinary("int", size, data) == false)) return false;
+	size_t pos = 0;
+
 	int n[9];
 	for (int i = 0; i < elems; ++i)
 	{
 		VTKModel::CELL& el = m_vtk->m_el[i];
 		el.type = FE_INVALID_ELEMENT_TYPE; // is determined by CELL_TYPE
 
-		if (readLine(szline) == nullptr) return false;
+		if (m_binary)
+		{
+			if ((pos >= data.size()) || (data[pos] < 0) || (data[pos] > 8) || (pos + data[pos] >= data.size())) return errf("Invalid cell data.");
+			for (int j = 0; j <= data[pos]; ++j) n[j] = data[pos + j];
+			pos += data[pos] + 1;
+		}
+		else
+		{
+			if (readLine(szline) == nullptr) return false;
+			int nread = sscanf(szline, "%d%d%d%d%d%d%d%d%d", &n[0], &n[1], &n[2], &n[3], &n[4], &n[5], &n[6], &n[7], &n[8]);
+		}
 
-		int nread = sscanf(szline, "%d%d%d%d%d%d%d%d%d", &n[0], &n[1], &n[2], &n[3], &n[4], &n[5], &n[6], &n[7], &n[8]);
 		int min = 0;
 		switch (n[0])
 		{
@@ -429,12 +553,20 @@ bool FEVTKimport::readCellTypes(char* szline)
 	sscanf(szline, "%*s%d", &elems);
 	if (elems != m_vtk->m_el.size()) return false;
 
+	std::vector<int> types;
+	if (m_binary && (readBinary("int", elems, types) == false)) return false;
+
 	for (int i = 0; i < elems; ++i)
 	{
-		if (readLine(szline) == nullptr) return false;
+		int ntype = 0;
+		if (m_binary) ntype = types[i];
+		else
+		{
+			if (readLine(szline) == nullptr) return false;
+			ntype = atoi(szline);
+		}
 
 		VTKModel::CELL& el = m_vtk->m_el[i];
-		int ntype = atoi(szline);
 		switch (ntype)
 		{
 		case 5 : el.type = FE_TRI3; break;
@@ -490,6 +622,38 @@ bool FEVTKimport::readScalars(char* szline)
 	// skip the lookup table tag
 	char* ch = readLine(szline);
 
+	if (m_binary)
+	{
+		if (m_readingPointData)
+		{
+			VTKModel::DataScalar data;
+			data.m_name = dataName;
+			if (readBinary(dataType, m_vtk->m_pt.size(), data.m_data) == false) return false;
+			m_vtk->m_ptDataScalar.push_back(data);
+		}
+		else if (m_readingCellData)
+		{
+			int elems = m_vtk->m_el.size();
+			if ((strcmp(dataType, "float") == 0) || (strcmp(dataType, "double") == 0))
+			{
+				VTKModel::DataScalar data;
+				data.m_name = dataName;
+				if (readBinary(dataType, elems, data.m_data) == false) return false;
+				m_vtk->m_cellDataScalar.push_back(data);
+			}
+			else
+			{
+				// assume these are part IDs
+				std::vector<int> ids;
+				if (readBinary(dataType, elems, ids) == false) return false;
+				for (int i = 0; i < elems; ++i) m_vtk->m_el[i].id = ids[i];
+			}
+		}
+		else return false;
+
+		return true;
+	}
+
 	if (m_readingPointData)
 	{
 		int nodes = m_vtk->m_pt.size();
@@ -555,6 +719,25 @@ bool FEVTKimport::readVectors(char* szline)
 	int nread = sscanf(szline, "%s %s %s", dataAttr, dataName, dataType);
 	if (strcmp(dataAttr, "VECTORS") != 0) return false;
 
+	if (m_binary)
+	{
+		if ((m_readingPointData == false) && (m_readingCellData == false)) return true;
+
+		size_t n = (m_readingPointData ? m_vtk->m_pt.size() : m_vtk->m_el.size());
+		std::vector<double> v;
+		if (readBinary(dataType, 3 * n, v) == false) return false;
+
+		VTKModel::DataVector data;
+		data.m_name = dataName;
+		data.m_data.resize(n);
+		for (size_t i = 0; i < n; ++i) data.m_data[i] = vec3f((float)v[3 * i], (float)v[3 * i + 1], (float)v[3 * i + 2]);
+
+		if (m_readingPointData) m_vtk->m_ptDataVector.push_back(data);
+		else m_vtk->m_cellDataVector.push_back(data);
+
+		return true;
+	}
+
 	if (m_readingPointData)
 	{
 		int nodes = m_vtk->m_pt.size();
@@ -610,6 +793,23 @@ bool FEVTKimport::readTensors(char* szline)
 		// TODO: implement this
 		return false;
 	}
+	else if (m_readingCellData && m_binary)
+	{
+		int elems = m_vtk->m_el.size();
+		std::vector<double> v;
+		if (readBinary(dataType, 9 * (size_t)elems, v) == false) return false;
+
+		VTKModel::DataTensor data;
+		data.m_name = dataName;
+		data.m_data.resize(elems);
+		for (int i = 0; i < elems; ++i)
+		{
+			const double* a = &v[9 * i];
+			data.m_data[i] = mat3f((float)a[0], (float)a[1], (float)a[2], (float)a[3], (float)a[4], (float)a[5], (float)a[6], (float)a[7], (float)a[8]);
+		}
+
+		m_vtk->m_cellDataTensor.push_back(data);
+	}
 	else if (m_readingCellData)
 	{
 		int elems = m_vtk->m_el.size();
@@ -57,6 +57,9 @@ protected:
 	bool readScalars(char* szline);
 	bool readVectors(char* szline);
 	bool readTensors(char* szline);
+
+	bool readBinary(const char* sztype, size_t n, std::vector<double>& v);
+	bool readBinary(const char* sztype, size_t n, std::vector<int>& v);
 	
 protected:
 	bool BuildMesh();
@@ -70,6 +73,7 @@ protected:
 	bool	m_isUnstructuredGrid;
 	bool	m_readingPointData;
 	bool	m_readingCellData;
+	bool	m_binary;	// data is stored in (big-endian) binary format
 
 	VTKModel* m_vtk;
 };
@@ -0,0 +1,422 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#include "FEVTUExport.h"
+#include "FEVTKExport.h"
+#include "FEPostModel.h"
+#include "FEMeshData_T.h"
+#include <stdio.h>
+#include <string.h>
+#include <zlib.h>
+#include <algorithm>
+using namespace Post;
+
+//-----------------------------------------------------------------------------
+// A data array of a VTU file. The bytes are stored in the encoded form
+// that is written to the appended data section.
+struct VTUDataArray
+{
+	std::string	name;
+	const char*	type;
+	int			ncomp;
+	std::vector<unsigned char>	data;
+};
+
+// The arrays of one piece.
+struct VTUPiece
+{
+	int	nodes;
+	int elems;
+	VTUDataArray	points;
+	VTUDataArray	cells[3];
+	std::vector<VTUDataArray>	pointData;
+	std::vector<VTUDataArray>	cellData;
+};
+
+static bool isBigEndian()
+{
+	int n = 1;
+	return (*(char*)&n == 0);
+}
+
+//-----------------------------------------------------------------------------
+// Encode the values for the appended section. Uncompressed data is preceded by
+// the number of bytes. Compressed data is split in blocks and is preceded by a
+// header with the number of blocks, the block size, the size of the last block,
+// and the compressed size of each block. 
+static void encodeArray(VTUDataArray& a, const void* pv, size_t nbytes, bool compress)
+{
+	const unsigned char* src = (const unsigned char*)pv;
+	if (compress == false)
+	{
+		unsigned long long h = nbytes;
+		a.data.resize(sizeof(h) + nbytes);
+		memcpy(a.data.data(), &h, sizeof(h));
+		if (nbytes > 0) memcpy(a.data.data() + sizeof(h), src, nbytes);
+		return;
+	}
+
+	const size_t blockSize = 32768;
+	size_t nblocks = (nbytes + blockSize - 1) / blockSize;
+	size_t lastSize = (nblocks > 0 ? nbytes - (nblocks - 1) * blockSize : 0);
+
+	std::vector<unsigned long long> h(3 + nblocks);
+	h[0] = nblocks;
+	h[1] = blockSize;
+	h[2] = lastSize;
+
+	std::vector<unsigned char> zbuf(compressBound((uLong)blockSize));
+	std::vector<unsigned char> body;
+	body.reserve(nbytes / 2);
+	for (size_t i = 0; i < nblocks; ++i)
+	{
+		size_t n = (i == nblocks - 1 ? lastSize : blockSize);
+		uLongf len = (uLongf)zbuf.size();
+		compress2(zbuf.data(), &len, src + i * blockSize, (uLong)n, Z_BEST_SPEED);
+		h[3 + i] = len;
+		body.insert(body.end(), zbuf.data(), zbuf.data() + len);
+	}
+
+	size_t hsize = h.size() * sizeof(unsigned long long);
+	a.data.resize(hsize + body.size());
+	memcpy(a.data.data(), h.data(), hsize);
+	if (body.empty() == false) memcpy(a.data.data() + hsize, body.data(), body.size());
+}
+
+// Expand the data values to VTK's component layout: tensors are written as full 3x3 matrices.
+static void expandValues(std::vector<float>& val, int ntype, int& ncomp)
+{
+	if (ntype == DATA_FLOAT) { ncomp = 1; return; }
+	if (ntype == DATA_VEC3F) { ncomp = 3; return; }
+
+	ncomp = 9;
+	int stride = (ntype == DATA_MAT3FS ? 6 : 3);
+	size_t n = val.size() / stride;
+	std::vector<float> v(9 * n, 0.f);
+	for (size_t i = 0; i < n; ++i)
+	{
+		const float* s = &val[stride * i];
+		float* d = &v[9 * i];
+		if (ntype == DATA_MAT3FS)
+		{
+			d[0] = s[0]; d[1] = s[3]; d[2] = s[5];
+			d[3] = s[3]; d[4] = s[1]; d[5] = s[4];
+			d[6] = s[5]; d[7] = s[4]; d[8] = s[2];
+		}
+		else
+		{
+			d[0] = s[0]; d[4] = s[1]; d[8] = s[2];
+		}
+	}
+	val.swap(v);
+}
+
+static int valueStride(int ntype)
+{
+	switch (ntype)
+	{
+	case DATA_FLOAT : return 1;
+	case DATA_VEC3F : return 3;
+	case DATA_MAT3FS: return 6;
+	case DATA_MAT3FD: return 3;
+	}
+	return 0;
+}
+
+// write a name as an XML attribute value
+static std::string xmlAttribute(const std::string& s)
+{
+	std::string r;
+	for (char c : s)
+	{
+		switch (c)
+		{
+		case '&': r += "&amp;"; break;
+		case '<': r += "&lt;"; break;
+		case '>': r += "&gt;"; break;
+		case '"': r += "&quot;"; break;
+		default:
+			r += c;
+		}
+	}
+	return r;
+}
+
+//-----------------------------------------------------------------------------
+FEVTUExport::FEVTUExport()
+{
+	m_bwriteAllStates = false;
+	m_bcompress = false;
+}
+
+void FEVTUExport::ExportAllStates(bool b)
+{
+	m_bwriteAllStates = b;
+}
+
+void FEVTUExport::SetCompression(bool b)
+{
+	m_bcompress = b;
+}
+
+void FEVTUExport::SetFieldSelection(const std::vector<std::string>& fields)
+{
+	m_fields = fields;
+}
+
+bool FEVTUExport::ExportField(const std::string& name) const
+{
+	if (m_fields.empty()) return true;
+	return (std::find(m_fields.begin(), m_fields.end(), name) != m_fields.end());
+}
+
+//-----------------------------------------------------------------------------
+bool FEVTUExport::Save(FEPostModel& fem, const char* szfile)
+{
+	int ns = fem.GetStates();
+	if (ns == 0) return false;
+
+	if (m_bwriteAllStates == false)
+	{
+		return WriteState(szfile, fem.CurrentState());
+	}
+
+	// strip the extension
+	std::string root(szfile);
+	size_t n = root.rfind('.');
+	size_t m = root.find_last_of("/\\");
+	if ((n != std::string::npos) && ((m == std::string::npos) || (n > m))) root.erase(n);
+
+	// file names of the states
+	int l0 = (int)log10((double)ns) + 1;
+	std::vector<std::string> files(ns);
+	char szname[1024] = { 0 };
+	for (int i = 0; i < ns; ++i)
+	{
+		snprintf(szname, sizeof(szname), "%s_%0*d.vtu", root.c_str(), l0, i);
+		files[i] = szname;
+	}
+
+	// The states can be written in parallel, unless the states are paged in
+	// on demand, since paging modifies the model.
+	bool bparallel = (fem.GetStateLoader() == nullptr);
+	std::vector<FEState*> states;
+	if (bparallel)
+	{
+		states.resize(ns);
+		for (int i = 0; i < ns; ++i) states[i] = fem.GetState(i);
+	}
+
+	std::vector<double> times(ns);
+	int nerrs = 0;
+#pragma omp parallel for schedule(dynamic) if (bparallel) reduction(+:nerrs)
+	for (int i = 0; i < ns; ++i)
+	{
+		FEState* ps = (bparallel ? states[i] : fem.GetState(i));
+		times[i] = ps->m_time;
+		if (WriteState(files[i].c_str(), ps) == false) nerrs++;
+	}
+	if (nerrs > 0) return false;
+
+	return WritePVD((root + ".pvd").c_str(), files, times);
+}
+
+//-----------------------------------------------------------------------------
+bool FEVTUExport::WritePVD(const char* szfile, const std::vector<std::string>& files, const std::vector<double>& times)
+{
+	FILE* fp = fopen(szfile, "wt");
+	if (fp == nullptr) return false;
+
+	fprintf(fp, "<?xml version=\"1.0\"?>\n");
+	fprintf(fp, "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"%s\">\n", (isBigEndian() ? "BigEndian" : "LittleEndian"));
+	fprintf(fp, "  <Collection>\n");
+	for (size_t i = 0; i < files.size(); ++i)
+	{
+		// reference the state files relative to the collection file
+		std::string file = files[i];
+		size_t n = file.find_last_of("/\\");
+		if (n != std::string::npos) file.erase(0, n + 1);
+
+		fprintf(fp, "    <DataSet timestep=\"%.9g\" group=\"\" part=\"0\" file=\"%s\"/>\n", times[i], xmlAttribute(file).c_str());
+	}
+	fprintf(fp, "  </Collection>\n");
+	fprintf(fp, "</VTKFile>\n");
+	fclose(fp);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEVTUExport::WriteState(const char* szfile, FEState* ps)
+{
+	FEPostMesh* pm = ps->GetFEMesh();
+	if (pm == nullptr) return false;
+	FEPostMesh& mesh = *pm;
+	FEPostModel& fem = *ps->GetFEModel();
+
+	VTUPiece piece;
+	int NN = piece.nodes = mesh.Nodes();
+	int NE = piece.elems = mesh.Elements();
+
+	// points
+	std::vector<float> val(3 * NN);
+	for (int i = 0; i < NN; ++i)
+	{
+		const vec3f& r = ps->m_NODE[i].m_rt;
+		val[3 * i] = r.x; val[3 * i + 1] = r.y; val[3 * i + 2] = r.z;
+	}
+	piece.points.name = "Points";
+	piece.points.type = "Float32";
+	piece.points.ncomp = 3;
+	encodeArray(piece.points, val.data(), val.size() * sizeof(float), m_bcompress);
+
+	// cells
+	std::vector<int> conn, offsets(NE);
+	std::vector<unsigned char> types(NE);
+	conn.reserve(8 * (size_t)NE);
+	for (int i = 0; i < NE; ++i)
+	{
+		FEElement_& el = mesh.ElementRef(i);
+		int ne = el.Nodes();
+		for (int j = 0; j < ne; ++j) conn.push_back(el.m_node[j]);
+		offsets[i] = (int)conn.size();
+		types[i] = (unsigned char)FEVTKExport::GetVTKCellType(el.Type());
+	}
+	piece.cells[0].name = "connectivity"; piece.cells[0].type = "Int32"; piece.cells[0].ncomp = 1;
+	piece.cells[1].name = "offsets"; piece.cells[1].type = "Int32"; piece.cells[1].ncomp = 1;
+	piece.cells[2].name = "types"; piece.cells[2].type = "UInt8"; piece.cells[2].ncomp = 1;
+	encodeArray(piece.cells[0], conn.data(), conn.size() * sizeof(int), m_bcompress);
+	encodeArray(piece.cells[1], offsets.data(), offsets.size() * sizeof(int), m_bcompress);
+	encodeArray(piece.cells[2], types.data(), types.size(), m_bcompress);
+
+	// data fields
+	FEDataManager& DM = *fem.GetDataManager();
+	FEDataFieldPtr pd = DM.FirstDataField();
+	int NDATA = (int)ps->m_Data.size();
+	for (int n = 0; n < NDATA; ++n, ++pd)
+	{
+		FEDataField& data = *(*pd);
+		if (ExportField(data.GetName()) == false) continue;
+
+		FEMeshData& meshData = ps->m_Data[n];
+		int ntype = meshData.GetType();
+		int stride = valueStride(ntype);
+		if (stride == 0) continue;
+
+		Data_Format dfmt = meshData.GetFormat();
+		if (data.DataClass() == CLASS_NODE)
+		{
+			if (FEVTKExport::FillNodeDataArray(val, meshData) == false) continue;
+		}
+		else if ((data.DataClass() == CLASS_ELEM) && ((dfmt == DATA_NODE) || (dfmt == DATA_COMP)))
+		{
+			if (FEVTKExport::FillElementNodeDataArray(val, meshData) == false) continue;
+		}
+		else if ((data.DataClass() == CLASS_ELEM) && (dfmt == DATA_ITEM))
+		{
+			// collect the values of all parts
+			std::vector<float> elemVal((size_t)NE * stride, 0.f), partVal;
+			for (int i = 0; i < mesh.Parts(); ++i)
+			{
+				FEPart& part = mesh.Part(i);
+				if (FEVTKExport::FillElemDataArray(partVal, meshData, part) == false) continue;
+				for (int j = 0; j < part.Size(); ++j)
+				{
+					int eid = part.m_Elem[j];
+					for (int k = 0; k < stride; ++k) elemVal[(size_t)eid * stride + k] = partVal[(size_t)j * stride + k];
+				}
+			}
+			val.swap(elemVal);
+		}
+		else continue;
+
+		VTUDataArray a;
+		a.name = data.GetName();
+		a.type = "Float32";
+		expandValues(val, ntype, a.ncomp);
+		encodeArray(a, val.data(), val.size() * sizeof(float), m_bcompress);
+
+		if (data.DataClass() == CLASS_NODE) piece.pointData.push_back(a);
+		else if (dfmt == DATA_ITEM) piece.cellData.push_back(a);
+		else piece.pointData.push_back(a);
+	}
+
+	// now write the file
+	FILE* fp = fopen(szfile, "wb");
+	if (fp == nullptr) return false;
+
+	fprintf(fp, "<?xml version=\"1.0\"?>\n");
+	fprintf(fp, "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"%s\" header_type=\"UInt64\"%s>\n",
+		(isBigEndian() ? "BigEndian" : "LittleEndian"),
+		(m_bcompress ? " compressor=\"vtkZLibDataCompressor\"" : ""));
+	fprintf(fp, "  <UnstructuredGrid>\n");
+	fprintf(fp, "    <Piece NumberOfPoints=\"%d\" NumberOfCells=\"%d\">\n", NN, NE);
+
+	size_t offset = 0;
+	auto writeArray = [&](const VTUDataArray& a) {
+		fprintf(fp, "        <DataArray type=\"%s\" Name=\"%s\" NumberOfComponents=\"%d\" format=\"appended\" offset=\"%llu\"/>\n",
+			a.type, xmlAttribute(a.name).c_str(), a.ncomp, (unsigned long long)offset);
+		offset += a.data.size();
+	};
+
+	fprintf(fp, "      <Points>\n");
+	writeArray(piece.points);
+	fprintf(fp, "      </Points>\n");
+	fprintf(fp, "      <Cells>\n");
+	for (int i = 0; i < 3; ++i) writeArray(piece.cells[i]);
+	fprintf(fp, "      </Cells>\n");
+	if (piece.pointData.empty() == false)
+	{
+		fprintf(fp, "      <PointData>\n");
+		for (VTUDataArray& a : piece.pointData) writeArray(a);
+		fprintf(fp, "      </PointData>\n");
+	}
+	if (piece.cellData.empty() == false)
+	{
+		fprintf(fp, "      <CellData>\n");
+		for (VTUDataArray& a : piece.cellData) writeArray(a);
+		fprintf(fp, "      </CellData>\n");
+	}
+	fprintf(fp, "    </Piece>\n");
+	fprintf(fp, "  </UnstructuredGrid>\n");
+
+	// write the appended data
+	fprintf(fp, "  <AppendedData encoding=\"raw\">\n   _");
+	auto writeData = [&](const VTUDataArray& a) {
+		if (a.data.empty() == false) fwrite(a.data.data(), 1, a.data.size(), fp);
+	};
+	writeData(piece.points);
+	for (int i = 0; i < 3; ++i) writeData(piece.cells[i]);
+	for (VTUDataArray& a : piece.pointData) writeData(a);
+	for (VTUDataArray& a : piece.cellData) writeData(a);
+	fprintf(fp, "\n  </AppendedData>\n");
+	fprintf(fp, "</VTKFile>\n");
+
+	bool ok = (ferror(fp) == 0);
+	fclose(fp);
+
+	return ok;
+}
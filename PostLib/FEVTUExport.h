@@ -0,0 +1,68 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+#pragma once
+#include "FEFileExport.h"
+#include <vector>
+#include <string>
+
+namespace Post {
+
+class FEPostModel;
+class FEState;
+
+//-----------------------------------------------------------------------------
+// Exports the states of a post model to VTK's XML unstructured grid format (.vtu).
+// The data is written in binary (raw appended) format, optionally compressed with
+// zlib. When all states are exported, each state is written to a separate file
+// and a ParaView collection file (.pvd) is written that lists the state files.
+class FEVTUExport : public FEFileExport
+{
+public:
+	FEVTUExport();
+
+	bool Save(FEPostModel& fem, const char* szfile) override;
+
+	// export all states (and write a .pvd collection), or only the current state
+	void ExportAllStates(bool b);
+
+	// compress the data with zlib
+	void SetCompression(bool b);
+
+	// set the names of the data fields to export. If empty, all fields are exported.
+	void SetFieldSelection(const std::vector<std::string>& fields);
+
+private:
+	bool WriteState(const char* szfile, FEState* ps);
+	bool WritePVD(const char* szfile, const std::vector<std::string>& files, const std::vector<double>& times);
+	bool ExportField(const std::string& name) const;
+
+private:
+	bool	m_bwriteAllStates;
+	bool	m_bcompress;
+	std::vector<std::string>	m_fields;
+};
+}
@@ -41,6 +41,7 @@ SOFTWARE.*/
 #include <ImageLib/3DImage.h>
 #include <ImageLib/3DGradientMap.h>
 #include <sstream>
+#include <algorithm>
 #include <assert.h>
 //using namespace std;
 
@@ -58,26 +59,16 @@ TriMesh::TriMesh()
 
 void TriMesh::Clear()
 {
+	m_Node.clear();
+	m_Norm.clear();
 	m_Face.clear();
 }
 
-void TriMesh::Reserve(size_t nsize)
+void TriMesh::Resize(size_t nodes, size_t faces)
 {
-	m_Face.reserve(nsize);
-}
-
-void TriMesh::Resize(size_t nsize)
-{
-	m_Face.resize(nsize);
-}
-
-void TriMesh::Merge(TriMesh& tri, int ncount)
-{
-	if (ncount < 0) ncount = tri.Faces();
-	int N = (int)m_Face.size();
-	m_Face.resize(m_Face.size() + ncount);
-	for (size_t i = 0; i < ncount; ++i)
-		m_Face[N + i] = tri.m_Face[i];
+	m_Node.resize(nodes);
+	m_Norm.resize(nodes);
+	m_Face.resize(faces);
 }
 
 CMarchingCubes::CMarchingCubes(CImageModel* img) : CGLImageRenderer(img)
@@ -99,6 +90,8 @@ CMarchingCubes::CMarchingCubes(CImageModel* img) : CGLImageRenderer(img)
 	m_bsmooth = true;
 	m_bcloseSurface = true;
 	m_binvertSpace = false;
+	m_bskipBlocks = true;
+	m_nflat = 0;
 	m_col = GLColor(200, 185, 185);
 
 	UpdateData(false);
@@ -167,174 +160,351 @@ void CMarchingCubes::Create()
 	CreateSurface();
 }
 
-void CMarchingCubes::CreateSurface()
-{
-	m_oldVal = m_val;
+//-----------------------------------------------------------------------------
+// The iso-surface is extracted in parallel over slabs of voxel layers. Each slab
+// creates its own vertices and triangles, where a vertex on an edge that is shared
+// by several voxels is only created once. Afterwards, the slabs are merged into one
+// indexed mesh, using prefix sums to find the offsets of each slab. Vertices on the 
+// planes between slabs are created by both slabs, so these duplicates are removed
+// in the merge. Blocks of voxels that cannot contain the surface can be skipped.
+namespace {
 
-	m_mesh.Clear();
-
-	CImageModel& im = *GetImageModel();
-	CImageSource* src = im.GetImageSource();
-	if (src == nullptr) return;
-	C3DImage& im3d = *src->Get3DImage();
+	// size of the blocks used for skipping, and the number of voxel layers per slab
+	const int MC_BLOCK = 8;
+	const int MC_SLAB = 2 * MC_BLOCK;
 
-	BOX b = im.GetBoundingBox();
+	struct MCSlab
+	{
+		int	k0, k1;	// voxel layers of this slab
+		std::vector<vec3f>	node, norm;
+		std::vector<int>	face;	// three local node indices per triangle
+		std::vector<std::pair<int, int> >	bottom, top;	// (edge key, local node) of nodes on the slab's boundary planes
+		std::vector<int>	gid;	// global node indices
+		int	nodes = 0;
+		int nodeOffset = 0;
+		int faceOffset = 0;
+	};
+
+	// direction (0,1,2 = x,y,z) and the offset of the first node of the voxel edges
+	struct MCEdge
+	{
+		int	dir, di, dj, dk;
+	};
+}
 
+static void ExtractIsoSurface(C3DImage& im3d, const BOX& b, Byte ref, bool invert, bool smooth, bool skipBlocks, TriMesh& mesh)
+{
 	int NX = im3d.Width();
 	int NY = im3d.Height();
 	int NZ = im3d.Depth();
-	if ((NX == 1) || (NY == 1) || (NZ == 1)) return;
+	const Byte* pb = im3d.GetBytes();
+	const size_t sxy = (size_t)NX*NY;
 
 	float dxi = (b.x1 - b.x0) / (NX - 1);
 	float dyi = (b.y1 - b.y0) / (NY - 1);
 	float dzi = (b.z1 - b.z0) / (NZ - 1);
-
-	Byte ref = (Byte)(m_val * 255.f);
 	float fref = (float)ref;
-	m_ref = ref;
 
 	C3DGradientMap grad(im3d, b);
 
-	#pragma omp parallel default(shared)
+	// set up the voxel edges
+	const int corner[8][3] = { {0,0,0},{1,0,0},{1,1,0},{0,1,0},{0,0,1},{1,0,1},{1,1,1},{0,1,1} };
+	MCEdge edge[12];
+	for (int i = 0; i < 12; ++i)
 	{
-		const int MAX_FACES = 1000000;
-		TriMesh temp;
-		temp.Resize(MAX_FACES);
-		int nfaces = 0;
-		Byte val[8];
-		vec3f r[8], g[8];
+		const int* a = corner[ET_HEX[i][0]];
+		const int* c = corner[ET_HEX[i][1]];
+		edge[i].dir = (a[0] != c[0] ? 0 : (a[1] != c[1] ? 1 : 2));
+		edge[i].di = (a[0] < c[0] ? a[0] : c[0]);
+		edge[i].dj = (a[1] < c[1] ? a[1] : c[1]);
+		edge[i].dk = (a[2] < c[2] ? a[2] : c[2]);
+	}
 
-		#pragma omp for schedule(dynamic, 5)
-		for (int k = 0; k < NZ - 1; ++k)
+	// find the blocks that can contain the surface, i.e. that have values on both sides of the iso-value
+	int BX = (NX - 2) / MC_BLOCK + 1;
+	int BY = (NY - 2) / MC_BLOCK + 1;
+	int BZ = (NZ - 2) / MC_BLOCK + 1;
+	std::vector<char> active;
+	if (skipBlocks)
+	{
+		active.assign((size_t)BX*BY*BZ, 0);
+		#pragma omp parallel for schedule(dynamic)
+		for (int bk = 0; bk < BZ; ++bk)
 		{
-			for (int j = 0; j < NY - 1; ++j)
+			int k0 = bk*MC_BLOCK, k1 = (k0 + MC_BLOCK < NZ - 1 ? k0 + MC_BLOCK : NZ - 1);
+			for (int bj = 0; bj < BY; ++bj)
 			{
-				for (int i = 0; i < NX - 1; ++i)
+				int j0 = bj*MC_BLOCK, j1 = (j0 + MC_BLOCK < NY - 1 ? j0 + MC_BLOCK : NY - 1);
+				for (int bi = 0; bi < BX; ++bi)
 				{
-					// get the voxel's values
-					if (i == 0)
-					{
-						val[0] = im3d.value(i, j, k);
-						val[3] = im3d.value(i, j + 1, k);
-						val[4] = im3d.value(i, j, k + 1);
-						val[7] = im3d.value(i, j + 1, k + 1);
-					}
+					int i0 = bi*MC_BLOCK, i1 = (i0 + MC_BLOCK < NX - 1 ? i0 + MC_BLOCK : NX - 1);
+					Byte vmin = 255, vmax = 0;
+					for (int k = k0; k <= k1; ++k)
+						for (int j = j0; j <= j1; ++j)
+						{
+							const Byte* p = pb + k*sxy + (size_t)j*NX;
+							for (int i = i0; i <= i1; ++i)
+							{
+								if (p[i] < vmin) vmin = p[i];
+								if (p[i] > vmax) vmax = p[i];
+							}
+						}
 
-					val[1] = im3d.value(i + 1, j, k);
-					val[2] = im3d.value(i + 1, j + 1, k);
-					val[5] = im3d.value(i + 1, j, k + 1);
-					val[6] = im3d.value(i + 1, j + 1, k + 1);
+					bool empty = (invert ? ((vmin >= ref) || (vmax < ref)) : ((vmax <= ref) || (vmin > ref)));
+					active[((size_t)bk*BY + bj)*BX + bi] = (empty ? 0 : 1);
+				}
+			}
+		}
+	}
 
-					// calculate the case of the voxel
-					int ncase = 0;
-					if (m_binvertSpace)
-					{
-						if (val[0] < ref) ncase |= 0x01;
-						if (val[1] < ref) ncase |= 0x02;
-						if (val[2] < ref) ncase |= 0x04;
-						if (val[3] < ref) ncase |= 0x08;
-						if (val[4] < ref) ncase |= 0x10;
-						if (val[5] < ref) ncase |= 0x20;
-						if (val[6] < ref) ncase |= 0x40;
-						if (val[7] < ref) ncase |= 0x80;
-					}
-					else
-					{
-						if (val[0] > ref) ncase |= 0x01;
-						if (val[1] > ref) ncase |= 0x02;
-						if (val[2] > ref) ncase |= 0x04;
-						if (val[3] > ref) ncase |= 0x08;
-						if (val[4] > ref) ncase |= 0x10;
-						if (val[5] > ref) ncase |= 0x20;
-						if (val[6] > ref) ncase |= 0x40;
-						if (val[7] > ref) ncase |= 0x80;
-					}
+	// set up the slabs
+	int nslabs = (NZ - 2) / MC_SLAB + 1;
+	std::vector<MCSlab> slabs(nslabs);
+	for (int i = 0; i < nslabs; ++i)
+	{
+		slabs[i].k0 = i*MC_SLAB;
+		slabs[i].k1 = (i == nslabs - 1 ? NZ - 1 : (i + 1)*MC_SLAB);
+	}
+
+	#pragma omp parallel
+	{
+		// node indices of the x- and y-edges on the bottom and top plane of a layer, and of the z-edges of a layer
+		std::vector<int> planeMap[2], zMap;
+		std::vector<int> planeUsed[2], zUsed;
+		planeMap[0].assign(2 * sxy, -1);
+		planeMap[1].assign(2 * sxy, -1);
+		zMap.assign(sxy, -1);
+
+		Byte val[8];
 
-					// cases 0 and 255 don't generate triangles, so don't waste time on these
-					if ((ncase != 0) && (ncase != 255))
+		#pragma omp for schedule(dynamic, 1)
+		for (int ns = 0; ns < nslabs; ++ns)
+		{
+			MCSlab& slab = slabs[ns];
+			int p0 = 0;
+			for (int k = slab.k0; k < slab.k1; ++k)
+			{
+				for (int j = 0; j < NY - 1; ++j)
+				{
+					const char* blockRow = (skipBlocks ? &active[(((size_t)k / MC_BLOCK)*BY + j / MC_BLOCK)*BX] : nullptr);
+					for (int i = 0; i < NX - 1; ++i)
 					{
-						// get the corners
-						r[0].x = b.x0 + i      *dxi; r[0].y = b.y0 + j      *dyi; r[0].z = b.z0 + k      *dzi;
-						r[1].x = b.x0 + (i + 1)*dxi; r[1].y = b.y0 + j      *dyi; r[1].z = b.z0 + k      *dzi;
-						r[2].x = b.x0 + (i + 1)*dxi; r[2].y = b.y0 + (j + 1)*dyi; r[2].z = b.z0 + k      *dzi;
-						r[3].x = b.x0 + i      *dxi; r[3].y = b.y0 + (j + 1)*dyi; r[3].z = b.z0 + k      *dzi;
-						r[4].x = b.x0 + i      *dxi; r[4].y = b.y0 + j      *dyi; r[4].z = b.z0 + (k + 1)*dzi;
-						r[5].x = b.x0 + (i + 1)*dxi; r[5].y = b.y0 + j      *dyi; r[5].z = b.z0 + (k + 1)*dzi;
-						r[6].x = b.x0 + (i + 1)*dxi; r[6].y = b.y0 + (j + 1)*dyi; r[6].z = b.z0 + (k + 1)*dzi;
-						r[7].x = b.x0 + i      *dxi; r[7].y = b.y0 + (j + 1)*dyi; r[7].z = b.z0 + (k + 1)*dzi;
-
-						// calculate gradients
-						if (m_bsmooth)
+						// skip the rest of this block if it cannot contain the surface
+						if (blockRow && (blockRow[i / MC_BLOCK] == 0))
+						{
+							i = (i / MC_BLOCK + 1)*MC_BLOCK - 1;
+							continue;
+						}
+
+						// get the voxel's values
+						const Byte* p = pb + k*sxy + (size_t)j*NX + i;
+						val[0] = p[0]; val[1] = p[1]; val[2] = p[NX + 1]; val[3] = p[NX];
+						p += sxy;
+						val[4] = p[0]; val[5] = p[1]; val[6] = p[NX + 1]; val[7] = p[NX];
+
+						// calculate the case of the voxel
+						int ncase = 0;
+						if (invert)
 						{
-							g[0] = grad.Value(i, j, k);
-							g[1] = grad.Value(i + 1, j, k);
-							g[2] = grad.Value(i + 1, j + 1, k);
-							g[3] = grad.Value(i, j + 1, k);
-							g[4] = grad.Value(i, j, k + 1);
-							g[5] = grad.Value(i + 1, j, k + 1);
-							g[6] = grad.Value(i + 1, j + 1, k + 1);
-							g[7] = grad.Value(i, j + 1, k + 1);
+							for (int l = 0; l < 8; ++l) if (val[l] < ref) ncase |= (1 << l);
+						}
+						else
+						{
+							for (int l = 0; l < 8; ++l) if (val[l] > ref) ncase |= (1 << l);
 						}
 
+						// cases 0 and 255 don't generate triangles, so don't waste time on these
+						if ((ncase == 0) || (ncase == 255)) continue;
+
 						// loop over faces
 						int* pf = LUT[ncase];
 						for (int l = 0; l < 5; l++)
 						{
 							if (*pf == -1) break;
 
-							// calculate nodal positions
-							TriMesh::TRI& tri = temp.Face(nfaces++);
 							for (int m = 0; m < 3; m++)
 							{
-								int n1 = ET_HEX[pf[m]][0];
-								int n2 = ET_HEX[pf[m]][1];
-
-								float w = (fref - (float)val[n1]) / ((float)val[n2] - (float)val[n1]);
-								assert((w >= 0.f) && (w <= 1.f));
-
-								tri.m_node[m] = r[n1] * (1.f - w) + r[n2] * w;
+								// find the node on this edge
+								const MCEdge& ed = edge[pf[m]];
+								int ii = i + ed.di;
+								int jj = j + ed.dj;
+								int* pn = nullptr;
+								int key = -1;
+								if (ed.dir == 2)
+								{
+									key = jj*NX + ii;
+									pn = &zMap[key];
+									if (*pn < 0) zUsed.push_back(key);
+								}
+								else
+								{
+									key = (int)(ed.dir*sxy) + jj*NX + ii;
+									int np = (ed.dk == 0 ? p0 : 1 - p0);
+									pn = &planeMap[np][key];
+									if (*pn < 0) planeUsed[np].push_back(key);
+								}
 
-								if (m_bsmooth)
+								// create it if it doesn't exist yet
+								if (*pn < 0)
 								{
-									vec3f normal = g[n1] * (1.f - w) + g[n2] * w;
-									normal.Normalize();
-									tri.m_norm[m] = (m_binvertSpace ? -normal : normal);
+									int n1 = ET_HEX[pf[m]][0];
+									int n2 = ET_HEX[pf[m]][1];
+
+									float w = (fref - (float)val[n1]) / ((float)val[n2] - (float)val[n1]);
+									assert((w >= 0.f) && (w <= 1.f));
+
+									const int* c1 = corner[n1];
+									const int* c2 = corner[n2];
+									vec3f r1(b.x0 + (i + c1[0])*dxi, b.y0 + (j + c1[1])*dyi, b.z0 + (k + c1[2])*dzi);
+									vec3f r2(b.x0 + (i + c2[0])*dxi, b.y0 + (j + c2[1])*dyi, b.z0 + (k + c2[2])*dzi);
+
+									vec3f normal(0.f, 0.f, 0.f);
+									if (smooth)
+									{
+										vec3f g1 = grad.Value(i + c1[0], j + c1[1], k + c1[2]);
+										vec3f g2 = grad.Value(i + c2[0], j + c2[1], k + c2[2]);
+										normal = g1 * (1.f - w) + g2 * w;
+										normal.Normalize();
+										if (invert) normal = -normal;
+									}
+
+									*pn = (int)slab.node.size();
+									slab.node.push_back(r1 * (1.f - w) + r2 * w);
+									slab.norm.push_back(normal);
+
+									// remember the nodes on the slab's boundary planes
+									if (ed.dir != 2)
+									{
+										if ((ed.dk == 0) && (k == slab.k0)) slab.bottom.push_back(std::pair<int, int>(key, *pn));
+										if ((ed.dk == 1) && (k == slab.k1 - 1)) slab.top.push_back(std::pair<int, int>(key, *pn));
+									}
 								}
-							}
 
-							if (m_bsmooth == false)
-							{
-								vec3f normal = (tri.m_node[1] - tri.m_node[0]) ^ (tri.m_node[2] - tri.m_node[0]);
-								normal.Normalize();
-								tri.m_norm[0] = normal;
-								tri.m_norm[1] = normal;
-								tri.m_norm[2] = normal;
+								slab.face.push_back(*pn);
 							}
 
 							pf += 3;
-
-							if (nfaces == MAX_FACES)
-							{
-								#pragma omp critical
-								m_mesh.Merge(temp, nfaces);
-								nfaces = 0;
-							}
 						}
 					}
-
-					// keep this for next i
-					val[0] = val[1];
-					val[4] = val[5];
-					val[3] = val[2];
-					val[7] = val[6];
 				}
+
+				// clear the z-edges, and the bottom plane, which will be the top plane of the next layer
+				for (int n : zUsed) zMap[n] = -1;
+				zUsed.clear();
+				for (int n : planeUsed[p0]) planeMap[p0][n] = -1;
+				planeUsed[p0].clear();
+				p0 = 1 - p0;
+			}
+
+			// clear the last plane for the next slab
+			for (int n : planeUsed[p0]) planeMap[p0][n] = -1;
+			planeUsed[p0].clear();
+		}
+	}
+
+	// Find the duplicate nodes on the planes between slabs. These are marked 
+	// with -2 - n, where n is the local node index in the previous slab. 
+	#pragma omp parallel for schedule(dynamic, 1)
+	for (int ns = 0; ns < nslabs; ++ns)
+	{
+		MCSlab& slab = slabs[ns];
+		slab.gid.assign(slab.node.size(), -1);
+		if (ns > 0)
+		{
+			std::vector<std::pair<int, int> >& bottom = slab.bottom;
+			std::vector<std::pair<int, int> >& top = slabs[ns - 1].top;
+			std::sort(bottom.begin(), bottom.end());
+			std::sort(top.begin(), top.end());
+			size_t a = 0, c = 0;
+			while ((a < bottom.size()) && (c < top.size()))
+			{
+				if (bottom[a].first < top[c].first) a++;
+				else if (top[c].first < bottom[a].first) c++;
+				else { slab.gid[bottom[a].second] = -2 - top[c].second; a++; c++; }
 			}
 		}
 
-		#pragma omp critical
-		m_mesh.Merge(temp, nfaces);
+		// local index of the remaining nodes
+		int n = 0;
+		for (int& id : slab.gid) if (id == -1) id = n++;
+		slab.nodes = n;
 	}
 
+	// prefix sums
+	int nodes = 0, faces = 0;
+	for (MCSlab& slab : slabs)
+	{
+		slab.nodeOffset = nodes; nodes += slab.nodes;
+		slab.faceOffset = faces; faces += (int)slab.face.size() / 3;
+	}
+	mesh.Resize(nodes, faces);
+
+	// copy the nodes
+	#pragma omp parallel for schedule(dynamic, 1)
+	for (int ns = 0; ns < nslabs; ++ns)
+	{
+		MCSlab& slab = slabs[ns];
+		for (size_t i = 0; i < slab.gid.size(); ++i)
+		{
+			if (slab.gid[i] >= 0)
+			{
+				slab.gid[i] += slab.nodeOffset;
+				mesh.Node(slab.gid[i]) = slab.node[i];
+				mesh.Normal(slab.gid[i]) = slab.norm[i];
+			}
+		}
+	}
+
+	// copy the faces, replacing duplicate nodes by the node of the previous slab
+	#pragma omp parallel for schedule(dynamic, 1)
+	for (int ns = 0; ns < nslabs; ++ns)
+	{
+		MCSlab& slab = slabs[ns];
+		int NF = (int)slab.face.size() / 3;
+		for (int i = 0; i < NF; ++i)
+		{
+			TriMesh::TRI& tri = mesh.Face(slab.faceOffset + i);
+			for (int j = 0; j < 3; ++j)
+			{
+				int id = slab.gid[slab.face[3 * i + j]];
+				if (id < 0) id = slabs[ns - 1].gid[-2 - id];
+				tri.m_node[j] = id;
+			}
+		}
+	}
+}
+
+void CMarchingCubes::CreateSurface()
+{
+	m_oldVal = m_val;
+
+	m_mesh.Clear();
+	m_nflat = 0;
+
+	CImageModel& im = *GetImageModel();
+	CImageSource* src = im.GetImageSource();
+	if (src == nullptr) return;
+	C3DImage& im3d = *src->Get3DImage();
+
+	BOX b = im.GetBoundingBox();
+
+	int NX = im3d.Width();
+	int NY = im3d.Height();
+	int NZ = im3d.Depth();
+	if ((NX == 1) || (NY == 1) || (NZ == 1)) return;
+
+	float dxi = (b.x1 - b.x0) / (NX - 1);
+	float dyi = (b.y1 - b.y0) / (NY - 1);
+	float dzi = (b.z1 - b.z0) / (NZ - 1);
+
+	Byte ref = (Byte)(m_val * 255.f);
+	m_ref = ref;
+
+	ExtractIsoSurface(im3d, b, ref, m_binvertSpace, m_bsmooth, m_bskipBlocks, m_mesh);
+
+	// without smoothing, the iso-surface is rendered with face normals
+	if (m_bsmooth == false) m_nflat = m_mesh.Faces();
+
 	// create surface meshes
 	if (m_bcloseSurface)
 	{
@@ -458,13 +628,14 @@ void CMarchingCubes::AddSurfaceTris(Byte val[4], vec3f r[4], const vec3f& faceNo
 		if (*pf == -1) break;
 
 		// calculate nodal positions
-		TriMesh::TRI tri;
+		int n[3];
 		for (int m = 0; m < 3; m++)
 		{
+			vec3f rm;
 			int node = pf[m];
 			if (node < 4)
 			{
-				tri.m_node[m] = r[node];
+				rm = r[node];
 			}
 			else
 			{
@@ -472,13 +643,13 @@ void CMarchingCubes::AddSurfaceTris(Byte val[4], vec3f r[4], const vec3f& faceNo
 				int n2 = ET2D[node - 4][1];
 
 				float w = (fref - (float)val[n1]) / ((float)val[n2] - (float)val[n1]);
-				tri.m_node[m] = r[n1] * (1.f - w) + r[n2] * w;
+				rm = r[n1] * (1.f - w) + r[n2] * w;
 			}
 
-			tri.m_norm[m] = faceNormal;
+			n[m] = m_mesh.AddNode(rm, faceNormal);
 		}
 
-		m_mesh.AddFace(tri);
+		m_mesh.AddFace(n[0], n[1], n[2]);
 
 		pf += 3;
 	}
@@ -496,12 +667,27 @@ void CMarchingCubes::Render(CGLContext& rc)
 	for (int i = 0; i < m_mesh.Faces(); ++i)
 	{
 		TriMesh::TRI& face = m_mesh.Face(i);
-		glNormal3f(face.m_norm[0].x, face.m_norm[0].y, face.m_norm[0].z);
-		glVertex3f(face.m_node[0].x, face.m_node[0].y, face.m_node[0].z);
-		glNormal3f(face.m_norm[1].x, face.m_norm[1].y, face.m_norm[1].z);
-		glVertex3f(face.m_node[1].x, face.m_node[1].y, face.m_node[1].z);
-		glNormal3f(face.m_norm[2].x, face.m_norm[2].y, face.m_norm[2].z);
-		glVertex3f(face.m_node[2].x, face.m_node[2].y, face.m_node[2].z);
+		const vec3f& r0 = m_mesh.Node(face.m_node[0]);
+		const vec3f& r1 = m_mesh.Node(face.m_node[1]);
+		const vec3f& r2 = m_mesh.Node(face.m_node[2]);
+		if (i < m_nflat)
+		{
+			vec3f normal = (r1 - r0) ^ (r2 - r0);
+			normal.Normalize();
+			glNormal3f(normal.x, normal.y, normal.z);
+			glVertex3f(r0.x, r0.y, r0.z);
+			glVertex3f(r1.x, r1.y, r1.z);
+			glVertex3f(r2.x, r2.y, r2.z);
+		}
+		else
+		{
+			const vec3f& n0 = m_mesh.Normal(face.m_node[0]);
+			const vec3f& n1 = m_mesh.Normal(face.m_node[1]);
+			const vec3f& n2 = m_mesh.Normal(face.m_node[2]);
+			glNormal3f(n0.x, n0.y, n0.z); glVertex3f(r0.x, r0.y, r0.z);
+			glNormal3f(n1.x, n1.y, n1.z); glVertex3f(r1.x, r1.y, r1.z);
+			glNormal3f(n2.x, n2.y, n2.z); glVertex3f(r2.x, r2.y, r2.z);
+		}
 	}
 	glEnd();
 }
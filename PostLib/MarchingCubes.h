@@ -34,13 +34,13 @@ namespace Post {
 
 class CImageModel;
 
+// Indexed triangle mesh. Vertices are shared between triangles.
 class TriMesh
 {
 public:
 	struct TRI
 	{
-		vec3f	m_node[3];
-		vec3f	m_norm[3];
+		int		m_node[3];
 	};
 
 public:
@@ -48,18 +48,21 @@ public:
 
 	void Clear();
 
-	void Merge(TriMesh& tri, int ncount = -1);
+	void Resize(size_t nodes, size_t faces);
 
-	void Reserve(size_t nsize);
-
-	void Resize(size_t nsize);
+	int Nodes() const { return (int)m_Node.size(); }
+	vec3f& Node(int i) { return m_Node[i]; }
+	vec3f& Normal(int i) { return m_Norm[i]; }
 
 	TRI& Face(int i) { return m_Face[i]; }
 	int Faces() const { return (int)m_Face.size(); }
 
-	void AddFace(TRI& tri) { m_Face.push_back(tri); }
+	int AddNode(const vec3f& r, const vec3f& n) { m_Node.push_back(r); m_Norm.push_back(n); return (int)m_Node.size() - 1; }
+	void AddFace(int n0, int n1, int n2) { TRI t = { {n0, n1, n2} }; m_Face.push_back(t); }
 
 protected:
+	std::vector<vec3f>	m_Node;
+	std::vector<vec3f>	m_Norm;
 	std::vector<TRI>	m_Face;
 };
 
@@ -88,6 +91,8 @@ public:
 
 	void Create();
 
+	const TriMesh& GetMesh() const { return m_mesh; }
+
 	void Render(CGLContext& rc) override;
 
 	void Update() override;
@@ -99,13 +104,19 @@ private:
 
 	void CreateSurface();
 
+public:
+	// skip blocks of voxels that cannot contain the iso-surface
+	void SetBlockSkipping(bool b) { m_bskipBlocks = b; }
+
 private:
 	float	m_val, m_oldVal;		// iso-surface value
 	bool	m_bsmooth;
 	bool	m_bcloseSurface;
 	bool	m_binvertSpace;
+	bool	m_bskipBlocks;
 	GLColor	m_col;
 	TriMesh	m_mesh;
+	int		m_nflat;	// number of faces (at the start of the mesh) that are rendered with face normals
 
 	Byte m_ref;
 };
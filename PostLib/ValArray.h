@@ -26,6 +26,7 @@ SOFTWARE.*/
 
 #pragma once
 #include <vector>
+#include <cstddef>
 
 //-----------------------------------------------------------------------------
 class ValArray
@@ -43,6 +44,9 @@ public:
 	float value(int item, int index) const { return m_data[m_index[item] + index]; }
 	float& value(int item, int index) { return m_data[m_index[item] + index]; }
 
+	// the memory used by this array (in bytes)
+	size_t memorySize() const { return m_index.size()*sizeof(int) + m_data.size()*sizeof(float); }
+
 protected:
 	std::vector<int>	m_index;
 	std::vector<float>	m_data;
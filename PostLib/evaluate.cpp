@@ -164,6 +164,136 @@ float component(const tens4fs& m, int n)
 	return g;
 }
 
+//-----------------------------------------------------------------------------
+// a float only has one component
+inline float component(float v, int n) { return v; }
+
+//-----------------------------------------------------------------------------
+// block size used by the batched evaluation of data fields
+const int EVAL_BLOCK_SIZE = 1024;
+
+//-----------------------------------------------------------------------------
+// Evaluate the nodal values of a node field, one block of nodes at a time
+template <typename T> void evalNodeBlocks(FEState& state, FENodeData_T<T>& dv, int ncomp, bool bparallel)
+{
+	FEPostMesh& mesh = *state.GetFEMesh();
+	int NN = mesh.Nodes();
+	int nblocks = (NN + EVAL_BLOCK_SIZE - 1) / EVAL_BLOCK_SIZE;
+#pragma omp parallel if(bparallel)
+	{
+		vector<T> buf(EVAL_BLOCK_SIZE);
+#pragma omp for schedule(dynamic)
+		for (int b = 0; b < nblocks; ++b)
+		{
+			int n0 = b*EVAL_BLOCK_SIZE;
+			int n1 = (n0 + EVAL_BLOCK_SIZE < NN ? n0 + EVAL_BLOCK_SIZE : NN);
+			dv.eval(n0, n1, &buf[0]);
+			for (int i = n0; i < n1; ++i)
+			{
+				NODEDATA& d = state.m_NODE[i];
+				if (mesh.Node(i).IsEnabled())
+				{
+					d.m_val = component(buf[i - n0], ncomp);
+					d.m_ntag = 1;
+				}
+				else
+				{
+					d.m_val = 0.f;
+					d.m_ntag = 0;
+				}
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Evaluate the element values of an element field (with one value per element), 
+// one block of elements at a time.
+template <typename T> void evalElemBlocks(FEState& state, FEElemData_T<T, DATA_ITEM>& dv, int ncomp, bool bparallel)
+{
+	FEPostMesh& mesh = *state.GetFEMesh();
+	int NE = mesh.Elements();
+	int nblocks = (NE + EVAL_BLOCK_SIZE - 1) / EVAL_BLOCK_SIZE;
+#pragma omp parallel if(bparallel)
+	{
+		vector<T> buf(EVAL_BLOCK_SIZE);
+#pragma omp for schedule(dynamic)
+		for (int b = 0; b < nblocks; ++b)
+		{
+			int n0 = b*EVAL_BLOCK_SIZE;
+			int n1 = (n0 + EVAL_BLOCK_SIZE < NE ? n0 + EVAL_BLOCK_SIZE : NE);
+			dv.eval(n0, n1, &buf[0]);
+			for (int i = n0; i < n1; ++i)
+			{
+				FEElement_& el = mesh.ElementRef(i);
+				ELEMDATA& d = state.m_ELEM[i];
+				d.m_val = 0.f;
+				d.m_state &= ~StatusFlags::ACTIVE;
+				el.Deactivate();
+				if (el.IsEnabled() && (el.IsEroded() == false) && dv.active(i))
+				{
+					float val = component(buf[i - n0], ncomp);
+					d.m_state |= StatusFlags::ACTIVE;
+					d.m_val = val;
+					el.Activate();
+					int ne = el.Nodes();
+					for (int j = 0; j < ne; ++j) state.m_ElemData.value(i, j) = val;
+				}
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Try to evaluate a node field with the batched eval. Returns false if the 
+// field's type is not supported, in which case the nodes need to be evaluated one by one.
+bool evalNodeFieldBlocks(FEState& state, int nfield, bool bparallel)
+{
+	if (state.m_Data.size() == 0) return false;
+
+	int ndata = FIELD_CODE(nfield);
+	int ncomp = FIELD_COMP(nfield);
+	Post::FEMeshData& rd = state.m_Data[ndata];
+	switch (rd.GetType())
+	{
+	case DATA_FLOAT  : evalNodeBlocks(state, dynamic_cast<FENodeData_T<float  >&>(rd), ncomp, bparallel); break;
+	case DATA_VEC3F  : evalNodeBlocks(state, dynamic_cast<FENodeData_T<vec3f  >&>(rd), ncomp, bparallel); break;
+	case DATA_MAT3F  : evalNodeBlocks(state, dynamic_cast<FENodeData_T<mat3f  >&>(rd), ncomp, bparallel); break;
+	case DATA_MAT3D  : evalNodeBlocks(state, dynamic_cast<FENodeData_T<Mat3d  >&>(rd), ncomp, bparallel); break;
+	case DATA_MAT3FS : evalNodeBlocks(state, dynamic_cast<FENodeData_T<mat3fs >&>(rd), ncomp, bparallel); break;
+	case DATA_MAT3FD : evalNodeBlocks(state, dynamic_cast<FENodeData_T<mat3fd >&>(rd), ncomp, bparallel); break;
+	case DATA_TENS4FS: evalNodeBlocks(state, dynamic_cast<FENodeData_T<tens4fs>&>(rd), ncomp, bparallel); break;
+	default:
+		return false;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Same as above, but for element fields. Only the DATA_ITEM format is handled.
+bool evalElemFieldBlocks(FEState& state, int nfield, bool bparallel)
+{
+	if (state.m_Data.size() == 0) return false;
+
+	int ndata = FIELD_CODE(nfield);
+	int ncomp = FIELD_COMP(nfield);
+	Post::FEMeshData& rd = state.m_Data[ndata];
+	if (rd.GetFormat() != DATA_ITEM) return false;
+	switch (rd.GetType())
+	{
+	case DATA_FLOAT  : evalElemBlocks(state, dynamic_cast<FEElemData_T<float  , DATA_ITEM>&>(rd), ncomp, bparallel); break;
+	case DATA_VEC3F  : evalElemBlocks(state, dynamic_cast<FEElemData_T<vec3f  , DATA_ITEM>&>(rd), ncomp, bparallel); break;
+	case DATA_MAT3F  : evalElemBlocks(state, dynamic_cast<FEElemData_T<mat3f  , DATA_ITEM>&>(rd), ncomp, bparallel); break;
+	case DATA_MAT3D  : evalElemBlocks(state, dynamic_cast<FEElemData_T<Mat3d  , DATA_ITEM>&>(rd), ncomp, bparallel); break;
+	case DATA_MAT3FS : evalElemBlocks(state, dynamic_cast<FEElemData_T<mat3fs , DATA_ITEM>&>(rd), ncomp, bparallel); break;
+	case DATA_MAT3FD : evalElemBlocks(state, dynamic_cast<FEElemData_T<mat3fd , DATA_ITEM>&>(rd), ncomp, bparallel); break;
+	case DATA_TENS4FS: evalElemBlocks(state, dynamic_cast<FEElemData_T<tens4fs, DATA_ITEM>&>(rd), ncomp, bparallel); break;
+	default:
+		return false;
+	}
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 bool FEPostModel::IsValidFieldCode(int nfield, int nstate)
 {
@@ -171,7 +301,7 @@ bool FEPostModel::IsValidFieldCode(int nfield, int nstate)
 	if ((nstate < 0) || (nstate >= GetStates())) return false;
 
 	// get the state info
-	FEState& state = *m_State[nstate];
+	FEState& state = *GetState(nstate);
 
 	// get the data field
 	int ndata = FIELD_CODE(nfield);
@@ -189,13 +319,22 @@ bool FEPostModel::IsValidFieldCode(int nfield, int nstate)
 bool FEPostModel::Evaluate(int nfield, int ntime, bool breset)
 {
 	// get the state data 
-	FEState& state = *m_State[ntime];
+	FEState& state = *GetState(ntime);
 	FEPostMesh* mesh = state.GetFEMesh();
 	if (mesh->Nodes() == 0) return false;
 
 	// make sure that we have to reevaluate
 	if ((state.m_nField != nfield) || breset)
 	{
+		if (breset) m_fieldCache.Remove(&state);
+		else
+		{
+			// hang on to the current values, in case we switch back to this field,
+			// and see if we evaluated the new field before.
+			m_fieldCache.Store(&state);
+			if (m_fieldCache.Restore(&state, nfield)) return true;
+		}
+
 		// store the field variable
 		state.m_nField = nfield;
 
@@ -208,6 +347,20 @@ bool FEPostModel::Evaluate(int nfield, int ntime, bool breset)
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+void FEPostModel::ResetAllStates()
+{
+	// (paged out states need to be reevaluated anyway)
+	for (int i = 0; i < GetStates(); ++i) m_State[i]->m_nField = -1;
+	m_fieldCache.Clear();
+}
+
+//-----------------------------------------------------------------------------
+void FEPostModel::ClearFieldCache()
+{
+	m_fieldCache.Clear();
+}
+
 //-----------------------------------------------------------------------------
 // Evaluate a nodal field
 void FEPostModel::EvalNodeField(int ntime, int nfield)
@@ -215,23 +368,33 @@ void FEPostModel::EvalNodeField(int ntime, int nfield)
 	assert(IS_NODE_FIELD(nfield));
 
 	// get the state data 
-	FEState& state = *m_State[ntime];
+	FEState& state = *GetState(ntime);
 	FEPostMesh* mesh = state.GetFEMesh();
 
+	// The items are evaluated in parallel, unless states are paged in on demand,
+	// since some data fields access other states which could then trigger a page-in.
+	bool bparallel = (m_stateLoader == nullptr);
+
 	// first, we evaluate all the nodes
-	int i, j;
-	for (i=0; i<mesh->Nodes(); ++i)
+	if (evalNodeFieldBlocks(state, nfield, bparallel) == false)
 	{
-		FENode& node = mesh->Node(i);
-		NODEDATA& d = state.m_NODE[i];
-		d.m_val = 0;
-		d.m_ntag = 0;
-		if (node.IsEnabled()) EvaluateNode(i, ntime, nfield, d);
+		int NN = mesh->Nodes();
+#pragma omp parallel for if(bparallel) schedule(dynamic, 1024)
+		for (int i=0; i<NN; ++i)
+		{
+			FENode& node = mesh->Node(i);
+			NODEDATA& d = state.m_NODE[i];
+			d.m_val = 0;
+			d.m_ntag = 0;
+			if (node.IsEnabled()) EvaluateNode(i, ntime, nfield, d);
+		}
 	}
 
 	// Next, we project the nodal data onto the faces
 	ValArray& faceData = state.m_FaceData;
-	for (i=0; i<mesh->Faces(); ++i)
+	int NF = mesh->Faces();
+#pragma omp parallel for if(bparallel)
+	for (int i=0; i<NF; ++i)
 	{
 		FEFace& f = mesh->Face(i);
 		FACEDATA& d = state.m_FACE[i];
@@ -240,14 +403,16 @@ void FEPostModel::EvalNodeField(int ntime, int nfield)
 		if (f.IsEnabled())
 		{
 			d.m_ntag = 1;
-			for (j=0; j<f.Nodes(); ++j) { float val = state.m_NODE[f.n[j]].m_val; faceData.value(i, j) = val; d.m_val += val; }
+			for (int j=0; j<f.Nodes(); ++j) { float val = state.m_NODE[f.n[j]].m_val; faceData.value(i, j) = val; d.m_val += val; }
 			d.m_val /= (float) f.Nodes();
 		}
 	}
 
 	// Finally, we project the nodal data onto the elements
 	ValArray& elemData = state.m_ElemData;
-	for (i=0; i<mesh->Elements(); ++i)
+	int NE = mesh->Elements();
+#pragma omp parallel for if(bparallel)
+	for (int i=0; i<NE; ++i)
 	{
 		FEElement_& e = mesh->ElementRef(i);
 		ELEMDATA& d = state.m_ELEM[i];
@@ -258,7 +423,7 @@ void FEPostModel::EvalNodeField(int ntime, int nfield)
 		{
 			d.m_state |= StatusFlags::ACTIVE;
 			e.Activate();
-			for (j=0; j<e.Nodes(); ++j) { float val = state.m_NODE[e.m_node[j]].m_val; elemData.value(i,j) = val; d.m_val += val; }
+			for (int j=0; j<e.Nodes(); ++j) { float val = state.m_NODE[e.m_node[j]].m_val; elemData.value(i,j) = val; d.m_val += val; }
 			d.m_val /= (float) e.Nodes();
 		}
 	}
@@ -271,7 +436,7 @@ void FEPostModel::EvalFaceField(int ntime, int nfield)
 	assert(IS_FACE_FIELD(nfield));
 
 	// get the state data 
-	FEState& state = *m_State[ntime];
+	FEState& state = *GetState(ntime);
 	FEPostMesh* mesh = state.GetFEMesh();
 
 	// get the data ID
@@ -284,6 +449,10 @@ void FEPostModel::EvalFaceField(int ntime, int nfield)
 	FEMeshData& rd = state.m_Data[ndata];
 	Data_Format fmt = rd.GetFormat();
 
+	// see EvalNodeField
+	bool bparallel = (m_stateLoader == nullptr);
+	int NF = mesh->Faces();
+
 	// for float/node face data we evaluate the nodal values directly.
 	if ((rd.GetType() == DATA_FLOAT) && (fmt == DATA_NODE))
 	{
@@ -297,24 +466,22 @@ void FEPostModel::EvalFaceField(int ntime, int nfield)
 		// get the data field
 		FEFaceData_T<float, DATA_NODE>& df = dynamic_cast<FEFaceData_T<float, DATA_NODE>&>(rd);
 
-		// evaluate nodes and faces
-		float tmp[FEElement::MAX_NODES] = {0.f};
-		for (int i=0; i<mesh->Faces(); ++i)
+		// evaluate faces
+#pragma omp parallel for if(bparallel)
+		for (int i=0; i<NF; ++i)
 		{
 			FEFace& face = mesh->Face(i);
 			state.m_FACE[i].m_val = 0.f;
 			state.m_FACE[i].m_ntag = 0;
 			if (df.active(i))
 			{
+				float tmp[FEElement::MAX_NODES] = {0.f};
 				df.eval(i, tmp);
 
 				float avg = 0.f;
 				for (int j = 0; j<face.Nodes(); ++j)
 				{
 					avg += tmp[j];
-					state.m_NODE[face.n[j]].m_val = tmp[j];
-					state.m_NODE[face.n[j]].m_ntag = 1;
-
 					state.m_FaceData.value(i, j) = tmp[j];
 				}
 
@@ -322,19 +489,34 @@ void FEPostModel::EvalFaceField(int ntime, int nfield)
 				state.m_FACE[i].m_ntag = 1;
 			}
 		}
+
+		// copy to the nodes
+		// (This is done serially so that shared nodes always get the value of the last face.)
+		for (int i = 0; i<NF; ++i)
+		{
+			if (state.m_FACE[i].m_ntag == 1)
+			{
+				FEFace& face = mesh->Face(i);
+				for (int j = 0; j<face.Nodes(); ++j)
+				{
+					state.m_NODE[face.n[j]].m_val = state.m_FaceData.value(i, j);
+					state.m_NODE[face.n[j]].m_ntag = 1;
+				}
+			}
+		}
 	}
 	else
 	{
 		// first evaluate all faces
-		float data[FEFace::MAX_NODES], val;
-		int i, j;
-		for (i=0; i<mesh->Faces(); ++i)
+#pragma omp parallel for if(bparallel) schedule(dynamic, 1024)
+		for (int i=0; i<NF; ++i)
 		{
 			FEFace& f = mesh->Face(i);
 			state.m_FACE[i].m_val = 0.f;
 			state.m_FACE[i].m_ntag = 0;
 			if (f.IsEnabled()) 
 			{
+				float data[FEFace::MAX_NODES], val;
 				if (EvaluateFace(i, ntime, nfield, data, val))
 				{
 					state.m_FACE[i].m_ntag = 1;
@@ -346,14 +528,16 @@ void FEPostModel::EvalFaceField(int ntime, int nfield)
 
 		// now evaluate the nodes
 		ValArray& faceData = state.m_FaceData;
-		for (i=0; i<mesh->Nodes(); ++i)
+		int NN = mesh->Nodes();
+#pragma omp parallel for if(bparallel)
+		for (int i=0; i<NN; ++i)
 		{
 			NODEDATA& node = state.m_NODE[i];
-			const vector<NodeFaceRef>& nfl = mesh->NodeFaceList(i);
+			NodeFaceRefList nfl = mesh->NodeFaceList(i);
 			node.m_val = 0.f; 
 			node.m_ntag = 0;
 			int n = 0;
-			for (j=0; j<(int) nfl.size(); ++j)
+			for (int j=0; j<(int) nfl.size(); ++j)
 			{
 				FACEDATA& f = state.m_FACE[nfl[j].fid];
 				if (f.m_ntag > 0)
@@ -388,41 +572,51 @@ void FEPostModel::EvalElemField(int ntime, int nfield)
 	assert(IS_ELEM_FIELD(nfield));
 
 	// get the state data 
-	FEState& state = *m_State[ntime];
+	FEState& state = *GetState(ntime);
 	FEPostMesh* mesh = state.GetFEMesh();
 
+	// see EvalNodeField
+	bool bparallel = (m_stateLoader == nullptr);
+
 	// first evaluate all elements
-	float data[FEElement::MAX_NODES] = {0.f};
-	float val;
-	for (int i=0; i<mesh->Elements(); ++i)
+	int NE = mesh->Elements();
+	if (evalElemFieldBlocks(state, nfield, bparallel) == false)
 	{
-		FEElement_& el = mesh->ElementRef(i);
-		state.m_ELEM[i].m_val = 0.f;
-		state.m_ELEM[i].m_state &= ~StatusFlags::ACTIVE;
-		el.Deactivate();
-		if (el.IsEnabled()) 
+#pragma omp parallel for if(bparallel) schedule(dynamic, 1024)
+		for (int i=0; i<NE; ++i)
 		{
-			if (EvaluateElement(i, ntime, nfield, data, val))
+			FEElement_& el = mesh->ElementRef(i);
+			state.m_ELEM[i].m_val = 0.f;
+			state.m_ELEM[i].m_state &= ~StatusFlags::ACTIVE;
+			el.Deactivate();
+			if (el.IsEnabled()) 
 			{
-				state.m_ELEM[i].m_state |= StatusFlags::ACTIVE;
-				state.m_ELEM[i].m_val = val;
-				el.Activate();
-				int ne = el.Nodes();
-				for (int j=0; j<ne; ++j) state.m_ElemData.value(i, j) = data[j];
+				float data[FEElement::MAX_NODES] = {0.f};
+				float val;
+				if (EvaluateElement(i, ntime, nfield, data, val))
+				{
+					state.m_ELEM[i].m_state |= StatusFlags::ACTIVE;
+					state.m_ELEM[i].m_val = val;
+					el.Activate();
+					int ne = el.Nodes();
+					for (int j=0; j<ne; ++j) state.m_ElemData.value(i, j) = data[j];
+				}
 			}
 		}
 	}
 
 	// now evaluate the nodes
 	ValArray& elemData = state.m_ElemData;
-	for (int i=0; i<mesh->Nodes(); ++i)
+	int NN = mesh->Nodes();
+#pragma omp parallel for if(bparallel)
+	for (int i=0; i<NN; ++i)
 	{
 		FENode& node = mesh->Node(i);
 		state.m_NODE[i].m_val = 0.f;
 		state.m_NODE[i].m_ntag = 0;
 		if (node.IsEnabled())
 		{
-			const vector<NodeElemRef>& nel = mesh->NodeElemList(i);
+			NodeElemRefList nel = mesh->NodeElemList(i);
 			int m = (int) nel.size(), n=0;
 			float val = 0.f;
 			for (int j=0; j<m; ++j)
@@ -444,7 +638,9 @@ void FEPostModel::EvalElemField(int ntime, int nfield)
 
 	// evaluate faces
 	ValArray& fd = state.m_FaceData;
-	for (int i=0; i<mesh->Faces(); ++i)
+	int NF = mesh->Faces();
+#pragma omp parallel for if(bparallel)
+	for (int i=0; i<NF; ++i)
 	{
 		FEFace& f = mesh->Face(i);
 		FACEDATA& d = state.m_FACE[i];
@@ -818,7 +1014,7 @@ void FEPostModel::EvaluateNode(int n, int ntime, int nfield, NODEDATA& d)
 	else if (IS_FACE_FIELD(nfield))
 	{
 		// we take the average of the adjacent face values
-		const vector<NodeFaceRef>& nfl = mesh->NodeFaceList(n);
+		NodeFaceRefList nfl = mesh->NodeFaceList(n);
 		if (!nfl.empty())
 		{
 			int nf = (int)nfl.size(), n = 0;
@@ -837,7 +1033,7 @@ void FEPostModel::EvaluateNode(int n, int ntime, int nfield, NODEDATA& d)
 	else if (IS_ELEM_FIELD(nfield))
 	{
 		// we take the average of the elements that contain this element
-		const vector<NodeElemRef>& nel = mesh->NodeElemList(n);
+		NodeElemRefList nel = mesh->NodeElemList(n);
 		float data[FEElement::MAX_NODES] = {0.f}, val;
 		int ne = (int)nel.size(), n = 0;
 		if (!nel.empty())
@@ -878,6 +1074,93 @@ void FEPostModel::EvaluateNode(const vec3f& p, int ntime, int nfield, NODEDATA&
 	d.m_val = el.eval(v, r[0], r[1], r[2]);
 }
 
+//-----------------------------------------------------------------------------
+// helper function for clamping the state range of a time history. Returns the number of states in the range.
+static int historyRange(int nstates, int& nmin, int& nmax)
+{
+	if (nstates == 0) return 0;
+	if (nmin < 0) nmin = 0;
+	if (nmin >= nstates) nmin = nstates - 1;
+	if ((nmax == -1) || (nmax >= nstates)) nmax = nstates - 1;
+	if (nmax < nmin) nmax = nmin;
+	return nmax - nmin + 1;
+}
+
+//-----------------------------------------------------------------------------
+// Evaluate the time history of a nodal value for a list of nodes.
+// All the items are evaluated one state at a time, so that each state is only visited once.
+// The states are processed in parallel, unless states are paged (see EvalNodeField).
+// States can share a mesh, so the data fields must not write to it during evaluation
+// (e.g. the curvature and congruency fields keep their face marks locally).
+int FEPostModel::EvaluateNodeHistory(const vector<int>& items, int nfield, int nmin, int nmax, vector<float>& val)
+{
+	int nsteps = historyRange(GetStates(), nmin, nmax);
+	int NI = (int)items.size();
+	val.assign(NI*nsteps, 0.f);
+	if ((NI == 0) || (nsteps == 0)) return nsteps;
+
+	bool bparallel = (m_stateLoader == nullptr);
+#pragma omp parallel for if(bparallel) schedule(dynamic)
+	for (int n = 0; n < nsteps; ++n)
+	{
+		NODEDATA nd;
+		for (int i = 0; i < NI; ++i)
+		{
+			EvaluateNode(items[i], nmin + n, nfield, nd);
+			val[i*nsteps + n] = nd.m_val;
+		}
+	}
+	return nsteps;
+}
+
+//-----------------------------------------------------------------------------
+// Evaluate the time history of a face value for a list of faces.
+int FEPostModel::EvaluateFaceHistory(const vector<int>& items, int nfield, int nmin, int nmax, vector<float>& val)
+{
+	int nsteps = historyRange(GetStates(), nmin, nmax);
+	int NI = (int)items.size();
+	val.assign(NI*nsteps, 0.f);
+	if ((NI == 0) || (nsteps == 0)) return nsteps;
+
+	bool bparallel = (m_stateLoader == nullptr);
+#pragma omp parallel for if(bparallel) schedule(dynamic)
+	for (int n = 0; n < nsteps; ++n)
+	{
+		float data[FEFace::MAX_NODES], v;
+		for (int i = 0; i < NI; ++i)
+		{
+			v = 0.f;
+			EvaluateFace(items[i], nmin + n, nfield, data, v);
+			val[i*nsteps + n] = v;
+		}
+	}
+	return nsteps;
+}
+
+//-----------------------------------------------------------------------------
+// Evaluate the time history of an element value for a list of elements.
+int FEPostModel::EvaluateElemHistory(const vector<int>& items, int nfield, int nmin, int nmax, vector<float>& val)
+{
+	int nsteps = historyRange(GetStates(), nmin, nmax);
+	int NI = (int)items.size();
+	val.assign(NI*nsteps, 0.f);
+	if ((NI == 0) || (nsteps == 0)) return nsteps;
+
+	bool bparallel = (m_stateLoader == nullptr);
+#pragma omp parallel for if(bparallel) schedule(dynamic)
+	for (int n = 0; n < nsteps; ++n)
+	{
+		float data[FEElement::MAX_NODES] = { 0.f }, v;
+		for (int i = 0; i < NI; ++i)
+		{
+			v = 0.f;
+			EvaluateElement(items[i], nmin + n, nfield, data, v);
+			val[i*nsteps + n] = v;
+		}
+	}
+	return nsteps;
+}
+
 //-----------------------------------------------------------------------------
 // Calculate field value of edge n at time ntime
 void FEPostModel::EvaluateEdge(int n, int ntime, int nfield, EDGEDATA& d)
@@ -904,7 +1187,7 @@ bool FEPostModel::EvaluateFace(int n, int ntime, int nfield, float* data, float&
 	int ntag = 0;
 
 	// get the state
-	FEState& s = *m_State[ntime];
+	FEState& s = *GetState(ntime);
 
 
 	if (IS_FACE_FIELD(nfield))
@@ -2180,7 +2463,7 @@ vec3f FEPostModel::EvaluateNodeVector(int n, int ntime, int nvec)
 	else if (IS_ELEM_FIELD(nvec))
 	{
 		// we take the average of the elements that contain this element
-		const vector<NodeElemRef>& nel = mesh->NodeElemList(n);
+		NodeElemRefList nel = mesh->NodeElemList(n);
 		if (!nel.empty())
 		{
 			int n = 0;
@@ -2201,7 +2484,7 @@ vec3f FEPostModel::EvaluateNodeVector(int n, int ntime, int nvec)
 	else if (IS_FACE_FIELD(nvec))
 	{
 		// we take the average of the elements that contain this element
-		const vector<NodeFaceRef>& nfl = mesh->NodeFaceList(n);
+		NodeFaceRefList nfl = mesh->NodeFaceList(n);
 		if (!nfl.empty())
 		{
 			int n = 0;
@@ -2503,7 +2786,7 @@ mat3f FEPostModel::EvaluateNodeTensor(int n, int ntime, int nten, int ntype)
 	else 
 	{
 		// we take the average of the elements that contain this element
-		const vector<NodeElemRef>& nel = mesh->NodeElemList(n);
+		NodeElemRefList nel = mesh->NodeElemList(n);
 		if (!nel.empty())
 		{
 			for (int i=0; i<(int) nel.size(); ++i) m += EvaluateElemTensor(nel[i].eid, ntime, nten, ntype);
@@ -0,0 +1,102 @@
+/*This file is part of the FEBio Studio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio-Studio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+// Tests for CMathExpression. Each expression is compiled and evaluated, and the
+// result is compared with the expected value. Expressions with stray
+// characters must be rejected with an error, as CMathParser does.
+
+#include <MathLib/MathExpression.h>
+#include <math.h>
+#include <stdio.h>
+
+static int failed = 0;
+
+//-----------------------------------------------------------------------------
+// compile the expression and compare its value at x = 2 with the expected value
+static void checkValue(const char* sz, double expected)
+{
+	CMathExpression e;
+	e.AddVariable("x");
+	if (e.Compile(sz) == false)
+	{
+		printf("FAILED: \"%s\" did not compile (%s)\n", sz, e.ErrorString().c_str());
+		failed++;
+		return;
+	}
+
+	double x = 2.0;
+	double v = e.Eval(&x);
+	if (fabs(v - expected) > 1e-12 * (1.0 + fabs(expected)))
+	{
+		printf("FAILED: \"%s\" = %lg, expected %lg\n", sz, v, expected);
+		failed++;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// the expression must not compile
+static void checkRejected(const char* sz)
+{
+	CMathExpression e;
+	e.AddVariable("x");
+	if (e.Compile(sz) || e.IsValid() || e.ErrorString().empty())
+	{
+		printf("FAILED: \"%s\" was accepted\n", sz);
+		failed++;
+	}
+}
+
+//-----------------------------------------------------------------------------
+int main()
+{
+	checkValue("x", 2.0);
+	checkValue("x-2", 0.0);
+	checkValue("-x^2", 4.0);		// unary minus binds tighter, as in CMathParser
+	checkValue("2*x+3/x", 5.5);
+	checkValue("2^3^2", 64.0);
+	checkValue("sin(pi/2)*x", 2.0);
+	checkValue("atan2(x, 2)", atan2(2.0, 2.0));
+	checkValue("exp(ln(x))", 2.0);
+
+	// stray characters
+	checkRejected("x # 2");
+	checkRejected("x ? 3");
+	checkRejected("x_1+1");
+	checkRejected("#");
+	checkRejected("x + @");
+	checkRejected("sin(x) $");
+
+	// malformed expressions
+	checkRejected("");
+	checkRejected("x +");
+	checkRejected("(x");
+	checkRejected("foo(x)");
+	checkRejected("atan2(x)");
+
+	if (failed) printf("%d checks failed\n", failed);
+	else printf("all checks passed\n");
+	return (failed ? 1 : 0);
+}
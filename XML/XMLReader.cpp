@@ -36,6 +36,137 @@ static char THIS_FILE[]=__FILE__;
 #define new DEBUG_NEW
 #endif
 
+//-----------------------------------------------------------------------------
+// Fast string to number conversion. Decimal numbers with at most 19 significant
+// digits whose mantissa fits in a double and whose exponent is small are converted
+// exactly with a single multiplication or division by a power of ten. Everything
+// else (long mantissas, large exponents, inf, nan, hex) is passed on to strtod, so
+// the result is always the same as that of strtod.
+static const double pow10tab[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static inline bool isdigit_(char c) { return ((c >= '0') && (c <= '9')); }
+
+static double parseDouble(const char* sz, const char** szend)
+{
+	const char* s = sz;
+	while (isspace((unsigned char)*s)) ++s;
+
+	bool neg = false;
+	if      (*s == '-') { neg = true; ++s; }
+	else if (*s == '+') ++s;
+
+	unsigned long long m = 0;
+	int nd = 0, e = 0;
+	bool bdigits = false;
+	bool bslow = false;
+	while (isdigit_(*s))
+	{
+		if (m || (*s != '0')) { m = m * 10 + (*s - '0'); nd++; }
+		bdigits = true;
+		++s;
+	}
+	if (*s == '.')
+	{
+		++s;
+		while (isdigit_(*s))
+		{
+			if (m || (*s != '0')) { m = m * 10 + (*s - '0'); nd++; }
+			e--;
+			bdigits = true;
+			++s;
+		}
+	}
+
+	if ((bdigits == false) || (nd > 19) || (*s == 'x') || (*s == 'X')) bslow = true;
+	else if ((*s == 'e') || (*s == 'E'))
+	{
+		const char* t = s + 1;
+		bool eneg = false;
+		if      (*t == '-') { eneg = true; ++t; }
+		else if (*t == '+') ++t;
+		if (isdigit_(*t))
+		{
+			int ne = 0;
+			while (isdigit_(*t)) { if (ne < 10000) ne = ne * 10 + (*t - '0'); ++t; }
+			e += (eneg ? -ne : ne);
+			s = t;
+		}
+	}
+
+	if (bslow || (m > (1ull << 53)) || (e < -22) || (e > 22))
+	{
+		char* end = 0;
+		double v = strtod(sz, &end);
+		if (szend) *szend = end;
+		return v;
+	}
+
+	double v = (double)m;
+	if (e < 0) v /= pow10tab[-e]; else v *= pow10tab[e];
+	if (szend) *szend = s;
+	return (neg ? -v : v);
+}
+
+// Same as atoi, but also returns the end of the number. 
+// If no number was found, szend is set to sz.
+static int parseInt(const char* sz, const char** szend)
+{
+	const char* s = sz;
+	while (isspace((unsigned char)*s)) ++s;
+
+	bool neg = false;
+	if      (*s == '-') { neg = true; ++s; }
+	else if (*s == '+') ++s;
+
+	if (isdigit_(*s) == false) { if (szend) *szend = sz; return 0; }
+
+	long long n = 0;
+	while (isdigit_(*s)) { n = n * 10 + (*s - '0'); ++s; }
+	if (szend) *szend = s;
+	return (int)(neg ? -n : n);
+}
+
+// Read up to n comma separated numbers. This works like sscanf with a "%lg,%lg,..."
+// format, i.e. it stops at the first value that cannot be read. Returns the number of values read.
+template <typename T> static int scanList(const char* sz, T* v, int n)
+{
+	for (int i = 0; i < n; ++i)
+	{
+		if (i > 0)
+		{
+			if (*sz != ',') return i;
+			++sz;
+		}
+		const char* end = sz;
+		double d = parseDouble(sz, &end);
+		if (end == sz) return i;
+		v[i] = (T)d;
+		sz = end;
+	}
+	return n;
+}
+
+template <> int scanList<int>(const char* sz, int* v, int n)
+{
+	for (int i = 0; i < n; ++i)
+	{
+		if (i > 0)
+		{
+			if (*sz != ',') return i;
+			++sz;
+		}
+		const char* end = sz;
+		int d = parseInt(sz, &end);
+		if (end == sz) return i;
+		v[i] = d;
+		sz = end;
+	}
+	return n;
+}
+
 int XMLAtt::value(double* pf, int n)
 {
 	char* sz = m_szval;
@@ -44,7 +175,7 @@ int XMLAtt::value(double* pf, int n)
 	{
 		char* sze = strchr(sz, ',');
 
-		pf[i] = atof(sz);
+		pf[i] = parseDouble(sz, 0);
 		nr++;
 
 		if (sze) sz = sze + 1;
@@ -86,7 +217,7 @@ int XMLTag::value(double* pf, int n)
 	{
 		const char* sze = strchr(sz, ',');
 
-		pf[i] = atof(sz);
+		pf[i] = parseDouble(sz, 0);
 		nr++;
 
 		if (sze) sz = sze + 1;
@@ -105,7 +236,7 @@ int XMLTag::value(float* pf, int n)
 	{
 		const char* sze = strchr(sz, ',');
 
-		pf[i] = (float) atof(sz);
+		pf[i] = (float) parseDouble(sz, 0);
 		nr++;
 
 		if (sze) sz = sze + 1;
@@ -126,7 +257,7 @@ void XMLTag::value(std::vector<double>& l)
 		// read the value
 		if (sz && *sz)
 		{
-			double v = atof(sz);
+			double v = parseDouble(sz, 0);
 			l.push_back(v);
 
 			// find next space or comma
@@ -148,7 +279,7 @@ void XMLTag::value2(std::vector<int>& l)
 		// read the value
 		if (sz && *sz)
 		{
-			int v = (int)atoi(sz);
+			int v = parseInt(sz, 0);
 			l.push_back(v);
 
 			// find next space or comma
@@ -168,7 +299,7 @@ int XMLTag::value(int* pi, int n)
 	{
 		const char* sze = strchr(sz, ',');
 
-		pi[i] = atoi(sz);
+		pi[i] = parseInt(sz, 0);
 		nr++;
 
 		if (sze) sz = sze + 1;
@@ -181,30 +312,36 @@ int XMLTag::value(int* pi, int n)
 
 void XMLTag::value(vec3d& v)
 {
-	sscanf(m_sval.c_str(), "%lg,%lg,%lg", &v.x, &v.y, &v.z);
+	double a[3] = { v.x, v.y, v.z };
+	scanList(m_sval.c_str(), a, 3);
+	v = vec3d(a[0], a[1], a[2]);
 }
 
 void XMLTag::value(vec2i& v)
 {
-	sscanf(m_sval.c_str(), "%d,%d", &v.x, &v.y);
+	int a[2] = { v.x, v.y };
+	scanList(m_sval.c_str(), a, 2);
+	v.x = a[0]; v.y = a[1];
 }
 
 void XMLTag::value(vec3f& v)
 {
-	sscanf(m_sval.c_str(), "%g,%g,%g", &v.x, &v.y, &v.z);
+	float a[3] = { v.x, v.y, v.z };
+	scanList(m_sval.c_str(), a, 3);
+	v = vec3f(a[0], a[1], a[2]);
 }
 
 void XMLTag::value(mat3d& m)
 {
 	double a[9] = { 0 };
-	sscanf(m_sval.c_str(), "%lg,%lg,%lg,%lg,%lg,%lg,%lg,%lg,%lg", a, a+1, a+2,a+3,a+4,a+5,a+6,a+7,a+8);
+	scanList(m_sval.c_str(), a, 9);
 	m = mat3d(a);
 }
 
 void XMLTag::value(GLColor& c)
 {
 	int n[3] = { 0,0,0 };
-	sscanf(m_sval.c_str(), "%d,%d,%d", &n[0], &n[1], &n[2]);
+	scanList(m_sval.c_str(), n, 3);
 	c.r = (Byte)n[0];
 	c.g = (Byte)n[1];
 	c.b = (Byte)n[2];
@@ -216,73 +353,48 @@ void XMLTag::value(std::string& s)
 }
 
 //-----------------------------------------------------------------------------
+// Reads a comma separated list of integers. Each entry can also be a range
+// of the form n0:n1 or n0:n1:nn.
 void XMLTag::value(vector<int>& l)
 {
-	int i, n = 0, n0, n1, nn;
-	char* szval = strdup(m_sval.c_str());
-	char* ch;
-	char* sz = szval;
-	int nread;
-	do
+	l.clear();
+	const char* sz = m_sval.c_str();
+	while (true)
 	{
-		ch = strchr(sz, ',');
-		if (ch) *ch = 0;
-		nread = sscanf(sz, "%d:%d:%d", &n0, &n1, &nn);
-		switch (nread)
+		// read the next entry
+		int n0 = 0, n1 = -1, nn = 1;
+		const char* end = sz;
+		n0 = parseInt(sz, &end);
+		if (end != sz)
 		{
-		case 1:
 			n1 = n0;
-			nn = 1;
-			break;
-		case 2:
-			nn = 1;
-			break;
-		case 3:
-			break;
-		default:
-			n0 = 0;
-			n1 = -1;
-			nn = 1;
-		}
-
-		for (i=n0; i<=n1; i += nn) ++n;
-
-		if (ch) *ch = ',';
-		sz = ch+1;
-	}
-	while (ch != 0);
-
-	if (n != 0)
-	{
-		l.resize(n);
-
-		sz = szval;
-		n = 0;
-		do
-		{
-			ch = strchr(sz, ',');
-			if (ch) *ch = 0;
-			nread = sscanf(sz, "%d:%d:%d", &n0, &n1, &nn);
-			switch (nread)
+			sz = end;
+			if (*sz == ':')
 			{
-			case 1:
-				n1 = n0;
-				nn = 1;
-				break;
-			case 2:
-				nn = 1;
+				n1 = parseInt(sz + 1, &end);
+				if (end != sz + 1)
+				{
+					sz = end;
+					if (*sz == ':')
+					{
+						nn = parseInt(sz + 1, &end);
+						if (end != sz + 1) sz = end; else nn = 1;
+					}
+				}
+				else n1 = n0;
 			}
+		}
 
-			for (i=n0; i<=n1; i += nn) l[n++] = i;
-			assert(n <= (int) l.size());
-
-			if (ch) *ch = ',';
-			sz = ch+1;
+		if (nn > 0)
+		{
+			for (int i = n0; i <= n1; i += nn) l.push_back(i);
 		}
-		while (ch != 0);
-	}
 
-	free(szval);
+		// go to the next entry
+		const char* ch = strchr(sz, ',');
+		if (ch == 0) break;
+		sz = ch + 1;
+	}
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -343,6 +455,7 @@ XMLReader::XMLReader()
 	m_fp = 0;
 	m_ownFile = false;
 	m_nline = 0;
+	m_buf.resize(BUF_SIZE);
 	m_bufIndex = 0;
 	m_bufSize = 0;
 	m_eof = false;
@@ -632,15 +745,39 @@ void XMLReader::ReadTag(XMLTag& tag)
 	}
 }
 
+// Reads everything up to the next '<'. Instead of going through GetChar, this
+// scans the buffer directly and copies the value in blocks, which is much faster
+// for the large values of mesh sections. Like GetChar, this skips newlines.
 void XMLReader::ReadValue(XMLTag& tag)
 {
-	char ch;
-	if (!tag.isend())
+	bool bstore = !tag.isend();
+	if (bstore) tag.m_sval.clear();
+
+	while (true)
 	{
-		tag.m_sval.clear();
-		while ((ch=GetChar())!='<') tag.m_sval += ch;
+		if (m_bufIndex >= m_bufSize) { fillBuffer(); continue; }
+
+		const char* sz = &m_buf[m_bufIndex];
+		const char* szend = sz + (m_bufSize - m_bufIndex);
+		const char* szlt = (const char*)memchr(sz, '<', szend - sz);
+		const char* szstop = (szlt ? szlt : szend);
+
+		// copy the value, skipping newlines
+		while (sz < szstop)
+		{
+			const char* sznl = (const char*)memchr(sz, '\n', szstop - sz);
+			const char* szl = (sznl ? sznl : szstop);
+			if (bstore) tag.m_sval.append(sz, szl - sz);
+			if (sznl) { ++m_nline; sz = sznl + 1; }
+			else sz = szstop;
+		}
+
+		// also consume the '<'
+		int64_t n = (szstop - &m_buf[m_bufIndex]) + (szlt ? 1 : 0);
+		m_bufIndex += n;
+		m_currentPos += n;
+		if (szlt) break;
 	}
-	else while ((ch=GetChar())!='<');
 }
 
 void XMLReader::ReadEndTag(XMLTag& tag)
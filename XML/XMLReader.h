@@ -34,6 +34,7 @@ SOFTWARE.*/
 #include <FSCore/color.h>
 #include <stdexcept>
 #include <cstring>
+#include <vector>
 
 #ifndef WIN32
 	#include <string>
@@ -183,7 +184,7 @@ template <> inline std::string XMLTag::AttributeValue<std::string>(const char* s
 class XMLReader  
 {
 public:
-	enum { BUF_SIZE = 4096 };
+	enum { BUF_SIZE = 65536 };
 
 public:
 	// exceptions -----------
@@ -300,16 +301,18 @@ protected:
 		return ch;
 	}
 
-	char readNextChar()
+	void fillBuffer()
 	{
-		if (m_bufIndex >= m_bufSize)
-		{
-			if (m_eof) throw EndOfFile();
+		if (m_eof) throw EndOfFile();
 
-			m_bufSize = fread(m_buf, 1, BUF_SIZE, m_fp);
-			m_bufIndex = 0;
-			m_eof = (m_bufSize != BUF_SIZE);
-		}
+		m_bufSize = fread(&m_buf[0], 1, BUF_SIZE, m_fp);
+		m_bufIndex = 0;
+		m_eof = (m_bufSize != BUF_SIZE);
+	}
+
+	char readNextChar()
+	{
+		if (m_bufIndex >= m_bufSize) fillBuffer();
 		m_currentPos++;
 		return m_buf[m_bufIndex++];
 	}
@@ -353,7 +356,7 @@ protected:
 
 	std::string	m_comment;	// last comment that was read
 
-	char		m_buf[BUF_SIZE];
+	std::vector<char>	m_buf;
 	int64_t		m_bufIndex, m_bufSize;
 	bool		m_eof;
 
@@ -29,7 +29,177 @@ SOFTWARE.*/
 //////////////////////////////////////////////////////////////////////
 
 #include "XMLWriter.h"
+#include <math.h>
+#include <stdlib.h>
 
+//-----------------------------------------------------------------------------
+// Fast number formatting. These functions produce the same output as the 
+// corresponding printf formats, but avoid the overhead of printf for the common 
+// cases. When the correctly rounded result cannot be guaranteed (e.g. when a value
+// is very close to a rounding boundary), they fall back to snprintf.
+
+static const double pow10tab[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static double pow10_(int n)
+{
+	if ((n >= 0) && (n <= 22)) return pow10tab[n];
+	if ((n < 0) && (n >= -22)) return 1.0 / pow10tab[-n];
+	return pow(10.0, n);
+}
+
+// Write the unsigned integer n in sz. Returns the number of characters written.
+static int writeUInt(char* sz, unsigned long long n)
+{
+	char tmp[24];
+	int l = 0;
+	do { tmp[l++] = (char)('0' + n % 10); n /= 10; } while (n);
+	for (int i = 0; i < l; ++i) sz[i] = tmp[l - i - 1];
+	return l;
+}
+
+// Same as sprintf(sz, "%*d", width, n). Returns the number of characters written.
+static int formatInt(char* sz, int n, int width = 0)
+{
+	char tmp[16];
+	int l = 0;
+	if (n < 0) { tmp[0] = '-'; l = 1 + writeUInt(tmp + 1, (unsigned long long)(-(long long)n)); }
+	else l = writeUInt(tmp, (unsigned long long)n);
+
+	int pad = (width > l ? width - l : 0);
+	for (int i = 0; i < pad; ++i) sz[i] = ' ';
+	memcpy(sz + pad, tmp, l);
+	sz[pad + l] = 0;
+	return pad + l;
+}
+
+// Calculates the first P significant digits of |v|, i.e. |v| ~ D*10^(X-P+1) with 10^(P-1) <= D < 10^P.
+// Returns false if the result might not be correctly rounded.
+static bool decimalDigits(double v, int P, unsigned long long& D, int& X)
+{
+	double a = fabs(v);
+	if ((a < 1e-300) || (a > 1e300) || (a != a) || (P < 1) || (P > 15)) return false;
+
+	double lo = pow10tab[P - 1];
+	double hi = pow10tab[P];
+	X = (int)floor(log10(a));
+	for (int k = 0; k < 2; ++k)
+	{
+		int s = P - 1 - X;
+		double f = (s >= 0 ? a * pow10_(s) : a / pow10_(-s));
+
+		// allow for the round-off error in the calculation of f
+		double eps = f * 1e-14;
+		if ((f < lo - eps) || (f + 0.5 >= hi + eps))
+		{
+			X += (f < lo ? -1 : 1);
+			continue;
+		}
+		if ((fabs(f - lo) <= eps) || (fabs(f + 0.5 - hi) <= eps)) return false;
+
+		// make sure we're not too close to a rounding boundary
+		double r = f - floor(f);
+		if (fabs(r - 0.5) <= eps) return false;
+
+		D = (unsigned long long)floor(f + 0.5);
+		return true;
+	}
+	return false;
+}
+
+// Same as sprintf(sz, "%.*lg", P, v). Returns the number of characters written.
+static int formatDouble(char* sz, double v, int P)
+{
+	if (P == 0) P = 1;
+	if (v == 0.0)
+	{
+		return (signbit(v) ? sprintf(sz, "-0") : sprintf(sz, "0"));
+	}
+
+	unsigned long long D;
+	int X;
+	if (decimalDigits(v, P, D, X) == false) return sprintf(sz, "%.*lg", P, v);
+
+	char dig[24];
+	writeUInt(dig, D);
+
+	// remove trailing zeroes
+	int nd = P;
+	while ((nd > 1) && (dig[nd - 1] == '0')) nd--;
+
+	char* c = sz;
+	if (v < 0) *c++ = '-';
+	if ((X < -4) || (X >= P))
+	{
+		// exponential notation
+		*c++ = dig[0];
+		if (nd > 1) { *c++ = '.'; for (int i = 1; i < nd; ++i) *c++ = dig[i]; }
+		*c++ = 'e';
+		*c++ = (X < 0 ? '-' : '+');
+		int e = (X < 0 ? -X : X);
+		if (e < 10) *c++ = '0';
+		c += writeUInt(c, e);
+	}
+	else if (X >= 0)
+	{
+		for (int i = 0; i <= X; ++i) *c++ = dig[i];
+		if (nd > X + 1) { *c++ = '.'; for (int i = X + 1; i < nd; ++i) *c++ = dig[i]; }
+	}
+	else
+	{
+		*c++ = '0'; *c++ = '.';
+		for (int i = 0; i < -X - 1; ++i) *c++ = '0';
+		for (int i = 0; i < nd; ++i) *c++ = dig[i];
+	}
+	*c = 0;
+	return (int)(c - sz);
+}
+
+// Same as sprintf(sz, "%15.7e", v). Returns the number of characters written.
+static int formatScientific(char* sz, double v)
+{
+	const int P = 8;
+	unsigned long long D = 0;
+	int X = 0;
+	if ((v != 0.0) && (decimalDigits(v, P, D, X) == false)) return sprintf(sz, "%15.7e", v);
+
+	char dig[24];
+	if (v == 0.0) memset(dig, '0', P); else writeUInt(dig, D);
+
+	char tmp[32];
+	char* c = tmp;
+	if (signbit(v)) *c++ = '-';
+	*c++ = dig[0];
+	*c++ = '.';
+	for (int i = 1; i < P; ++i) *c++ = dig[i];
+	*c++ = 'e';
+	*c++ = (X < 0 ? '-' : '+');
+	int e = (X < 0 ? -X : X);
+	if (e < 10) *c++ = '0';
+	c += writeUInt(c, e);
+
+	int l = (int)(c - tmp);
+	int pad = (l < 15 ? 15 - l : 0);
+	for (int i = 0; i < pad; ++i) sz[i] = ' ';
+	memcpy(sz + pad, tmp, l);
+	sz[pad + l] = 0;
+	return pad + l;
+}
+
+// returns the width of an integer format of the form "%d" or "%6d", or -1 for any other format.
+static int intFormatWidth(const char* szfmt)
+{
+	if (szfmt[0] != '%') return -1;
+	int w = 0;
+	const char* c = szfmt + 1;
+	while ((*c >= '0') && (*c <= '9')) { w = 10 * w + (*c - '0'); ++c; }
+	if ((c[0] != 'd') || (c[1] != 0)) return -1;
+	return w;
+}
+
+//-----------------------------------------------------------------------------
 const char* XMLElement::intFormat = "%6d";
 
 void XMLElement::setDefautlFormats()
@@ -42,6 +212,18 @@ void XMLElement::value(int* pi, int n)
 	m_szval[0] = 0;
 	if (n==0) return;
 
+	int w = intFormatWidth(intFormat);
+	if (w >= 0)
+	{
+		char* sz = m_szval;
+		for (int i = 0; i < n; ++i)
+		{
+			if (i > 0) *sz++ = ',';
+			sz += formatInt(sz, pi[i], w);
+		}
+		return;
+	}
+
 	sprintf(m_szval, intFormat, pi[0]);
 	int l = (int)strlen(m_szval);
 	for (int i=1; i<n; ++i)
@@ -52,26 +234,37 @@ void XMLElement::value(int* pi, int n)
 	}
 }
 
+void XMLElement::value(double g)
+{
+	formatDouble(m_szval, g, 9);
+}
+
 void XMLElement::value(double* pg, int n)
 {
 	m_szval[0] = 0;
-	if (n==0) return;
-
-	sprintf(m_szval, "%lg", pg[0]);
-	int l = (int)strlen(m_szval);
-	for (int i=1; i<n; ++i)
+	char* sz = m_szval;
+	for (int i=0; i<n; ++i)
 	{
-		sprintf(m_szval+l, ",%lg", pg[i]);
-		l = (int)strlen(m_szval);
+		if (i > 0) *sz++ = ',';
+		sz += formatDouble(sz, pg[i], 6);
 	}
 }
 
 void XMLElement::value(const vec3d& r)
 { 
+	char* sz = m_szval;
 	if (XMLWriter::GetFloatFormat() == XMLWriter::ScientificFormat)
-		sprintf(m_szval, "%15.7e,%15.7e,%15.7e", r.x, r.y, r.z); 
+	{
+		sz += formatScientific(sz, r.x); *sz++ = ',';
+		sz += formatScientific(sz, r.y); *sz++ = ',';
+		formatScientific(sz, r.z);
+	}
 	else
-		sprintf(m_szval, "%.9lg,%.9lg,%.9lg", r.x, r.y, r.z);
+	{
+		sz += formatDouble(sz, r.x, 9); *sz++ = ',';
+		sz += formatDouble(sz, r.y, 9); *sz++ = ',';
+		formatDouble(sz, r.z, 9);
+	}
 }
 
 void XMLElement::value(const vec2i& r)
@@ -195,6 +388,13 @@ bool XMLWriter::open(const char* szfile)
 
 	m_fp = fopen(szfile, "wt");
 
+	// use a large write buffer
+	if (m_fp)
+	{
+		m_buf.resize(BUF_SIZE);
+		setvbuf(m_fp, &m_buf[0], _IOFBF, BUF_SIZE);
+	}
+
 	// write the first line
 	if (m_fp) fprintf(m_fp, "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?>\n");
 	
@@ -287,21 +487,150 @@ void XMLWriter::add_empty(XMLElement& el, bool bclear)
 
 void XMLWriter::add_leaf(XMLElement& el, bool bclear)
 {
-	char szformat[256] = {0};
-	sprintf(szformat, "%s<%%s", m_sztab);
-
-	fprintf(m_fp, szformat, el.m_sztag);
+	fputs(m_sztab, m_fp);
+	fputc('<', m_fp);
+	fputs(el.m_sztag, m_fp);
 
 	for (int i=0; i<el.m_natt; ++i)
 	{
-		fprintf(m_fp, " %s=\"%s\"", el.m_attn[i], el.m_attv[i]);
+		fputc(' ', m_fp);
+		fputs(el.m_attn[i], m_fp);
+		fputs("=\"", m_fp);
+		fputs(el.m_attv[i], m_fp);
+		fputc('"', m_fp);
 	}
 
-	fprintf(m_fp, ">%s</%s>\n", el.m_szval, el.m_sztag);
+	fputc('>', m_fp);
+	fputs(el.m_szval, m_fp);
+	fputs("</", m_fp);
+	fputs(el.m_sztag, m_fp);
+	fputs(">\n", m_fp);
 
 	if (bclear) el.clear();
 }
 
+//-----------------------------------------------------------------------------
+// Helper class for add_leaves that writes the leaves into a memory buffer
+// before they are written to the file.
+class XMLLeafBuffer
+{
+public:
+	XMLLeafBuffer(FILE* fp, const char* sztab, const char* szn, const char* sza) : m_fp(fp)
+	{
+		// The start of each leaf is the same up to the attribute value
+		m_head = std::string(sztab) + "<" + szn + " " + sza + "=\"";
+		m_tail = std::string("</") + szn + ">\n";
+		m_buf.resize(BUF_SIZE + 4096);
+		m_n = 0;
+	}
+
+	~XMLLeafBuffer() { flush(); }
+
+	// start a new leaf with the attribute value natt
+	void begin(int natt)
+	{
+		if (m_n > BUF_SIZE) flush();
+		append(m_head);
+		m_n += formatInt(&m_buf[m_n], natt);
+		m_buf[m_n++] = '"';
+		m_buf[m_n++] = '>';
+	}
+
+	// end the current leaf
+	void end() { append(m_tail); }
+
+	void comma() { m_buf[m_n++] = ','; }
+
+	// Returns a pointer to write a value to.
+	char* pos() { return &m_buf[m_n]; }
+	void advance(int n) { m_n += n; }
+
+	void flush()
+	{
+		if (m_n) fwrite(&m_buf[0], 1, m_n, m_fp);
+		m_n = 0;
+	}
+
+private:
+	void append(const std::string& s)
+	{
+		memcpy(&m_buf[m_n], s.c_str(), s.size());
+		m_n += s.size();
+	}
+
+private:
+	enum { BUF_SIZE = 65536 };
+	FILE*				m_fp;
+	std::string			m_head, m_tail;
+	std::vector<char>	m_buf;
+	size_t				m_n;
+};
+
+void XMLWriter::add_leaves(const char* szn, const char* sza, const int* att, const int* val, int nleaf, int nval)
+{
+	// values per leaf must fit in the buffer's margin
+	if (nval > 64) 
+	{
+		XMLElement el(szn);
+		el.add_attribute(sza, 0);
+		for (int i = 0; i < nleaf; ++i)
+		{
+			el.set_attribute(0, att[i]);
+			el.value((int*)val + i*nval, nval);
+			add_leaf(el, false);
+		}
+		return;
+	}
+
+	int w = intFormatWidth(XMLElement::intFormat);
+	if (w < 0) w = 0;
+
+	XMLLeafBuffer buf(m_fp, m_sztab, szn, sza);
+	for (int i = 0; i < nleaf; ++i)
+	{
+		buf.begin(att[i]);
+		const int* v = val + i*nval;
+		for (int j = 0; j < nval; ++j)
+		{
+			if (j > 0) buf.comma();
+			buf.advance(formatInt(buf.pos(), v[j], w));
+		}
+		buf.end();
+	}
+}
+
+void XMLWriter::add_leaves(const char* szn, const char* sza, const int* att, const double* val, int nleaf, int nval, int prec)
+{
+	// values per leaf must fit in the buffer's margin
+	if (nval > 16)
+	{
+		XMLElement el(szn);
+		el.add_attribute(sza, 0);
+		for (int i = 0; i < nleaf; ++i)
+		{
+			el.set_attribute(0, att[i]);
+			el.value((double*)val + i*nval, nval);
+			add_leaf(el, false);
+		}
+		return;
+	}
+
+	bool sci = (m_floatFormat == ScientificFormat);
+
+	XMLLeafBuffer buf(m_fp, m_sztab, szn, sza);
+	for (int i = 0; i < nleaf; ++i)
+	{
+		buf.begin(att[i]);
+		const double* v = val + i*nval;
+		for (int j = 0; j < nval; ++j)
+		{
+			if (j > 0) buf.comma();
+			buf.advance(sci ? formatScientific(buf.pos(), v[j]) : formatDouble(buf.pos(), v[j], prec));
+		}
+		buf.end();
+	}
+}
+
 void XMLWriter::add_leaf(const char* szn, const char* szv)
 {
 	char szformat[256] = {0};
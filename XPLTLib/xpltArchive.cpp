@@ -29,18 +29,6 @@ SOFTWARE.*/
 #include <FSCore/Archive.h>
 #include <zlib.h>
 
-#ifdef WIN32
-typedef __int64 off_type;
-#endif
-
-#ifdef LINUX // same for Linux and Mac OS X
-typedef off_t off_type;
-#endif
-
-#ifdef __APPLE__ // same for Linux and Mac OS X
-typedef off_t off_type;
-#endif
-
 #ifdef WIN32
 #define ftell64(a)     _ftelli64(a)
 #define fseek64(a,b,c) _fseeki64(a,b,c)
@@ -252,10 +240,10 @@ bool xpltArchive::Open(IOFileStream* fp)
 	return true;
 }
 
-int xpltArchive::DecompressChunk(unsigned int& nid, unsigned int& nsize)
+int xpltArchive::DecompressChunk(CHUNK_BUFFER& chunk)
 {
 	const int CHUNK = 16384;
-	nsize = -1;
+	chunk.nsize = -1;
 
 	int ret;
 	unsigned have;
@@ -308,13 +296,12 @@ int xpltArchive::DecompressChunk(unsigned int& nid, unsigned int& nsize)
 	char* pbuf = buf.data();
 	if (pbuf)
 	{
-		memcpy(&nid, pbuf, sizeof(int)); pbuf += sizeof(int); if (im.m_bswap) bswap(nid);
-		memcpy(&nsize, pbuf, sizeof(int)); pbuf += sizeof(int); if (im.m_bswap) bswap(nsize);
+		memcpy(&chunk.id, pbuf, sizeof(int)); pbuf += sizeof(int); if (im.m_bswap) bswap(chunk.id);
+		memcpy(&chunk.nsize, pbuf, sizeof(int)); pbuf += sizeof(int); if (im.m_bswap) bswap(chunk.nsize);
 
-		im.m_bufsize = buf.size() - 2 * sizeof(int);
-		im.m_buf = new char[im.m_bufsize];
-		memcpy(im.m_buf, pbuf, im.m_bufsize);
-		im.m_pdata = im.m_buf;
+		chunk.bufsize = buf.size() - 2 * sizeof(int);
+		chunk.pbuf = new char[chunk.bufsize];
+		memcpy(chunk.pbuf, pbuf, chunk.bufsize);
 	}
 
 	/* clean up and return */
@@ -323,6 +310,46 @@ int xpltArchive::DecompressChunk(unsigned int& nid, unsigned int& nsize)
 }
 
 
+off_type xpltArchive::Tell()
+{
+	assert(im.m_Chunk.empty());
+	off_type pos = ftell64(im.m_fp->FilePtr());
+
+	// the decompression stream may have read past the end of the last chunk
+	if (im.m_ncompress) pos -= im.strm.avail_in;
+
+	return pos;
+}
+
+bool xpltArchive::Seek(off_type pos)
+{
+	// clear the chunk stack
+	while (im.m_Chunk.empty() == false)
+	{
+		CHUNK* pc = im.m_Chunk.top(); im.m_Chunk.pop();
+		delete pc;
+	}
+
+	if (im.m_buf) delete[] im.m_buf;
+	im.m_buf = 0;
+	im.m_pdata = 0;
+	im.m_bufsize = 0;
+
+	// any unprocessed compressed data is no longer valid
+	im.strm.avail_in = 0;
+	im.strm.next_in = Z_NULL;
+
+	im.m_bend = false;
+
+	return (fseek64(im.m_fp->FilePtr(), pos, SEEK_SET) == 0);
+}
+
+off_type xpltArchive::FileSize()
+{
+	if ((im.m_fp == 0) || (fseek64(im.m_fp->FilePtr(), 0, SEEK_END) != 0)) return -1;
+	return ftell64(im.m_fp->FilePtr());
+}
+
 bool xpltArchive::Append(const char* szfile)
 {
 	// reopen the plot file for appending
@@ -346,50 +373,17 @@ int xpltArchive::OpenChunk()
 	// see if we have a buffer allocated
 	if (im.m_buf == 0)
 	{
-		unsigned int id, nsize;
-		if (im.m_ncompress == 0)
-		{
-			// see if we have reached the end of the file
-			if (feof(im.m_fp->FilePtr()) || ferror(im.m_fp->FilePtr())) return IO_ERROR;
-
-			// get the master chunk id and size
-			int nret = im.m_fp->read(&id, sizeof(unsigned int), 1); if (nret != 1) return IO_ERROR;
-			if (im.m_bswap) bswap(id);
-			nret = im.m_fp->read(&nsize, sizeof(unsigned int), 1); if (nret != 1) return IO_ERROR;
-			if (im.m_bswap) bswap(nsize);
-
-			if (nsize == 0)
-			{
-				im.m_bend = true;
-				return IO_END;
-			}
-			else
-			{
-				// allocate the buffer
-				im.m_bufsize = nsize;
-				im.m_buf = new char[im.m_bufsize];
-
-				// read the buffer from file
-				int nread = im.m_fp->read(im.m_buf, sizeof(char), nsize);
-				if (nread != nsize) return IO_ERROR;
-
-				// set the data pointer
-				im.m_pdata = im.m_buf;
-			}
-		}
-		else
+		// read the next master chunk
+		CHUNK_BUFFER buf;
+		IOResult ret = ReadChunk(buf);
+		if (ret == IO_END)
 		{
-			// we need to decompress the chunk
-			if (DecompressChunk(id, nsize) != Z_OK) return IO_ERROR;
+			im.m_bend = true;
+			return IO_END;
 		}
+		else if (ret != IO_OK) return IO_ERROR;
 
-		// create a new chunk
-		CHUNK* pc = new CHUNK;
-		pc->id = id;
-		pc->nsize = nsize;
-		pc->pdata = im.m_pdata;
-		// add it to the stack
-		im.m_Chunk.push(pc);
+		return OpenChunk(buf);
 	}
 	else
 	{
@@ -413,6 +407,69 @@ int xpltArchive::OpenChunk()
 	return IO_OK;
 }
 
+xpltArchive::IOResult xpltArchive::ReadChunk(CHUNK_BUFFER& buf)
+{
+	delete[] buf.pbuf;
+	buf.pbuf = 0;
+	buf.bufsize = 0;
+
+	if (im.m_ncompress == 0)
+	{
+		// see if we have reached the end of the file
+		if (feof(im.m_fp->FilePtr()) || ferror(im.m_fp->FilePtr())) return IO_ERROR;
+
+		// get the master chunk id and size
+		unsigned int id, nsize;
+		int nret = im.m_fp->read(&id, sizeof(unsigned int), 1); if (nret != 1) return IO_ERROR;
+		if (im.m_bswap) bswap(id);
+		nret = im.m_fp->read(&nsize, sizeof(unsigned int), 1); if (nret != 1) return IO_ERROR;
+		if (im.m_bswap) bswap(nsize);
+
+		buf.id = id;
+		buf.nsize = nsize;
+		if (nsize == 0) return IO_END;
+
+		// allocate the buffer
+		buf.bufsize = nsize;
+		buf.pbuf = new char[nsize];
+
+		// read the buffer from file
+		int nread = im.m_fp->read(buf.pbuf, sizeof(char), nsize);
+		if (nread != nsize) return IO_ERROR;
+	}
+	else
+	{
+		// we need to decompress the chunk
+		if (DecompressChunk(buf) != Z_OK) return IO_ERROR;
+	}
+
+	return IO_OK;
+}
+
+int xpltArchive::OpenChunk(CHUNK_BUFFER& buf)
+{
+	assert(im.m_buf == 0);
+	assert(buf.pbuf);
+
+	// the archive takes ownership of the data
+	im.m_bufsize = buf.bufsize;
+	im.m_buf = buf.pbuf;
+	im.m_pdata = im.m_buf;
+	buf.pbuf = 0;
+	buf.bufsize = 0;
+
+	// create a new chunk
+	CHUNK* pc = new CHUNK;
+	pc->id = buf.id;
+	pc->nsize = buf.nsize;
+	pc->pdata = im.m_pdata;
+
+	// add it to the stack
+	im.m_Chunk.push(pc);
+
+	return IO_OK;
+}
+
 void xpltArchive::CloseChunk()
 {
 	// pop the last chunk
@@ -31,6 +31,18 @@ SOFTWARE.*/
 #include <MathLib/math3d.h>
 #include <FSCore/Archive.h>
 
+#ifdef WIN32
+typedef __int64 off_type;
+#endif
+
+#ifdef LINUX // same for Linux and Mac OS X
+typedef off_t off_type;
+#endif
+
+#ifdef __APPLE__ // same for Linux and Mac OS X
+typedef off_t off_type;
+#endif
+
 //-----------------------------------------------------------------------------
 // Input archive
 class xpltArchive  
@@ -47,6 +59,18 @@ class xpltArchive
 public:
 	enum IOResult { IO_ERROR, IO_OK, IO_END };
 
+	// buffer that stores the (uncompressed) data of a master chunk
+	struct CHUNK_BUFFER
+	{
+		unsigned int	id;			// chunk ID
+		unsigned int	nsize;		// size of chunk
+		char*			pbuf;		// chunk data
+		unsigned int	bufsize;	// size of data buffer
+
+		CHUNK_BUFFER() { id = 0; nsize = 0; pbuf = 0; bufsize = 0; }
+		~CHUNK_BUFFER() { delete[] pbuf; }
+	};
+
 public:
 	//! class constructor
 	xpltArchive();
@@ -111,6 +135,14 @@ public: // reading
 	// Open a chunk
 	int OpenChunk();
 
+	// Read the next master chunk into a buffer (decompressing it if needed)
+	// This only accesses the file, so it can run while the current chunk is being processed.
+	IOResult ReadChunk(CHUNK_BUFFER& buf);
+
+	// Open a master chunk that was read with ReadChunk
+	// (The archive takes ownership of the buffer's data)
+	int OpenChunk(CHUNK_BUFFER& buf);
+
 	// Get the current chunk ID
 	unsigned int GetChunkID();
 
@@ -162,7 +194,17 @@ public: // reading
 	int GetCompression();
 	void SetCompression(int n);
 
-	int DecompressChunk(unsigned int& nid, unsigned int& nsize);
+	int DecompressChunk(CHUNK_BUFFER& buf);
+
+	// get the file position of the next (master) chunk
+	// (only valid between master chunks)
+	off_type Tell();
+
+	// move to the file position of a master chunk (as returned by Tell)
+	bool Seek(off_type pos);
+
+	// get the current size of the file (this moves the file position to the end)
+	off_type FileSize();
 
 protected:
 	Imp& im;
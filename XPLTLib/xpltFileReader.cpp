@@ -54,21 +54,43 @@ void xpltParser::addWarning(int n)
 xpltFileReader::xpltFileReader(Post::FEPostModel* fem) : FEFileReader(fem)
 {
 	m_xplt = 0;
+	m_fs = 0;
 	m_read_state_flag = XPLT_READ_ALL_STATES;
+	m_maxPagedStates = 10;
+	m_bfollow = false;
 }
 
 xpltFileReader::~xpltFileReader()
 {
+	// If the model is still paging states from this file, we need to read 
+	// them all in now, since we're about to close the file.
+	if (m_fem && (m_fem->GetStateLoader() == this)) m_fem->LoadAllStates();
+
+	Close();
+	delete m_xplt;
+}
+
+void xpltFileReader::Close()
+{
+	m_ar.Close();
+	delete m_fs;
+	m_fs = 0;
+	FEFileReader::Close();
 }
 
 bool xpltFileReader::Load(const char* szfile)
 {
+	// The file may still be open if the states were paged. In that case,
+	// the old states can't be read anymore, so we just clear them.
+	if (m_fem && (m_fem->GetStateLoader() == this)) m_fem->ClearStates();
+	Close();
+
 	// open the file
 	if (Open(szfile, "rb") == false) return errf("Failed opening file.");
 
 	// attach the file to the archive
-	IOFileStream fs(m_fp, false);
-	if (m_ar.Open(&fs) == false) return errf("This is not a valid XPLT file.");
+	m_fs = new IOFileStream(m_fp, false);
+	if (m_ar.Open(m_fs) == false) { Close(); return errf("This is not a valid XPLT file."); }
 
 	// open the root chunk (no compression for this sectio)
 	m_ar.SetCompression(0);
@@ -100,12 +122,22 @@ bool xpltFileReader::Load(const char* szfile)
 		m_xplt = new XpltReader3(this);
 	}
 
+	// paging is only supported for version 3.0 and up
+	int read_state_flag = m_read_state_flag;
+	if ((m_read_state_flag == XPLT_READ_STATES_PAGED) && (m_hdr.nversion < 0x0030)) m_read_state_flag = XPLT_READ_ALL_STATES;
+
+	// following is only supported for version 3.0 and up, and only when all states are read
+	if ((m_hdr.nversion < 0x0030) || ((m_read_state_flag != XPLT_READ_ALL_STATES) && (m_read_state_flag != XPLT_READ_STATES_PAGED))) m_bfollow = false;
+
 	// load the rest of the file
 	bool bret = m_xplt->Load(*m_fem);
 
+	m_read_state_flag = read_state_flag;
+
 	// clean up
-	m_ar.Close();
-	Close();
+	// (If the states are paged or the file is followed, we need to keep the file open.)
+	if (bret == false) m_bfollow = false;
+	if ((m_fem->GetStateLoader() != this) && (m_bfollow == false)) Close();
 
 	if (m_xplt->warnings() > 0)
 	{
@@ -126,6 +158,28 @@ bool xpltFileReader::Load(const char* szfile)
 }
 
 
+//-----------------------------------------------------------------------------
+bool xpltFileReader::LoadState(Post::FEState* ps)
+{
+	if ((m_xplt == 0) || (m_fp == 0)) return false;
+	return m_xplt->LoadState(*m_fem, ps);
+}
+
+//-----------------------------------------------------------------------------
+int xpltFileReader::ReadNewStates()
+{
+	if ((m_bfollow == false) || (m_xplt == 0) || (m_fp == 0)) return -1;
+	return m_xplt->ReadNewStates(*m_fem);
+}
+
+//-----------------------------------------------------------------------------
+void xpltFileReader::StopFollowing()
+{
+	if (m_bfollow == false) return;
+	m_bfollow = false;
+	if (m_fem && (m_fem->GetStateLoader() != this)) Close();
+}
+
 //-----------------------------------------------------------------------------
 bool xpltFileReader::ReadHeader()
 {
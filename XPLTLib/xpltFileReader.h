@@ -26,13 +26,15 @@ SOFTWARE.*/
 
 #pragma once
 #include "PostLib/FEFileReader.h"
+#include "PostLib/FEPostModel.h"
 #include "xpltArchive.h"
 
 enum XPLT_READ_STATE_FLAG { 
 	XPLT_READ_ALL_STATES, 
 	XPLT_READ_LAST_STATE_ONLY, 
 	XPLT_READ_STATES_FROM_LIST,
-	XPLT_READ_FIRST_AND_LAST 
+	XPLT_READ_FIRST_AND_LAST,
+	XPLT_READ_STATES_PAGED			// states are read on demand (only supported for version 3.0 and up)
 };
 
 enum XPLT_READ_WARNING {
@@ -51,6 +53,13 @@ public:
 
 	virtual bool Load(Post::FEPostModel& fem) = 0;
 
+	// reload the data of a paged state
+	virtual bool LoadState(Post::FEPostModel& fem, Post::FEState* ps) { return false; }
+
+	// read the states that were appended to the file since the last read (follow mode)
+	// returns the number of new states, or -1 if the file can no longer be followed
+	virtual int ReadNewStates(Post::FEPostModel& fem) { return -1; }
+
 	bool errf(const char* sz);
 
 	void addWarning(int n);
@@ -63,7 +72,7 @@ protected:
 	vector<int>			m_wrng;	// warning list
 };
 
-class xpltFileReader : public Post::FEFileReader
+class xpltFileReader : public Post::FEFileReader, public Post::FEStateLoader
 {
 protected:
 	// file tags
@@ -102,9 +111,29 @@ public:
 	void SetReadStateFlag(int n) { m_read_state_flag = n; }
 	void SetReadStatesList(const vector<int>& l) { m_state_list = l; }
 
+	// max number of states kept in memory (only when m_read_state_flag == XPLT_READ_STATES_PAGED)
+	void SetMaxPagedStates(int n) { m_maxPagedStates = n; }
+	int GetMaxPagedStates() const { return m_maxPagedStates; }
+
+	// (overridden from FEStateLoader)
+	bool LoadState(Post::FEState* ps) override;
+
 	int GetReadStateFlag() const { return m_read_state_flag; }
 	vector<int> GetReadStates() const { return m_state_list; }
 
+	// In follow mode the file is kept open after loading so that states that are 
+	// appended later (e.g. by a running job) can be read with ReadNewStates.
+	// (only supported for version 3.0 and up, when all states are read or paged)
+	void SetFollowMode(bool b) { m_bfollow = b; }
+	bool IsFollowing() const { return m_bfollow; }
+
+	// read any new states (follow mode only)
+	// returns the number of states added, or -1 if the file needs to be reloaded
+	int ReadNewStates();
+
+	// stop following the file (closes the file, unless states are paged)
+	void StopFollowing();
+
 public:
 	xpltArchive& GetArchive() { return m_ar; }
 
@@ -113,14 +142,19 @@ public:
 protected:
 	bool ReadHeader();
 
+	void Close() override;
+
 private:
 	xpltParser*		m_xplt;
 	xpltArchive		m_ar;
+	IOFileStream*	m_fs;
 	HEADER			m_hdr;
 
 	// Options
 	int			m_read_state_flag;	//!< flag setting option for reading states
 	vector<int>	m_state_list;		//!< list of states to read (only when m_read_state_flag == XPLT_READ_STATES_FROM_LIST)
+	int			m_maxPagedStates;	//!< max nr of states in memory (only when m_read_state_flag == XPLT_READ_STATES_PAGED)
+	bool		m_bfollow;			//!< keep the file open to read states that are appended later
 
 	friend class xpltParser;
 };
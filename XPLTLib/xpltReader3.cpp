@@ -122,6 +122,8 @@ XpltReader3::XpltReader3(xpltFileReader* xplt) : xpltParser(xplt)
 {
 	m_pstate = 0;
 	m_mesh = 0;
+	m_stateEnd = 0;
+	m_bpaged = false;
 }
 
 XpltReader3::~XpltReader3()
@@ -152,6 +154,10 @@ bool XpltReader3::Load(FEPostModel& fem)
 	// clear the model data
 	fem.Clear();
 
+	m_bpaged = (m_xplt->GetReadStateFlag() == XPLT_READ_STATES_PAGED);
+	m_stateOffset.clear();
+	m_pagedMesh.clear();
+
 	// read the root section (no compression for this section)
 	if (ReadRootSection(fem) == false) return false;
 
@@ -175,42 +181,69 @@ bool XpltReader3::Load(FEPostModel& fem)
 	// Clear the end-flag of the mesh section
 	if (m_ar.OpenChunk() != xpltArchive::IO_END) return false;
 
+	// the state sections start here
+	m_stateEnd = m_ar.Tell();
+
 	// read the state sections (these could be compressed)
 	const xpltFileReader::HEADER& hdr = m_xplt->GetHeader();
 	m_ar.SetCompression(hdr.ncompression);
 	int read_state_flag = m_xplt->GetReadStateFlag();
 	int nstate = 0;
+	bool bok = true;
 	try{
+		// While a chunk is processed, the next chunk is read (and decompressed) on another thread.
+		// This isn't done when paging, since then we need to know where each chunk starts.
+		xpltArchive::CHUNK_BUFFER next;
+		xpltArchive::IOResult nextResult = xpltArchive::IO_OK;
+		if (m_bpaged == false) nextResult = m_ar.ReadChunk(next);
+
 		while (true)
 		{
-			if (m_ar.OpenChunk() != xpltArchive::IO_OK) break;
+			if (m_xplt->IsCancelled()) break;
+
+			off_type pos = 0, end = 0;
+			if (m_bpaged)
+			{
+				// store the position of this chunk, since we need to page it in later
+				pos = m_ar.Tell();
+				if (m_ar.OpenChunk() != xpltArchive::IO_OK) break;
+			}
+			else
+			{
+				if (nextResult != xpltArchive::IO_OK) break;
+
+				// the chunk was read completely, so this is where it ends
+				end = m_ar.Tell();
+				m_ar.OpenChunk(next);
+			}
 
-			if (m_ar.GetChunkID() == PLT_STATE)
+			int nret = READ_CHUNK_OK;
+#pragma omp parallel sections num_threads(2)
 			{
-				if (m_pstate) { delete m_pstate; m_pstate = 0; }
-				if (ReadStateSection(fem) == false) break;
-				if (read_state_flag == XPLT_READ_ALL_STATES) { fem.AddState(m_pstate); m_pstate = 0; }
-				else if (read_state_flag == XPLT_READ_STATES_FROM_LIST)
+#pragma omp section
 				{
-					vector<int> state_list = m_xplt->GetReadStates();
-					int n = (int) state_list.size();
-					for (int i=0; i<n; ++i)
+					if (m_bpaged == false)
 					{
-						if (state_list[i] == nstate)
+						try {
+							nextResult = m_ar.ReadChunk(next);
+						}
+						catch (...)
 						{
-							fem.AddState(m_pstate); 
-							m_pstate = 0;
-							break;
+							nextResult = xpltArchive::IO_ERROR;
 						}
 					}
 				}
+#pragma omp section
+				{
+					nret = ReadDataChunk(fem, nstate, pos);
+				}
 			}
-			else if (m_ar.GetChunkID() == PLT_MESH)
-			{
-				if (ReadMesh(fem) == false) return errf("Error while reading mesh section.");
-			}
-			else errf("Error while reading state data.");
+			if (nret == READ_CHUNK_ERROR) { bok = false; break; }
+			if (nret == READ_CHUNK_STOP) break;
+
 			m_ar.CloseChunk();
+			if (m_bpaged) end = m_ar.Tell();
+			m_stateEnd = end;
 		
 			// clear end-flag
 			if (m_ar.OpenChunk() != xpltArchive::IO_END)
@@ -221,18 +254,152 @@ bool XpltReader3::Load(FEPostModel& fem)
 
 			++nstate;
 		}
-		if (read_state_flag == XPLT_READ_LAST_STATE_ONLY) { fem.AddState(m_pstate); m_pstate = 0; }
+		if (bok && (read_state_flag == XPLT_READ_LAST_STATE_ONLY)) { fem.AddState(m_pstate); m_pstate = 0; }
 	}
 	catch (...)
 	{
 		errf("An unknown exception has occurred.\nNot all data was read in.");
 	}
+	if (bok == false) return false;
 
-	Clear();
+	// When paging, we need to hang on to the dictionary and mesh data
+	// since we'll need it to read the states later.
+	if (m_bpaged)
+	{
+		fem.SetStateLoader(m_xplt, m_xplt->GetMaxPagedStates());
+	}
+	else if (m_xplt->IsFollowing() == false) Clear();
 
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// Process the master chunk that is currently open (i.e. a state or mesh section)
+int XpltReader3::ReadDataChunk(FEPostModel& fem, int nstate, off_type pos)
+{
+	try {
+		int read_state_flag = m_xplt->GetReadStateFlag();
+		if (m_ar.GetChunkID() == PLT_STATE)
+		{
+			if (m_pstate) { delete m_pstate; m_pstate = 0; }
+			if (read_state_flag == XPLT_READ_STATES_PAGED)
+			{
+				if (IndexStateSection(fem, pos) == false) return READ_CHUNK_STOP;
+			}
+			else if (ReadStateSection(fem) == false) return READ_CHUNK_STOP;
+			if (read_state_flag == XPLT_READ_ALL_STATES) { fem.AddState(m_pstate); m_pstate = 0; }
+			else if (read_state_flag == XPLT_READ_STATES_FROM_LIST)
+			{
+				vector<int> state_list = m_xplt->GetReadStates();
+				int n = (int)state_list.size();
+				for (int i = 0; i < n; ++i)
+				{
+					if (state_list[i] == nstate)
+					{
+						fem.AddState(m_pstate);
+						m_pstate = 0;
+						break;
+					}
+				}
+			}
+		}
+		else if (m_ar.GetChunkID() == PLT_MESH)
+		{
+			if (ReadMesh(fem) == false)
+			{
+				errf("Error while reading mesh section.");
+				return READ_CHUNK_ERROR;
+			}
+		}
+		else errf("Error while reading state data.");
+	}
+	catch (...)
+	{
+		errf("An unknown exception has occurred.\nNot all data was read in.");
+		return READ_CHUNK_STOP;
+	}
+
+	return READ_CHUNK_OK;
+}
+
+//-----------------------------------------------------------------------------
+bool XpltReader3::LoadState(FEPostModel& fem, FEState* ps)
+{
+	std::map<FEState*, off_type>::iterator it = m_stateOffset.find(ps);
+	if (it == m_stateOffset.end()) return false;
+
+	// make sure we read the data for the correct mesh
+	ActivateMesh(ps->GetFEMesh());
+
+	// find the state section
+	if (m_ar.Seek(it->second) == false) return errf("Failed locating state data.");
+	if (m_ar.OpenChunk() != xpltArchive::IO_OK) return errf("Failed reading state data.");
+	if (m_ar.GetChunkID() != PLT_STATE) return errf("Failed reading state data.");
+
+	bool bret = false;
+	try {
+		bret = ReadState(fem, ps);
+	}
+	catch (...)
+	{
+		return errf("An unknown exception has occurred while reading state data.");
+	}
+	m_ar.CloseChunk();
+
+	return bret;
+}
+
+//-----------------------------------------------------------------------------
+// Read the sections that were added to the file after the last complete section 
+// was read. A section that is still being written fails to read and is tried 
+// again on the next call. A complete section that can't be processed is an error.
+int XpltReader3::ReadNewStates(FEPostModel& fem)
+{
+	// if the file got smaller, it was probably overwritten
+	if (m_ar.FileSize() < m_stateEnd) return -1;
+
+	// new states are read for the last mesh
+	if (m_bpaged && (fem.Meshes() > 0)) ActivateMesh(fem.GetFEMesh(fem.Meshes() - 1));
+
+	int newStates = 0;
+	while (true)
+	{
+		if (m_ar.Seek(m_stateEnd) == false) return -1;
+
+		xpltArchive::CHUNK_BUFFER buf;
+		if (m_ar.ReadChunk(buf) != xpltArchive::IO_OK) break;
+		off_type end = m_ar.Tell();
+
+		int nstates = fem.GetStates();
+		m_ar.OpenChunk(buf);
+		int nret = ReadDataChunk(fem, nstates, m_stateEnd);
+		m_ar.CloseChunk();
+		if (nret != READ_CHUNK_OK) return -1;
+
+		m_stateEnd = end;
+		newStates += fem.GetStates() - nstates;
+	}
+
+	// leave the file at the end of the last complete section
+	m_ar.Seek(m_stateEnd);
+
+	if (newStates > 0) fem.UpdateBoundingBox();
+
+	return newStates;
+}
+
+//-----------------------------------------------------------------------------
+void XpltReader3::ActivateMesh(Post::FEPostMesh* mesh)
+{
+	if (mesh == m_mesh) return;
+
+	// park the current mesh and bring in the requested one
+	std::swap(m_xmesh, m_pagedMesh[m_mesh]);
+	std::swap(m_xmesh, m_pagedMesh[mesh]);
+	m_pagedMesh.erase(mesh);
+	m_mesh = mesh;
+}
+
 //-----------------------------------------------------------------------------
 bool XpltReader3::ReadRootSection(FEPostModel& fem)
 {
@@ -841,6 +1008,9 @@ void XpltReader3::CreateMaterials(FEPostModel& fem)
 //-----------------------------------------------------------------------------
 bool XpltReader3::ReadMesh(FEPostModel &fem)
 {
+	// paged states may still need the current mesh, so we hang on to it
+	if (m_bpaged && m_mesh) std::swap(m_xmesh, m_pagedMesh[m_mesh]);
+
 	// clear the current XMesh
 	m_xmesh.Clear();
 
@@ -1325,18 +1495,54 @@ bool XpltReader3::ReadStateSection(FEPostModel& fem)
 		return errf("Error allocating memory for state data");
 	}
 
+	return ReadState(fem, ps);
+}
+
+//-----------------------------------------------------------------------------
+// Only read the state header and remember where to find the state. The state's
+// data will be read when the state is paged in.
+bool XpltReader3::IndexStateSection(FEPostModel& fem, off_type pos)
+{
+	Post::FEPostMesh& mesh = *GetCurrentMesh();
+
+	FEState* ps = new FEState(0.f, &fem, &mesh, false);
+	while (m_ar.OpenChunk() == xpltArchive::IO_OK)
+	{
+		if (m_ar.GetChunkID() == PLT_STATE_HEADER) ReadStateHeader(ps);
+		m_ar.CloseChunk();
+	}
+
+	ps->m_bpaged = true;
+	m_stateOffset[ps] = pos;
+	fem.AddState(ps);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool XpltReader3::ReadStateHeader(FEState* ps)
+{
+	while (m_ar.OpenChunk() == xpltArchive::IO_OK)
+	{
+		int nid = m_ar.GetChunkID();
+		if (nid == PLT_STATE_HDR_TIME) m_ar.read(ps->m_time);
+		if (nid == PLT_STATE_STATUS  ) m_ar.read(ps->m_status);
+		m_ar.CloseChunk();
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool XpltReader3::ReadState(FEPostModel& fem, FEState* ps)
+{
+	Post::FEPostMesh& mesh = *ps->GetFEMesh();
+
 	while (m_ar.OpenChunk() == xpltArchive::IO_OK)
 	{
 		int nid = m_ar.GetChunkID();
 		if (nid == PLT_STATE_HEADER)
 		{
-			while (m_ar.OpenChunk() == xpltArchive::IO_OK)
-			{
-				int nid = m_ar.GetChunkID();
-				if (nid == PLT_STATE_HDR_TIME) m_ar.read(ps->m_time);
-				if (nid == PLT_STATE_STATUS  ) m_ar.read(ps->m_status);
-				m_ar.CloseChunk();
-			}
+			ReadStateHeader(ps);
 		}
 		else if (nid == PLT_STATE_DATA)
 		{
@@ -1441,7 +1647,7 @@ bool XpltReader3::ReadStateSection(FEPostModel& fem)
 
 								assert((nv >= 0) && (nv < po->m_data.size()));
 
-								ObjectData* pd = m_pstate->m_objPt[objId].data;
+								ObjectData* pd = ps->m_objPt[objId].data;
 
 								switch (po->m_data[nv]->Type())
 								{
@@ -1500,7 +1706,7 @@ bool XpltReader3::ReadStateSection(FEPostModel& fem)
 
 								assert((nv >= 0) && (nv < po->m_data.size()));
 
-								ObjectData* pd = m_pstate->m_objLn[objId].data;
+								ObjectData* pd = ps->m_objLn[objId].data;
 
 								switch (po->m_data[nv]->Type())
 								{
@@ -27,6 +27,7 @@ SOFTWARE.*/
 #pragma once
 #include "xpltFileReader.h"
 #include <MeshLib/FEElement.h>
+#include <map>
 
 namespace Post {
 	class FEState;
@@ -318,9 +319,22 @@ public:
 
 	bool Load(Post::FEPostModel& fem);
 
+	// reload the data of a paged state
+	bool LoadState(Post::FEPostModel& fem, Post::FEState* ps) override;
+
+	// read the states that were appended since the last read (follow mode)
+	int ReadNewStates(Post::FEPostModel& fem) override;
+
 protected:
 	bool ReadRootSection(Post::FEPostModel& fem);
 	bool ReadStateSection(Post::FEPostModel& fem);
+	bool ReadState(Post::FEPostModel& fem, Post::FEState* ps);
+	bool ReadStateHeader(Post::FEState* ps);
+	bool IndexStateSection(Post::FEPostModel& fem, off_type pos);
+
+	// return values for ReadDataChunk
+	enum { READ_CHUNK_OK, READ_CHUNK_STOP, READ_CHUNK_ERROR };
+	int ReadDataChunk(Post::FEPostModel& fem, int nstate, off_type pos);
 
 	bool ReadDictionary(Post::FEPostModel& fem);
 	bool ReadMesh(Post::FEPostModel& fem);
@@ -364,6 +378,9 @@ protected:
 protected:
 	Post::FEPostMesh* GetCurrentMesh() { return m_mesh; }
 
+	// make the XMesh of the given mesh the current one (used when paging)
+	void ActivateMesh(Post::FEPostMesh* mesh);
+
 protected:
 	Dictionary			m_dic;
 	XMesh				m_xmesh;
@@ -385,4 +402,11 @@ protected:
 
 	Post::FEState*	m_pstate;	//!< last read state section
 	Post::FEPostMesh*	m_mesh;		//!< current mesh
+
+	// paging data
+	bool	m_bpaged;	//!< are the states paged?
+	std::map<Post::FEState*, off_type>		m_stateOffset;	//!< file position of each paged state
+	std::map<Post::FEPostMesh*, XMesh>		m_pagedMesh;	//!< the (inactive) meshes that paged states may refer to
+
+	off_type	m_stateEnd;	//!< file position after the last complete section (used in follow mode)
 };